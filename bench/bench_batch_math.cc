@@ -0,0 +1,83 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/collections/vec.h"
+#include "sus/num/batch_math.h"
+#include "sus/prelude.h"
+
+namespace {
+template <class F>
+static sus::Vec<F> generate_data(usize sz, F lo, F hi) {
+  auto data = sus::Vec<F>::with_capacity(sz);
+  for (usize i; i < sz; i += 1u) {
+    data.push(lo + (hi - lo) * sus::cast<F>(i) / sus::cast<F>(sz));
+  }
+  return data;
+}
+}  // namespace
+
+// Compares the scalar float methods, applied to each element in a loop,
+// against the batch functions over the whole slice.
+template <class F>
+static void batch_math(ankerl::nanobench::Bench& b, const sus::Vec<F>& data,
+                       std::string_view name, F (*scalar)(const F&),
+                       void (*batch)(const sus::Slice<F>&, sus::SliceMut<F>)) {
+  auto out = sus::Vec<F>::with_capacity(data.len());
+  for (usize i; i < data.len(); i += 1u) out.push(F());
+
+  b.run(fmt::format("scalar {}, n = {}", name, data.len()), [&]() {
+    for (usize i; i < data.len(); i += 1u) out[i] = scalar(data[i]);
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+
+  b.run(fmt::format("sus::num::batch::{}, n = {}", name, data.len()), [&]() {
+    batch(data, out);
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+}
+
+template <class F>
+static void all_functions(usize num_elements) {
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+  auto trig = generate_data<F>(num_elements, sus::cast<F>(-100_i32),
+                               sus::cast<F>(100_i32));
+  batch_math<F>(b, trig, "sin", [](const F& x) { return x.sin(); },
+                sus::num::batch::sin);
+  batch_math<F>(b, trig, "cos", [](const F& x) { return x.cos(); },
+                sus::num::batch::cos);
+  batch_math<F>(b, trig, "tanh", [](const F& x) { return x.tanh(); },
+                sus::num::batch::tanh);
+  auto exp = generate_data<F>(num_elements, sus::cast<F>(-80_i32),
+                              sus::cast<F>(80_i32));
+  batch_math<F>(b, exp, "exp", [](const F& x) { return x.exp(); },
+                sus::num::batch::exp);
+  auto pos = generate_data<F>(num_elements, sus::cast<F>(1e-3_f64),
+                              sus::cast<F>(1e6_f64));
+  batch_math<F>(b, pos, "ln", [](const F& x) { return x.ln(); },
+                sus::num::batch::ln);
+  batch_math<F>(b, pos, "sqrt", [](const F& x) { return x.sqrt(); },
+                sus::num::batch::sqrt);
+  batch_math<F>(
+      b, pos, "rsqrt",
+      [](const F& x) { return sus::cast<F>(1_i32) / x.sqrt(); },
+      sus::num::batch::rsqrt);
+}
+
+TEST(BenchBatchMath, F32_1000) { all_functions<f32>(1'000u); }
+TEST(BenchBatchMath, F32_100_000) { all_functions<f32>(100'000u); }
+TEST(BenchBatchMath, F64_1000) { all_functions<f64>(1'000u); }
+TEST(BenchBatchMath, F64_100_000) { all_functions<f64>(100'000u); }
@@ -0,0 +1,64 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This file is a compile-time benchmark, built once as `bench_compile_headers`
+// which includes the library headers, and once as `bench_compile_module` which
+// imports the `sus` module, or uses its precompiled headers when the compiler
+// can not build modules. The build reports the time and memory used to compile
+// each one.
+
+#if defined(SUS_USE_MODULE) && SUS_USE_MODULE
+import sus;
+#else
+#include "sus/boxed/box.h"
+#include "sus/choice/choice.h"
+#include "sus/collections/array.h"
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+#include "sus/tuple/tuple.h"
+#endif
+
+using namespace sus::prelude;
+
+namespace {
+// A typical mix of library use, so that compiling this file instantiates the
+// common templates in the library.
+sus::Result<u32, u32> sum_evens(const sus::Vec<u32>& v) {
+  auto evens = v.iter()
+                   .filter([](const u32& x) { return x % 2u == 0u; })
+                   .map([](const u32& x) { return x * 2u; })
+                   .collect<sus::Vec<u32>>();
+  if (evens.is_empty()) return sus::err(0u);
+  return sus::ok(sus::move(evens).into_iter().fold(
+      0_u32, [](u32 acc, u32 x) { return acc.wrapping_add(x); }));
+}
+
+Option<sus::Tuple<usize, i32>> find_max(sus::Array<i32, 4> a) {
+  return sus::move(a).into_iter().enumerate().max_by_key(
+      [](const sus::Tuple<usize, i32>& t) { return t.at<1>(); });
+}
+}  // namespace
+
+u32 bench_compile_time() {
+  auto v = sus::Vec<u32>(1u, 2u, 3u, 4u);
+  auto b = sus::Box<u32>(5u);
+  auto m = find_max(sus::Array<i32, 4>(3, 1, 4, 1));
+  auto max = sus::move(m).map([](sus::Tuple<usize, i32> t) {
+    return u32::try_from(t.at<1>()).unwrap();
+  });
+  return sum_evens(v).unwrap_or_default() + *b + max.unwrap_or_default();
+}
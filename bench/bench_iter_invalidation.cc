@@ -0,0 +1,121 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This file is built once for each iterator invalidation mode, with
+// `SUS_ITERATOR_INVALIDATION`, `SUS_ITERATOR_INVALIDATION_ATOMIC` and
+// `SUS_ITERATOR_INVALIDATION_VIEWS` set by the build, since the mode changes
+// the layout of the collection types. Compare
+// the results of the `bench_iter_invalidation_*` binaries to see the cost of
+// each mode.
+
+#include <thread>
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+
+namespace {
+constexpr usize kLen = 16u;
+constexpr usize kSlices = 10'000u;
+constexpr usize kThreads = 4u;
+constexpr usize kLongLen = 100'000u;
+constexpr usize kWindow = 4u;
+
+#if defined(SUS_ITERATOR_INVALIDATION) && !SUS_ITERATOR_INVALIDATION
+constexpr const char* kMode = "off";
+#elif !SUS_ITERATOR_INVALIDATION_VIEWS
+constexpr const char* kMode = "owner_only";
+#elif SUS_ITERATOR_INVALIDATION_ATOMIC
+constexpr const char* kMode = "atomic";
+#else
+constexpr const char* kMode = "plain";
+#endif
+
+// Each short iteration makes a `SliceIter` from the `Vec`, so the cost of
+// counting them is not hidden by a long loop over the elements.
+i32 sum_short_iters(const sus::Vec<i32>& v) {
+  i32 sum;
+  for (usize i; i < kSlices; i += 1u) {
+    for (const i32& x : v.iter()) sum = sum.wrapping_add(x);
+  }
+  return sum;
+}
+
+// Each window is a `Slice` that is iterated over, which is only counted when
+// views are tracked.
+i32 sum_windows(const sus::Vec<i32>& v) {
+  i32 sum;
+  for (sus::Slice<i32> w : v.windows(kWindow)) {
+    for (const i32& x : w) sum = sum.wrapping_add(x);
+  }
+  return sum;
+}
+
+i32 sum_chunks(const sus::Vec<i32>& v) {
+  i32 sum;
+  for (sus::Slice<i32> c : v.chunks(kWindow)) {
+    for (const i32& x : c) sum = sum.wrapping_add(x);
+  }
+  return sum;
+}
+
+sus::Vec<i32> make_vec(usize len) {
+  auto v = sus::Vec<i32>::with_capacity(len);
+  for (usize i; i < len; i += 1u) v.push(sus::cast<i32>(i));
+  return v;
+}
+}  // namespace
+
+TEST(BenchIterInvalidation, ShortIters) {
+  auto v = make_vec(kLen);
+
+  auto b = ankerl::nanobench::Bench();
+  b.run(kMode, [&]() {
+    ankerl::nanobench::doNotOptimizeAway(sum_short_iters(v));
+  });
+}
+
+TEST(BenchIterInvalidation, Windows) {
+  auto v = make_vec(kLongLen);
+
+  auto b = ankerl::nanobench::Bench();
+  b.run(kMode, [&]() { ankerl::nanobench::doNotOptimizeAway(sum_windows(v)); });
+}
+
+TEST(BenchIterInvalidation, Chunks) {
+  auto v = make_vec(kLongLen);
+
+  auto b = ankerl::nanobench::Bench();
+  b.run(kMode, [&]() { ankerl::nanobench::doNotOptimizeAway(sum_chunks(v)); });
+}
+
+// Plain counting is not safe when iterating on many threads at once.
+#if (defined(SUS_ITERATOR_INVALIDATION) && !SUS_ITERATOR_INVALIDATION) || \
+    SUS_ITERATOR_INVALIDATION_ATOMIC
+TEST(BenchIterInvalidation, ShortItersOnManyThreads) {
+  auto v = make_vec(kLen);
+
+  auto b = ankerl::nanobench::Bench();
+  b.run(kMode, [&]() {
+    auto threads = sus::Vec<std::thread>::with_capacity(kThreads);
+    for (usize t; t < kThreads; t += 1u) {
+      threads.push(std::thread([&v] {
+        ankerl::nanobench::doNotOptimizeAway(sum_short_iters(v));
+      }));
+    }
+    for (std::thread& t : threads.iter_mut()) t.join();
+  });
+}
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+
+#include <charconv>
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+
+namespace {
+// Generates `sz` numbers formatted as strings, such as would be read from a
+// CSV file.
+template <class T>
+static sus::Vec<std::string> generate_strings(usize sz) {
+  auto data = sus::Vec<std::string>::with_capacity(sz);
+  uint64_t state = 0x853c49e6748fea9bu;
+  for (usize i; i < sz; i += 1u) {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    if constexpr (std::same_as<T, u64>) {
+      data.push(std::to_string(state >> (state % 64u)));
+    } else {
+      char buf[32u];
+      const double d = static_cast<double>(state >> 11u) / 1e6;
+      const int n = snprintf(buf, sizeof(buf), "%.*g",
+                             static_cast<int>(state % 17u) + 1, d);
+      data.push(std::string(buf, static_cast<size_t>(n)));
+    }
+  }
+  return data;
+}
+}  // namespace
+
+TEST(BenchParse, U64) {
+  auto strings = generate_strings<u64>(10'000u);
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  b.run("strtoull", [&]() {
+    uint64_t sum = 0u;
+    for (const std::string& s : strings)
+      sum += strtoull(s.c_str(), nullptr, 10);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run("std::from_chars", [&]() {
+    uint64_t sum = 0u;
+    for (const std::string& s : strings) {
+      uint64_t v;
+      std::from_chars(s.data(), s.data() + s.size(), v);
+      sum += v;
+    }
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run("u64::from_str_radix", [&]() {
+    u64 sum;
+    for (const std::string& s : strings)
+      sum = sum.wrapping_add(u64::from_str_radix(s, 10u).unwrap());
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
+
+TEST(BenchParse, F64) {
+  auto strings = generate_strings<f64>(10'000u);
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  b.run("strtod", [&]() {
+    double sum = 0.0;
+    for (const std::string& s : strings) sum += strtod(s.c_str(), nullptr);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run("f64::from_str", [&]() {
+    f64 sum;
+    for (const std::string& s : strings) sum += f64::from_str(s).unwrap();
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
+
+TEST(BenchParse, ToChars) {
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+  char buf[24u];
+  auto out = sus::SliceMut<char>::from(buf);
+
+  b.run("std::to_chars u64", [&]() {
+    size_t sum = 0u;
+    for (uint64_t i = 1u; i < 1'000'000'000'000u; i *= 3u)
+      sum += static_cast<size_t>(std::to_chars(buf, buf + 24, i).ptr - buf);
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run("u64::to_chars", [&]() {
+    usize sum;
+    for (u64 i = 1u; i < 1'000'000'000'000u; i *= 3u)
+      sum += i.to_chars(out).unwrap();
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
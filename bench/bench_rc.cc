@@ -0,0 +1,131 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/boxed/arc.h"
+#include "sus/boxed/rc.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+
+namespace {
+// A node in a graph where each node shares ownership of the nodes it points
+// to, so building and walking it is dominated by reference count traffic.
+template <template <class> class Ptr>
+struct Node {
+  i32 value;
+  sus::Vec<Ptr<Node>> edges;
+};
+
+template <class T>
+using SharedPtr = std::shared_ptr<T>;
+
+constexpr usize kNodes = 1'000u;
+constexpr usize kEdges = 8u;
+
+template <class P, class MakeFn, class CloneFn>
+sus::Vec<P> build_graph(MakeFn make, CloneFn clone) {
+  auto nodes = sus::Vec<P>::with_capacity(kNodes);
+  for (usize i; i < kNodes; i += 1u) {
+    auto edges = sus::Vec<P>::with_capacity(kEdges);
+    if (i > 0u) {
+      for (usize e; e < kEdges; e += 1u)
+        edges.push(clone(nodes[(i * 7u + e * 13u) % i]));
+    }
+    nodes.push(make(sus::cast<i32>(i), sus::move(edges)));
+  }
+  return nodes;
+}
+}  // namespace
+
+TEST(BenchRc, BuildGraph) {
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  b.run("std::shared_ptr", [&]() {
+    using N = Node<SharedPtr>;
+    auto g = build_graph<std::shared_ptr<N>>(
+        [](i32 v, sus::Vec<std::shared_ptr<N>> e) {
+          return std::make_shared<N>(v, sus::move(e));
+        },
+        [](const std::shared_ptr<N>& p) { return p; });
+    ankerl::nanobench::doNotOptimizeAway(g);
+  });
+  b.run("Rc", [&]() {
+    using N = Node<sus::Rc>;
+    auto g = build_graph<sus::Rc<N>>(
+        [](i32 v, sus::Vec<sus::Rc<N>> e) {
+          return sus::Rc<N>::with_args(v, sus::move(e));
+        },
+        [](const sus::Rc<N>& p) { return p.clone(); });
+    ankerl::nanobench::doNotOptimizeAway(g);
+  });
+  b.run("Arc", [&]() {
+    using N = Node<sus::Arc>;
+    auto g = build_graph<sus::Arc<N>>(
+        [](i32 v, sus::Vec<sus::Arc<N>> e) {
+          return sus::Arc<N>::with_args(v, sus::move(e));
+        },
+        [](const sus::Arc<N>& p) { return p.clone(); });
+    ankerl::nanobench::doNotOptimizeAway(g);
+  });
+}
+
+TEST(BenchRc, CloneAll) {
+  using SN = Node<SharedPtr>;
+  using RN = Node<sus::Rc>;
+  using AN = Node<sus::Arc>;
+  auto shared = build_graph<std::shared_ptr<SN>>(
+      [](i32 v, sus::Vec<std::shared_ptr<SN>> e) {
+        return std::make_shared<SN>(v, sus::move(e));
+      },
+      [](const std::shared_ptr<SN>& p) { return p; });
+  auto rcs = build_graph<sus::Rc<RN>>(
+      [](i32 v, sus::Vec<sus::Rc<RN>> e) {
+        return sus::Rc<RN>::with_args(v, sus::move(e));
+      },
+      [](const sus::Rc<RN>& p) { return p.clone(); });
+  auto arcs = build_graph<sus::Arc<AN>>(
+      [](i32 v, sus::Vec<sus::Arc<AN>> e) {
+        return sus::Arc<AN>::with_args(v, sus::move(e));
+      },
+      [](const sus::Arc<AN>& p) { return p.clone(); });
+
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  // Clone every edge into a growing vector, which also measures moving the
+  // pointers when the vector reallocates.
+  b.run("std::shared_ptr", [&]() {
+    auto out = std::vector<std::shared_ptr<SN>>();
+    for (const auto& n : shared)
+      for (const auto& e : n->edges) out.push_back(e);
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  b.run("Rc", [&]() {
+    auto out = sus::Vec<sus::Rc<RN>>();
+    for (const auto& n : rcs)
+      for (const auto& e : n->edges) out.push(e.clone());
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+  b.run("Arc", [&]() {
+    auto out = sus::Vec<sus::Arc<AN>>();
+    for (const auto& n : arcs)
+      for (const auto& e : n->edges) out.push(e.clone());
+    ankerl::nanobench::doNotOptimizeAway(out);
+  });
+}
@@ -0,0 +1,86 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/boxed/box.h"
+#include "sus/boxed/small_box.h"
+#include "sus/collections/vec.h"
+#include "sus/fn/fn.h"
+#include "sus/prelude.h"
+
+namespace {
+// A function object with two pointers of state, which fits in the default
+// storage of a `SmallBox`.
+struct Accumulate {
+  i32 operator()(i32 i) const { return *base + i * *scale; }
+  const i32* base;
+  const i32* scale;
+};
+
+constexpr usize kNumFns = 1'000u;
+}  // namespace
+
+TEST(BenchSmallBox, Construct) {
+  const i32 base = 1;
+  const i32 scale = 2;
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  b.run("Box<DynFn>::from", [&]() {
+    auto v = sus::Vec<sus::Box<sus::fn::DynFn<i32(i32)>>>::with_capacity(
+        kNumFns);
+    for (usize i; i < kNumFns; i += 1u)
+      v.push(sus::Box<sus::fn::DynFn<i32(i32)>>::from(
+          Accumulate(&base, &scale)));
+    ankerl::nanobench::doNotOptimizeAway(v);
+  });
+  b.run("SmallBox<DynFn>::from", [&]() {
+    auto v = sus::Vec<sus::SmallBox<sus::fn::DynFn<i32(i32)>>>::with_capacity(
+        kNumFns);
+    for (usize i; i < kNumFns; i += 1u)
+      v.push(sus::SmallBox<sus::fn::DynFn<i32(i32)>>::from(
+          Accumulate(&base, &scale)));
+    ankerl::nanobench::doNotOptimizeAway(v);
+  });
+}
+
+TEST(BenchSmallBox, Call) {
+  const i32 base = 1;
+  const i32 scale = 2;
+  auto boxes =
+      sus::Vec<sus::Box<sus::fn::DynFn<i32(i32)>>>::with_capacity(kNumFns);
+  auto small_boxes =
+      sus::Vec<sus::SmallBox<sus::fn::DynFn<i32(i32)>>>::with_capacity(kNumFns);
+  for (usize i; i < kNumFns; i += 1u) {
+    boxes.push(
+        sus::Box<sus::fn::DynFn<i32(i32)>>::from(Accumulate(&base, &scale)));
+    small_boxes.push(sus::SmallBox<sus::fn::DynFn<i32(i32)>>::from(
+        Accumulate(&base, &scale)));
+  }
+
+  auto b = ankerl::nanobench::Bench();
+  b.relative(true);
+
+  b.run("Box<DynFn>::operator()", [&]() {
+    i32 sum;
+    for (const auto& f : boxes) sum = sum.wrapping_add(f(3));
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+  b.run("SmallBox<DynFn>::operator()", [&]() {
+    i32 sum;
+    for (const auto& f : small_boxes) sum = sum.wrapping_add(f(3));
+    ankerl::nanobench::doNotOptimizeAway(sum);
+  });
+}
@@ -0,0 +1,88 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include <tuple>
+#include <utility>
+
+#include "googletest/include/gtest/gtest.h"
+#include "nanobench.h"
+#include "sus/prelude.h"
+#include "sus/tuple/tuple.h"
+
+namespace {
+// Element types of mixed sizes, in an order that needs padding between them
+// unless they are reordered.
+template <size_t I>
+using Mixed = std::tuple_element_t<I % 4u, std::tuple<u8, u64, u16, u32>>;
+
+template <template <class...> class Tup, class Is>
+struct MixedTupleHelper;
+template <template <class...> class Tup, size_t... Is>
+struct MixedTupleHelper<Tup, std::index_sequence<Is...>> {
+  using type = Tup<Mixed<Is>...>;
+};
+
+template <template <class...> class Tup, size_t N>
+using MixedTuple = MixedTupleHelper<Tup, std::make_index_sequence<N>>::type;
+
+template <size_t N>
+void print_sizes() {
+  printf("%2zu elements: sus::Tuple %3zu bytes, std::tuple %3zu bytes\n", N,
+         sizeof(MixedTuple<sus::Tuple, N>), sizeof(MixedTuple<std::tuple, N>));
+  EXPECT_LE(sizeof(MixedTuple<sus::Tuple, N>),
+            sizeof(MixedTuple<std::tuple, N>));
+}
+
+template <size_t N>
+auto make_tuple() {
+  return [&]<size_t... Is>(std::index_sequence<Is...>) {
+    return MixedTuple<sus::Tuple, N>(Mixed<Is>::try_from(Is).unwrap()...);
+  }(std::make_index_sequence<N>());
+}
+
+template <size_t N>
+u64 sum_elements(const MixedTuple<sus::Tuple, N>& t) {
+  return [&]<size_t... Is>(std::index_sequence<Is...>) {
+    return (u64::from(t.template at<Is>()) + ...);
+  }(std::make_index_sequence<N>());
+}
+}  // namespace
+
+TEST(BenchTuple, Size) {
+  print_sizes<2u>();
+  print_sizes<4u>();
+  print_sizes<8u>();
+  print_sizes<16u>();
+}
+
+// Looking up each element is most costly when the build is not optimized, so
+// this is best compared in a debug build.
+TEST(BenchTuple, At) {
+  auto t2 = make_tuple<2u>();
+  auto t8 = make_tuple<8u>();
+  auto t16 = make_tuple<16u>();
+
+  auto b = ankerl::nanobench::Bench();
+  b.run("2 elements", [&]() {
+    ankerl::nanobench::doNotOptimizeAway(sum_elements<2u>(t2));
+  });
+  b.run("8 elements", [&]() {
+    ankerl::nanobench::doNotOptimizeAway(sum_elements<8u>(t8));
+  });
+  b.run("16 elements", [&]() {
+    ankerl::nanobench::doNotOptimizeAway(sum_elements<16u>(t16));
+  });
+}
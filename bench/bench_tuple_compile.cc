@@ -0,0 +1,51 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This file is a compile-time benchmark for Tuple. It instantiates Tuples of
+// 2 to 16 distinct element types and looks up each of their elements, so the
+// time to build the `bench_tuple_compile` target measures the cost of
+// instantiating the Tuple storage.
+
+#include <utility>
+
+#include "sus/prelude.h"
+#include "sus/tuple/tuple.h"
+
+namespace {
+// A distinct type for each index, so that no instantiations are shared between
+// the Tuples.
+template <size_t I>
+struct E {
+  u32 v;
+  constexpr bool operator==(const E&) const = default;
+};
+
+template <size_t S, size_t... Is>
+constexpr bool use_tuple(std::index_sequence<Is...>) {
+  using T = sus::Tuple<E<S + Is>...>;
+  auto t = T(E<S + Is>(u32::try_from(Is).unwrap())...);
+  auto u = t;
+  ((u.template at_mut<Is>().v += 1u), ...);
+  return ((t.template at<Is>().v + 1u == u.template at<Is>().v) && ...) &&
+         !(t == u);
+}
+
+template <size_t... Ns>
+constexpr bool use_tuples(std::index_sequence<Ns...>) {
+  // Sizes from 2 to 16, each with their own element types.
+  return (use_tuple<Ns * 16u>(std::make_index_sequence<Ns + 2u>()) && ...);
+}
+
+static_assert(use_tuples(std::make_index_sequence<15u>()));
+}  // namespace
@@ -12,8 +12,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <filesystem>
+#include <fstream>
+
 #include "subdoc/tests/subdoc_gen_test.h"
 
+namespace {
+
+void write_file(const std::filesystem::path& path) noexcept {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream(path) << "stale";
+}
+
+}  // namespace
+
 TEST_F(SubDocGenTest, FunctionOverloads) {
   EXPECT_TRUE(run_gen_test("function-overloads"));
 }
@@ -41,3 +53,51 @@ TEST_F(SubDocGenTest, Templates) {
 TEST_F(SubDocGenTest, TypenamesAcrossPaths) {
   EXPECT_TRUE(run_gen_test("typenames-across-paths"));
 }
+
+TEST_F(SubDocGenTest, Incremental) {
+  Option<subdoc::Database> db = run_code(R"(
+    /// Comment headline S
+    struct S {};
+  )");
+  ASSERT_TRUE(db.is_some());
+  subdoc::gen::Options options = gen_options("incremental");
+  std::filesystem::remove_all(options.output_root);
+
+  subdoc::gen::GenerateStats first =
+      subdoc::gen::generate(db.as_value(), options).unwrap();
+  EXPECT_GT(first.written, 0u);
+  EXPECT_EQ(first.unchanged, 0u);
+  EXPECT_EQ(first.deleted, 0u);
+
+  // Files that weren't generated are deleted, along with directories left
+  // empty, but not those whose names start with a `.`.
+  write_file(options.output_root / "x.html");
+  write_file(options.output_root / "sub" / "y.html");
+  write_file(options.output_root / ".git" / "HEAD");
+
+  subdoc::gen::GenerateStats second =
+      subdoc::gen::generate(db.as_value(), options).unwrap();
+  EXPECT_EQ(second.written, 0u);
+  EXPECT_EQ(second.unchanged, first.written);
+  EXPECT_EQ(second.deleted, 2u);
+  EXPECT_FALSE(std::filesystem::exists(options.output_root / "x.html"));
+  EXPECT_FALSE(std::filesystem::exists(options.output_root / "sub"));
+  EXPECT_TRUE(std::filesystem::exists(options.output_root / ".git" / "HEAD"));
+}
+
+TEST_F(SubDocGenTest, OutputRootIsAFile) {
+  Option<subdoc::Database> db = run_code(R"(
+    /// Comment headline S
+    struct S {};
+  )");
+  ASSERT_TRUE(db.is_some());
+  subdoc::gen::Options options = gen_options("output-root-is-a-file");
+  std::filesystem::remove_all(options.output_root);
+  write_file(options.output_root);
+
+  subdoc::gen::GenerateStats stats =
+      subdoc::gen::generate(db.as_value(), options).unwrap();
+  EXPECT_GT(stats.written, 0u);
+  EXPECT_EQ(stats.deleted, 1u);
+  EXPECT_TRUE(std::filesystem::is_directory(options.output_root));
+}
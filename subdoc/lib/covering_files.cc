@@ -0,0 +1,74 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/covering_files.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "sus/iter/iterator.h"
+
+namespace subdoc {
+
+Vec<usize> select_covering_files(
+    sus::Slice<Option<Vec<std::string>>> includes) noexcept {
+  // Give each file a number, and turn the includes of each translation unit
+  // into a list of those numbers without duplicates.
+  std::unordered_map<std::string_view, usize> file_ids;
+  auto tu_files = Vec<Vec<usize>>::with_capacity(includes.len());
+  auto seen = std::unordered_set<usize>();
+  for (const Option<Vec<std::string>>& files : includes) {
+    auto ids = Vec<usize>();
+    if (files.is_some()) {
+      seen.clear();
+      for (const std::string& f : files.as_value()) {
+        auto [it, inserted] = file_ids.emplace(f, usize::from(file_ids.size()));
+        if (seen.insert(it->second).second) ids.push(it->second);
+      }
+    }
+    tu_files.push(sus::move(ids));
+  }
+
+  auto chosen = Vec<bool>::with_capacity(includes.len());
+  for (usize i; i < includes.len(); i += 1u)
+    chosen.push(includes[i].is_none());
+  auto covered = Vec<bool>::with_capacity(usize::from(file_ids.size()));
+  for (usize i; i < file_ids.size(); i += 1u) covered.push(false);
+
+  while (true) {
+    usize best_index;
+    usize best_count;
+    for (usize i; i < tu_files.len(); i += 1u) {
+      if (chosen[i]) continue;
+      usize count = tu_files[i].iter().filter([&](const usize& id) {
+        return !covered[id];
+      }).count();
+      if (count > best_count) {
+        best_index = i;
+        best_count = count;
+      }
+    }
+    if (best_count == 0u) break;
+    chosen[best_index] = true;
+    for (usize id : tu_files[best_index].iter()) covered[id] = true;
+  }
+
+  auto selected = Vec<usize>();
+  for (usize i; i < chosen.len(); i += 1u) {
+    if (chosen[i]) selected.push(i);
+  }
+  return selected;
+}
+
+}  // namespace subdoc
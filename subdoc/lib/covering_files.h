@@ -0,0 +1,40 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+
+namespace subdoc {
+
+/// Chooses which translation units to parse, given the files matched by the
+/// path patterns that each one includes. An entry of None is a translation
+/// unit whose includes are not known, and it is always chosen.
+///
+/// Every file in `includes` is included by at least one of the chosen
+/// translation units. Finding the smallest such set is NP-hard, so instead the
+/// translation unit that includes the most files not yet covered is chosen
+/// until every file is covered, with ties going to the earliest one.
+///
+/// Returns the indices of the chosen translation units in increasing order, so
+/// that they are parsed in the same order as they were given.
+Vec<usize> select_covering_files(
+    sus::Slice<Option<Vec<std::string>>> includes) noexcept;
+
+}  // namespace subdoc
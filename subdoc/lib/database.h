@@ -60,6 +60,36 @@ using FoundName = sus::Choice<sus_choice_types(
     (FoundNameTag::Field, const FieldElement&),
     (FoundNameTag::Macro, const MacroElement&))>;
 
+/// An index of the elements in a `Database` by their fully qualified name,
+/// built by `Database::build_name_index()`.
+///
+/// A name is the path from the global namespace with each part preceded by
+/// `::`, such as `::sus::ops::Try`. The elements are held in node-based maps,
+/// so the index stays valid when the `Database` is moved, but it must be built
+/// again if elements are added or removed.
+struct NameIndex {
+  /// The element that `find_name()` finds for each name. A function with an
+  /// overload set is named with the overload set after a `!`. Where more than
+  /// one element has the same name, the one that `find_name()` would reach
+  /// first is kept.
+  std::unordered_map<std::string, FoundName> names;
+  /// The records, including nested records, by name.
+  std::unordered_map<std::string, const RecordElement*> records;
+  /// The functions in namespaces and the methods of records by name, without
+  /// their overload sets, so each name collects every overload set.
+  std::unordered_map<std::string, Vec<const FunctionElement*>> functions;
+
+  static std::string join(std::string_view parent,
+                          std::string_view name) noexcept {
+    std::string path;
+    path.reserve(parent.size() + 2u + name.size());
+    path += parent;
+    path += "::";
+    path += name;
+    return path;
+  }
+};
+
 struct SourceLink {
   enum Quality {
     UnknownLocation,
@@ -314,6 +344,22 @@ struct FunctionElement : public CommentElement {
     return sus::none();
   }
 
+  /// Adds the function to `index` as a child of `parent_path`. It is added to
+  /// `NameIndex::functions` only if `overloads_by_name` is true.
+  void add_names(NameIndex& index, std::string_view parent_path,
+                 bool overloads_by_name) const noexcept {
+    std::string path = NameIndex::join(parent_path, name);
+    if (overload_set.is_none()) {
+      index.names.try_emplace(path,
+                              FoundName::with<FoundName::Tag::Function>(*this));
+    } else if (!overload_set.as_value().empty()) {
+      // An empty overload set can't be matched by `find_name()`.
+      index.names.try_emplace(path + "!" + overload_set.as_value(),
+                              FoundName::with<FoundName::Tag::Function>(*this));
+    }
+    if (overloads_by_name) index.functions[sus::move(path)].push(this);
+  }
+
   void for_each_comment(sus::fn::FnMut<void(Comment&)> auto fn) { fn(comment); }
 };
 
@@ -395,6 +441,7 @@ struct ConceptId {
   std::string name;
 
   bool operator==(const ConceptId&) const = default;
+  auto operator<=>(const ConceptId&) const = default;
 
   struct Hash {
     std::size_t operator()(const ConceptId& k) const {
@@ -409,6 +456,7 @@ struct MacroId {
   std::string name;
 
   bool operator==(const MacroId&) const = default;
+  auto operator<=>(const MacroId&) const = default;
 
   struct Hash {
     std::size_t operator()(const MacroId& k) const {
@@ -423,6 +471,7 @@ struct NamespaceId {
   std::string name;
 
   bool operator==(const NamespaceId&) const = default;
+  auto operator<=>(const NamespaceId&) const = default;
 
   struct Hash {
     std::size_t operator()(const NamespaceId& k) const {
@@ -437,6 +486,7 @@ struct AliasId {
   std::string name;
 
   bool operator==(const AliasId&) const = default;
+  auto operator<=>(const AliasId&) const = default;
 
   struct Hash {
     std::size_t operator()(const AliasId& k) const {
@@ -459,6 +509,7 @@ struct RecordId {
   std::string name;
 
   bool operator==(const RecordId&) const = default;
+  auto operator<=>(const RecordId&) const = default;
 
   struct Hash {
     std::size_t operator()(const RecordId& k) const {
@@ -479,6 +530,7 @@ struct FunctionId {
   std::string overload_set;
 
   bool operator==(const FunctionId&) const = default;
+  auto operator<=>(const FunctionId&) const = default;
 
   struct Hash {
     std::size_t operator()(const FunctionId& k) const {
@@ -674,6 +726,24 @@ struct RecordElement : public TypeElement {
     return out;
   }
 
+  /// Adds the record and everything inside it that `find_name()` can find to
+  /// `index`, in the same order that `find_name()` searches them.
+  void add_names(NameIndex& index, std::string path) const noexcept {
+    index.names.try_emplace(path, FoundName::with<FoundName::Tag::Type>(*this));
+    index.records.try_emplace(path, this);
+    for (const auto& [k, e] : records)
+      e.add_names(index, NameIndex::join(path, e.name));
+    for (const auto& [k, e] : fields) {
+      index.names.try_emplace(NameIndex::join(path, e.name),
+                              FoundName::with<FoundName::Tag::Field>(e));
+    }
+    for (const auto& [k, e] : deductions) e.add_names(index, path, false);
+    for (const auto& [k, e] : ctors) e.add_names(index, path, false);
+    for (const auto& [k, e] : dtors) e.add_names(index, path, false);
+    for (const auto& [k, e] : conversions) e.add_names(index, path, false);
+    for (const auto& [k, e] : methods) e.add_names(index, path, true);
+  }
+
   void for_each_comment(sus::fn::FnMut<void(Comment&)> auto fn) {
     fn(comment);
     for (auto& [k, e] : records) e.for_each_comment(fn);
@@ -972,6 +1042,37 @@ struct NamespaceElement : public CommentElement {
     return out;
   }
 
+  /// Adds everything inside the namespace that `find_name()` can find to
+  /// `index`, in the same order that `find_name_inside()` searches them.
+  void add_names_inside(NameIndex& index,
+                        std::string_view path) const noexcept {
+    for (const auto& [k, e] : concepts) {
+      index.names.try_emplace(NameIndex::join(path, e.name),
+                              FoundName::with<FoundName::Tag::Concept>(e));
+    }
+    for (const auto& [k, e] : namespaces) {
+      std::string sub_path = NameIndex::join(path, e.name);
+      index.names.try_emplace(sub_path,
+                              FoundName::with<FoundName::Tag::Namespace>(e));
+      e.add_names_inside(index, sub_path);
+    }
+    for (const auto& [k, e] : records)
+      e.add_names(index, NameIndex::join(path, e.name));
+    for (const auto& [k, e] : functions) e.add_names(index, path, true);
+    for (const auto& [k, e] : aliases) {
+      index.names.try_emplace(NameIndex::join(path, e.name),
+                              FoundName::with<FoundName::Tag::Type>(e));
+    }
+    for (const auto& [k, e] : variables) {
+      index.names.try_emplace(NameIndex::join(path, e.name),
+                              FoundName::with<FoundName::Tag::Field>(e));
+    }
+    for (const auto& [k, e] : macros) {
+      index.names.try_emplace(NameIndex::join(path, e.name),
+                              FoundName::with<FoundName::Tag::Macro>(e));
+    }
+  }
+
   void for_each_comment(sus::fn::FnMut<void(Comment&)> auto fn) {
     fn(comment);
     for (auto& [k, e] : concepts) e.for_each_comment(fn);
@@ -1012,7 +1113,19 @@ struct Database {
 
   bool has_any_comments() const noexcept { return global.has_any_comments(); }
 
+  /// Builds the index of elements by their fully qualified name that is used
+  /// by `find_name()` and `resolve_inherited_comments()`. It must be called
+  /// again after elements are added to or removed from the `Database`.
+  void build_name_index() noexcept {
+    auto index = NameIndex();
+    global.add_names_inside(index, global.name);
+    name_index_ = sus::some(sus::move(index));
+  }
+
   sus::Result<void, std::string> resolve_inherited_comments() {
+    if (name_index_.is_none()) build_name_index();
+    const NameIndex& index = name_index_.as_value();
+
     Vec<Comment*> to_resolve;
     {
       Vec<Comment*>* to_resolve_ptr = &to_resolve;
@@ -1037,6 +1150,7 @@ struct Database {
             (Target::Record, const RecordElement&),
             (Target::Function, const FunctionElement&))>;
         auto target = TargetChoice::with<Target::Namespace>(global);
+        std::string path = global.name;
         for (const InheritPathElement& e : *(c->attrs.inherit)) {
           switch (e) {
             case InheritPathNamespace: {
@@ -1057,77 +1171,46 @@ struct Database {
               }
               target.set<Target::Namespace>(
                   target.as_mut<Target::Namespace>().namespaces.at(id));
+              path = NameIndex::join(path, name);
               break;
             }
             case InheritPathRecord: {
-              // TODO: Make Record maps keyed on a RecordId we can construct
-              // here.
               const std::string& name = e.as<InheritPathRecord>();
-              auto find_record = [&](const auto& record_map)
-                  -> Option<const RecordElement&> {
-                for (const auto& [k, e] : record_map) {
-                  if (e.name == name) return sus::some(e);
-                }
-                return sus::none();
-              };
-              Option<const RecordElement&> record;
-              switch (target) {
-                case Target::Namespace:
-                  record =
-                      find_record(target.as_mut<Target::Namespace>().records);
-                  break;
-                case Target::Record:
-                  record = find_record(target.as_mut<Target::Record>().records);
-                  break;
-                case Target::Function: {
-                  std::ostringstream s;
-                  s << "Inherited comment at " << c->begin_loc
-                    << " has invalid path, with a record inside a function.";
-                  return sus::err(sus::move(s).str());
-                }
+              if (target.which() == Target::Function) {
+                std::ostringstream s;
+                s << "Inherited comment at " << c->begin_loc
+                  << " has invalid path, with a record inside a function.";
+                return sus::err(sus::move(s).str());
               }
-              if (record.is_none()) {
+              path = NameIndex::join(path, name);
+              auto it = index.records.find(path);
+              if (it == index.records.end()) {
                 std::ostringstream s;
                 s << "Inherited comment at " << c->begin_loc
                   << " can't find record " << name;
                 return sus::err(sus::move(s).str());
               }
-              target.set<Target::Record>(sus::move(record).unwrap());
+              target.set<Target::Record>(*it->second);
               break;
             }
             case InheritPathFunction: {
               const std::string& name = e.as<InheritPathFunction>();
-              auto find_function = [&](const auto& function_map)
-                  -> Option<const FunctionElement&> {
-                for (const auto& [k, e] : function_map) {
-                  if (e.name == name) return sus::some(e);
-                }
-                return sus::none();
-              };
-              Option<const FunctionElement&> function;
-              switch (target) {
-                case Target::Namespace:
-                  function = find_function(
-                      target.as_mut<Target::Namespace>().functions);
-                  break;
-                case Target::Record:
-                  function =
-                      find_function(target.as_mut<Target::Record>().methods);
-                  break;
-                case Target::Function: {
-                  std::ostringstream s;
-                  s << "Inherited comment at " << c->begin_loc
-                    << " has invalid path, with a function inside a function.";
-                  return sus::err(sus::move(s).str());
-                }
+              if (target.which() == Target::Function) {
+                std::ostringstream s;
+                s << "Inherited comment at " << c->begin_loc
+                  << " has invalid path, with a function inside a function.";
+                return sus::err(sus::move(s).str());
               }
-              if (function.is_none()) {
+              path = NameIndex::join(path, name);
+              // Any overload set will do, the first one found is used.
+              auto it = index.functions.find(path);
+              if (it == index.functions.end()) {
                 std::ostringstream s;
                 s << "Inherited comment at " << c->begin_loc
                   << " can't find function " << name;
                 return sus::err(sus::move(s).str());
               }
-              target.set<Target::Function>(sus::move(function).unwrap());
+              target.set<Target::Function>(*it->second[0u]);
               break;
             }
           }
@@ -1351,7 +1434,21 @@ struct Database {
   /// If there's a `!`, what comes after it is used as the overload set
   /// matcher for functions, which will match with what was specified in
   /// `#[doc.overloads=_]`.
+  ///
+  /// Once `build_name_index()` has been called, the name is looked up in the
+  /// index instead of searching through the `Database`.
   Option<FoundName> find_name(std::string_view full_name) const noexcept {
+    if (name_index_.is_some()) {
+      if (full_name.empty())
+        return sus::some(FoundName::with<FoundName::Tag::Namespace>(global));
+      const NameIndex& index = name_index_.as_value();
+      auto it = full_name.starts_with("::")
+                    ? index.names.find(std::string(full_name))
+                    : index.names.find(NameIndex::join(global.name, full_name));
+      if (it == index.names.end()) return sus::none();
+      return sus::some(it->second);
+    }
+
     llvm::SmallVector<llvm::StringRef> splits;
     llvm::StringRef(full_name).split(splits, "::");
 
@@ -1395,6 +1492,8 @@ struct Database {
   }
 
  private:
+  Option<NameIndex> name_index_;
+
   Option<RecordElement&> find_record_mut_impl(clang::RecordDecl* rdecl,
                                                    NamespaceElement& ne) & {
     if (auto* parent = clang::dyn_cast<clang::RecordDecl>(rdecl->getParent())) {
@@ -16,7 +16,9 @@
 
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <string_view>
 
 #include "subdoc/lib/database.h"
 #include "sus/collections/slice.h"
@@ -25,6 +27,14 @@
 
 namespace subdoc::gen {
 
+/// Prints `message` to stderr in a single write. Pages are generated on many
+/// threads, and printing their warnings this way keeps them from interleaving.
+inline void print_warning(std::string_view message) noexcept {
+  static std::mutex mutex;
+  auto lock = std::scoped_lock(mutex);
+  llvm::errs() << message;
+}
+
 inline Option<std::ofstream> open_file_for_writing(
     std::filesystem::path path) noexcept {
   std::filesystem::create_directories(path.parent_path());
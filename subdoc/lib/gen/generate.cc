@@ -18,46 +18,44 @@
 
 #include "subdoc/lib/gen/files.h"
 #include "subdoc/lib/gen/generate_namespace.h"
+#include "subdoc/lib/gen/generate_pages.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "subdoc/lib/gen/search.h"
 #include "sus/error/compat_error.h"
 
 namespace subdoc::gen {
 
 namespace {
 
-sus::result::Result<void, GenerateError> delete_tree(
-    const std::filesystem::path& path) {
-  if (std::filesystem::is_directory(path)) {
-    for (auto it = std::filesystem::directory_iterator(path);
-         it != std::filesystem::directory_iterator(); ++it) {
-      auto name = it->path().filename().string();
-      // Don't delete `.git` or `.` and `..`.
-      if (name.starts_with(".")) continue;
-
-      if (it->is_directory()) {
-        auto result = delete_tree(it->path());
-        if (result.is_err())
-          return sus::err(sus::into(sus::move(result).unwrap_err()));
-      }
+/// Deletes the files under `path` that were not produced by this run, along
+/// with any directories left empty, and counts them in `deleted`.
+sus::result::Result<void, GenerateError> delete_stale_files(
+    const std::filesystem::path& path, const OutputFiles& files,
+    usize& deleted) {
+  for (auto it = std::filesystem::directory_iterator(path);
+       it != std::filesystem::directory_iterator(); ++it) {
+    auto name = it->path().filename().string();
+    // Don't delete `.git` or `.` and `..`.
+    if (name.starts_with(".")) continue;
 
-      std::error_code ec;
-      std::filesystem::remove(*it, ec);
-      if (ec) {
-        return sus::err(
-            sus::into(GenerateError::with<GenerateError::Tag::DeleteFileError>(
-                GenerateFileError{
-                    .path = it->path().string(),
-                    .source = sus::move_into(ec),
-                })));
-      }
+    if (it->is_directory()) {
+      auto result = delete_stale_files(it->path(), files, deleted);
+      if (result.is_err())
+        return sus::err(sus::into(sus::move(result).unwrap_err()));
+      if (!std::filesystem::is_empty(it->path())) continue;
+    } else if (files.contains(it->path())) {
+      continue;
+    } else {
+      deleted += 1u;
     }
-  } else {
+
     std::error_code ec;
-    std::filesystem::remove(path, ec);
+    std::filesystem::remove(*it, ec);
     if (ec) {
       return sus::err(
           sus::into(GenerateError::with<GenerateError::Tag::DeleteFileError>(
               GenerateFileError{
-                  .path = path.string(),
+                  .path = it->path().string(),
                   .source = sus::move_into(ec),
               })));
     }
@@ -65,51 +63,105 @@ sus::result::Result<void, GenerateError> delete_tree(
   return sus::ok();
 }
 
+/// Copies the file at `source` into the `dest` directory, writing it only if
+/// it changed.
+sus::result::Result<void, GenerateError> copy_file(
+    const std::filesystem::path& source, const std::filesystem::path& dest,
+    OutputFiles& files) {
+  auto buffer = llvm::MemoryBuffer::getFile(source.string());
+  if (!buffer) {
+    std::error_code ec = buffer.getError();
+    return sus::err(
+        sus::into(GenerateError::with<GenerateError::Tag::CopyFileError>(
+            GenerateFileError{
+                .path = source.string(),
+                .source = sus::move_into(ec),
+            })));
+  }
+  llvm::StringRef bytes = (*buffer)->getBuffer();
+  auto file = OutputFile(dest / source.filename(), files);
+  file << std::string_view(bytes.data(), bytes.size());
+  return sus::ok();
+}
+
 }  // namespace
 
-sus::result::Result<void, sus::Box<sus::error::DynError>> generate(
+sus::result::Result<GenerateStats, sus::error::SmallError> generate(
     const Database& db, const Options& options) {
-  if (std::filesystem::exists(options.output_root)) {
-    auto result = delete_tree(options.output_root);
-    if (result.is_err())
-      return sus::err(sus::into(sus::move(result).unwrap_err()));
+  // Every file is recorded as it is produced, and written only if it changed.
+  // The files left over from an earlier run are deleted at the end.
+  auto files = OutputFiles();
+  usize deleted;
+
+  // Files are written inside the output root, so if it's not a directory it is
+  // removed first.
+  if (std::filesystem::exists(options.output_root) &&
+      !std::filesystem::is_directory(options.output_root)) {
+    std::error_code ec;
+    std::filesystem::remove(options.output_root, ec);
+    if (ec) {
+      return sus::err(
+          sus::into(GenerateError::with<GenerateError::Tag::DeleteFileError>(
+              GenerateFileError{
+                  .path = options.output_root.string(),
+                  .source = sus::move_into(ec),
+              })));
+    }
+    deleted += 1u;
   }
 
+  // The search index is built while walking the `Database`, which finds the
+  // pages to write afterward.
+  auto pages = Vec<Page>();
   {
-    std::filesystem::path search_json_path = options.output_root;
-    search_json_path.append("search_db.js");
-    auto json_writer =
-        JsonWriter(sus::some("g_search_db"),
-                   open_file_for_writing(search_json_path).unwrap());
-    auto search_documents = json_writer.open_array();
-
+    auto search_index = SearchIndex();
     if (auto result = generate_namespace(db, db.global, sus::empty,
-                                         search_documents, options);
+                                         search_index, pages, options);
         result.is_err()) {
       return sus::err(
           sus::into(GenerateError::with<GenerateError::Tag::MarkdownError>(
               sus::into(sus::move(result).unwrap_err()))));
     }
+    search_index.write(options.output_root, files);
+  }
+
+  if (auto result = generate_pages(db, pages, files, options);
+      result.is_err()) {
+    return sus::err(
+        sus::into(GenerateError::with<GenerateError::Tag::MarkdownError>(
+            sus::into(sus::move(result).unwrap_err()))));
   }
 
   for (const std::string& s : options.copy_files) {
     if (!std::filesystem::exists(s)) {
       llvm::errs() << "Skipping copy of '" << s << "'. File not found.\n";
-    } else {
-      std::error_code ec;
-      std::filesystem::copy(s, options.output_root, ec);
-      if (ec) {
-        return sus::err(
-            sus::into(GenerateError::with<GenerateError::Tag::CopyFileError>(
-                GenerateFileError{
-                    .path = sus::clone(s),
-                    .source = sus::move_into(ec),
-                })));
+    } else if (std::filesystem::is_directory(s)) {
+      // The files directly inside a directory are copied, as with
+      // `std::filesystem::copy()`.
+      for (auto it = std::filesystem::directory_iterator(s);
+           it != std::filesystem::directory_iterator(); ++it) {
+        if (!it->is_regular_file()) continue;
+        auto result = copy_file(it->path(), options.output_root, files);
+        if (result.is_err())
+          return sus::err(sus::into(sus::move(result).unwrap_err()));
       }
+    } else {
+      auto result = copy_file(s, options.output_root, files);
+      if (result.is_err())
+        return sus::err(sus::into(sus::move(result).unwrap_err()));
     }
   }
 
-  return sus::ok();
+  if (auto result = delete_stale_files(options.output_root, files, deleted);
+      result.is_err()) {
+    return sus::err(sus::into(sus::move(result).unwrap_err()));
+  }
+
+  return sus::ok(GenerateStats{
+      .written = files.written(),
+      .unchanged = files.unchanged(),
+      .deleted = deleted,
+  });
 }
 
 }  // namespace subdoc::gen
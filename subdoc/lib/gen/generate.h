@@ -22,6 +22,7 @@
 #include "sus/boxed/box.h"
 #include "sus/choice/choice.h"
 #include "sus/error/error.h"
+#include "sus/error/small_error.h"
 #include "sus/prelude.h"
 #include "sus/result/result.h"
 
@@ -44,10 +45,25 @@ using GenerateError = sus::Choice<sus_choice_types(
     (GenerateErrorTag::DeleteFileError, GenerateFileError),
     (GenerateErrorTag::MarkdownError, sus::Box<sus::error::DynError>))>;
 
+/// The files that `generate()` produced, compared to what was already in the
+/// output directory.
+struct GenerateStats {
+  /// The files that were new or had changed, and were written.
+  usize written;
+  /// The files that already had the same contents, and were not written.
+  usize unchanged;
+  /// The stale files from an earlier run that were deleted.
+  usize deleted;
+};
+
 /// Generate the html output from the database.
 ///
+/// Only files whose contents changed are written, and files in the output
+/// directory that were not generated are deleted, apart from those whose name
+/// starts with a `.`.
+///
 /// Returns an error if generation fails.
-sus::result::Result<void, sus::Box<sus::error::DynError>> generate(
+sus::result::Result<GenerateStats, sus::error::SmallError> generate(
     const Database& db, const Options& options);
 
 }  // namespace subdoc::gen
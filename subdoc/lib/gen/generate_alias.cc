@@ -14,6 +14,8 @@
 
 #include "subdoc/lib/gen/generate_alias.h"
 
+#include <sstream>
+
 #include "subdoc/lib/database.h"
 #include "subdoc/lib/gen/files.h"
 #include "subdoc/lib/gen/generate_cpp_path.h"
@@ -154,9 +156,11 @@ sus::Result<void, MarkdownToHtmlError> generate_alias_reference(
         span.write_text(element.name);
       }
     } else {
-      llvm::errs() << "WARNING: Reference to hidden AliasElement "
-                   << element.name << " in namespace "
-                   << element.namespace_path;
+      std::ostringstream warning;
+      warning << "WARNING: Reference to hidden AliasElement "
+              << element.name << " in namespace " << element.namespace_path
+              << "\n";
+      print_warning(warning.str());
       auto span = type_sig_div.open_span(HtmlWriter::SingleLine);
       span.add_class("type-name");
       span.write_text(element.name);
@@ -179,7 +183,7 @@ sus::Result<void, MarkdownToHtmlError> generate_alias_reference(
 }
 
 sus::Result<void, MarkdownToHtmlError> generate_alias_json(
-    const Database& db, JsonWriter::JsonArray& search_documents,
+    const Database& db, SearchIndex& search_index,
     std::string_view parent_full_name, const AliasElement& element,
     const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
@@ -192,41 +196,39 @@ sus::Result<void, MarkdownToHtmlError> generate_alias_json(
   // the alias is defined so it shows up in search still?
   if (Option<std::string> url = construct_html_url_for_alias(element);
       url.is_some()) {
-    i32 index = search_documents.len();
-    auto json = search_documents.open_object();
-    json.add_int("index", index);
+    auto doc = SearchDocument();
     switch (element.target) {
       case AliasTarget::Tag::AliasOfType:
-        json.add_string("type", "type alias");
+        doc.type = "type alias";
         break;
       case AliasTarget::Tag::AliasOfConcept:
-        json.add_string("type", "concept alias");
+        doc.type = "concept alias";
         break;
       case AliasTarget::Tag::AliasOfFunction:
-        json.add_string("type", "function alias");
+        doc.type = "function alias";
         break;
       case AliasTarget::Tag::AliasOfMethod:
-        json.add_string("type", "method alias");
+        doc.type = "method alias";
         break;
       case AliasTarget::Tag::AliasOfEnumConstant:
-        json.add_string("type", "enum value alias");
+        doc.type = "enum value alias";
         break;
       case AliasTarget::Tag::AliasOfVariable:
-        json.add_string("type", "variable alias");
+        doc.type = "variable alias";
         break;
     }
-    json.add_string("url", url.as_value());
-    json.add_string("name", element.name);
-    json.add_string("full_name", full_name);
-    json.add_string("split_name", split_for_search(full_name));
+    doc.url = url.as_value();
+    doc.name = element.name;
+    doc.full_name = sus::move(full_name);
 
     ParseMarkdownPageState page_state(db, options);
     if (auto md_html = get_alias_comment(element, page_state);
         md_html.is_err()) {
       return sus::err(sus::into(sus::move(md_html).unwrap_err()));
     } else {
-      json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+      doc.summary = sus::move(md_html).unwrap().summary_text;
     }
+    search_index.add(sus::move(doc));
   }
 
   return sus::ok();
@@ -16,8 +16,8 @@
 
 #include "subdoc/lib/database.h"
 #include "subdoc/lib/gen/html_writer.h"
-#include "subdoc/lib/gen/json_writer.h"
 #include "subdoc/lib/gen/markdown_to_html.h"
+#include "subdoc/lib/gen/search.h"
 #include "sus/prelude.h"
 #include "sus/result/result.h"
 
@@ -28,7 +28,7 @@ sus::Result<void, MarkdownToHtmlError> generate_alias_reference(
     ParseMarkdownPageState& page_state) noexcept;
 
 sus::Result<void, MarkdownToHtmlError> generate_alias_json(
-    const Database& db, JsonWriter::JsonArray& search_documents,
+    const Database& db, SearchIndex& search_index,
     std::string_view parent_full_name, const AliasElement& element,
     const Options& options) noexcept;
 
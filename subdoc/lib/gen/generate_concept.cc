@@ -128,16 +128,15 @@ void generate_concept_overview(HtmlWriter::OpenDiv& record_div,
 sus::Result<void, MarkdownToHtmlError> generate_concept(
     const Database& db, const ConceptElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept {
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
   {
-    i32 index = search_documents.len();
-    auto json = search_documents.open_object();
-    json.add_int("index", index);
-    json.add_string("type", "concept");
-    json.add_string("url", construct_html_url_for_concept(element));
-    json.add_string("name", element.name);
+    auto doc = SearchDocument();
+    doc.type = "concept";
+    doc.url = construct_html_url_for_concept(element);
+    doc.name = element.name;
 
     std::string full_name;
     for (CppPathElement e :
@@ -148,8 +147,7 @@ sus::Result<void, MarkdownToHtmlError> generate_concept(
         full_name += e.name;
       }
     }
-    json.add_string("full_name", full_name);
-    json.add_string("split_name", split_for_search(full_name));
+    doc.full_name = sus::move(full_name);
 
     if (auto comment = element.get_comment(); comment.is_some()) {
       ParseMarkdownPageState page_state(db, options);
@@ -157,11 +155,24 @@ sus::Result<void, MarkdownToHtmlError> generate_concept(
           md_html.is_err()) {
         return sus::err(sus::move(md_html).unwrap_err());
       } else {
-        json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+        doc.summary = sus::move(md_html).unwrap().summary_text;
       }
     }
+    search_index.add(sus::move(doc));
   }
 
+  pages.push(Page{
+      .element = PageElement::with<PageTag::Concept>(element),
+      .namespaces = namespaces.to_vec(),
+      .records = Vec<const RecordElement*>(),
+  });
+  return sus::ok();
+}
+
+sus::Result<void, MarkdownToHtmlError> generate_concept_page(
+    const Database& db, const ConceptElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    OutputFiles& files, const Options& options) noexcept {
   ParseMarkdownPageState page_state(db, options);
 
   MarkdownToHtml md_html;
@@ -174,7 +185,7 @@ sus::Result<void, MarkdownToHtmlError> generate_concept(
 
   const std::filesystem::path path =
       construct_html_file_path_for_concept(options.output_root, element);
-  auto html = HtmlWriter(open_file_for_writing(path).unwrap());
+  auto html = HtmlWriter(OutputFile(path, files));
 
   {
     std::ostringstream title;
@@ -231,9 +242,11 @@ sus::Result<void, MarkdownToHtmlError> generate_concept_reference(
       if (!element.hidden()) {
         name_link.add_href(construct_html_url_for_concept(element));
       } else {
-        llvm::errs() << "WARNING: Reference to hidden ConceptElement "
-                     << element.name << " in namespace "
-                     << element.namespace_path;
+        std::ostringstream warning;
+        warning << "WARNING: Reference to hidden ConceptElement "
+                << element.name << " in namespace " << element.namespace_path
+                << "\n";
+        print_warning(warning.str());
       }
       name_link.write_text(element.name);
     }
@@ -15,19 +15,30 @@
 #pragma once
 
 #include "subdoc/lib/database.h"
+#include "subdoc/lib/gen/generate_pages.h"
 #include "subdoc/lib/gen/html_writer.h"
-#include "subdoc/lib/gen/json_writer.h"
 #include "subdoc/lib/gen/markdown_to_html.h"
 #include "subdoc/lib/gen/options.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "subdoc/lib/gen/search.h"
 #include "sus/prelude.h"
 #include "sus/result/result.h"
 
 namespace subdoc::gen {
 
+/// Adds the search documents for `element`, and queues its page to be written by
+/// `generate_pages()`.
 sus::Result<void, MarkdownToHtmlError> generate_concept(
     const Database& db, const ConceptElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept;
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept;
+
+/// Writes the page for `element`.
+sus::Result<void, MarkdownToHtmlError> generate_concept_page(
+    const Database& db, const ConceptElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    OutputFiles& files, const Options& options) noexcept;
 
 sus::Result<void, MarkdownToHtmlError> generate_concept_reference(
     HtmlWriter::OpenUl& items_list, const ConceptElement& element,
@@ -161,9 +161,11 @@ void generate_overload_set(HtmlWriter::OpenDiv& div,
           if (!element.hidden()) {
             link_anchor.add_href(construct_html_url_for_function(element));
           } else {
-            llvm::errs() << "WARNING: Reference to hidden FunctionElement "
-                         << element.name << " in namespace "
-                         << element.namespace_path;
+            std::ostringstream warning;
+            warning << "WARNING: Reference to hidden FunctionElement "
+                    << element.name << " in namespace "
+                    << element.namespace_path << "\n";
+            print_warning(warning.str());
           }
         } else {
           // Only methods are not given their own page, and are just a named
@@ -203,16 +205,15 @@ void generate_overload_set(HtmlWriter::OpenDiv& div,
 sus::Result<void, MarkdownToHtmlError> generate_function(
     const Database& db, const FunctionElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept {
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
   {
-    i32 index = search_documents.len();
-    auto json = search_documents.open_object();
-    json.add_int("index", index);
-    json.add_string("type", "function");
-    json.add_string("url", construct_html_url_for_function(element));
-    json.add_string("name", element.name);
+    auto doc = SearchDocument();
+    doc.type = "function";
+    doc.url = construct_html_url_for_function(element);
+    doc.name = element.name;
 
     std::string full_name;
     for (CppPathElement e :
@@ -223,8 +224,7 @@ sus::Result<void, MarkdownToHtmlError> generate_function(
         full_name += e.name;
       }
     }
-    json.add_string("full_name", full_name);
-    json.add_string("split_name", split_for_search(full_name));
+    doc.full_name = sus::move(full_name);
 
     if (auto comment = element.get_comment(); comment.is_some()) {
       ParseMarkdownPageState page_state(db, options);
@@ -232,11 +232,24 @@ sus::Result<void, MarkdownToHtmlError> generate_function(
           md_html.is_err()) {
         return sus::err(sus::move(md_html).unwrap_err());
       } else {
-        json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+        doc.summary = sus::move(md_html).unwrap().summary_text;
       }
     }
+    search_index.add(sus::move(doc));
   }
 
+  pages.push(Page{
+      .element = PageElement::with<PageTag::Function>(element),
+      .namespaces = namespaces.to_vec(),
+      .records = Vec<const RecordElement*>(),
+  });
+  return sus::ok();
+}
+
+sus::Result<void, MarkdownToHtmlError> generate_function_page(
+    const Database& db, const FunctionElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    OutputFiles& files, const Options& options) noexcept {
   ParseMarkdownPageState page_state(db, options);
 
   MarkdownToHtml md_html;
@@ -249,7 +262,7 @@ sus::Result<void, MarkdownToHtmlError> generate_function(
 
   const std::filesystem::path path =
       construct_html_file_path_for_function(options.output_root, element);
-  auto html = HtmlWriter(open_file_for_writing(path).unwrap());
+  auto html = HtmlWriter(OutputFile(path, files));
 
   {
     std::ostringstream title;
@@ -81,10 +81,6 @@ void generate_head(HtmlWriter& html, std::string_view title,
     }
 
     // Script for showing search results.
-    {
-      auto script = head.open_script(HtmlWriter::SingleLine);
-      script.add_src("./search_db.js");
-    }
     {
       auto script = head.open_script();
       script.write_html(R"#(
@@ -198,25 +194,113 @@ void generate_head(HtmlWriter& html, std::string_view title,
           header_elem.innerText = "Search results";
         }
 
-        var cache_idx;
+        // The search index is written in shards by `SearchIndex`, which are
+        // loaded as they are needed. Each is a js file that sets one of these
+        // globals, as importing json is not widely supported yet (not on
+        // Safari) and fetching files is not allowed from `file://` urls.
+        // - g_search_index: the number of documents, their types, and which
+        //   shards of terms exist.
+        // - g_search_docs: the shards of documents, each an array of
+        //   [type, url, name, full_name, split_name, summary].
+        // - g_search_terms: the shards of terms, each mapping a term to the
+        //   ids of the documents that contain it.
+        var g_search_index;
+        var g_search_docs = [];
+        var g_search_terms = {};
+
+        var searchScripts = {};
+        function loadSearchScript(name) {
+          if (!searchScripts[name]) {
+            searchScripts[name] = new Promise((resolve, reject) => {
+              let script = document.createElement("script");
+              script.src = `./search/${name}`;
+              script.onload = resolve;
+              script.onerror = () => {
+                delete searchScripts[name];
+                reject(new Error(`unable to load ${script.src}`));
+              };
+              document.head.appendChild(script);
+            });
+          }
+          return searchScripts[name];
+        }
+
+        // The shard of terms that holds `term`, which is named by the first
+        // two bytes of the term in hex.
+        function termShard(term) {
+          return Array.from(new TextEncoder().encode(term).slice(0, 2))
+            .map(b => b.toString(16).padStart(2, "0"))
+            .join("");
+        }
+
+        // Finds the ids of the documents that contain a term of the query, or
+        // returns null if the query may match any document.
+        async function findSearchDocuments(query) {
+          // A prohibited term, like `-foo`, matches the documents that do not
+          // contain it, which may be any of them. Lunr treats a `-` at the
+          // start of a term as prohibiting it.
+          if (/(^|[\s\-])-/.test(query)) return null;
+          let terms = [];
+          for (let word of query.split(/[\s\-]+/)) {
+            // Drop the lunr query syntax for presence, fields and boosts.
+            word = word.replace(/^\+/, "").replace(/^[^:]*:/, "")
+              .replace(/\^\d*$/, "");
+            // The index lowercases only ASCII letters, while lunr lowercases
+            // every letter, so a term with other characters may be in any
+            // shard.
+            if (/[^\x00-\x7f]/.test(word)) return null;
+            word = word.replace(/[A-Z]/g, c => c.toLowerCase());
+            // A fuzzy match may find terms in any shard.
+            if (word.includes("~")) return null;
+            // Split the same way as `splitTokens` in `load_idx()`.
+            for (let term of word.split(/(\s+|_+|(::)+)/)) {
+              if (!term) continue;
+              const star = term.indexOf("*");
+              if (star == 0) return null;
+              if (star > 0) {
+                const prefix = term.slice(0, star);
+                const key = termShard(prefix);
+                // A one byte prefix may be in any shard that starts with it.
+                const one_byte = key.length < 4;
+                terms.push({
+                  matches: t => t.startsWith(prefix),
+                  shards: g_search_index.terms.filter(k => {
+                    return one_byte ? k.startsWith(key) : k == key;
+                  }),
+                });
+              } else {
+                const key = termShard(term);
+                terms.push({
+                  matches: t => t == term,
+                  shards: g_search_index.terms.filter(k => k == key),
+                });
+              }
+            }
+          }
+
+          await Promise.all(terms.flatMap(t => t.shards).map(k => {
+            return loadSearchScript(`terms.${k}.js`);
+          }));
+          let ids = new Set();
+          for (const t of terms) {
+            for (const k of t.shards) {
+              const shard = g_search_terms[k];
+              for (const [term, term_ids] of Object.entries(shard)) {
+                if (t.matches(term)) term_ids.forEach(id => ids.add(id));
+              }
+            }
+          }
+          return ids;
+        }
 
         // Searching via https://lunrjs.com.
         //
-        // Load the JSON search database, which will be turned into a search
-        // index. Returns an object with two fields:
-        // - search_db: the contents of the search.json file.
+        // Load the documents that may match the query, which will be turned
+        // into a search index. Returns an object with two fields:
+        // - search_db: the documents, indexed by their `index` field.
         // - idx: the lunr search index.
         //   Documented at https://lunrjs.com/docs/lunr.Index.html.
-        async function loadSearchIndex() {
-          // This is not widely supported yet (not on Safari), so instead we
-          // turned the json file into a js file that sets a global variable. :|
-          //async function load_search_db() {
-          //  let x = await import('./search.json', {
-          //    with: {type: 'json'}
-          //  });
-          //  return x.default;
-          //}
-
+        async function loadSearchIndex(query) {
           async function load_idx(search_db) {
             let idx = lunr(function () {
               this.ref('index');
@@ -288,10 +372,36 @@ void generate_head(HtmlWriter& html, std::string_view title,
             return out;
           };
 
-          if (!cache_idx) {
-            cache_idx = await load_idx(g_search_db);
+          await loadSearchScript("index.js");
+          // lunrjs treats `:` specially and `::` breaks the query syntax, so
+          // just split into two words, as in `populateSearchResults()`.
+          let ids = await findSearchDocuments(query.split("::").join(" "));
+          if (ids === null) {
+            ids = Array.from({length: g_search_index.num_docs}, (_, i) => i);
           }
-          return cache_idx;
+          const shard_size = g_search_index.shard_size;
+          const shards =
+              new Set(Array.from(ids, id => Math.floor(id / shard_size)));
+          await Promise.all(Array.from(shards, s => {
+            return loadSearchScript(`docs.${s}.js`);
+          }));
+
+          // A sparse array, so that `forEach()` visits only these documents.
+          let search_db = [];
+          for (const id of ids) {
+            const doc =
+                g_search_docs[Math.floor(id / shard_size)][id % shard_size];
+            search_db[id] = {
+              index: id,
+              type: g_search_index.types[doc[0]],
+              url: doc[1],
+              name: doc[2],
+              full_name: doc[3],
+              split_name: doc[4],
+              summary: doc[5],
+            };
+          }
+          return load_idx(search_db);
         }
 
         // If there's a search query, hide the other content and asynchronously
@@ -311,7 +421,9 @@ void generate_head(HtmlWriter& html, std::string_view title,
             let content_ele = document.querySelector(".search-results-content");
             content_ele.innerText = "";
 
-            loadSearchIndex().then(populateSearchResults)
+            loadSearchIndex(query).then(populateSearchResults).catch(err => {
+              header_elem.innerText = `Search error: ${err.message}`;
+            });
           } else {
             showHide(".main-content", true);
 
@@ -34,16 +34,15 @@ namespace subdoc::gen {
 sus::Result<void, MarkdownToHtmlError> generate_macro(
     const Database& db, const MacroElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept {
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
   {
-    i32 index = search_documents.len();
-    auto json = search_documents.open_object();
-    json.add_int("index", index);
-    json.add_string("type", "macro");
-    json.add_string("url", construct_html_url_for_macro(element));
-    json.add_string("name", element.name);
+    auto doc = SearchDocument();
+    doc.type = "macro";
+    doc.url = construct_html_url_for_macro(element);
+    doc.name = element.name;
 
     std::string full_name;
     for (CppPathElement e :
@@ -54,8 +53,7 @@ sus::Result<void, MarkdownToHtmlError> generate_macro(
         full_name += e.name;
       }
     }
-    json.add_string("full_name", full_name);
-    json.add_string("split_name", split_for_search(full_name));
+    doc.full_name = sus::move(full_name);
 
     if (auto comment = element.get_comment(); comment.is_some()) {
       ParseMarkdownPageState page_state(db, options);
@@ -63,11 +61,24 @@ sus::Result<void, MarkdownToHtmlError> generate_macro(
           md_html.is_err()) {
         return sus::err(sus::move(md_html).unwrap_err());
       } else {
-        json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+        doc.summary = sus::move(md_html).unwrap().summary_text;
       }
     }
+    search_index.add(sus::move(doc));
   }
 
+  pages.push(Page{
+      .element = PageElement::with<PageTag::Macro>(element),
+      .namespaces = namespaces.to_vec(),
+      .records = Vec<const RecordElement*>(),
+  });
+  return sus::ok();
+}
+
+sus::Result<void, MarkdownToHtmlError> generate_macro_page(
+    const Database& db, const MacroElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    OutputFiles& files, const Options& options) noexcept {
   ParseMarkdownPageState page_state(db, options);
 
   MarkdownToHtml md_html;
@@ -80,7 +91,7 @@ sus::Result<void, MarkdownToHtmlError> generate_macro(
 
   const std::filesystem::path path =
       construct_html_file_path_for_macro(options.output_root, element);
-  auto html = HtmlWriter(open_file_for_writing(path).unwrap());
+  auto html = HtmlWriter(OutputFile(path, files));
 
   {
     std::ostringstream title;
@@ -223,9 +234,11 @@ sus::Result<void, MarkdownToHtmlError> generate_macro_reference(
           if (!element.hidden()) {
             link_anchor.add_href(construct_html_url_for_macro(element));
           } else {
-            llvm::errs() << "WARNING: Reference to hidden MacroElement "
-                         << element.name << " in namespace "
-                         << element.namespace_path;
+            std::ostringstream warning;
+            warning << "WARNING: Reference to hidden MacroElement "
+                    << element.name << " in namespace "
+                    << element.namespace_path << "\n";
+            print_warning(warning.str());
           }
           link_anchor.add_class("macro-name");
           link_anchor.write_text(element.name);
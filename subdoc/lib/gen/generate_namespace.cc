@@ -15,6 +15,7 @@
 #include "subdoc/lib/gen/generate_namespace.h"
 
 #include <filesystem>
+#include <sstream>
 
 #include "subdoc/lib/gen/files.h"
 #include "subdoc/lib/gen/generate_alias.h"
@@ -28,7 +29,6 @@
 #include "subdoc/lib/gen/generate_search.h"
 #include "subdoc/lib/gen/generate_source_link.h"
 #include "subdoc/lib/gen/html_writer.h"
-#include "subdoc/lib/gen/json_writer.h"
 #include "subdoc/lib/gen/markdown_to_html.h"
 #include "subdoc/lib/gen/search.h"
 #include "sus/assertions/unreachable.h"
@@ -549,7 +549,7 @@ sus::Result<void, MarkdownToHtmlError> generate_variable_references(
 }
 
 sus::Result<void, MarkdownToHtmlError> generate_variable_json(
-    const Database& db, JsonWriter::JsonArray& search_documents,
+    const Database& db, SearchIndex& search_index,
     std::string_view parent_full_name, const FieldElement& element,
     const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
@@ -560,14 +560,11 @@ sus::Result<void, MarkdownToHtmlError> generate_variable_json(
 
   // TODO: If there's no target to link to, should it link to the place where
   // the alias is defined so it shows up in search still?
-  i32 index = search_documents.len();
-  auto json = search_documents.open_object();
-  json.add_int("index", index);
-  json.add_string("type", "variable");
-  json.add_string("url", construct_html_url_for_field(element));
-  json.add_string("name", element.name);
-  json.add_string("full_name", full_name);
-  json.add_string("split_name", split_for_search(full_name));
+  auto doc = SearchDocument();
+  doc.type = "variable";
+  doc.url = construct_html_url_for_field(element);
+  doc.name = element.name;
+  doc.full_name = sus::move(full_name);
 
   if (auto comment = element.get_comment(); comment.is_some()) {
     ParseMarkdownPageState page_state(db, options);
@@ -575,9 +572,10 @@ sus::Result<void, MarkdownToHtmlError> generate_variable_json(
         md_html.is_err()) {
       return sus::err(sus::move(md_html).unwrap_err());
     } else {
-      json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+      doc.summary = sus::move(md_html).unwrap().summary_text;
     }
   }
+  search_index.add(sus::move(doc));
 
   return sus::ok();
 }
@@ -587,7 +585,8 @@ sus::Result<void, MarkdownToHtmlError> generate_variable_json(
 sus::Result<void, MarkdownToHtmlError> generate_namespace(
     const Database& db, const NamespaceElement& element,
     Vec<const NamespaceElement*> ancestors,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept {
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
   {
@@ -603,24 +602,20 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace(
     }
 
     {
-      i32 index = search_documents.len();
-      auto json = search_documents.open_object();
-      json.add_int("index", index);
-      json.add_string("url", construct_html_url_for_namespace(element));
+      auto doc = SearchDocument();
+      doc.url = construct_html_url_for_namespace(element);
       switch (element.namespace_name) {
         case Namespace::Tag::Global: {
-          json.add_string("type", "project");
-          json.add_string("name", options.project_name);
-          json.add_string("full_name", options.project_name);
-          json.add_string("split_name", split_for_search(options.project_name));
+          doc.type = "project";
+          doc.name = options.project_name;
+          doc.full_name = options.project_name;
           break;
         }
         case Namespace::Tag::Anonymous: sus_unreachable();
         case Namespace::Tag::Named: {
-          json.add_string("type", "namespace");
-          json.add_string("name", element.name);
-          json.add_string("full_name", namespace_cpp_path);
-          json.add_string("split_name", split_for_search(namespace_cpp_path));
+          doc.type = "namespace";
+          doc.name = element.name;
+          doc.full_name = namespace_cpp_path;
           break;
         }
       }
@@ -631,12 +626,13 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace(
             md_html.is_err()) {
           return sus::err(sus::move(md_html).unwrap_err());
         } else {
-          json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+          doc.summary = sus::move(md_html).unwrap().summary_text;
         }
       }
+      search_index.add(sus::move(doc));
     }
     for (const auto& [alias_id, sub_element] : element.aliases) {
-      if (auto r = generate_alias_json(db, search_documents, namespace_cpp_path,
+      if (auto r = generate_alias_json(db, search_index, namespace_cpp_path,
                                        sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
@@ -644,13 +640,69 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace(
     }
     for (const auto& [alias_id, sub_element] : element.variables) {
       if (auto r = generate_variable_json(
-              db, search_documents, namespace_cpp_path, sub_element, options);
+              db, search_index, namespace_cpp_path, sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
       }
     }
   }
 
+  pages.push(Page{
+      .element = PageElement::with<PageTag::Namespace>(element),
+      .namespaces = sus::clone(ancestors),
+      .records = Vec<const RecordElement*>(),
+  });
+
+  // Recurse into namespaces, concepts, records and functions.
+  ancestors.push(&element);
+  for (const auto& [u, sub_element] : element.namespaces) {
+    if (sub_element.hidden()) continue;
+    if (auto result = generate_namespace(db, sub_element, sus::clone(ancestors),
+                                         search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+  for (const auto& [u, sub_element] : element.concepts) {
+    if (sub_element.hidden()) continue;
+    if (auto result = generate_concept(db, sub_element, ancestors,
+                                       search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+  for (const auto& [u, sub_element] : element.records) {
+    if (sub_element.hidden()) continue;
+    if (auto result = generate_record(db, sub_element, ancestors, sus::empty,
+                                      search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+  for (const auto& [u, sub_element] : element.functions) {
+    if (sub_element.hidden()) continue;
+    if (auto result = generate_function(db, sub_element, ancestors,
+                                        search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+  for (const auto& [u, sub_element] : element.macros) {
+    if (sub_element.hidden()) continue;
+    if (auto result = generate_macro(db, sub_element, ancestors,
+                                     search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+
+  return sus::ok();
+}
+
+sus::Result<void, MarkdownToHtmlError> generate_namespace_page(
+    const Database& db, const NamespaceElement& element,
+    sus::Slice<const NamespaceElement*> ancestors,
+    OutputFiles& files, const Options& options) noexcept {
   ParseMarkdownPageState page_state(db, options);
 
   MarkdownToHtml md_html;
@@ -663,7 +715,7 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace(
 
   const std::filesystem::path path =
       construct_html_file_path_for_namespace(options.output_root, element);
-  auto html = HtmlWriter(open_file_for_writing(path).unwrap());
+  auto html = HtmlWriter(OutputFile(path, files));
   generate_head(html, namespace_display_name(element, ancestors, options),
                 md_html.summary_text, options);
 
@@ -1077,49 +1129,6 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace(
     }
   }
 
-  // Recurse into namespaces, concepts, records and functions.
-  ancestors.push(&element);
-  for (const auto& [u, sub_element] : element.namespaces) {
-    if (sub_element.hidden()) continue;
-    if (auto result = generate_namespace(db, sub_element, sus::clone(ancestors),
-                                         search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-  for (const auto& [u, sub_element] : element.concepts) {
-    if (sub_element.hidden()) continue;
-    if (auto result = generate_concept(db, sub_element, ancestors,
-                                       search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-  for (const auto& [u, sub_element] : element.records) {
-    if (sub_element.hidden()) continue;
-    if (auto result = generate_record(db, sub_element, ancestors, sus::empty,
-                                      search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-  for (const auto& [u, sub_element] : element.functions) {
-    if (sub_element.hidden()) continue;
-    if (auto result = generate_function(db, sub_element, ancestors,
-                                        search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-  for (const auto& [u, sub_element] : element.macros) {
-    if (sub_element.hidden()) continue;
-    if (auto result = generate_macro(db, sub_element, ancestors,
-                                     search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-
   return sus::ok();
 }
 
@@ -1135,9 +1144,11 @@ sus::Result<void, MarkdownToHtmlError> generate_namespace_reference(
     if (!element.hidden()) {
       name_link.add_href(construct_html_url_for_namespace(element));
     } else {
-      llvm::errs() << "WARNING: Reference to hidden NamespaceElement "
-                   << element.name << " in namespace "
-                   << element.namespace_path;
+      std::ostringstream warning;
+      warning << "WARNING: Reference to hidden NamespaceElement "
+              << element.name << " in namespace " << element.namespace_path
+              << "\n";
+      print_warning(warning.str());
     }
     name_link.write_text(element.name);
   }
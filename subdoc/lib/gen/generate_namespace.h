@@ -15,21 +15,31 @@
 #pragma once
 
 #include "subdoc/lib/database.h"
+#include "subdoc/lib/gen/generate_pages.h"
 #include "subdoc/lib/gen/html_writer.h"
-#include "subdoc/lib/gen/json_writer.h"
 #include "subdoc/lib/gen/markdown_to_html.h"
 #include "subdoc/lib/gen/options.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "subdoc/lib/gen/search.h"
 #include "sus/prelude.h"
 #include "sus/result/result.h"
 
 namespace subdoc::gen {
 
+/// Adds the search documents for `element` and everything in it, and queues
+/// their pages to be written by `generate_pages()`.
 sus::Result<void, MarkdownToHtmlError> generate_namespace(
     const Database& db, const NamespaceElement& element,
     Vec<const NamespaceElement*> ancestors,
-    JsonWriter::JsonArray& search_documents,
+    SearchIndex& search_index, Vec<Page>& pages,
     const Options& options) noexcept;
 
+/// Writes the page for `element`.
+sus::Result<void, MarkdownToHtmlError> generate_namespace_page(
+    const Database& db, const NamespaceElement& element,
+    sus::Slice<const NamespaceElement*> ancestors,
+    OutputFiles& files, const Options& options) noexcept;
+
 sus::Result<void, MarkdownToHtmlError> generate_namespace_reference(
     HtmlWriter::OpenLi& li, const NamespaceElement& element,
     ParseMarkdownPageState& page_state) noexcept;
@@ -0,0 +1,93 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/gen/generate_pages.h"
+
+#include <atomic>
+#include <thread>
+
+#include "subdoc/lib/gen/generate_concept.h"
+#include "subdoc/lib/gen/generate_function.h"
+#include "subdoc/lib/gen/generate_macro.h"
+#include "subdoc/lib/gen/generate_namespace.h"
+#include "subdoc/lib/gen/generate_record.h"
+#include "sus/assertions/unreachable.h"
+
+namespace subdoc::gen {
+
+namespace {
+
+sus::Result<void, MarkdownToHtmlError> generate_page(
+    const Database& db, const Page& page, OutputFiles& files,
+    const Options& options) noexcept {
+  switch (page.element) {
+    case PageTag::Namespace:
+      return generate_namespace_page(db, page.element.as<PageTag::Namespace>(),
+                                     page.namespaces, files, options);
+    case PageTag::Record:
+      return generate_record_page(db, page.element.as<PageTag::Record>(),
+                                  page.namespaces, page.records, files,
+                                  options);
+    case PageTag::Function:
+      return generate_function_page(db, page.element.as<PageTag::Function>(),
+                                    page.namespaces, files, options);
+    case PageTag::Concept:
+      return generate_concept_page(db, page.element.as<PageTag::Concept>(),
+                                   page.namespaces, files, options);
+    case PageTag::Macro:
+      return generate_macro_page(db, page.element.as<PageTag::Macro>(),
+                                 page.namespaces, files, options);
+  }
+  sus_unreachable();
+}
+
+}  // namespace
+
+sus::Result<void, MarkdownToHtmlError> generate_pages(
+    const Database& db, const Vec<Page>& pages, OutputFiles& files,
+    const Options& options) noexcept {
+  usize num_pages = pages.len();
+  usize num_threads = usize::from(options.jobs);
+  if (num_threads < 1u) num_threads = 1u;
+  if (num_threads > num_pages) num_threads = num_pages;
+
+  auto results =
+      Vec<Option<sus::Result<void, MarkdownToHtmlError>>>::with_capacity(
+          num_pages);
+  for (usize i; i < num_pages; i += 1u)
+    results.push(Option<sus::Result<void, MarkdownToHtmlError>>());
+
+  auto next_page = std::atomic<size_t>(0u);
+  auto work = [&]() {
+    while (true) {
+      usize i = next_page.fetch_add(1u, std::memory_order_relaxed);
+      if (i >= num_pages) break;
+      results[i].insert(generate_page(db, pages[i], files, options));
+    }
+  };
+  if (num_threads == 1u) {
+    work();
+  } else {
+    auto threads = Vec<std::thread>::with_capacity(num_threads);
+    for (usize i; i < num_threads; i += 1u) threads.push(std::thread(work));
+    for (std::thread& t : threads.iter_mut()) t.join();
+  }
+
+  for (Option<sus::Result<void, MarkdownToHtmlError>>& r : results.iter_mut()) {
+    if (r.as_value().is_err()) return sus::move(r).unwrap();
+  }
+  return sus::ok();
+}
+
+}  // namespace subdoc::gen
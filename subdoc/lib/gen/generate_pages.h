@@ -0,0 +1,64 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "subdoc/lib/database.h"
+#include "subdoc/lib/gen/markdown_to_html.h"
+#include "subdoc/lib/gen/options.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "sus/choice/choice.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+
+namespace subdoc::gen {
+
+enum class PageTag {
+  Namespace,
+  Record,
+  Function,
+  Concept,
+  Macro,
+};
+/// The element that a page is written for.
+using PageElement = sus::Choice<sus_choice_types(
+    (PageTag::Namespace, const NamespaceElement&),
+    (PageTag::Record, const RecordElement&),
+    (PageTag::Function, const FunctionElement&),
+    (PageTag::Concept, const ConceptElement&),
+    (PageTag::Macro, const MacroElement&))>;
+
+/// A page to be written by `generate_pages()`, which is found while writing
+/// the search index.
+struct Page {
+  PageElement element;
+  /// The namespaces that the element is in. These are copied, as the ones used
+  /// while walking the `Database` are gone before the page is written.
+  Vec<const NamespaceElement*> namespaces;
+  /// The records that the element is in, for a nested record.
+  Vec<const RecordElement*> records;
+};
+
+/// Writes each of `pages` on `Options::jobs` threads, recording them in
+/// `files`.
+///
+/// The pages only read from `db`, so they can be written in any order and the
+/// output is the same. If more than one page fails, the error from the first
+/// of them in `pages` is returned.
+sus::Result<void, MarkdownToHtmlError> generate_pages(
+    const Database& db, const Vec<Page>& pages, OutputFiles& files,
+    const Options& options) noexcept;
+
+}  // namespace subdoc::gen
@@ -306,22 +306,19 @@ sus::Result<void, MarkdownToHtmlError> generate_record_methods(
 }
 
 sus::Result<void, MarkdownToHtmlError> generate_field_json(
-    const Database& db, JsonWriter::JsonArray& search_documents,
+    const Database& db, SearchIndex& search_index,
     std::string_view parent_full_name, const FieldElement& element,
     const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
-  i32 index = search_documents.len();
-  auto json = search_documents.open_object();
-  json.add_int("index", index);
-  json.add_string("type", "field");
-  json.add_string("url", construct_html_url_for_field(element));
-  json.add_string("name", element.name);
+  auto doc = SearchDocument();
+  doc.type = "field";
+  doc.url = construct_html_url_for_field(element);
+  doc.name = element.name;
   auto full_name = std::string(parent_full_name);
   if (full_name.size() > 0u) full_name += std::string("::");
   full_name += element.name;
-  json.add_string("full_name", full_name);
-  json.add_string("split_name", split_for_search(full_name));
+  doc.full_name = sus::move(full_name);
 
   if (auto comment = element.get_comment(); comment.is_some()) {
     ParseMarkdownPageState page_state(db, options);
@@ -329,30 +326,28 @@ sus::Result<void, MarkdownToHtmlError> generate_field_json(
         md_html.is_err()) {
       return sus::err(sus::move(md_html).unwrap_err());
     } else {
-      json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+      doc.summary = sus::move(md_html).unwrap().summary_text;
     }
   }
+  search_index.add(sus::move(doc));
 
   return sus::ok();
 }
 
 sus::Result<void, MarkdownToHtmlError> generate_method_json(
-    const Database& db, JsonWriter::JsonArray& search_documents,
+    const Database& db, SearchIndex& search_index,
     std::string_view parent_full_name, std::string_view type,
     const FunctionElement& element, const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
-  i32 index = search_documents.len();
-  auto json = search_documents.open_object();
-  json.add_int("index", index);
-  json.add_string("type", type);
-  json.add_string("url", construct_html_url_for_function(element));
-  json.add_string("name", element.name);
+  auto doc = SearchDocument();
+  doc.type = type;
+  doc.url = construct_html_url_for_function(element);
+  doc.name = element.name;
   auto full_name = std::string(parent_full_name);
   if (full_name.size() > 0u) full_name += std::string("::");
   full_name += element.name;
-  json.add_string("full_name", full_name);
-  json.add_string("split_name", split_for_search(full_name));
+  doc.full_name = sus::move(full_name);
 
   if (auto comment = element.get_comment(); comment.is_some()) {
     ParseMarkdownPageState page_state(db, options);
@@ -360,9 +355,10 @@ sus::Result<void, MarkdownToHtmlError> generate_method_json(
         md_html.is_err()) {
       return sus::err(sus::move(md_html).unwrap_err());
     } else {
-      json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+      doc.summary = sus::move(md_html).unwrap().summary_text;
     }
   }
+  search_index.add(sus::move(doc));
 
   return sus::ok();
 }
@@ -373,7 +369,8 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
     const Database& db, const RecordElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
     Vec<const RecordElement*> type_ancestors,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept {
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept {
   if (element.hidden()) return sus::ok();
 
   {
@@ -388,15 +385,11 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
     }
 
     {
-      i32 index = search_documents.len();
-      auto json = search_documents.open_object();
-      json.add_int("index", index);
-      json.add_string("type",
-                      friendly_record_type_name(element.record_type, false));
-      json.add_string("url", construct_html_url_for_type(element));
-      json.add_string("name", element.name);
-      json.add_string("full_name", type_cpp_path);
-      json.add_string("split_name", split_for_search(type_cpp_path));
+      auto doc = SearchDocument();
+      doc.type = friendly_record_type_name(element.record_type, false);
+      doc.url = construct_html_url_for_type(element);
+      doc.name = element.name;
+      doc.full_name = type_cpp_path;
 
       if (auto comment = element.get_comment(); comment.is_some()) {
         ParseMarkdownPageState page_state(db, options);
@@ -404,40 +397,41 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
             md_html.is_err()) {
           return sus::err(sus::move(md_html).unwrap_err());
         } else {
-          json.add_string("summary", sus::move(md_html).unwrap().summary_text);
+          doc.summary = sus::move(md_html).unwrap().summary_text;
         }
       }
+      search_index.add(sus::move(doc));
     }
     for (const auto& [id, sub_element] : element.fields) {
-      if (auto r = generate_field_json(db, search_documents, type_cpp_path,
+      if (auto r = generate_field_json(db, search_index, type_cpp_path,
                                        sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
       }
     }
     for (const auto& [id, sub_element] : element.ctors) {
-      if (auto r = generate_method_json(db, search_documents, type_cpp_path,
+      if (auto r = generate_method_json(db, search_index, type_cpp_path,
                                         "constructor", sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
       }
     }
     for (const auto& [id, sub_element] : element.conversions) {
-      if (auto r = generate_method_json(db, search_documents, type_cpp_path,
+      if (auto r = generate_method_json(db, search_index, type_cpp_path,
                                         "conversion", sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
       }
     }
     for (const auto& [id, sub_element] : element.methods) {
-      if (auto r = generate_method_json(db, search_documents, type_cpp_path,
+      if (auto r = generate_method_json(db, search_index, type_cpp_path,
                                         "method", sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
       }
     }
     for (const auto& [id, sub_element] : element.aliases) {
-      if (auto r = generate_alias_json(db, search_documents, type_cpp_path,
+      if (auto r = generate_alias_json(db, search_index, type_cpp_path,
                                        sub_element, options);
           r.is_err()) {
         return sus::err(sus::into(sus::move(r).unwrap_err()));
@@ -445,6 +439,30 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
     }
   }
 
+  pages.push(Page{
+      .element = PageElement::with<PageTag::Record>(element),
+      .namespaces = namespaces.to_vec(),
+      .records = sus::clone(type_ancestors),
+  });
+
+  type_ancestors.push(&element);
+  for (const auto& [key, subrecord] : element.records) {
+    if (auto result = generate_record(db, subrecord, namespaces,
+                                      sus::clone(type_ancestors),
+                                      search_index, pages, options);
+        result.is_err()) {
+      return sus::err(sus::move(result).unwrap_err());
+    }
+  }
+
+  return sus::ok();
+}
+
+sus::Result<void, MarkdownToHtmlError> generate_record_page(
+    const Database& db, const RecordElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    sus::Slice<const RecordElement*> type_ancestors,
+    OutputFiles& files, const Options& options) noexcept {
   ParseMarkdownPageState page_state(db, options);
 
   MarkdownToHtml md_html;
@@ -458,7 +476,7 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
   const std::filesystem::path path = construct_html_file_path(
       options.output_root, element.namespace_path.as_slice(),
       element.record_path.as_slice(), element.name);
-  auto html = HtmlWriter(open_file_for_writing(path).unwrap());
+  auto html = HtmlWriter(OutputFile(path, files));
 
   {
     std::ostringstream title;
@@ -671,16 +689,6 @@ sus::Result<void, MarkdownToHtmlError> generate_record(
     }
   }
 
-  type_ancestors.push(&element);
-  for (const auto& [key, subrecord] : element.records) {
-    if (auto result = generate_record(db, subrecord, namespaces,
-                                      sus::clone(type_ancestors),
-                                      search_documents, options);
-        result.is_err()) {
-      return sus::err(sus::move(result).unwrap_err());
-    }
-  }
-
   return sus::ok();
 }
 
@@ -703,9 +711,11 @@ sus::Result<void, MarkdownToHtmlError> generate_record_reference(
       if (!element.hidden()) {
         name_link.add_href(construct_html_url_for_type(element));
       } else {
-        llvm::errs() << "WARNING: Reference to hidden RecordElement "
-                     << element.name << " in namespace "
-                     << element.namespace_path;
+        std::ostringstream warning;
+        warning << "WARNING: Reference to hidden RecordElement "
+                << element.name << " in namespace " << element.namespace_path
+                << "\n";
+        print_warning(warning.str());
       }
       name_link.write_text(element.name);
     }
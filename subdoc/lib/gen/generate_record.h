@@ -15,20 +15,32 @@
 #pragma once
 
 #include "subdoc/lib/database.h"
+#include "subdoc/lib/gen/generate_pages.h"
 #include "subdoc/lib/gen/html_writer.h"
-#include "subdoc/lib/gen/json_writer.h"
 #include "subdoc/lib/gen/markdown_to_html.h"
 #include "subdoc/lib/gen/options.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "subdoc/lib/gen/search.h"
 #include "sus/prelude.h"
 #include "sus/result/result.h"
 
 namespace subdoc::gen {
 
+/// Adds the search documents for `element` and the records nested in it, and
+/// queues their pages to be written by `generate_pages()`.
 sus::Result<void, MarkdownToHtmlError> generate_record(
     const Database& db, const RecordElement& element,
     sus::Slice<const NamespaceElement*> namespaces,
     Vec<const RecordElement*> type_ancestors,
-    JsonWriter::JsonArray& search_documents, const Options& options) noexcept;
+    SearchIndex& search_index, Vec<Page>& pages,
+    const Options& options) noexcept;
+
+/// Writes the page for `element`.
+sus::Result<void, MarkdownToHtmlError> generate_record_page(
+    const Database& db, const RecordElement& element,
+    sus::Slice<const NamespaceElement*> namespaces,
+    sus::Slice<const RecordElement*> type_ancestors,
+    OutputFiles& files, const Options& options) noexcept;
 
 sus::Result<void, MarkdownToHtmlError> generate_record_reference(
     HtmlWriter::OpenUl& items_list, const RecordElement& element,
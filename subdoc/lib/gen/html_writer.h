@@ -14,8 +14,7 @@
 
 #pragma once
 
-#include <fstream>
-
+#include "subdoc/lib/gen/output_file.h"
 #include "sus/iter/empty.h"
 #include "sus/prelude.h"
 
@@ -835,7 +834,7 @@ class HtmlWriter {
     }
   };
 
-  explicit HtmlWriter(std::ofstream stream) noexcept
+  explicit HtmlWriter(OutputFile stream) noexcept
       : stream_(sus::move(stream)) {
     stream_ << "<!DOCTYPE html>\n";
     write_open("html", sus::iter::empty<const std::string&>(),
@@ -1003,7 +1002,7 @@ class HtmlWriter {
   }
 
   u32 indent_ = 0_u32;
-  std::ofstream stream_;
+  OutputFile stream_;
 };
 
 }  // namespace subdoc::gen
@@ -67,8 +67,8 @@ std::string summarize_html(std::string_view html) noexcept {
       }
     }
   }
-  llvm::errs() << "WARNING: Html summary could not find non-empty tag pair.\n";
-  llvm::errs() << html << "\n";
+  print_warning(fmt::format(
+      "WARNING: Html summary could not find non-empty tag pair.\n{}\n", html));
   return std::string(html);
 }
 
@@ -63,6 +63,8 @@ struct Options {
   Vec<FavIcon> favicons;
   Vec<std::string> copy_files;
   bool ignore_bad_code_links = false;
+  /// How many pages to write at once. The output is the same for any number.
+  u32 jobs = 1u;
 };
 static_assert(sus::mem::Move<Options>);
 
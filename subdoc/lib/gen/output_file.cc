@@ -0,0 +1,69 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/gen/output_file.h"
+
+#include "subdoc/lib/gen/files.h"
+#include "subdoc/llvm.h"
+
+namespace subdoc::gen {
+
+void OutputFiles::record(const std::filesystem::path& path,
+                         bool written) noexcept {
+  auto lock = std::scoped_lock(mutex_);
+  paths_.insert(path.lexically_normal().string());
+  if (written)
+    written_ += 1u;
+  else
+    unchanged_ += 1u;
+}
+
+bool OutputFiles::contains(const std::filesystem::path& path) const noexcept {
+  auto lock = std::scoped_lock(mutex_);
+  return paths_.contains(path.lexically_normal().string());
+}
+
+usize OutputFiles::written() const noexcept {
+  auto lock = std::scoped_lock(mutex_);
+  return written_;
+}
+
+usize OutputFiles::unchanged() const noexcept {
+  auto lock = std::scoped_lock(mutex_);
+  return unchanged_;
+}
+
+void OutputFile::close() noexcept {
+  if (closed_) return;
+  closed_ = true;
+
+  std::string contents = sus::move(*this).str();
+  // Only read back an existing file if its size matches, which is enough to
+  // find nearly every changed file without reading it.
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path_, ec);
+  if (!ec && size == contents.size()) {
+    auto buffer = llvm::MemoryBuffer::getFile(path_.string());
+    if (buffer && (*buffer)->getBuffer() == contents) {
+      files_->record(path_, false);
+      return;
+    }
+  }
+
+  std::ofstream file = open_file_for_writing(path_).unwrap();
+  file.write(contents.data(), std::streamsize(contents.size()));
+  files_->record(path_, true);
+}
+
+}  // namespace subdoc::gen
@@ -0,0 +1,75 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "sus/prelude.h"
+
+namespace subdoc::gen {
+
+/// The files produced by `generate()`, which may be recorded from the threads
+/// that write pages. Any other files found in the output directory afterward
+/// are stale.
+class OutputFiles {
+ public:
+  /// Records that `path` was produced, and whether it had to be written or the
+  /// file on disk already had the same contents.
+  void record(const std::filesystem::path& path, bool written) noexcept;
+  /// Whether `path` was produced by `generate()`.
+  bool contains(const std::filesystem::path& path) const noexcept;
+
+  usize written() const noexcept;
+  usize unchanged() const noexcept;
+
+ private:
+  mutable std::mutex mutex_;
+  std::set<std::string> paths_;
+  usize written_;
+  usize unchanged_;
+};
+
+/// A file whose contents are built in memory. When it is closed, the file is
+/// only written if it does not already exist on disk with the same contents,
+/// so that the unchanged files of a previous run are left untouched.
+class OutputFile : public std::ostringstream {
+ public:
+  explicit OutputFile(std::filesystem::path path, OutputFiles& files) noexcept
+      : path_(sus::move(path)), files_(&files) {}
+  OutputFile(OutputFile&& o) noexcept
+      : std::ostringstream(sus::move(o)),
+        path_(sus::move(o.path_)),
+        files_(o.files_),
+        closed_(o.closed_) {
+    o.closed_ = true;
+  }
+  OutputFile& operator=(OutputFile&&) = delete;
+  ~OutputFile() noexcept { close(); }
+
+  /// Compares the contents with the file on disk and writes them if they
+  /// differ. Does nothing if the file was already closed.
+  void close() noexcept;
+
+ private:
+  std::filesystem::path path_;
+  OutputFiles* files_;
+  bool closed_ = false;
+};
+
+}  // namespace subdoc::gen
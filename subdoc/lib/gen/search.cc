@@ -14,48 +14,188 @@
 
 #include "subdoc/lib/gen/search.h"
 
-#include <sstream>
-
+#include "fmt/format.h"
 #include "sus/prelude.h"
 
 namespace subdoc::gen {
 
-std::string split_for_search(std::string_view s) noexcept {
-  if (s.size() == 0u) return std::string();
+namespace {
 
-  bool is_camel_case = false;
-  for (usize i; i < s.size() - 1u; i += 1u) {
-    if (s[i] >= 'a' && s[i] <= 'z' && s[i + 1u] >= 'A' && s[i + 1u] <= 'Z') {
-      is_camel_case = true;
+constexpr usize kDocsPerShard = 500u;
+
+/// Calls `f` with each token of `s` as it would be indexed by lunr.js, which
+/// splits at whitespace and `-`.
+template <class F>
+void for_each_index_token(std::string_view s, F f) noexcept {
+  auto is_separator = [](char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '-';
+  };
+  usize start;
+  while (start < s.size()) {
+    if (is_separator(s[start])) {
+      start += 1u;
+      continue;
     }
+    usize end = start + 1u;
+    while (end < s.size() && !is_separator(s[end])) end += 1u;
+    f(s.substr(start, end - start));
+    start = end;
   }
+}
+
+/// The shard of the index that holds `term`, which is its first two bytes in
+/// hex so that it can be used in a file name.
+std::string term_shard(std::string_view term) noexcept {
+  std::string key;
+  for (char c : term.substr(0u, 2u))
+    key += fmt::format("{:02x}", static_cast<unsigned char>(c));
+  return key;
+}
+
+/// Writes `s` as a JavaScript string literal.
+void write_string(OutputFile& out, std::string_view s) noexcept {
+  out << '"';
+  for (char c : s) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20u)
+          out << fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+        else
+          out << c;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+std::string split_for_search(std::string_view s) noexcept {
+  std::string split;
+  split.reserve(s.size() + s.size() / 2u);
+  for_each_search_word(s, [&](std::string_view word) {
+    if (!split.empty()) split += ' ';
+    split += word;
+  });
+  return split;
+}
+
+void SearchIndex::add(SearchDocument doc) noexcept {
+  const u32 id = u32::try_from(docs_.len()).unwrap();
 
-  std::stringstream split_string;
-  const char* query = ":_";
-  if (is_camel_case) {
-    query = ":_ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  Option<usize> type = types_.iter().position(
+      [&](const std::string& t) { return t == doc.type; });
+  if (type.is_none()) {
+    type = sus::some(types_.len());
+    types_.push(sus::move(doc.type));
   }
-  auto last = 0_usize, start = 0_usize;
-  while (true) {
-    auto found = s.find_first_of(query, start);
-    if (found == std::string::npos) {
-      split_string << std::string_view(s).substr(last);
-      break;
+
+  std::string split_name = split_for_search(doc.full_name);
+  auto d = Document{
+      .type = u32::try_from(sus::move(type).unwrap()).unwrap(),
+      .url = sus::move(doc.url),
+      .name = sus::move(doc.name),
+      .full_name = sus::move(doc.full_name),
+      .split_name = sus::move(split_name),
+      .summary = sus::move(doc.summary),
+  };
+
+  // The terms are matched exactly, as lunr.js is given a query of whole
+  // words, so each token that lunr.js will index the document by is recorded.
+  // Only ASCII letters are lowercased, which the search script does the same
+  // way, and it searches every document for a query term with any other
+  // characters, since lunr.js lowercases those too.
+  std::string term;
+  auto add_term = [&](std::string_view token) {
+    term.assign(token);
+    for (char& c : term) {
+      if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
     }
-    auto append = std::string_view(s).substr(last, found - last);
-    if (append.size() > 0u) split_string << append << std::string_view(" ");
-
-    auto view = std::string_view(s).substr(found);
-    if (view.starts_with(":") || view.starts_with("_")) {
-      last = found + 1u;
-      start = found + 1u;
-    } else {
-      last = found;
-      start = found + 1;
+    auto it = terms_.find(term);
+    if (it == terms_.end()) it = terms_.emplace(term, Vec<u32>()).first;
+    Vec<u32>& ids = it->second;
+    if (ids.is_empty() || ids[ids.len() - 1u] != id) ids.push(id);
+  };
+  for_each_index_token(d.name, add_term);
+  for_each_index_token(d.full_name, add_term);
+  for_each_index_token(d.split_name, add_term);
+
+  docs_.push(sus::move(d));
+}
+
+void SearchIndex::write(const std::filesystem::path& root,
+                        OutputFiles& files) const noexcept {
+  std::filesystem::path dir = root;
+  dir.append("search");
+
+  // Each document is an array of its type, url, name, full_name, split_name
+  // and summary.
+  for (usize shard; shard * kDocsPerShard < docs_.len(); shard += 1u) {
+    auto out = OutputFile(dir / fmt::format("docs.{}.js", shard), files);
+    out << "g_search_docs[" << shard << "]=[\n";
+    usize end = (shard + 1u) * kDocsPerShard;
+    if (end > docs_.len()) end = docs_.len();
+    for (usize i = shard * kDocsPerShard; i < end; i += 1u) {
+      const Document& d = docs_[i];
+      out << "[" << d.type << ",";
+      write_string(out, d.url);
+      out << ",";
+      write_string(out, d.name);
+      out << ",";
+      write_string(out, d.full_name);
+      out << ",";
+      write_string(out, d.split_name);
+      out << ",";
+      write_string(out, d.summary);
+      out << (i + 1u < end ? "],\n" : "]\n");
+    }
+    out << "];\n";
+  }
+
+  // The terms are sorted, so the ones that share a shard are next to each
+  // other.
+  auto term_shards = Vec<std::string>();
+  auto it = terms_.begin();
+  while (it != terms_.end()) {
+    std::string key = term_shard(it->first);
+    std::string_view prefix = std::string_view(it->first).substr(0u, 2u);
+    auto out = OutputFile(dir / fmt::format("terms.{}.js", key), files);
+    out << "g_search_terms[\"" << key << "\"]={\n";
+    bool first = true;
+    for (; it != terms_.end() &&
+           std::string_view(it->first).substr(0u, 2u) == prefix;
+         ++it) {
+      if (!first) out << ",\n";
+      first = false;
+      write_string(out, it->first);
+      out << ":[";
+      for (usize i; i < it->second.len(); i += 1u) {
+        if (i > 0u) out << ",";
+        out << it->second[i];
+      }
+      out << "]";
     }
+    out << "\n};\n";
+    term_shards.push(sus::move(key));
   }
 
-  return sus::move(split_string).str();
+  auto out = OutputFile(dir / "index.js", files);
+  out << "g_search_index={\"shard_size\":" << kDocsPerShard
+      << ",\"num_docs\":" << docs_.len() << ",\"types\":[";
+  for (usize i; i < types_.len(); i += 1u) {
+    if (i > 0u) out << ",";
+    write_string(out, types_[i]);
+  }
+  out << "],\"terms\":[";
+  for (usize i; i < term_shards.len(); i += 1u) {
+    if (i > 0u) out << ",";
+    write_string(out, term_shards[i]);
+  }
+  out << "]};\n";
 }
 
 }  // namespace subdoc::gen
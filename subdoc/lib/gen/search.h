@@ -14,11 +14,100 @@
 
 #pragma once
 
+#include <filesystem>
+#include <map>
 #include <string>
 #include <string_view>
 
+#include "subdoc/lib/gen/output_file.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+
 namespace subdoc::gen {
 
-std::string split_for_search(std::string_view s) noexcept;
+/// Calls `f` with each word of `s`, as a `std::string_view` into `s`. Words are
+/// split at `:` and `_`, and before each capital letter if `s` is camelCase.
+template <class F>
+void for_each_search_word(std::string_view s, F f) noexcept {
+  bool is_camel_case = false;
+  for (usize i = 1u; i < s.size(); i += 1u) {
+    if (s[i - 1u] >= 'a' && s[i - 1u] <= 'z' && s[i] >= 'A' && s[i] <= 'Z') {
+      is_camel_case = true;
+      break;
+    }
+  }
+
+  const char* query = ":_";
+  if (is_camel_case) {
+    query = ":_ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  }
+  auto last = 0_usize, start = 0_usize;
+  while (true) {
+    auto found = s.find_first_of(query, start);
+    if (found == std::string_view::npos) {
+      if (last < s.size()) f(s.substr(last));
+      break;
+    }
+    if (found > last) f(s.substr(last, found - last));
 
+    if (s[found] == ':' || s[found] == '_') {
+      last = found + 1u;
+    } else {
+      last = found;
+    }
+    start = found + 1u;
+  }
 }
+
+/// Returns the words of `s`, as found by `for_each_search_word()`, separated by
+/// spaces.
+std::string split_for_search(std::string_view s) noexcept;
+
+/// An item that can be found by searching.
+struct SearchDocument {
+  std::string type;
+  std::string url;
+  std::string name;
+  std::string full_name;
+  std::string summary;
+};
+
+/// The search index, which is written in shards that the search script loads
+/// as they are needed.
+///
+/// The documents are split by their id into shards of a fixed size. The index
+/// maps each term to the ids of the documents that contain it, and is split
+/// into shards by the first two bytes of the term. A search loads the shards of
+/// the terms in the query, and then the shards of the documents they list.
+///
+/// The terms are the tokens that lunr.js indexes each document by, with ASCII
+/// letters lowercased. Other characters are left as they are, so the search
+/// script looks up only query terms that are all ASCII in the index.
+class SearchIndex {
+ public:
+  /// Adds `doc` to the index, giving it the next id.
+  void add(SearchDocument doc) noexcept;
+
+  usize len() const noexcept { return docs_.len(); }
+
+  /// Writes the shards into a `search` directory in `root`.
+  void write(const std::filesystem::path& root,
+             OutputFiles& files) const noexcept;
+
+ private:
+  struct Document {
+    u32 type;
+    std::string url;
+    std::string name;
+    std::string full_name;
+    std::string split_name;
+    std::string summary;
+  };
+
+  Vec<std::string> types_;
+  Vec<Document> docs_;
+  /// The ids of the documents containing each term, in increasing order.
+  std::map<std::string, Vec<u32>> terms_;
+};
+
+}  // namespace subdoc::gen
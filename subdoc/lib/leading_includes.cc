@@ -0,0 +1,63 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/leading_includes.h"
+
+namespace subdoc {
+
+namespace {
+
+std::string_view trim(std::string_view s) noexcept {
+  constexpr std::string_view kWhitespace = " \t\r\f\v";
+  size_t start = s.find_first_not_of(kWhitespace);
+  if (start == std::string_view::npos) return std::string_view();
+  size_t end = s.find_last_not_of(kWhitespace);
+  return s.substr(start, end + 1u - start);
+}
+
+}  // namespace
+
+Vec<std::string> leading_includes(std::string_view source) noexcept {
+  auto includes = Vec<std::string>();
+  bool in_block_comment = false;
+  while (!source.empty()) {
+    size_t newline = source.find('\n');
+    std::string_view line = source.substr(0u, newline);
+    source = newline == std::string_view::npos ? std::string_view()
+                                               : source.substr(newline + 1u);
+    line = trim(line);
+
+    // Drop any block comments before the code on the line. A block comment
+    // that does not end on the line continues on the following ones.
+    while (in_block_comment || line.starts_with("/*")) {
+      size_t start = in_block_comment ? 0u : 2u;
+      size_t end = line.find("*/", start);
+      if (end == std::string_view::npos) {
+        in_block_comment = true;
+        line = std::string_view();
+        break;
+      }
+      in_block_comment = false;
+      line = trim(line.substr(end + 2u));
+    }
+
+    if (line.empty() || line.starts_with("//")) continue;
+    if (line == "#pragma once") continue;
+    if (!line.starts_with("#include")) break;
+    includes.push(std::string(line));
+  }
+  return includes;
+}
+
+}  // namespace subdoc
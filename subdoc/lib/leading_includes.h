@@ -0,0 +1,30 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+
+namespace subdoc {
+
+/// Returns the `#include` lines at the top of a source file, before any other
+/// code or preprocessor directive. Blank lines, comments and `#pragma once`
+/// are skipped over.
+Vec<std::string> leading_includes(std::string_view source) noexcept;
+
+}  // namespace subdoc
@@ -25,69 +25,99 @@ LinkedType LinkedType::with_type(Type t, const Database& db) noexcept {
   return LinkedType(CONSTRUCT, sus::move(t), sus::move(refs));
 }
 
+LinkedType LinkedType::unlinked(Type t) noexcept {
+  return LinkedType(CONSTRUCT, sus::move(t), Vec<Option<TypeRef>>());
+}
+
+void LinkedType::relink(const Database& db) noexcept {
+  type_element_refs = db.collect_type_element_refs(type);
+}
+
 LinkedConcept LinkedConcept::with_concept(sus::Slice<Namespace> namespace_path,
                                           std::string name,
                                           const Database& db) noexcept {
+  auto linked = LinkedConcept{
+      .ref_or_name =
+          ConceptRefOrName::with<ConceptRefOrName::Tag::Name>(std::string()),
+      .namespace_path = namespace_path.to_vec(),
+      .name = sus::move(name),
+  };
+  linked.relink(db);
+  return linked;
+}
+
+void LinkedConcept::relink(const Database& db) noexcept {
   Option<FoundName> found =
       db.find_name_in_namespace_path(namespace_path, name);
   if (found.is_some() && *found == FoundName::Tag::Concept) {
-    return LinkedConcept{
-        ConceptRefOrName::with<ConceptRefOrName::Tag::Ref>(
-            found->as<FoundName::Tag::Concept>()),
-    };
+    ref_or_name = ConceptRefOrName::with<ConceptRefOrName::Tag::Ref>(
+        found->as<FoundName::Tag::Concept>());
   } else {
     std::ostringstream s;
     s << namespace_path_to_string(namespace_path.iter());
-    s << sus::move(name);
-    return LinkedConcept{
-        ConceptRefOrName::with<ConceptRefOrName::Tag::Name>(sus::move(s).str()),
-    };
+    s << name;
+    ref_or_name =
+        ConceptRefOrName::with<ConceptRefOrName::Tag::Name>(sus::move(s).str());
   }
 }
 
 LinkedFunction LinkedFunction::with_function(
     sus::Slice<Namespace> namespace_path, std::string name,
     const Database& db) noexcept {
+  auto linked = LinkedFunction{
+      .ref_or_name =
+          FunctionRefOrName::with<FunctionRefOrName::Tag::Name>(std::string()),
+      .namespace_path = namespace_path.to_vec(),
+      .name = sus::move(name),
+  };
+  linked.relink(db);
+  return linked;
+}
+
+void LinkedFunction::relink(const Database& db) noexcept {
   // TODO: The alias has to pick an overload set to link to, which one? Should
   // all function overload sets be on one html page?
   Option<FoundName> found =
       db.find_name_in_namespace_path(namespace_path, name);
   if (found.is_some() && *found == FoundName::Tag::Function) {
-    return LinkedFunction{
-        FunctionRefOrName::with<FunctionRefOrName::Tag::Ref>(
-            found->as<FoundName::Tag::Function>()),
-    };
+    ref_or_name = FunctionRefOrName::with<FunctionRefOrName::Tag::Ref>(
+        found->as<FoundName::Tag::Function>());
   } else {
     std::ostringstream s;
     s << namespace_path_to_string(namespace_path.iter());
-    s << sus::move(name);
-    return LinkedFunction{
-        FunctionRefOrName::with<FunctionRefOrName::Tag::Name>(
-            sus::move(s).str()),
-    };
+    s << name;
+    ref_or_name = FunctionRefOrName::with<FunctionRefOrName::Tag::Name>(
+        sus::move(s).str());
   }
 }
 
 LinkedVariable LinkedVariable::with_variable(
     sus::Slice<Namespace> namespace_path, std::string name,
     const Database& db) noexcept {
+  auto linked = LinkedVariable{
+      .ref_or_name =
+          VariableRefOrName::with<VariableRefOrName::Tag::Name>(std::string()),
+      .namespace_path = namespace_path.to_vec(),
+      .name = sus::move(name),
+  };
+  linked.relink(db);
+  return linked;
+}
+
+void LinkedVariable::relink(const Database& db) noexcept {
   // TODO: The alias has to pick an overload set to link to, which one? Should
   // all function overload sets be on one html page?
   Option<FoundName> found =
       db.find_name_in_namespace_path(namespace_path, name);
   if (found.is_some() && *found == FoundName::Tag::Field) {
-    return LinkedVariable{
-        VariableRefOrName::with<VariableRefOrName::Tag::Ref>(
-            found->as<FoundName::Tag::Field>()),
-    };
+    ref_or_name = VariableRefOrName::with<VariableRefOrName::Tag::Ref>(
+        found->as<FoundName::Tag::Field>());
   } else {
     std::ostringstream s;
     s << namespace_path_to_string(namespace_path.iter());
-    s << sus::move(name);
-    return LinkedVariable{
-        VariableRefOrName::with<VariableRefOrName::Tag::Name>(
-            sus::move(s).str()),
-    };
+    s << name;
+    ref_or_name = VariableRefOrName::with<VariableRefOrName::Tag::Name>(
+        sus::move(s).str());
   }
 }
 
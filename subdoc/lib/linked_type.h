@@ -41,6 +41,13 @@ using TypeRef =
 /// database when they exist there and are not marked hidden.
 struct LinkedType {
   static LinkedType with_type(Type t, const Database& db) noexcept;
+  /// Makes a LinkedType without any references into a `Database`, which can be
+  /// found later with `relink()`.
+  static LinkedType unlinked(Type t) noexcept;
+
+  /// Finds the references into `db` again, such as after the elements they
+  /// refer to were merged from another `Database`.
+  void relink(const Database& db) noexcept;
 
   Type type;
   /// References into the database for every type that makes up `type`.
@@ -66,7 +73,13 @@ struct LinkedConcept {
       sus::Slice<Namespace> namespace_path, std::string name,
       const Database& db) noexcept;
 
+  /// Finds the reference into `db` again.
+  void relink(const Database& db) noexcept;
+
   ConceptRefOrName ref_or_name;
+  /// The namespace path and name used to find the concept in the `Database`.
+  Vec<Namespace> namespace_path;
+  std::string name;
 };
 
 enum class FunctionRefOrNameTag {
@@ -83,7 +96,13 @@ struct LinkedFunction {
       sus::Slice<Namespace> namespace_path, std::string name,
       const Database& db) noexcept;
 
+  /// Finds the reference into `db` again.
+  void relink(const Database& db) noexcept;
+
   FunctionRefOrName ref_or_name;
+  /// The namespace path and name used to find the function in the `Database`.
+  Vec<Namespace> namespace_path;
+  std::string name;
 };
 
 enum class VariableRefOrNameTag {
@@ -100,7 +119,13 @@ struct LinkedVariable {
       sus::Slice<Namespace> namespace_path, std::string name,
       const Database& db) noexcept;
 
+  /// Finds the reference into `db` again.
+  void relink(const Database& db) noexcept;
+
   VariableRefOrName ref_or_name;
+  /// The namespace path and name used to find the variable in the `Database`.
+  Vec<Namespace> namespace_path;
+  std::string name;
 };
 
 }  // namespace subdoc
@@ -0,0 +1,245 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/merge.h"
+
+#include <compare>
+#include <sstream>
+#include <utility>
+
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+#include "sus/mem/swap.h"
+
+namespace subdoc {
+
+namespace {
+
+using MergeResult = sus::Result<void, std::string>;
+
+/// Combines the comment and source link of an element that was found in two
+/// translation units, the same way as the `add_*_to_db()` methods of the
+/// `Visitor`.
+MergeResult merge_comment(CommentElement& into,
+                          CommentElement& from) noexcept {
+  if (!into.has_found_comment() && from.has_found_comment()) {
+    // Steal the comment.
+    sus::mem::swap(into.comment, from.comment);
+  } else if (!from.has_found_comment()) {
+    // Leave the existing comment in place, do nothing.
+  } else if (from.comment.begin_loc == into.comment.begin_loc) {
+    // Both translation units visited the same thing.
+  } else {
+    std::ostringstream s;
+    s << from.comment.begin_loc
+      << ": error: ignored API comment, superceded by comment at "
+      << into.comment.begin_loc;
+    return sus::err(sus::move(s).str());
+  }
+  if (from.source_link > into.source_link)
+    into.source_link = sus::move(from.source_link);
+  return sus::ok();
+}
+
+// The elements which have more than a comment to merge. All others are merged
+// by `merge_comment()`.
+MergeResult merge_element(NamespaceElement& into,
+                          NamespaceElement& from) noexcept;
+MergeResult merge_element(RecordElement& into, RecordElement& from) noexcept;
+MergeResult merge_element(FunctionElement& into,
+                          FunctionElement& from) noexcept;
+MergeResult merge_element(CommentElement& into, CommentElement& from) noexcept {
+  return merge_comment(into, from);
+}
+
+/// Moves each element of `from` into `into`, or merges it with the element of
+/// the same key in `into`. The map nodes are moved, so the elements do not
+/// move in memory.
+template <class MapT>
+MergeResult merge_map(MapT& into, MapT& from) noexcept {
+  while (!from.empty()) {
+    auto node = from.extract(from.begin());
+    if (auto it = into.find(node.key()); it != into.end()) {
+      if (MergeResult r = merge_element(it->second, node.mapped()); r.is_err())
+        return r;
+    } else {
+      into.insert(std::move(node));
+    }
+  }
+  return sus::ok();
+}
+
+MergeResult merge_element(NamespaceElement& into,
+                          NamespaceElement& from) noexcept {
+  if (MergeResult r = merge_comment(into, from); r.is_err()) return r;
+  if (MergeResult r = merge_map(into.concepts, from.concepts); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.namespaces, from.namespaces); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.records, from.records); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.functions, from.functions); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.aliases, from.aliases); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.variables, from.variables); r.is_err())
+    return r;
+  return merge_map(into.macros, from.macros);
+}
+
+MergeResult merge_element(RecordElement& into, RecordElement& from) noexcept {
+  if (MergeResult r = merge_comment(into, from); r.is_err()) return r;
+  if (MergeResult r = merge_map(into.records, from.records); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.fields, from.fields); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.deductions, from.deductions); r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.ctors, from.ctors); r.is_err()) return r;
+  if (MergeResult r = merge_map(into.dtors, from.dtors); r.is_err()) return r;
+  if (MergeResult r = merge_map(into.conversions, from.conversions);
+      r.is_err())
+    return r;
+  if (MergeResult r = merge_map(into.methods, from.methods); r.is_err())
+    return r;
+  return merge_map(into.aliases, from.aliases);
+}
+
+MergeResult merge_element(FunctionElement& into,
+                          FunctionElement& from) noexcept {
+  if (MergeResult r = merge_comment(into, from); r.is_err()) return r;
+  // The overloads are each added as the `Visitor` would have added them, in
+  // the order they were found, skipping ones that are already present.
+  for (FunctionOverload& overload : from.overloads.iter_mut()) {
+    bool exists = into.overloads.iter().any(
+        [&overload](const FunctionOverload& existing) {
+          return existing.signature_key == overload.signature_key;
+        });
+    if (!exists) into.overloads.push(sus::move(overload));
+  }
+  return sus::ok();
+}
+
+/// Rebuilds `map` by inserting its elements in key order into empty buckets.
+/// The iteration order of an unordered map follows from its buckets and from
+/// the order that colliding elements were inserted in, so afterward it depends
+/// only on the set of keys, and not on how the map was filled.
+template <class MapT>
+void sort_map(MapT& map) noexcept {
+  auto nodes = Vec<typename MapT::node_type>::with_capacity(map.size());
+  while (!map.empty()) nodes.push(map.extract(map.begin()));
+  nodes.sort_unstable_by(
+      [](const typename MapT::node_type& a,
+         const typename MapT::node_type& b) -> std::weak_ordering {
+        return a.key() <=> b.key();
+      });
+  // Start from an empty set of buckets, so that the buckets depend only on the
+  // elements and not on how the map grew.
+  map.rehash(0u);
+  for (typename MapT::node_type& node : nodes.iter_mut())
+    map.insert(std::move(node));
+}
+
+void sort_record(RecordElement& e) noexcept {
+  sort_map(e.records);
+  sort_map(e.fields);
+  sort_map(e.deductions);
+  sort_map(e.ctors);
+  sort_map(e.dtors);
+  sort_map(e.conversions);
+  sort_map(e.methods);
+  sort_map(e.aliases);
+  for (auto& [k, sub] : e.records) sort_record(sub);
+}
+
+void sort_namespace(NamespaceElement& e) noexcept {
+  sort_map(e.concepts);
+  sort_map(e.namespaces);
+  sort_map(e.records);
+  sort_map(e.functions);
+  sort_map(e.aliases);
+  sort_map(e.variables);
+  sort_map(e.macros);
+  for (auto& [k, sub] : e.namespaces) sort_namespace(sub);
+  for (auto& [k, sub] : e.records) sort_record(sub);
+}
+
+void relink_function(FunctionElement& e, const Database& db) noexcept {
+  for (FunctionOverload& overload : e.overloads.iter_mut()) {
+    for (FunctionParameter& p : overload.parameters.iter_mut())
+      p.type.relink(db);
+    overload.return_type.relink(db);
+  }
+}
+
+void relink_alias(AliasElement& e, const Database& db) noexcept {
+  switch (e.target) {
+    case AliasTarget::Tag::AliasOfType:
+      e.target.as_mut<AliasTarget::Tag::AliasOfType>().relink(db);
+      break;
+    case AliasTarget::Tag::AliasOfConcept:
+      e.target.as_mut<AliasTarget::Tag::AliasOfConcept>().relink(db);
+      break;
+    case AliasTarget::Tag::AliasOfMethod: {
+      auto&& [type, method_name] =
+          e.target.as_mut<AliasTarget::Tag::AliasOfMethod>();
+      type.relink(db);
+      break;
+    }
+    case AliasTarget::Tag::AliasOfFunction:
+      e.target.as_mut<AliasTarget::Tag::AliasOfFunction>().relink(db);
+      break;
+    case AliasTarget::Tag::AliasOfEnumConstant: {
+      auto&& [type, constant_name] =
+          e.target.as_mut<AliasTarget::Tag::AliasOfEnumConstant>();
+      type.relink(db);
+      break;
+    }
+    case AliasTarget::Tag::AliasOfVariable:
+      e.target.as_mut<AliasTarget::Tag::AliasOfVariable>().relink(db);
+      break;
+  }
+}
+
+void relink_record(RecordElement& e, const Database& db) noexcept {
+  for (auto& [k, sub] : e.records) relink_record(sub, db);
+  for (auto& [k, sub] : e.fields) sub.type.relink(db);
+  for (auto& [k, sub] : e.deductions) relink_function(sub, db);
+  for (auto& [k, sub] : e.ctors) relink_function(sub, db);
+  for (auto& [k, sub] : e.dtors) relink_function(sub, db);
+  for (auto& [k, sub] : e.conversions) relink_function(sub, db);
+  for (auto& [k, sub] : e.methods) relink_function(sub, db);
+  for (auto& [k, sub] : e.aliases) relink_alias(sub, db);
+}
+
+void relink_namespace(NamespaceElement& e, const Database& db) noexcept {
+  for (auto& [k, sub] : e.namespaces) relink_namespace(sub, db);
+  for (auto& [k, sub] : e.records) relink_record(sub, db);
+  for (auto& [k, sub] : e.functions) relink_function(sub, db);
+  for (auto& [k, sub] : e.aliases) relink_alias(sub, db);
+  for (auto& [k, sub] : e.variables) sub.type.relink(db);
+}
+
+}  // namespace
+
+sus::Result<void, std::string> merge_database(Database& into,
+                                              Database from) noexcept {
+  return merge_element(into.global, from.global);
+}
+
+void sort_database(Database& db) noexcept { sort_namespace(db.global); }
+
+void relink_database(Database& db) noexcept { relink_namespace(db.global, db); }
+
+}  // namespace subdoc
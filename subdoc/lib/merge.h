@@ -0,0 +1,50 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+
+#include "subdoc/lib/database.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+
+namespace subdoc {
+
+/// Merges `from`, the `Database` collected from a single translation unit, into
+/// `into`.
+///
+/// Elements found in both are combined with the rules the `Visitor` uses when
+/// it finds an element again in another translation unit: a comment fills in
+/// for a missing one, the better source link is kept, and function overloads
+/// that are not already present are added. Two different comments on the same
+/// element is an error, and its message is returned.
+///
+/// The references between elements are left pointing into `from`, so
+/// `relink_database()` must be run once every translation unit is merged.
+sus::Result<void, std::string> merge_database(Database& into,
+                                              Database from) noexcept;
+
+/// Rebuilds every map in `db` by inserting its elements in key order, so that
+/// iterating over the `Database` does not depend on the order that translation
+/// units were visited or merged in. The maps are unordered, so this does not
+/// put them in key order, but it makes their order depend only on the keys
+/// they hold. The elements are not moved in memory.
+void sort_database(Database& db) noexcept;
+
+/// Finds the references from types and aliases to other elements of `db`
+/// again, now that every element that they may refer to is present.
+void relink_database(Database& db) noexcept;
+
+}  // namespace subdoc
@@ -14,11 +14,27 @@
 
 #include "subdoc/lib/run.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <regex>
+#include <set>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "subdoc/lib/clang_resource_dir.h"
+#include "subdoc/lib/covering_files.h"
+#include "subdoc/lib/leading_includes.h"
+#include "subdoc/lib/merge.h"
+#include "subdoc/lib/serialize.h"
 #include "subdoc/lib/visit.h"
 #include "sus/collections/compat_vector.h"
 #include "sus/iter/iterator.h"
@@ -64,24 +80,11 @@ struct DiagnosticTracker : public clang::TextDiagnosticPrinter {
   DiagnosticResults results;
 };
 
-sus::Result<Database, DiagnosticResults> run_files(
-    const clang::tooling::CompilationDatabase& comp_db, Vec<std::string> paths,
-    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
-    const RunOptions& options) noexcept {
-  // Clang DiagnoticsConsumer that prints out the full error and context, which
-  // is what the default one does, but by making it we have a pointer from which
-  // we can see if an error occured.
-  auto diags = std::make_unique<DiagnosticTracker>(
-      llvm::errs(), new clang::DiagnosticOptions());
-
-  usize num_files = paths.len();
-  auto tool = clang::tooling::ClangTool(
-      comp_db, sus::move(paths).into_iter().collect<std::vector<std::string>>(),
-      std::make_shared<clang::PCHContainerOperations>(), std::move(fs));
-  tool.setDiagnosticConsumer(&*diags);
-
-  ClangResourceDir resource_dir;
+namespace {
 
+/// Changes the command line of each compilation run by `tool` to suit subdoc.
+void add_arguments_adjuster(clang::tooling::ClangTool& tool,
+                            ClangResourceDir& resource_dir) noexcept {
   auto adj = [&resource_dir](clang::tooling::CommandLineArguments args,
                              llvm::StringRef) {
     // Clang-cl doesn't understand this argument, but it may appear in the
@@ -141,6 +144,741 @@ sus::Result<Database, DiagnosticResults> run_files(
     return std::move(args);
   };
   tool.appendArgumentsAdjuster(adj);
+}
+
+/// Records each file entered by the preprocessor that matches the path patterns
+/// in the `RunOptions`.
+struct IncludesCollector : public clang::PPCallbacks {
+  explicit IncludesCollector(const clang::SourceManager& sm,
+                             const RunOptions& options, Vec<std::string>& files)
+      : sm(sm), options(options), files(files) {}
+
+  void FileChanged(clang::SourceLocation loc, FileChangeReason reason,
+                   clang::SrcMgr::CharacteristicKind,
+                   clang::FileID) noexcept final {
+    if (reason != FileChangeReason::EnterFile) return;
+    auto entry = sm.getFileEntryRefForID(sm.getFileID(loc));
+    // No FileEntry means a builtin, which is never visited.
+    if (!entry) return;
+
+    llvm::StringRef path = entry->getFileEntry().tryGetRealPathName();
+    if (path.empty()) path = entry->getName();
+    // Canonicalize the path to use `/` instead of `\`.
+    auto canonical_path = std::string(path);
+    std::replace(canonical_path.begin(), canonical_path.end(), '\\', '/');
+    if (!std::regex_search(canonical_path, options.include_path_patterns))
+      return;
+    if (std::regex_search(canonical_path, options.exclude_path_patterns))
+      return;
+    files.push(sus::move(canonical_path));
+  }
+
+  const clang::SourceManager& sm;
+  const RunOptions& options;
+  Vec<std::string>& files;
+};
+
+struct IncludesAction : public clang::PreprocessOnlyAction {
+  explicit IncludesAction(const RunOptions& options, Vec<std::string>& files)
+      : options(options), files(files) {}
+
+  bool BeginSourceFileAction(clang::CompilerInstance& ci) noexcept final {
+    ci.getPreprocessor().addPPCallbacks(std::make_unique<IncludesCollector>(
+        ci.getSourceManager(), options, files));
+    return true;
+  }
+
+  const RunOptions& options;
+  Vec<std::string>& files;
+};
+
+struct IncludesFactory : public clang::tooling::FrontendActionFactory {
+  explicit IncludesFactory(const RunOptions& options, Vec<std::string>& files)
+      : options(options), files(files) {}
+
+  // Returns an IncludesAction.
+  std::unique_ptr<clang::FrontendAction> create() noexcept final {
+    return std::make_unique<IncludesAction>(options, files);
+  }
+
+  const RunOptions& options;
+  Vec<std::string>& files;
+};
+
+/// Reads through to a file system that is shared between threads, but keeps
+/// its own working directory. `ClangTool` sets the working directory on the
+/// file system it is given, so each worker thread needs one of these.
+class WorkingDirectoryFileSystem : public llvm::vfs::ProxyFileSystem {
+ public:
+  explicit WorkingDirectoryFileSystem(
+      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs)
+      : llvm::vfs::ProxyFileSystem(std::move(fs)) {
+    if (llvm::ErrorOr<std::string> cwd =
+            getUnderlyingFS().getCurrentWorkingDirectory())
+      cwd_ = sus::move(*cwd);
+  }
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override {
+    return llvm::vfs::ProxyFileSystem::status(absolute(path));
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(
+      const llvm::Twine& path) override {
+    return llvm::vfs::ProxyFileSystem::openFileForRead(absolute(path));
+  }
+  llvm::vfs::directory_iterator dir_begin(const llvm::Twine& dir,
+                                          std::error_code& ec) override {
+    return llvm::vfs::ProxyFileSystem::dir_begin(absolute(dir), ec);
+  }
+  std::error_code getRealPath(
+      const llvm::Twine& path,
+      llvm::SmallVectorImpl<char>& output) const override {
+    return llvm::vfs::ProxyFileSystem::getRealPath(absolute(path), output);
+  }
+  std::error_code isLocal(const llvm::Twine& path, bool& result) override {
+    return llvm::vfs::ProxyFileSystem::isLocal(absolute(path), result);
+  }
+
+  llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override {
+    return cwd_;
+  }
+  std::error_code setCurrentWorkingDirectory(const llvm::Twine& path) override {
+    llvm::SmallString<128> dir = absolute(path);
+    llvm::ErrorOr<llvm::vfs::Status> s =
+        llvm::vfs::ProxyFileSystem::status(dir);
+    if (!s) return s.getError();
+    if (!s->isDirectory())
+      return std::make_error_code(std::errc::not_a_directory);
+    cwd_ = std::string(dir);
+    return std::error_code();
+  }
+
+ private:
+  llvm::SmallString<128> absolute(const llvm::Twine& path) const noexcept {
+    llvm::SmallString<128> out;
+    path.toVector(out);
+    llvm::sys::fs::make_absolute(cwd_, out);
+    return out;
+  }
+
+  std::string cwd_;
+};
+
+/// Calls `work(i, fs, resource_dir)` for each `i` below `count`, on up to
+/// `jobs` threads. Each thread reads through `fs` with a working directory of
+/// its own, and has its own `ClangResourceDir`, which caches what it finds
+/// without a lock.
+template <class F>
+void run_on_workers(usize count, u32 jobs,
+                    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+                    F work) noexcept {
+  usize num_threads = usize::from(jobs);
+  if (num_threads < 1u) num_threads = 1u;
+  if (num_threads > count) num_threads = count;
+
+  auto next = std::atomic<size_t>(0u);
+  auto worker = [&]() {
+    ClangResourceDir resource_dir;
+    auto thread_fs = llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(
+        new WorkingDirectoryFileSystem(fs));
+    while (true) {
+      usize i = next.fetch_add(1u, std::memory_order_relaxed);
+      if (i >= count) break;
+      work(i, thread_fs, resource_dir);
+    }
+  };
+  if (num_threads <= 1u) {
+    worker();
+    return;
+  }
+  auto threads = Vec<std::thread>::with_capacity(num_threads);
+  for (usize i; i < num_threads; i += 1u) threads.push(std::thread(worker));
+  for (std::thread& t : threads.iter_mut()) t.join();
+}
+
+/// Runs only the preprocessor over each of `paths`, on `RunOptions::jobs`
+/// threads, and returns the files matched by the path patterns that each one
+/// includes, or None if it failed.
+Vec<Option<Vec<std::string>>> collect_included_files(
+    const clang::tooling::CompilationDatabase& comp_db,
+    const Vec<std::string>& paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const RunOptions& options) noexcept {
+  auto included = Vec<Option<Vec<std::string>>>::with_capacity(paths.len());
+  for (usize i; i < paths.len(); i += 1u)
+    included.push(Option<Vec<std::string>>());
+
+  run_on_workers(
+      paths.len(), options.jobs, std::move(fs),
+      [&](usize i, llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> thread_fs,
+          ClangResourceDir& resource_dir) {
+        // Errors are reported when the translation unit is parsed for real.
+        auto diags = clang::IgnoringDiagConsumer();
+        auto tool = clang::tooling::ClangTool(
+            comp_db, std::vector<std::string>{paths[i]},
+            std::make_shared<clang::PCHContainerOperations>(),
+            std::move(thread_fs));
+        tool.setDiagnosticConsumer(&diags);
+        add_arguments_adjuster(tool, resource_dir);
+
+        auto files = Vec<std::string>();
+        auto factory = IncludesFactory(options, files);
+        if (tool.run(&factory) == 0)
+          included[i].insert(sus::move(files));
+      });
+  return included;
+}
+
+/// Returns the fewest of `paths` that together include every file matched by
+/// the path patterns, in their original order.
+Vec<std::string> select_paths(
+    const clang::tooling::CompilationDatabase& comp_db, Vec<std::string> paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const RunOptions& options) noexcept {
+  Vec<Option<Vec<std::string>>> included =
+      collect_included_files(comp_db, paths, std::move(fs), options);
+  Vec<usize> selected = select_covering_files(included);
+
+  if (options.show_progress) {
+    auto all_files = std::unordered_set<std::string_view>();
+    for (const Option<Vec<std::string>>& files : included) {
+      if (files.is_some())
+        for (const std::string& f : files.as_value()) all_files.insert(f);
+    }
+    fmt::println(stderr,
+                 "Parsing {} of {} source files, which include all {} "
+                 "matching files",
+                 selected.len(), paths.len(), all_files.size());
+  }
+
+  auto selected_paths = Vec<std::string>::with_capacity(selected.len());
+  for (usize i : selected.iter()) selected_paths.push(sus::move(paths[i]));
+  return selected_paths;
+}
+
+/// Precompiled headers for groups of source files, which are removed from disk
+/// when it is destroyed.
+struct PrecompiledHeaders {
+  PrecompiledHeaders() = default;
+  PrecompiledHeaders(const PrecompiledHeaders&) = delete;
+  PrecompiledHeaders& operator=(const PrecompiledHeaders&) = delete;
+  ~PrecompiledHeaders() {
+    for (const std::string& f : temp_files) llvm::sys::fs::remove(f);
+  }
+
+  /// The precompiled header to load for each source file, by the file name in
+  /// its compile command.
+  std::unordered_map<std::string, std::string> pch_for_file;
+  std::vector<std::string> temp_files;
+};
+
+/// Makes each compilation run by `tool` load the precompiled header built for
+/// its source file, if there is one.
+void add_pch_adjuster(clang::tooling::ClangTool& tool,
+                      const PrecompiledHeaders& pchs) noexcept {
+  auto adj = [&pchs](clang::tooling::CommandLineArguments args,
+                     llvm::StringRef file) {
+    if (auto it = pchs.pch_for_file.find(std::string(file));
+        it != pchs.pch_for_file.end()) {
+      args.push_back("-include-pch");
+      args.push_back(it->second);
+    }
+    return std::move(args);
+  };
+  tool.appendArgumentsAdjuster(adj);
+}
+
+/// An `#include` line from the top of a source file.
+struct LeadingInclude {
+  std::string line;
+  /// The directory of the source file, where a quoted include is looked up
+  /// first. It is empty for an angled include, which does not depend on it.
+  std::string quote_dir;
+
+  bool operator==(const LeadingInclude&) const = default;
+};
+
+struct GeneratePchAction : public clang::GeneratePCHAction {
+  explicit GeneratePchAction(const std::string& output) : output(output) {}
+
+  bool BeginInvocation(clang::CompilerInstance& ci) noexcept final {
+    ci.getFrontendOpts().OutputFile = output;
+    return clang::GeneratePCHAction::BeginInvocation(ci);
+  }
+
+  const std::string& output;
+};
+
+struct GeneratePchFactory : public clang::tooling::FrontendActionFactory {
+  explicit GeneratePchFactory(const std::string& output) : output(output) {}
+
+  // Returns a GeneratePchAction.
+  std::unique_ptr<clang::FrontendAction> create() noexcept final {
+    return std::make_unique<GeneratePchAction>(output);
+  }
+
+  const std::string& output;
+};
+
+/// Builds a precompiled header at `pch_path` from the header at `header_path`,
+/// using the compile command of the source file at `path`. Quoted includes
+/// are also looked up in each of `quote_dirs`, as the header is not next to
+/// the source files that its includes came from.
+bool build_pch(const clang::tooling::CompilationDatabase& comp_db,
+               const std::string& path, const std::string& header_path,
+               const std::string& pch_path,
+               const std::set<std::string>& quote_dirs,
+               llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+               ClangResourceDir& resource_dir) noexcept {
+  // If the header can not be built, the source files are parsed without it,
+  // and report any errors then.
+  auto diags = clang::IgnoringDiagConsumer();
+  auto tool = clang::tooling::ClangTool(
+      comp_db, std::vector<std::string>{path},
+      std::make_shared<clang::PCHContainerOperations>(), std::move(fs));
+  tool.setDiagnosticConsumer(&diags);
+  add_arguments_adjuster(tool, resource_dir);
+  auto swap_input = [&header_path, &quote_dirs](
+                        clang::tooling::CommandLineArguments args,
+                        llvm::StringRef file) {
+    std::replace(args.begin(), args.end(), std::string(file), header_path);
+    for (const std::string& dir : quote_dirs) {
+      args.push_back("-iquote");
+      args.push_back(dir);
+    }
+    return std::move(args);
+  };
+  tool.appendArgumentsAdjuster(swap_input);
+
+  auto factory = GeneratePchFactory(pch_path);
+  return tool.run(&factory) == 0;
+}
+
+/// Builds a precompiled header for each group of `paths` that share the same
+/// compile command, from the includes that every source file in the group
+/// starts with.
+void build_precompiled_headers(
+    const clang::tooling::CompilationDatabase& comp_db,
+    const Vec<std::string>& paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const RunOptions& options, PrecompiledHeaders& pchs) noexcept {
+  struct Group {
+    /// The paths used to find the compile commands.
+    Vec<std::string> paths;
+    /// The file names in the compile commands.
+    Vec<std::string> file_names;
+    Vec<LeadingInclude> includes;
+  };
+  // Keyed by the working directory and the command line, without the source
+  // and output file names.
+  std::map<std::string, Group> groups;
+
+  for (const std::string& path : paths) {
+    std::vector<clang::tooling::CompileCommand> commands =
+        comp_db.getCompileCommands(path);
+    if (commands.size() != 1u) continue;
+    const clang::tooling::CompileCommand& command = commands[0u];
+    // Clang-cl uses different flags to load a precompiled header.
+    if (std::filesystem::path(command.CommandLine[0u]).filename().string() ==
+        "cl.exe")
+      continue;
+
+    auto buffer = fs->getBufferForFile(path);
+    if (!buffer) continue;
+    // A quoted include may find a different file for source files in other
+    // directories, so it is only shared by source files in the same one.
+    constexpr size_t kIncludeLen = std::string_view("#include").size();
+    std::string source_dir =
+        (std::filesystem::path(command.Directory) / command.Filename)
+            .parent_path()
+            .string();
+    auto includes =
+        leading_includes(std::string_view((*buffer)->getBuffer()))
+            .into_iter()
+            .map([&source_dir](std::string line) {
+              size_t name = line.find_first_not_of(" \t", kIncludeLen);
+              bool quoted = name != std::string::npos && line[name] == '"';
+              return LeadingInclude(sus::move(line),
+                                    quoted ? source_dir : std::string());
+            })
+            .collect<Vec<LeadingInclude>>();
+
+    std::string key = command.Directory;
+    for (size_t i = 0u; i < command.CommandLine.size(); ++i) {
+      const std::string& arg = command.CommandLine[i];
+      if (arg == command.Filename) continue;
+      if (arg == "-o") {
+        ++i;
+        continue;
+      }
+      key += "\n";
+      key += arg;
+    }
+
+    auto [it, inserted] = groups.try_emplace(sus::move(key));
+    Group& group = it->second;
+    group.paths.push(path);
+    group.file_names.push(command.Filename);
+    if (inserted) {
+      group.includes = sus::move(includes);
+    } else {
+      group.includes =
+          sus::move(group.includes)
+              .into_iter()
+              .filter([&includes](const LeadingInclude& include) {
+                return includes.iter().any(
+                    [&include](const LeadingInclude& i) {
+                      return i == include;
+                    });
+              })
+              .collect<Vec<LeadingInclude>>();
+    }
+  }
+
+  ClangResourceDir resource_dir;
+  for (auto& [key, group] : groups) {
+    // A precompiled header saves time only once it is used more than once.
+    if (group.paths.len() < 2u || group.includes.is_empty()) continue;
+
+    llvm::SmallString<128> header_path;
+    llvm::SmallString<128> pch_path;
+    if (llvm::sys::fs::createTemporaryFile("subdoc", "h", header_path))
+      continue;
+    pchs.temp_files.push_back(std::string(header_path));
+    if (llvm::sys::fs::createTemporaryFile("subdoc", "pch", pch_path))
+      continue;
+    pchs.temp_files.push_back(std::string(pch_path));
+    auto quote_dirs = std::set<std::string>();
+    {
+      auto header = std::ofstream(std::string(header_path));
+      for (const LeadingInclude& include : group.includes) {
+        header << include.line << "\n";
+        if (!include.quote_dir.empty()) quote_dirs.insert(include.quote_dir);
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool built = build_pch(comp_db, group.paths[0u], std::string(header_path),
+                           std::string(pch_path), quote_dirs, fs, resource_dir);
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+    if (options.show_progress) {
+      if (built) {
+        fmt::println(stderr,
+                     "Precompiled {} includes shared by {} files in {:.2f}s",
+                     group.includes.len(), group.paths.len(), elapsed.count());
+      } else {
+        fmt::println(stderr,
+                     "Failed to precompile the includes shared by {} files",
+                     group.paths.len());
+      }
+    }
+    if (!built) continue;
+
+    for (const std::string& file_name : group.file_names)
+      pchs.pch_for_file.emplace(file_name, std::string(pch_path));
+  }
+}
+
+/// Prints how long it took to parse translation units with and without a
+/// precompiled header.
+void print_parse_times(const ParseTimes& cold,
+                       const ParseTimes& warm) noexcept {
+  auto print = [](const ParseTimes& times, std::string_view what) {
+    if (times.count == 0u) return;
+    double each = times.total.count() /
+                  static_cast<double>(times.count.primitive_value);
+    fmt::println(stderr, "Parsed {} files {} in {:.2f}s, {:.2f}s each",
+                 times.count, what, times.total.count(), each);
+  };
+  print(cold, "without a precompiled header");
+  print(warm, "with a precompiled header");
+}
+
+/// Records the path of each file entered by the preprocessor, which together
+/// are every file that the translation unit depends on.
+struct DependencyCollector : public clang::PPCallbacks {
+  explicit DependencyCollector(const clang::SourceManager& sm,
+                               std::set<std::string>& files)
+      : sm(sm), files(files) {}
+
+  void FileChanged(clang::SourceLocation loc, FileChangeReason reason,
+                   clang::SrcMgr::CharacteristicKind,
+                   clang::FileID) noexcept final {
+    if (reason != FileChangeReason::EnterFile) return;
+    auto entry = sm.getFileEntryRefForID(sm.getFileID(loc));
+    // No FileEntry means a builtin, which can not change.
+    if (!entry) return;
+
+    llvm::StringRef path = entry->getFileEntry().tryGetRealPathName();
+    if (path.empty()) path = entry->getName();
+    files.emplace(path);
+  }
+
+  const clang::SourceManager& sm;
+  std::set<std::string>& files;
+};
+
+/// Runs the wrapped action, and records the files that it reads.
+struct DependencyAction : public clang::WrapperFrontendAction {
+  explicit DependencyAction(std::unique_ptr<clang::FrontendAction> wrapped,
+                            std::set<std::string>& files)
+      : clang::WrapperFrontendAction(std::move(wrapped)), files(files) {}
+
+  bool BeginSourceFileAction(clang::CompilerInstance& ci) noexcept final {
+    ci.getPreprocessor().addPPCallbacks(std::make_unique<DependencyCollector>(
+        ci.getSourceManager(), files));
+    return clang::WrapperFrontendAction::BeginSourceFileAction(ci);
+  }
+
+  std::set<std::string>& files;
+};
+
+struct DependencyFactory : public clang::tooling::FrontendActionFactory {
+  explicit DependencyFactory(clang::tooling::FrontendActionFactory& wrapped,
+                             std::set<std::string>& files)
+      : wrapped(wrapped), files(files) {}
+
+  // Returns a DependencyAction around the action made by `wrapped`.
+  std::unique_ptr<clang::FrontendAction> create() noexcept final {
+    return std::make_unique<DependencyAction>(wrapped.create(), files);
+  }
+
+  clang::tooling::FrontendActionFactory& wrapped;
+  std::set<std::string>& files;
+};
+
+/// Returns the SHA1 of `bytes` as a hex string.
+std::string sha1_hex(llvm::StringRef bytes) noexcept {
+  return llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(bytes)),
+                     /*LowerCase=*/true);
+}
+
+/// The `Database` collected from each translation unit on earlier runs, kept
+/// in the `RunOptions::cache_dir`.
+///
+/// Each translation unit has one entry, named by a hash of its compile command
+/// and of the options that change what is collected. Like the direct mode of
+/// ccache, the entry lists every file that the translation unit read with a
+/// hash of its contents, and it is used only while none of them has changed.
+/// The files are read through the same file system that they are parsed from.
+struct TuCache {
+  explicit TuCache(const clang::tooling::CompilationDatabase& comp_db,
+                   llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+                   const RunOptions& options)
+      : comp_db(comp_db), fs(std::move(fs)), options(options) {
+    auto add = [this](std::string_view s) {
+      options_key += s;
+      options_key += '\0';
+    };
+    auto add_option = [&add](const Option<std::string>& o) {
+      add(o.is_some() ? "1" + o.as_value() : "0");
+    };
+    // Changes to the format of the entries, or to what the `Visitor` collects,
+    // must change this version so that older entries are not used.
+    add("subdoc-tu-cache-2");
+    add(CLANG_VERSION_STRING);
+    for (const std::string& prefix : options.macro_prefixes) add(prefix);
+    add(options.generate_source_links ? "1" : "0");
+    add_option(options.remove_path_prefix);
+    add_option(options.add_path_prefix);
+    add_option(options.source_line_prefix);
+    add(options.project_overview_text);
+    add(options.cache_options_key);
+
+    auto ec = std::error_code();
+    std::filesystem::create_directories(options.cache_dir.as_value(), ec);
+  }
+
+  /// Returns the `Database` collected from the source file at `path` on an
+  /// earlier run, if none of the files it read have changed since.
+  Option<Database> load(const std::string& path) noexcept {
+    Option<std::string> entry = entry_path(path);
+    if (entry.is_none()) return sus::none();
+    auto buffer = llvm::MemoryBuffer::getFile(entry.as_value());
+    if (!buffer) return sus::none();
+
+    llvm::StringRef rest = (*buffer)->getBuffer();
+    auto [count_line, after_count] = rest.split('\n');
+    rest = after_count;
+    size_t count;
+    if (count_line.getAsInteger(10u, count)) return sus::none();
+    for (size_t i = 0u; i < count; ++i) {
+      auto [line, after_line] = rest.split('\n');
+      rest = after_line;
+      auto [hash, dependency] = line.split(' ');
+      const Option<std::string>& current = file_hash(std::string(dependency));
+      if (current.is_none() || current.as_value() != hash) return sus::none();
+    }
+
+    sus::Result<Database, std::string> db =
+        load_database(std::string_view(rest.data(), rest.size()));
+    if (db.is_err()) return sus::none();
+    return sus::some(sus::move(db).unwrap());
+  }
+
+  /// Writes the `Database` collected from the source file at `path`, along
+  /// with the files it read, so that later runs can use it.
+  void save(const std::string& path, const std::set<std::string>& dependencies,
+            const Database& db) noexcept {
+    Option<std::string> entry = entry_path(path);
+    if (entry.is_none()) return;
+
+    std::string out = std::to_string(dependencies.size()) + "\n";
+    for (const std::string& dependency : dependencies) {
+      const Option<std::string>& hash = file_hash(dependency);
+      // A file that can not be read could not be checked for changes later.
+      if (hash.is_none()) return;
+      out += hash.as_value();
+      out += ' ';
+      out += dependency;
+      out += '\n';
+    }
+    out += save_database(db);
+
+    // Write to a temporary file first, so that another run never sees a
+    // partly written entry.
+    int fd;
+    llvm::SmallString<128> temp_path;
+    if (llvm::sys::fs::createUniqueFile(entry.as_value() + "-%%%%%%", fd,
+                                        temp_path))
+      return;
+    {
+      auto os = llvm::raw_fd_ostream(fd, /*shouldClose=*/true);
+      os << out;
+    }
+    if (llvm::sys::fs::rename(temp_path, entry.as_value()))
+      llvm::sys::fs::remove(temp_path);
+  }
+
+  /// Returns the path of the entry for the source file at `path`, or None if
+  /// it does not have exactly one compile command.
+  Option<std::string> entry_path(const std::string& path) const noexcept {
+    std::vector<clang::tooling::CompileCommand> commands =
+        comp_db.getCompileCommands(path);
+    if (commands.size() != 1u) return sus::none();
+    const clang::tooling::CompileCommand& command = commands[0u];
+
+    std::string key = options_key;
+    key += command.Directory;
+    key += '\0';
+    key += command.Filename;
+    for (const std::string& arg : command.CommandLine) {
+      key += '\0';
+      key += arg;
+    }
+    auto entry = std::filesystem::path(options.cache_dir.as_value()) /
+                 sha1_hex(key);
+    return sus::some(entry.string());
+  }
+
+  /// Returns the hash of the contents of the file at `path`, or None if it can
+  /// not be read. Each file is read at most once.
+  const Option<std::string>& file_hash(const std::string& path) noexcept {
+    auto [it, inserted] = file_hashes.try_emplace(path);
+    if (inserted) {
+      if (auto buffer = fs->getBufferForFile(path))
+        it->second.insert(sha1_hex((*buffer)->getBuffer()));
+    }
+    return it->second;
+  }
+
+  const clang::tooling::CompilationDatabase& comp_db;
+  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs;
+  const RunOptions& options;
+  std::string options_key;
+  std::unordered_map<std::string, Option<std::string>> file_hashes;
+};
+
+/// Gives the maps in the `Database` an iteration order that depends only on
+/// their keys, and points its references at its own elements, so that the
+/// result is the same whether it was collected from each translation unit in
+/// turn or merged from many separate ones. Then indexes its elements by
+/// name, as no more elements will be added.
+sus::Result<void, std::string> finish_database(Database& docs_db) noexcept {
+  sort_database(docs_db);
+  relink_database(docs_db);
+  docs_db.build_name_index();
+  return docs_db.resolve_inherited_comments();
+}
+
+/// What was collected from a single translation unit on a worker thread.
+struct TuResult {
+  /// The elements found in the translation unit, or None if it failed.
+  Option<Database> docs_db;
+  DiagnosticResults diags;
+  /// The printed diagnostics, held back so they can be written out in the same
+  /// order as when running on a single thread.
+  std::string diags_text;
+  ParseTimes cold;
+  ParseTimes warm;
+  /// The files that the translation unit read, when they are needed for the
+  /// `TuCache`.
+  std::set<std::string> dependencies;
+};
+
+TuResult run_one_file(const clang::tooling::CompilationDatabase& comp_db,
+                      const std::string& path, usize file_index,
+                      usize num_files,
+                      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+                      ClangResourceDir& resource_dir,
+                      const PrecompiledHeaders& pchs,
+                      const RunOptions& options) noexcept {
+  auto diags_text = std::string();
+  auto diags_stream = llvm::raw_string_ostream(diags_text);
+  auto diags = std::make_unique<DiagnosticTracker>(
+      diags_stream, new clang::DiagnosticOptions());
+
+  auto tool = clang::tooling::ClangTool(
+      comp_db, std::vector<std::string>{path},
+      std::make_shared<clang::PCHContainerOperations>(), std::move(fs));
+  tool.setDiagnosticConsumer(&*diags);
+  add_arguments_adjuster(tool, resource_dir);
+  add_pch_adjuster(tool, pchs);
+
+  auto cx = VisitCx(options);
+  auto docs_db = Database(
+      Comment(sus::clone(options.project_overview_text), "", DocAttributes()));
+  auto visitor_factory = VisitorFactory(cx, docs_db, num_files);
+  visitor_factory.line_stats.cur_file = file_index + 1u;
+
+  auto dependencies = std::set<std::string>();
+  i32 run_value;
+  if (options.cache_dir.is_some()) {
+    auto dependency_factory = DependencyFactory(visitor_factory, dependencies);
+    run_value = sus::move(tool).run(&dependency_factory);
+  } else {
+    run_value = sus::move(tool).run(&visitor_factory);
+  }
+  bool failed = run_value == 1 || diags->getNumErrors() > 0u;
+  const LineStats& stats = visitor_factory.line_stats;
+  auto result = TuResult(Option<Database>(), sus::move(diags->results),
+                         std::string(), stats.cold, stats.warm,
+                         sus::move(dependencies));
+  diags_stream.flush();
+  result.diags_text = sus::move(diags_text);
+  if (!failed) result.docs_db.insert(sus::move(docs_db));
+  return result;
+}
+
+sus::Result<Database, DiagnosticResults> run_files_serial(
+    const clang::tooling::CompilationDatabase& comp_db, Vec<std::string> paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const PrecompiledHeaders& pchs, const RunOptions& options) noexcept {
+  // Clang DiagnoticsConsumer that prints out the full error and context, which
+  // is what the default one does, but by making it we have a pointer from which
+  // we can see if an error occured.
+  auto diags = std::make_unique<DiagnosticTracker>(
+      llvm::errs(), new clang::DiagnosticOptions());
+
+  usize num_files = paths.len();
+  auto tool = clang::tooling::ClangTool(
+      comp_db, sus::move(paths).into_iter().collect<std::vector<std::string>>(),
+      std::make_shared<clang::PCHContainerOperations>(), std::move(fs));
+  tool.setDiagnosticConsumer(&*diags);
+
+  ClangResourceDir resource_dir;
+  add_arguments_adjuster(tool, resource_dir);
+  add_pch_adjuster(tool, pchs);
 
   auto cx = VisitCx(options);
   auto docs_db = Database(
@@ -148,6 +886,10 @@ sus::Result<Database, DiagnosticResults> run_files(
   auto visitor_factory = VisitorFactory(cx, docs_db, num_files);
 
   i32 run_value = sus::move(tool).run(&visitor_factory);
+  if (options.show_progress && !pchs.pch_for_file.empty()) {
+    print_parse_times(visitor_factory.line_stats.cold,
+                      visitor_factory.line_stats.warm);
+  }
   if (run_value == 1) {
     return sus::err(sus::move(sus::move(diags)->results));
   }
@@ -155,7 +897,7 @@ sus::Result<Database, DiagnosticResults> run_files(
     return sus::err(sus::move(sus::move(diags)->results));
   }
 
-  auto r = docs_db.resolve_inherited_comments();
+  auto r = finish_database(docs_db);
   if (r.is_err()) {
     // TODO: forward the message location into a diagnostic.
     llvm::errs() << sus::move(sus::move(r).unwrap_err()) << "\n";
@@ -165,4 +907,122 @@ sus::Result<Database, DiagnosticResults> run_files(
   return sus::ok(sus::move(docs_db));
 }
 
+sus::Result<Database, DiagnosticResults> run_files_parallel(
+    const clang::tooling::CompilationDatabase& comp_db, Vec<std::string> paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const PrecompiledHeaders& pchs, Option<TuCache&> cache,
+    const RunOptions& options) noexcept {
+  usize num_files = paths.len();
+
+  auto results = Vec<Option<TuResult>>::with_capacity(num_files);
+  for (usize i; i < num_files; i += 1u) results.push(Option<TuResult>());
+
+  // The translation units that are not up to date in the cache are parsed.
+  auto to_parse = Vec<usize>::with_capacity(num_files);
+  for (usize i; i < num_files; i += 1u) {
+    Option<Database> cached = cache.is_some()
+                                  ? cache.as_value_mut().load(paths[i])
+                                  : Option<Database>();
+    if (cached.is_some()) {
+      results[i].insert(TuResult(sus::move(cached), DiagnosticResults(),
+                                 std::string(), ParseTimes(), ParseTimes()));
+    } else {
+      to_parse.push(i);
+    }
+  }
+  if (options.show_progress && cache.is_some()) {
+    fmt::println(stderr, "Loaded {} of {} files from the cache",
+                 num_files - to_parse.len(), num_files);
+  }
+
+  run_on_workers(
+      to_parse.len(), options.jobs, std::move(fs),
+      [&](usize next, llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> thread_fs,
+          ClangResourceDir& resource_dir) {
+        usize i = to_parse[next];
+        results[i].insert(run_one_file(comp_db, paths[i], i, num_files,
+                                       std::move(thread_fs), resource_dir,
+                                       pchs, options));
+      });
+
+  if (cache.is_some()) {
+    for (usize i : to_parse.iter()) {
+      const TuResult& result = results[i].as_value();
+      if (result.docs_db.is_some()) {
+        cache.as_value_mut().save(paths[i], result.dependencies,
+                                  result.docs_db.as_value());
+      }
+    }
+  }
+
+  // Merge in the order of `paths`, which is the order that a serial run visits
+  // them in, so that the same comment wins when two of them conflict.
+  auto docs_db = Database(
+      Comment(sus::clone(options.project_overview_text), "", DocAttributes()));
+  auto diags = DiagnosticResults();
+  auto cold = ParseTimes();
+  auto warm = ParseTimes();
+  bool failed = false;
+  for (Option<TuResult>& o : results.iter_mut()) {
+    TuResult& result = o.as_value_mut();
+    llvm::errs() << result.diags_text;
+    cold.add(result.cold);
+    warm.add(result.warm);
+    diags.locations.extend(sus::move(result.diags.locations));
+    if (failed) continue;
+    if (result.docs_db.is_none()) {
+      failed = true;
+      continue;
+    }
+    auto r = merge_database(docs_db, sus::move(result.docs_db).unwrap());
+    if (r.is_err()) {
+      llvm::errs() << sus::move(r).unwrap_err() << "\n";
+      failed = true;
+    }
+  }
+  if (options.show_progress && !pchs.pch_for_file.empty())
+    print_parse_times(cold, warm);
+  if (failed) return sus::err(sus::move(diags));
+
+  auto r = finish_database(docs_db);
+  if (r.is_err()) {
+    // TODO: forward the message location into a diagnostic.
+    llvm::errs() << sus::move(sus::move(r).unwrap_err()) << "\n";
+    return sus::err(sus::move(diags));
+  }
+
+  return sus::ok(sus::move(docs_db));
+}
+
+}  // namespace
+
+sus::Result<Database, DiagnosticResults> run_files(
+    const clang::tooling::CompilationDatabase& comp_db, Vec<std::string> paths,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+    const RunOptions& options) noexcept {
+  if (options.covering_files_only && paths.len() > 1u)
+    paths = select_paths(comp_db, sus::move(paths), fs, options);
+
+  PrecompiledHeaders pchs;
+  if (options.cache_dir.is_some()) {
+    // The files read from a precompiled header are not entered by the
+    // preprocessor, so they would be missing from the dependencies of each
+    // cached translation unit. Each translation unit is collected on its own,
+    // so it can be cached separately.
+    auto cache = TuCache(comp_db, fs, options);
+    return run_files_parallel(comp_db, sus::move(paths), std::move(fs), pchs,
+                              Option<TuCache&>(cache), options);
+  }
+
+  if (options.precompile_headers && paths.len() > 1u)
+    build_precompiled_headers(comp_db, paths, fs, options, pchs);
+
+  if (options.jobs <= 1u || paths.len() <= 1u) {
+    return run_files_serial(comp_db, sus::move(paths), std::move(fs), pchs,
+                            options);
+  }
+  return run_files_parallel(comp_db, sus::move(paths), std::move(fs), pchs,
+                            Option<TuCache&>(), options);
+}
+
 }  // namespace subdoc
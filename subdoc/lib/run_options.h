@@ -40,7 +40,7 @@ struct RunOptions {
     return sus::move(*this);
   }
   RunOptions set_on_tu_complete(
-      sus::Box<sus::fn::DynFn<void(clang::ASTContext&, clang::Preprocessor&)>>
+      sus::fn::InplaceFn<void(clang::ASTContext&, clang::Preprocessor&)>
           fn) && {
     on_tu_complete = sus::some(sus::move(fn));
     return sus::move(*this);
@@ -65,6 +65,30 @@ struct RunOptions {
     source_line_prefix = sus::move(prefix);
     return sus::move(*this);
   }
+  RunOptions set_skip_function_bodies(bool skip) && {
+    skip_function_bodies = skip;
+    return sus::move(*this);
+  }
+  RunOptions set_covering_files_only(bool only) && {
+    covering_files_only = only;
+    return sus::move(*this);
+  }
+  RunOptions set_precompile_headers(bool pch) && {
+    precompile_headers = pch;
+    return sus::move(*this);
+  }
+  RunOptions set_jobs(u32 j) && {
+    jobs = j;
+    return sus::move(*this);
+  }
+  RunOptions set_cache_dir(Option<std::string> dir) && {
+    cache_dir = sus::move(dir);
+    return sus::move(*this);
+  }
+  RunOptions set_cache_options_key(std::string key) && {
+    cache_options_key = sus::move(key);
+    return sus::move(*this);
+  }
 
   /// Whether to print progress while collecting documentation from souce files.
   bool show_progress = true;
@@ -78,8 +102,7 @@ struct RunOptions {
   ///
   /// Used for tests to observe the AST and test subdoc methods that act on
   /// things from the AST.
-  Option<
-      sus::Box<sus::fn::DynFn<void(clang::ASTContext&, clang::Preprocessor&)>>>
+  Option<sus::fn::InplaceFn<void(clang::ASTContext&, clang::Preprocessor&)>>
       on_tu_complete;
   /// The overview markdown which will be applied as the doc comment to the
   /// global namespace/project overview page. This is the raw markdown text, not
@@ -95,6 +118,31 @@ struct RunOptions {
   /// A prefix to add to the source code line number html fragment. Github uses
   /// an `L` as its prefix.
   Option<std::string> source_line_prefix;
+  /// Whether to skip parsing the bodies of functions, which are not part of
+  /// the documentation. Clang still parses the bodies of constexpr functions
+  /// and functions with a deduced return type, as they are needed to compile
+  /// the declarations that use them.
+  bool skip_function_bodies = true;
+  /// Whether to first run only the preprocessor over each translation unit,
+  /// and then parse just enough of them to include every file matched by the
+  /// path patterns.
+  bool covering_files_only = false;
+  /// Whether to precompile the includes that each group of translation units
+  /// with the same compile command starts with, and load them in each one
+  /// instead of parsing the headers again.
+  bool precompile_headers = false;
+  /// How many translation units to parse at once. When more than 1, each
+  /// translation unit is collected into its own `Database` on a worker thread,
+  /// and `on_tu_complete` is run on that thread.
+  u32 jobs = 1u;
+  /// A directory in which to keep the `Database` collected from each
+  /// translation unit, so that later runs parse only the translation units
+  /// where the source file or something it includes has changed.
+  Option<std::string> cache_dir;
+  /// Describes the options that change what is collected from a translation
+  /// unit but that can not be compared directly, such as the path patterns.
+  /// A translation unit in the cache is only used by a run with the same key.
+  std::string cache_options_key;
 };
 
 }  // namespace subdoc
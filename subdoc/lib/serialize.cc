@@ -0,0 +1,961 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/serialize.h"
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <utility>
+
+#include "sus/collections/vec.h"
+#include "sus/iter/iterator.h"
+
+namespace subdoc {
+
+namespace {
+
+// The bytes start with a fixed size header:
+//
+//   char magic[8];
+//   u32 version;
+//   u32 string_count;
+//   u32 string_data_size;
+//   u32 body_size;
+//
+// followed by the string table, which is `string_count + 1` u32 offsets into
+// the string data, and then the string data itself. Last is the body, which
+// holds the elements of the `Database`. In the body, numbers, lengths and
+// string ids are written as varints, with 7 bits in each byte, and each
+// distinct string is written once in the string table and referred to by its
+// index.
+//
+// The fixed size values are little-endian. Strings are found through the
+// offsets in the string table without parsing anything else, but each one is
+// copied out as it is read, since the `Database` owns its strings.
+constexpr std::string_view kMagic = "subdocdb";
+/// Must change whenever the format of the bytes changes.
+constexpr uint32_t kVersion = 1u;
+constexpr size_t kHeaderSize = kMagic.size() + 4u * 4u;
+
+void append_u32(std::string& out, uint32_t v) noexcept {
+  for (uint32_t i = 0u; i < 4u; ++i)
+    out.push_back(static_cast<char>((v >> (i * 8u)) & 0xffu));
+}
+
+/// Reads the little-endian u32 at `pos` in `bytes`, which must be in range.
+uint32_t read_u32(std::string_view bytes, size_t pos) noexcept {
+  uint32_t v = 0u;
+  for (uint32_t i = 0u; i < 4u; ++i)
+    v |= uint32_t{static_cast<uint8_t>(bytes[pos + i])} << (i * 8u);
+  return v;
+}
+
+struct Writer {
+  /// The body of the output.
+  std::string out;
+  /// Each distinct string, in the order they were first written. These point
+  /// into the `Database` being written, which outlives the `Writer`.
+  Vec<std::string_view> strings;
+  std::unordered_map<std::string_view, uint32_t> string_ids;
+
+  void put_byte(uint8_t b) noexcept { out.push_back(static_cast<char>(b)); }
+  void put_bool(bool b) noexcept { put_byte(b ? 1u : 0u); }
+  void put_u32(uint32_t v) noexcept {
+    while (v >= 0x80u) {
+      put_byte(static_cast<uint8_t>(v & 0x7fu) | 0x80u);
+      v >>= 7u;
+    }
+    put_byte(static_cast<uint8_t>(v));
+  }
+  void put_len(usize len) noexcept {
+    put_u32(u32::try_from(len).unwrap().primitive_value);
+  }
+  void put_str(std::string_view s) noexcept {
+    auto [it, inserted] = string_ids.try_emplace(
+        s, u32::try_from(strings.len()).unwrap().primitive_value);
+    if (inserted) strings.push(s);
+    put_u32(it->second);
+  }
+  template <class E>
+  void put_enum(E e) noexcept {
+    put_byte(static_cast<uint8_t>(e));
+  }
+
+  /// Returns the header and string table followed by the body.
+  std::string finish() && noexcept {
+    auto string_data_size = 0_usize;
+    for (std::string_view s : strings) string_data_size += s.size();
+
+    auto bytes = std::string();
+    bytes.reserve(kHeaderSize + (strings.len() + 1u) * 4u + string_data_size +
+                  out.size());
+    bytes += kMagic;
+    append_u32(bytes, kVersion);
+    append_u32(bytes, u32::try_from(strings.len()).unwrap().primitive_value);
+    append_u32(bytes, u32::try_from(string_data_size).unwrap().primitive_value);
+    append_u32(bytes, u32::try_from(out.size()).unwrap().primitive_value);
+    auto offset = 0_u32;
+    append_u32(bytes, offset.primitive_value);
+    for (std::string_view s : strings) {
+      offset += u32::try_from(s.size()).unwrap();
+      append_u32(bytes, offset.primitive_value);
+    }
+    for (std::string_view s : strings) bytes += s;
+    bytes += out;
+    return bytes;
+  }
+};
+
+// Reading past the end, or a value that is out of range, marks the reader as
+// failed, and it returns default values from then on.
+struct Reader {
+  /// The body of the input.
+  std::string_view in;
+  /// The `string_count + 1` offsets of the string table.
+  std::string_view string_offsets;
+  std::string_view string_data;
+  uint32_t string_count;
+  bool failed = false;
+
+  uint8_t get_byte() noexcept {
+    if (in.empty()) {
+      failed = true;
+      return 0u;
+    }
+    auto b = static_cast<uint8_t>(in[0u]);
+    in.remove_prefix(1u);
+    return b;
+  }
+  bool get_bool() noexcept { return get_byte() != 0u; }
+  uint32_t get_u32() noexcept {
+    uint32_t v = 0u;
+    for (uint32_t shift = 0u; shift < 35u; shift += 7u) {
+      uint8_t b = get_byte();
+      v |= uint32_t{b & 0x7fu} << shift;
+      if ((b & 0x80u) == 0u) return v;
+    }
+    failed = true;
+    return 0u;
+  }
+  /// Reads the length of a list. Each item takes at least one byte, which
+  /// bounds the length by the bytes that remain.
+  uint32_t get_len() noexcept {
+    uint32_t len = get_u32();
+    if (len > in.size()) {
+      failed = true;
+      return 0u;
+    }
+    return len;
+  }
+  std::string get_str() noexcept {
+    uint32_t id = get_u32();
+    if (id >= string_count) {
+      failed = true;
+      return std::string();
+    }
+    uint32_t begin = read_u32(string_offsets, size_t{id} * 4u);
+    uint32_t end = read_u32(string_offsets, (size_t{id} + 1u) * 4u);
+    if (begin > end || end > string_data.size()) {
+      failed = true;
+      return std::string();
+    }
+    return std::string(string_data.substr(begin, end - begin));
+  }
+  /// Reads an enum whose last value is `max`.
+  template <class E>
+  E get_enum(E max) noexcept {
+    uint8_t b = get_byte();
+    if (b > static_cast<uint8_t>(max)) {
+      failed = true;
+      return max;
+    }
+    return static_cast<E>(b);
+  }
+};
+
+template <class T, class F>
+void put_vec(Writer& w, const Vec<T>& v, F put) noexcept {
+  w.put_len(v.len());
+  for (const T& t : v) put(w, t);
+}
+
+template <class T, class F>
+Vec<T> get_vec(Reader& r, F get) noexcept {
+  uint32_t len = r.get_len();
+  auto v = Vec<T>::with_capacity(len);
+  for (uint32_t i = 0u; i < len; ++i) v.push(get(r));
+  return v;
+}
+
+template <class T, class F>
+void put_option(Writer& w, const Option<T>& o, F put) noexcept {
+  w.put_bool(o.is_some());
+  if (o.is_some()) put(w, o.as_value());
+}
+
+template <class T, class F>
+Option<T> get_option(Reader& r, F get) noexcept {
+  if (!r.get_bool()) return Option<T>();
+  return Option<T>(get(r));
+}
+
+void put_string(Writer& w, const std::string& s) noexcept { w.put_str(s); }
+std::string get_string(Reader& r) noexcept { return r.get_str(); }
+
+void put_namespace(Writer& w, const Namespace& n) noexcept {
+  w.put_enum(n.which());
+  if (n.which() == Namespace::Tag::Named)
+    w.put_str(n.as<Namespace::Tag::Named>());
+}
+
+Namespace get_namespace(Reader& r) noexcept {
+  switch (r.get_enum(Namespace::Tag::Named)) {
+    case Namespace::Tag::Global:
+      return Namespace::with<Namespace::Tag::Global>();
+    case Namespace::Tag::Anonymous:
+      return Namespace::with<Namespace::Tag::Anonymous>();
+    case Namespace::Tag::Named:
+      return Namespace::with<Namespace::Tag::Named>(r.get_str());
+  }
+  sus_unreachable();
+}
+
+void put_inherit_path_element(Writer& w, const InheritPathElement& e) noexcept {
+  w.put_enum(e.which());
+  switch (e) {
+    case InheritPathNamespace: w.put_str(e.as<InheritPathNamespace>()); break;
+    case InheritPathRecord: w.put_str(e.as<InheritPathRecord>()); break;
+    case InheritPathFunction: w.put_str(e.as<InheritPathFunction>()); break;
+  }
+}
+
+InheritPathElement get_inherit_path_element(Reader& r) noexcept {
+  switch (r.get_enum(InheritPathFunction)) {
+    case InheritPathNamespace:
+      return InheritPathElement::with<InheritPathNamespace>(r.get_str());
+    case InheritPathRecord:
+      return InheritPathElement::with<InheritPathRecord>(r.get_str());
+    case InheritPathFunction:
+      return InheritPathElement::with<InheritPathFunction>(r.get_str());
+  }
+  sus_unreachable();
+}
+
+void put_comment(Writer& w, const Comment& c) noexcept {
+  w.put_str(c.text);
+  w.put_str(c.begin_loc);
+  put_option(w, c.attrs.overload_set, put_string);
+  put_option(w, c.attrs.inherit,
+             [](Writer& w, const Vec<InheritPathElement>& inherit) {
+               put_vec(w, inherit, put_inherit_path_element);
+             });
+  w.put_bool(c.attrs.hidden);
+}
+
+Comment get_comment(Reader& r) noexcept {
+  std::string text = r.get_str();
+  std::string begin_loc = r.get_str();
+  // The clang::SourceLocation is only used while visiting the AST, and is not
+  // meaningful outside of it.
+  auto attrs = DocAttributes();
+  attrs.overload_set = get_option<std::string>(r, get_string);
+  attrs.inherit = get_option<Vec<InheritPathElement>>(r, [](Reader& r) {
+    return get_vec<InheritPathElement>(r, get_inherit_path_element);
+  });
+  attrs.hidden = r.get_bool();
+  return Comment(sus::move(text), sus::move(begin_loc), sus::move(attrs));
+}
+
+void put_source_link(Writer& w, const SourceLink& link) noexcept {
+  w.put_enum(link.quality);
+  w.put_str(link.file_path);
+  w.put_str(link.line);
+}
+
+SourceLink get_source_link(Reader& r) noexcept {
+  SourceLink::Quality quality =
+      r.get_enum(SourceLink::CommentAndDefinitionLocation);
+  std::string file_path = r.get_str();
+  std::string line = r.get_str();
+  return SourceLink{
+      .quality = quality,
+      .file_path = sus::move(file_path),
+      .line = sus::move(line),
+  };
+}
+
+/// The parts that every element holds, through `CommentElement`.
+struct CommentElementParts {
+  Vec<Namespace> namespace_path;
+  Comment comment;
+  std::string name;
+  u32 sort_key;
+  Option<SourceLink> source_link;
+};
+
+void put_comment_element(Writer& w, const CommentElement& e) noexcept {
+  put_vec(w, e.namespace_path, put_namespace);
+  put_comment(w, e.comment);
+  w.put_str(e.name);
+  w.put_u32(e.sort_key.primitive_value);
+  put_option(w, e.source_link, put_source_link);
+}
+
+CommentElementParts get_comment_element(Reader& r) noexcept {
+  Vec<Namespace> namespace_path = get_vec<Namespace>(r, get_namespace);
+  // Every element has the global namespace in its path.
+  if (namespace_path.is_empty()) {
+    r.failed = true;
+    namespace_path.push(Namespace::with<Namespace::Tag::Global>());
+  }
+  Comment comment = get_comment(r);
+  std::string name = r.get_str();
+  u32 sort_key = r.get_u32();
+  Option<SourceLink> source_link = get_option<SourceLink>(r, get_source_link);
+  return CommentElementParts{
+      .namespace_path = sus::move(namespace_path),
+      .comment = sus::move(comment),
+      .name = sus::move(name),
+      .sort_key = sort_key,
+      .source_link = sus::move(source_link),
+  };
+}
+
+void put_qualifier(Writer& w, const Qualifier& q) noexcept {
+  w.put_bool(q.is_const);
+  w.put_bool(q.is_volatile);
+  w.put_enum(q.nullness);
+}
+
+Qualifier get_qualifier(Reader& r) noexcept {
+  bool is_const = r.get_bool();
+  bool is_volatile = r.get_bool();
+  Nullness nullness = r.get_enum(Nullness::Unknown);
+  return Qualifier()
+      .set_const(is_const)
+      .set_volatile(is_volatile)
+      .set_nullness(nullness);
+}
+
+void put_type(Writer& w, const Type& t) noexcept;
+Type get_type(Reader& r) noexcept;
+
+void put_type_or_value(Writer& w, const TypeOrValue& t) noexcept {
+  w.put_enum(t.choice.which());
+  switch (t.choice) {
+    case TypeOrValueTag::Type:
+      put_type(w, t.choice.as<TypeOrValueTag::Type>());
+      break;
+    case TypeOrValueTag::Value:
+      w.put_str(t.choice.as<TypeOrValueTag::Value>());
+      break;
+  }
+}
+
+TypeOrValue get_type_or_value(Reader& r) noexcept {
+  switch (r.get_enum(TypeOrValueTag::Value)) {
+    case TypeOrValueTag::Type:
+      return TypeOrValue(
+          TypeOrValueChoice::with<TypeOrValueTag::Type>(get_type(r)));
+    case TypeOrValueTag::Value:
+      return TypeOrValue(
+          TypeOrValueChoice::with<TypeOrValueTag::Value>(r.get_str()));
+  }
+  sus_unreachable();
+}
+
+void put_boxed_type(Writer& w, const sus::Box<Type>& t) noexcept {
+  put_type(w, *t);
+}
+
+sus::Box<Type> get_boxed_type(Reader& r) noexcept {
+  return sus::Box<Type>(get_type(r));
+}
+
+void put_type(Writer& w, const Type& t) noexcept {
+  w.put_enum(t.category);
+  put_vec(w, t.namespace_path, put_string);
+  put_vec(w, t.record_path, put_string);
+  w.put_str(t.name);
+  put_vec(w, t.nested_names, put_type_or_value);
+  w.put_enum(t.refs);
+  put_qualifier(w, t.qualifier);
+  put_vec(w, t.pointers, put_qualifier);
+  put_vec(w, t.pointers_to_array, put_qualifier);
+  put_option(w, t.member_pointer_type, put_boxed_type);
+  put_vec(w, t.array_dims, put_string);
+  put_vec(w, t.template_params, put_type_or_value);
+  w.put_bool(t.is_pack);
+  put_option(w, t.fn_return_type, put_boxed_type);
+  put_vec(w, t.fn_param_types, put_type);
+}
+
+Type get_type(Reader& r) noexcept {
+  // Arguments are evaluated in an unspecified order, so each field is read
+  // into a variable first.
+  TypeCategory category = r.get_enum(TypeCategory::FunctionProto);
+  Vec<std::string> namespace_path = get_vec<std::string>(r, get_string);
+  Vec<std::string> record_path = get_vec<std::string>(r, get_string);
+  std::string name = r.get_str();
+  Vec<TypeOrValue> nested_names = get_vec<TypeOrValue>(r, get_type_or_value);
+  Refs refs = r.get_enum(Refs::RValueRef);
+  Qualifier qualifier = get_qualifier(r);
+  Vec<Qualifier> pointers = get_vec<Qualifier>(r, get_qualifier);
+  Vec<Qualifier> pointers_to_array = get_vec<Qualifier>(r, get_qualifier);
+  Option<sus::Box<Type>> member_pointer_type =
+      get_option<sus::Box<Type>>(r, get_boxed_type);
+  Vec<std::string> array_dims = get_vec<std::string>(r, get_string);
+  Vec<TypeOrValue> template_params =
+      get_vec<TypeOrValue>(r, get_type_or_value);
+  bool is_pack = r.get_bool();
+  Option<sus::Box<Type>> fn_return_type =
+      get_option<sus::Box<Type>>(r, get_boxed_type);
+  Vec<Type> fn_param_types = get_vec<Type>(r, get_type);
+  return Type{
+      .category = category,
+      .namespace_path = sus::move(namespace_path),
+      .record_path = sus::move(record_path),
+      .name = sus::move(name),
+      .nested_names = sus::move(nested_names),
+      .refs = refs,
+      .qualifier = qualifier,
+      .pointers = sus::move(pointers),
+      .pointers_to_array = sus::move(pointers_to_array),
+      .member_pointer_type = sus::move(member_pointer_type),
+      .array_dims = sus::move(array_dims),
+      .template_params = sus::move(template_params),
+      .is_pack = is_pack,
+      .fn_return_type = sus::move(fn_return_type),
+      .fn_param_types = sus::move(fn_param_types),
+  };
+}
+
+void put_linked_type(Writer& w, const LinkedType& t) noexcept {
+  put_type(w, t.type);
+}
+
+LinkedType get_linked_type(Reader& r) noexcept {
+  return LinkedType::unlinked(get_type(r));
+}
+
+void put_requires_constraint(Writer& w,
+                             const RequiresConstraint& c) noexcept {
+  w.put_enum(c.which());
+  switch (c) {
+    case RequiresConstraintTag::Concept: {
+      const RequiresConceptConstraint& con =
+          c.as<RequiresConstraintTag::Concept>();
+      w.put_str(con.concept_name);
+      put_vec(w, con.args, put_string);
+      break;
+    }
+    case RequiresConstraintTag::Text:
+      w.put_str(c.as<RequiresConstraintTag::Text>());
+      break;
+  }
+}
+
+RequiresConstraint get_requires_constraint(Reader& r) noexcept {
+  switch (r.get_enum(RequiresConstraintTag::Text)) {
+    case RequiresConstraintTag::Concept: {
+      std::string concept_name = r.get_str();
+      Vec<std::string> args = get_vec<std::string>(r, get_string);
+      return RequiresConstraint::with<RequiresConstraintTag::Concept>(
+          RequiresConceptConstraint{
+              .concept_name = sus::move(concept_name),
+              .args = sus::move(args),
+          });
+    }
+    case RequiresConstraintTag::Text:
+      return RequiresConstraint::with<RequiresConstraintTag::Text>(
+          r.get_str());
+  }
+  sus_unreachable();
+}
+
+void put_requires_constraints(Writer& w,
+                              const RequiresConstraints& c) noexcept {
+  put_vec(w, c.list, put_requires_constraint);
+}
+
+RequiresConstraints get_requires_constraints(Reader& r) noexcept {
+  return RequiresConstraints{
+      .list = get_vec<RequiresConstraint>(r, get_requires_constraint),
+  };
+}
+
+void put_method_specific(Writer& w, const MethodSpecific& m) noexcept {
+  w.put_bool(m.is_static);
+  w.put_bool(m.is_volatile);
+  w.put_bool(m.is_virtual);
+  w.put_bool(m.is_ctor);
+  w.put_bool(m.is_dtor);
+  w.put_bool(m.is_conversion);
+  w.put_bool(m.is_explicit);
+  w.put_enum(m.qualifier);
+}
+
+MethodSpecific get_method_specific(Reader& r) noexcept {
+  auto m = MethodSpecific();
+  m.is_static = r.get_bool();
+  m.is_volatile = r.get_bool();
+  m.is_virtual = r.get_bool();
+  m.is_ctor = r.get_bool();
+  m.is_dtor = r.get_bool();
+  m.is_conversion = r.get_bool();
+  m.is_explicit = r.get_bool();
+  m.qualifier = r.get_enum(MethodQualifier::MutableRValue);
+  return m;
+}
+
+void put_function_parameter(Writer& w, const FunctionParameter& p) noexcept {
+  put_linked_type(w, p.type);
+  w.put_str(p.parameter_name);
+  put_option(w, p.default_value, put_string);
+}
+
+FunctionParameter get_function_parameter(Reader& r) noexcept {
+  LinkedType type = get_linked_type(r);
+  std::string parameter_name = r.get_str();
+  Option<std::string> default_value = get_option<std::string>(r, get_string);
+  return FunctionParameter{
+      .type = sus::move(type),
+      .parameter_name = sus::move(parameter_name),
+      .default_value = sus::move(default_value),
+  };
+}
+
+void put_function_overload(Writer& w, const FunctionOverload& o) noexcept {
+  put_vec(w, o.parameters, put_function_parameter);
+  put_option(w, o.method, put_method_specific);
+  put_linked_type(w, o.return_type);
+  put_option(w, o.constraints, put_requires_constraints);
+  put_vec(w, o.template_params, put_string);
+  w.put_bool(o.is_deleted);
+  w.put_str(o.signature_key);
+}
+
+FunctionOverload get_function_overload(Reader& r) noexcept {
+  Vec<FunctionParameter> parameters =
+      get_vec<FunctionParameter>(r, get_function_parameter);
+  Option<MethodSpecific> method =
+      get_option<MethodSpecific>(r, get_method_specific);
+  LinkedType return_type = get_linked_type(r);
+  Option<RequiresConstraints> constraints =
+      get_option<RequiresConstraints>(r, get_requires_constraints);
+  Vec<std::string> template_params = get_vec<std::string>(r, get_string);
+  bool is_deleted = r.get_bool();
+  std::string signature_key = r.get_str();
+  return FunctionOverload{
+      .parameters = sus::move(parameters),
+      .method = sus::move(method),
+      .return_type = sus::move(return_type),
+      .constraints = sus::move(constraints),
+      .template_params = sus::move(template_params),
+      .is_deleted = is_deleted,
+      .signature_key = sus::move(signature_key),
+  };
+}
+
+// The `Linked*` types are written as the path and name used to find them in
+// the `Database`. The `ref_or_name` is filled in by `relink()`.
+template <class Linked>
+void put_linked_name(Writer& w, const Linked& l) noexcept {
+  put_vec(w, l.namespace_path, put_namespace);
+  w.put_str(l.name);
+}
+
+template <class Linked, class RefOrName>
+Linked get_linked_name(Reader& r) noexcept {
+  Vec<Namespace> namespace_path = get_vec<Namespace>(r, get_namespace);
+  std::string name = r.get_str();
+  return Linked{
+      .ref_or_name = RefOrName::template with<RefOrName::Tag::Name>(name),
+      .namespace_path = sus::move(namespace_path),
+      .name = sus::move(name),
+  };
+}
+
+void put_alias_target(Writer& w, const AliasTarget& t) noexcept {
+  w.put_enum(t.which());
+  switch (t) {
+    case AliasTarget::Tag::AliasOfType:
+      put_linked_type(w, t.as<AliasTarget::Tag::AliasOfType>());
+      break;
+    case AliasTarget::Tag::AliasOfConcept:
+      put_linked_name(w, t.as<AliasTarget::Tag::AliasOfConcept>());
+      break;
+    case AliasTarget::Tag::AliasOfMethod: {
+      const auto& [type, method_name] =
+          t.as<AliasTarget::Tag::AliasOfMethod>();
+      put_linked_type(w, type);
+      w.put_str(method_name);
+      break;
+    }
+    case AliasTarget::Tag::AliasOfFunction:
+      put_linked_name(w, t.as<AliasTarget::Tag::AliasOfFunction>());
+      break;
+    case AliasTarget::Tag::AliasOfEnumConstant: {
+      const auto& [type, constant_name] =
+          t.as<AliasTarget::Tag::AliasOfEnumConstant>();
+      put_linked_type(w, type);
+      w.put_str(constant_name);
+      break;
+    }
+    case AliasTarget::Tag::AliasOfVariable:
+      put_linked_name(w, t.as<AliasTarget::Tag::AliasOfVariable>());
+      break;
+  }
+}
+
+AliasTarget get_alias_target(Reader& r) noexcept {
+  switch (r.get_enum(AliasTarget::Tag::AliasOfVariable)) {
+    case AliasTarget::Tag::AliasOfType:
+      return AliasTarget::with<AliasTarget::Tag::AliasOfType>(
+          get_linked_type(r));
+    case AliasTarget::Tag::AliasOfConcept:
+      return AliasTarget::with<AliasTarget::Tag::AliasOfConcept>(
+          get_linked_name<LinkedConcept, ConceptRefOrName>(r));
+    case AliasTarget::Tag::AliasOfMethod: {
+      LinkedType type = get_linked_type(r);
+      std::string method_name = r.get_str();
+      return AliasTarget::with<AliasTarget::Tag::AliasOfMethod>(
+          sus::move(type), sus::move(method_name));
+    }
+    case AliasTarget::Tag::AliasOfFunction:
+      return AliasTarget::with<AliasTarget::Tag::AliasOfFunction>(
+          get_linked_name<LinkedFunction, FunctionRefOrName>(r));
+    case AliasTarget::Tag::AliasOfEnumConstant: {
+      LinkedType type = get_linked_type(r);
+      std::string constant_name = r.get_str();
+      return AliasTarget::with<AliasTarget::Tag::AliasOfEnumConstant>(
+          sus::move(type), sus::move(constant_name));
+    }
+    case AliasTarget::Tag::AliasOfVariable:
+      return AliasTarget::with<AliasTarget::Tag::AliasOfVariable>(
+          get_linked_name<LinkedVariable, VariableRefOrName>(r));
+  }
+  sus_unreachable();
+}
+
+void put_concept(Writer& w, const ConceptElement& e) noexcept {
+  put_comment_element(w, e);
+  put_vec(w, e.template_params, put_string);
+  put_requires_constraints(w, e.constraints);
+}
+
+ConceptElement get_concept(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  Vec<std::string> template_params = get_vec<std::string>(r, get_string);
+  RequiresConstraints constraints = get_requires_constraints(r);
+  auto e = ConceptElement(sus::move(parts.namespace_path),
+                          sus::move(parts.comment), sus::move(parts.name),
+                          sus::move(template_params), sus::move(constraints),
+                          parts.sort_key);
+  e.source_link = sus::move(parts.source_link);
+  return e;
+}
+
+void put_alias(Writer& w, const AliasElement& e) noexcept {
+  put_comment_element(w, e);
+  put_vec(w, e.record_path, put_string);
+  w.put_enum(e.alias_style);
+  put_option(w, e.constraints, put_requires_constraints);
+  put_alias_target(w, e.target);
+}
+
+AliasElement get_alias(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  Vec<std::string> record_path = get_vec<std::string>(r, get_string);
+  AliasStyle alias_style = r.get_enum(AliasStyle::NewType);
+  Option<RequiresConstraints> constraints =
+      get_option<RequiresConstraints>(r, get_requires_constraints);
+  AliasTarget target = get_alias_target(r);
+  auto e = AliasElement(sus::move(parts.namespace_path),
+                        sus::move(parts.comment), sus::move(parts.name),
+                        parts.sort_key, sus::move(record_path), alias_style,
+                        sus::move(constraints), sus::move(target));
+  e.source_link = sus::move(parts.source_link);
+  return e;
+}
+
+void put_function(Writer& w, const FunctionElement& e) noexcept {
+  put_comment_element(w, e);
+  w.put_str(e.signature_name);
+  w.put_bool(e.is_operator);
+  put_vec(w, e.overloads, put_function_overload);
+  put_option(w, e.overload_set, put_string);
+  put_vec(w, e.record_path, put_string);
+}
+
+FunctionElement get_function(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  std::string signature_name = r.get_str();
+  bool is_operator = r.get_bool();
+  Vec<FunctionOverload> overloads =
+      get_vec<FunctionOverload>(r, get_function_overload);
+  Option<std::string> overload_set = get_option<std::string>(r, get_string);
+  Vec<std::string> record_path = get_vec<std::string>(r, get_string);
+
+  // A FunctionElement is constructed from its first overload.
+  if (overloads.is_empty()) {
+    r.failed = true;
+    overloads.push(FunctionOverload{
+        .parameters = Vec<FunctionParameter>(),
+        .method = sus::none(),
+        .return_type = LinkedType::unlinked(Type()),
+        .constraints = sus::none(),
+        .template_params = Vec<std::string>(),
+        .is_deleted = false,
+        .signature_key = std::string(),
+    });
+  }
+  auto it = sus::move(overloads).into_iter();
+  FunctionOverload first = it.next().unwrap();
+  auto e = FunctionElement(
+      sus::move(parts.namespace_path), sus::move(parts.comment),
+      sus::move(parts.name), sus::move(signature_name),
+      sus::move(first.signature_key), is_operator,
+      sus::move(first.return_type), sus::move(first.constraints),
+      sus::move(first.template_params), first.is_deleted,
+      sus::move(first.parameters), sus::move(overload_set),
+      sus::move(record_path), parts.sort_key);
+  e.overloads[0u].method = sus::move(first.method);
+  for (FunctionOverload overload : sus::move(it)) {
+    e.overloads.push(sus::move(overload));
+  }
+  e.source_link = sus::move(parts.source_link);
+  return e;
+}
+
+void put_field(Writer& w, const FieldElement& e) noexcept {
+  put_comment_element(w, e);
+  put_vec(w, e.record_path, put_string);
+  put_linked_type(w, e.type);
+  w.put_enum(e.is_static);
+  put_vec(w, e.template_params, put_string);
+  put_option(w, e.constraints, put_requires_constraints);
+}
+
+FieldElement get_field(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  Vec<std::string> record_path = get_vec<std::string>(r, get_string);
+  LinkedType type = get_linked_type(r);
+  FieldElement::StaticType is_static = r.get_enum(FieldElement::NonStatic);
+  Vec<std::string> template_params = get_vec<std::string>(r, get_string);
+  Option<RequiresConstraints> constraints =
+      get_option<RequiresConstraints>(r, get_requires_constraints);
+  auto e = FieldElement(sus::move(parts.namespace_path),
+                        sus::move(parts.comment), sus::move(parts.name),
+                        sus::move(type), sus::move(record_path), is_static,
+                        sus::move(template_params), sus::move(constraints),
+                        parts.sort_key);
+  e.source_link = sus::move(parts.source_link);
+  return e;
+}
+
+void put_macro(Writer& w, const MacroElement& e) noexcept {
+  put_comment_element(w, e);
+  put_option(w, e.parameters, [](Writer& w, const Vec<std::string>& params) {
+    put_vec(w, params, put_string);
+  });
+}
+
+MacroElement get_macro(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  Option<Vec<std::string>> parameters =
+      get_option<Vec<std::string>>(r, [](Reader& r) {
+        return get_vec<std::string>(r, get_string);
+      });
+  // Macros are always in the global namespace, so the `namespace_path` is not
+  // used.
+  auto e = MacroElement(sus::move(parts.comment), sus::move(parts.name),
+                        sus::move(parameters), parts.sort_key);
+  e.source_link = sus::move(parts.source_link);
+  return e;
+}
+
+// The keys which are only a name.
+template <class Id>
+void put_name_id(Writer& w, const Id& id) noexcept {
+  w.put_str(id.name);
+}
+
+template <class Id>
+Id get_name_id(Reader& r) noexcept {
+  return Id(r.get_str());
+}
+
+void put_function_id(Writer& w, const FunctionId& id) noexcept {
+  w.put_str(id.name);
+  w.put_bool(id.is_static);
+  w.put_str(id.overload_set);
+}
+
+FunctionId get_function_id(Reader& r) noexcept {
+  std::string name = r.get_str();
+  bool is_static = r.get_bool();
+  std::string overload_set = r.get_str();
+  return FunctionId(sus::move(name), is_static, sus::move(overload_set));
+}
+
+void put_unique_symbol(Writer& w, const UniqueSymbol& u) noexcept {
+  for (uint8_t b : u.bytes) w.put_byte(b);
+}
+
+UniqueSymbol get_unique_symbol(Reader& r) noexcept {
+  auto u = UniqueSymbol();
+  for (uint8_t& b : u.bytes) b = r.get_byte();
+  return u;
+}
+
+/// Writes each key and element of `map`.
+template <class Map, class PutKey, class PutElement>
+void put_map(Writer& w, const Map& map, PutKey put_key,
+             PutElement put_element) noexcept {
+  w.put_len(usize::from(map.size()));
+  for (const auto& [key, element] : map) {
+    put_key(w, key);
+    put_element(w, element);
+  }
+}
+
+/// Reads the keys and elements of a map written by `put_map()` into `map`.
+template <class Map, class GetKey, class GetElement>
+void get_map(Reader& r, Map& map, GetKey get_key,
+             GetElement get_element) noexcept {
+  uint32_t len = r.get_len();
+  map.reserve(len);
+  for (uint32_t i = 0u; i < len && !r.failed; ++i) {
+    auto key = get_key(r);
+    auto element = get_element(r);
+    map.emplace(sus::move(key), sus::move(element));
+  }
+}
+
+void put_record(Writer& w, const RecordElement& e) noexcept {
+  put_comment_element(w, e);
+  put_vec(w, e.record_path, put_string);
+  w.put_enum(e.record_type);
+  put_option(w, e.constraints, put_requires_constraints);
+  put_vec(w, e.template_params, put_string);
+  w.put_bool(e.final);
+
+  put_map(w, e.records, put_name_id<RecordId>, put_record);
+  put_map(w, e.fields, put_unique_symbol, put_field);
+  put_map(w, e.deductions, put_function_id, put_function);
+  put_map(w, e.ctors, put_function_id, put_function);
+  put_map(w, e.dtors, put_function_id, put_function);
+  put_map(w, e.conversions, put_function_id, put_function);
+  put_map(w, e.methods, put_function_id, put_function);
+  put_map(w, e.aliases, put_name_id<AliasId>, put_alias);
+}
+
+RecordElement get_record(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  Vec<std::string> record_path = get_vec<std::string>(r, get_string);
+  RecordType record_type = r.get_enum(RecordType::Union);
+  Option<RequiresConstraints> constraints =
+      get_option<RequiresConstraints>(r, get_requires_constraints);
+  Vec<std::string> template_params = get_vec<std::string>(r, get_string);
+  bool final = r.get_bool();
+  auto e = RecordElement(sus::move(parts.namespace_path),
+                         sus::move(parts.comment), sus::move(parts.name),
+                         sus::move(record_path), record_type,
+                         sus::move(constraints), sus::move(template_params),
+                         final, parts.sort_key);
+  e.source_link = sus::move(parts.source_link);
+
+  get_map(r, e.records, get_name_id<RecordId>, get_record);
+  get_map(r, e.fields, get_unique_symbol, get_field);
+  get_map(r, e.deductions, get_function_id, get_function);
+  get_map(r, e.ctors, get_function_id, get_function);
+  get_map(r, e.dtors, get_function_id, get_function);
+  get_map(r, e.conversions, get_function_id, get_function);
+  get_map(r, e.methods, get_function_id, get_function);
+  get_map(r, e.aliases, get_name_id<AliasId>, get_alias);
+  return e;
+}
+
+void put_namespace_element(Writer& w, const NamespaceElement& e) noexcept {
+  put_comment_element(w, e);
+  put_map(w, e.concepts, put_name_id<ConceptId>, put_concept);
+  put_map(w, e.namespaces, put_name_id<NamespaceId>, put_namespace_element);
+  put_map(w, e.records, put_name_id<RecordId>, put_record);
+  put_map(w, e.functions, put_function_id, put_function);
+  put_map(w, e.aliases, put_name_id<AliasId>, put_alias);
+  put_map(w, e.variables, put_unique_symbol, put_field);
+  put_map(w, e.macros, put_name_id<MacroId>, put_macro);
+}
+
+NamespaceElement get_namespace_element(Reader& r) noexcept {
+  CommentElementParts parts = get_comment_element(r);
+  auto e = NamespaceElement(sus::move(parts.namespace_path),
+                            sus::move(parts.comment), sus::move(parts.name),
+                            parts.sort_key);
+  e.source_link = sus::move(parts.source_link);
+  get_map(r, e.concepts, get_name_id<ConceptId>, get_concept);
+  get_map(r, e.namespaces, get_name_id<NamespaceId>, get_namespace_element);
+  get_map(r, e.records, get_name_id<RecordId>, get_record);
+  get_map(r, e.functions, get_function_id, get_function);
+  get_map(r, e.aliases, get_name_id<AliasId>, get_alias);
+  get_map(r, e.variables, get_unique_symbol, get_field);
+  get_map(r, e.macros, get_name_id<MacroId>, get_macro);
+  return e;
+}
+
+}  // namespace
+
+std::string save_database(const Database& db) noexcept {
+  auto w = Writer();
+  put_namespace_element(w, db.global);
+  return sus::move(w).finish();
+}
+
+sus::Result<Database, std::string> load_database(
+    std::string_view bytes) noexcept {
+  if (bytes.size() < kHeaderSize || !bytes.starts_with(kMagic))
+    return sus::err(std::string("not a subdoc database"));
+  uint32_t version = read_u32(bytes, kMagic.size());
+  if (version != kVersion) {
+    return sus::err(std::string("unsupported subdoc database version ") +
+                    std::to_string(version));
+  }
+  uint32_t string_count = read_u32(bytes, kMagic.size() + 4u);
+  uint32_t string_data_size = read_u32(bytes, kMagic.size() + 8u);
+  uint32_t body_size = read_u32(bytes, kMagic.size() + 12u);
+  size_t offsets_size = (size_t{string_count} + 1u) * 4u;
+  if (bytes.size() - kHeaderSize !=
+      offsets_size + size_t{string_data_size} + size_t{body_size})
+    return sus::err(std::string("database is truncated or invalid"));
+
+  auto r = Reader();
+  r.string_count = string_count;
+  r.string_offsets = bytes.substr(kHeaderSize, offsets_size);
+  r.string_data =
+      bytes.substr(kHeaderSize + offsets_size, size_t{string_data_size});
+  r.in = bytes.substr(kHeaderSize + offsets_size + size_t{string_data_size});
+  NamespaceElement global = get_namespace_element(r);
+  if (r.failed)
+    return sus::err(std::string("database is truncated or invalid"));
+  if (!r.in.empty())
+    return sus::err(std::string("database has unexpected trailing bytes"));
+
+  auto db = Database(Comment());
+  db.global = sus::move(global);
+  return sus::ok(sus::move(db));
+}
+
+}  // namespace subdoc
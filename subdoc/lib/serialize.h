@@ -0,0 +1,45 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "subdoc/lib/database.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+
+namespace subdoc {
+
+/// Writes `db` out as bytes that `load_database()` can read back.
+///
+/// The bytes begin with a version, and hold each distinct string once in a
+/// table. Loading copies each string out of the table into the `Database`,
+/// which owns its strings, so the bytes are not needed after loading.
+///
+/// The references from types and aliases to other elements are not written,
+/// only what is needed to find them again.
+std::string save_database(const Database& db) noexcept;
+
+/// Reads a `Database` from bytes written by `save_database()`, or returns an
+/// error if they are not valid or were written in a different version of the
+/// format.
+///
+/// The references between elements are not found, so `relink_database()` must
+/// be run on the `Database`, or on one it is merged into.
+sus::Result<Database, std::string> load_database(
+    std::string_view bytes) noexcept;
+
+}  // namespace subdoc
@@ -33,6 +33,7 @@ struct UniqueSymbol {
   }
 
   bool operator==(const UniqueSymbol& other) const = default;
+  auto operator<=>(const UniqueSymbol& other) const = default;
 };
 
 inline UniqueSymbol unique_from_decl(const clang::Decl* decl) noexcept {
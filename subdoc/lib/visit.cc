@@ -14,6 +14,7 @@
 
 #include "subdoc/lib/visit.h"
 
+#include <mutex>
 #include <regex>
 
 #include "subdoc/lib/database.h"
@@ -1642,50 +1643,87 @@ class AstConsumer : public clang::ASTConsumer {
   AstConsumer(VisitCx& cx, Database& docs_db, clang::Preprocessor& preprocessor)
       : cx_(cx), docs_db_(docs_db), preprocessor_(preprocessor) {}
 
+  void Initialize(clang::ASTContext& ast_cx) noexcept final {
+    ast_cx_ = &ast_cx;
+  }
+
   bool HandleTopLevelDecl(clang::DeclGroupRef group_ref) noexcept final {
+    if (!visit_precompiled_decls()) return false;
     for (clang::Decl* decl : group_ref) {
-      clang::SourceManager& sm = decl->getASTContext().getSourceManager();
+      if (!visit_top_level_decl(decl)) return false;
+    }
+    return true;
+  }
 
-      if (!decl->getLocation().isMacroID()) {
-        // Don't visit the same file repeatedly.
-        auto v = VisitedLocation(decl->getLocation().printToString(sm));
-        if (cx_.visited_locations.contains(v)) {
-          continue;
-        }
-        cx_.visited_locations.emplace(sus::move(v));
-      }
+  void HandleTranslationUnit(clang::ASTContext& ast_cx) noexcept final {
+    // A translation unit may have no decls outside of its precompiled header.
+    visit_precompiled_decls();
+    if (cx_.options.on_tu_complete.is_some()) {
+      ::sus::fn::call(*cx_.options.on_tu_complete, ast_cx, preprocessor_);
+    }
+  }
 
-      if (!cx_.should_include_decl_based_on_file(decl)) {
-        continue;
+ private:
+  bool visit_top_level_decl(clang::Decl* decl) noexcept {
+    clang::SourceManager& sm = decl->getASTContext().getSourceManager();
+
+    if (!decl->getLocation().isMacroID()) {
+      // Don't visit the same file repeatedly.
+      auto v = VisitedLocation(decl->getLocation().printToString(sm));
+      if (cx_.visited_locations.contains(v)) {
+        return true;
       }
+      cx_.visited_locations.emplace(sus::move(v));
+    }
 
-      {
-        auto visitor =
-            Visitor(cx_, docs_db_, preprocessor_,
-                    DiagnosticIds::with_context(decl->getASTContext()));
-        if (!visitor.TraverseDecl(decl)) {
-          return false;
-        }
-        if (!visitor.VisitMacros(decl)) {
-          return false;
-        }
+    if (!cx_.should_include_decl_based_on_file(decl)) {
+      return true;
+    }
+
+    {
+      auto visitor =
+          Visitor(cx_, docs_db_, preprocessor_,
+                  DiagnosticIds::with_context(decl->getASTContext()));
+      if (!visitor.TraverseDecl(decl)) {
+        return false;
       }
-      if (decl->getASTContext().getDiagnostics().getNumErrors() > 0u)
+      if (!visitor.VisitMacros(decl)) {
         return false;
+      }
     }
+    if (decl->getASTContext().getDiagnostics().getNumErrors() > 0u)
+      return false;
     return true;
   }
 
-  void HandleTranslationUnit(clang::ASTContext& ast_cx) noexcept final {
-    if (cx_.options.on_tu_complete.is_some()) {
-      ::sus::fn::call(*cx_.options.on_tu_complete, ast_cx, preprocessor_);
+  /// The decls loaded from a precompiled header are never given to
+  /// `HandleTopLevelDecl()`, so they are visited from the translation unit
+  /// before the first decl that is. The precompiled header holds the
+  /// translation unit's first includes, so this keeps the order of a parse
+  /// without it.
+  bool visit_precompiled_decls() noexcept {
+    if (visited_precompiled_decls_) return true;
+    visited_precompiled_decls_ = true;
+    if (ast_cx_ == nullptr || ast_cx_->getExternalSource() == nullptr)
+      return true;
+
+    // Collect them first, as visiting may load more decls into the
+    // translation unit.
+    auto decls = Vec<clang::Decl*>();
+    for (clang::Decl* decl : ast_cx_->getTranslationUnitDecl()->decls()) {
+      if (decl->isFromASTFile()) decls.push(decl);
     }
+    for (clang::Decl* decl : decls) {
+      if (!visit_top_level_decl(decl)) return false;
+    }
+    return true;
   }
 
- private:
   VisitCx& cx_;
   Database& docs_db_;
   clang::Preprocessor& preprocessor_;
+  clang::ASTContext* ast_cx_ = nullptr;
+  bool visited_precompiled_decls_ = false;
 };
 
 std::unique_ptr<clang::FrontendAction> VisitorFactory::create() noexcept {
@@ -1696,8 +1734,14 @@ std::unique_ptr<clang::ASTConsumer> VisitorAction::CreateASTConsumer(
     clang::CompilerInstance& compiler, llvm::StringRef file) noexcept {
   if (cx.options.show_progress) {
     if (std::string_view(file) != line_stats.cur_file_name) {
-      fmt::println(stderr, "[{}/{}] {}", line_stats.cur_file,
-                   line_stats.num_files, std::string_view(file));
+      // Translation units can be visited on many threads at once, so the
+      // lines are written one at a time to keep them from interleaving.
+      static std::mutex progress_mutex;
+      {
+        auto lock = std::scoped_lock(progress_mutex);
+        fmt::println(stderr, "[{}/{}] {}", line_stats.cur_file,
+                     line_stats.num_files, std::string_view(file));
+      }
       line_stats.cur_file += 1u;
       line_stats.cur_file_name = std::string(file);
     }
@@ -1705,6 +1749,25 @@ std::unique_ptr<clang::ASTConsumer> VisitorAction::CreateASTConsumer(
   return std::make_unique<AstConsumer>(cx, docs_db, compiler.getPreprocessor());
 }
 
+bool VisitorAction::BeginInvocation(
+    clang::CompilerInstance& compiler) noexcept {
+  if (cx.options.skip_function_bodies)
+    compiler.getFrontendOpts().SkipFunctionBodies = true;
+  return true;
+}
+
+void VisitorAction::ExecuteAction() noexcept {
+  auto start = std::chrono::steady_clock::now();
+  clang::ASTFrontendAction::ExecuteAction();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  bool with_pch =
+      !getCompilerInstance().getPreprocessorOpts().ImplicitPCHInclude.empty();
+  ParseTimes& times = with_pch ? line_stats.warm : line_stats.cold;
+  times.count += 1u;
+  times.total += elapsed;
+}
+
 bool VisitCx::should_include_decl_based_on_file(clang::Decl* decl) noexcept {
   clang::SourceManager& sm = decl->getASTContext().getSourceManager();
 
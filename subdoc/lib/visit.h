@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <unordered_set>
 
@@ -62,10 +63,25 @@ struct VisitCx {
   std::map<std::string, VisitedPath, std::less<>> visited_paths_;
 };
 
+/// The time spent parsing some number of translation units.
+struct ParseTimes {
+  usize count;
+  std::chrono::duration<double> total = std::chrono::duration<double>(0.0);
+
+  void add(const ParseTimes& other) noexcept {
+    count += other.count;
+    total += other.total;
+  }
+};
+
 struct LineStats {
   usize cur_file = 1_usize;
   usize num_files;
   std::string cur_file_name;
+  /// Parse times of translation units that did not load a precompiled header.
+  ParseTimes cold;
+  /// Parse times of translation units that loaded a precompiled header.
+  ParseTimes warm;
 };
 
 struct VisitorFactory : public clang::tooling::FrontendActionFactory {
@@ -91,6 +107,13 @@ struct VisitorAction : public clang::ASTFrontendAction {
   std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
       clang::CompilerInstance& compiler, llvm::StringRef file) noexcept final;
 
+  /// Sets up the parser as the `RunOptions` request.
+  bool BeginInvocation(clang::CompilerInstance& compiler) noexcept final;
+
+  /// Parses the translation unit, and records how long it took in the
+  /// `line_stats`.
+  void ExecuteAction() noexcept final;
+
   VisitCx& cx;
   Database& docs_db;
   LineStats& line_stats;
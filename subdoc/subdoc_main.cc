@@ -143,6 +143,45 @@ int main(int argc, const char** argv) {
       llvm::cl::init(false),  //
       llvm::cl::cat(option_category));
 
+  llvm::cl::opt<bool> option_parse_function_bodies(
+      "parse-function-bodies",
+      llvm::cl::desc("Parse the bodies of all functions. By default, they are "
+                     "skipped unless needed to compile the declarations."),
+      llvm::cl::init(false),  //
+      llvm::cl::cat(option_category));
+
+  llvm::cl::opt<bool> option_covering_files_only(
+      "covering-files-only",
+      llvm::cl::desc("Run only the preprocessor over each source file first, "
+                     "then parse just enough of them to include every file "
+                     "matched by --include-file-pattern."),
+      llvm::cl::init(false),  //
+      llvm::cl::cat(option_category));
+
+  llvm::cl::opt<bool> option_precompile_headers(
+      "precompile-headers",
+      llvm::cl::desc("Precompile the includes shared by source files with the "
+                     "same compile command, instead of parsing them for each "
+                     "source file."),
+      llvm::cl::init(false),  //
+      llvm::cl::cat(option_category));
+
+  llvm::cl::opt<unsigned> option_jobs(
+      "jobs",
+      llvm::cl::desc("The number of source files to parse, and of pages to "
+                     "write, at once. The output is the same for any number "
+                     "of jobs."),
+      llvm::cl::init(1u),  //
+      llvm::cl::cat(option_category));
+
+  llvm::cl::opt<std::string> option_cache_dir(
+      "cache-dir",
+      llvm::cl::desc("A directory to keep what is collected from each source "
+                     "file in. Later runs with the same directory parse only "
+                     "the source files where it or anything it includes has "
+                     "changed."),
+      llvm::cl::cat(option_category));
+
   llvm::Expected<clang::tooling::CommonOptionsParser> options_parser =
       clang::tooling::CommonOptionsParser::create(argc, argv, option_category,
                                                   llvm::cl::ZeroOrMore);
@@ -250,6 +289,20 @@ int main(int argc, const char** argv) {
     run_options.source_line_prefix =
         sus::some(option_source_line_prefix.getValue());
   }
+  run_options.skip_function_bodies = !option_parse_function_bodies.getValue();
+  run_options.covering_files_only = option_covering_files_only.getValue();
+  run_options.precompile_headers = option_precompile_headers.getValue();
+  run_options.jobs = u32::from(option_jobs.getValue());
+  if (option_cache_dir.getNumOccurrences() > 0) {
+    run_options.cache_dir = sus::some(option_cache_dir.getValue());
+    // The path patterns are compiled into a regex, which can not be compared,
+    // so the patterns themselves are part of the key.
+    std::string key;
+    for (const std::string& p : option_include_paths) key += p + "\n";
+    key += "\n";
+    for (const std::string& p : option_exclude_paths) key += p + "\n";
+    run_options.cache_options_key = sus::move(key);
+  }
 
   auto fs = llvm::vfs::getRealFileSystem();
   auto result = subdoc::run_files(comp_db, sus::move(run_against_files),
@@ -267,6 +320,7 @@ int main(int argc, const char** argv) {
       .favicons = sus::empty,
       .copy_files = sus::empty,
       .ignore_bad_code_links = option_ignore_bad_code_links.getValue(),
+      .jobs = u32::from(option_jobs.getValue()),
   };
   if (option_project_name.getNumOccurrences() > 0) {
     gen_options.project_name = option_project_name.getValue();
@@ -299,7 +353,7 @@ int main(int argc, const char** argv) {
   }
 
   fmt::println("Generating into '{}'", gen_options.output_root.string());
-  sus::result::Result<void, sus::Box<sus::error::DynError>> r =
+  sus::result::Result<subdoc::gen::GenerateStats, sus::error::SmallError> r =
       subdoc::gen::generate(docs_db, sus::move(gen_options));
   if (r.is_err()) {
     fmt::println(stderr, "ERROR: {}", r.as_err());
@@ -311,5 +365,8 @@ int main(int argc, const char** argv) {
     }
     return 1;
   }
+  const subdoc::gen::GenerateStats& stats = r.as_value();
+  fmt::println("Wrote {} files, {} unchanged, deleted {} stale files",
+               stats.written, stats.unchanged, stats.deleted);
   return 0;
 }
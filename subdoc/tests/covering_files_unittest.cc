@@ -0,0 +1,49 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/covering_files.h"
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace {
+
+using Includes = Option<Vec<std::string>>;
+
+TEST(CoveringFiles, SameHeaders) {
+  auto includes = Vec<Includes>(
+      Includes(Vec<std::string>("a.h", "b.h")),
+      Includes(Vec<std::string>("b.h", "a.h")),
+      Includes(Vec<std::string>("a.h")));
+  EXPECT_EQ(subdoc::select_covering_files(includes), Vec<usize>(0u));
+}
+
+TEST(CoveringFiles, MostUncoveredFirst) {
+  auto includes = Vec<Includes>(
+      Includes(Vec<std::string>("a.h", "b.h")),
+      Includes(Vec<std::string>("c.h", "d.h", "e.h")),
+      Includes(Vec<std::string>("a.h", "b.h", "c.h", "d.h")),
+      Includes(Vec<std::string>("d.h", "d.h")));
+  // The 3rd covers the most, then the 2nd covers `e.h`. The 1st and 4th add
+  // nothing.
+  EXPECT_EQ(subdoc::select_covering_files(includes), Vec<usize>(1u, 2u));
+}
+
+TEST(CoveringFiles, UnknownIncludesAreChosen) {
+  auto includes = Vec<Includes>(Includes(Vec<std::string>("a.h")), Includes(),
+                                Includes(Vec<std::string>("a.h")),
+                                Includes(Vec<std::string>()));
+  EXPECT_EQ(subdoc::select_covering_files(includes), Vec<usize>(0u, 1u));
+}
+
+}  // namespace
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "subdoc/lib/serialize.h"
 #include "subdoc/tests/subdoc_test.h"
 
 TEST_F(SubDocTest, Function) {
@@ -328,3 +329,70 @@ TEST_F(SubDocTest, FunctionRequiresOverload) {
   // is specified).
   EXPECT_TRUE(has_function_comment(db, "9:5", "<p>Comment headline two</p>"));
 }
+
+TEST_F(SubDocTest, FunctionParamDefinedLater) {
+  auto result = run_code(R"(
+    struct S;
+    /// Comment headline
+    void f(S);
+    struct S {};
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(has_function_comment(db, "3:5", "<p>Comment headline</p>"));
+
+  // The parameter type is linked to `S` even though `S` was defined after the
+  // function.
+  ASSERT_EQ(db.global.functions.size(), 1u);
+  const subdoc::FunctionElement& e = db.global.functions.begin()->second;
+  ASSERT_EQ(e.overloads.len(), 1u);
+  ASSERT_EQ(e.overloads[0u].parameters.len(), 1u);
+  EXPECT_TRUE(e.overloads[0u]
+                  .parameters[0u]
+                  .type.type_element_refs.iter()
+                  .any([](const Option<subdoc::TypeRef>& ref) {
+                    return ref.is_some();
+                  }));
+}
+
+TEST_F(SubDocTest, FunctionSkipBodies) {
+  constexpr std::string_view kCode = R"(
+    /// Comment headline constexpr
+    constexpr int c() { return 3; }
+    /// Comment headline auto
+    auto a() { return c(); }
+    /// Comment headline array
+    void p(int (&)[c()]) {}
+
+    // These need the bodies of `c()` and `a()`, so Clang can not skip them.
+    static_assert(c() == 3);
+    static_assert(sizeof(a()) == sizeof(int));
+  )";
+  // Function bodies are skipped by default.
+  auto result = run_code(std::string(kCode));
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(
+      has_function_comment(db, "2:5", "<p>Comment headline constexpr</p>"));
+  EXPECT_TRUE(has_function_comment(db, "4:5", "<p>Comment headline auto</p>"));
+  EXPECT_TRUE(has_function_comment(db, "6:5", "<p>Comment headline array</p>"));
+
+  // The return type of `a()` is deduced from its body.
+  bool found_a = false;
+  for (const auto& [id, e] : db.global.functions) {
+    if (e.name != "a") continue;
+    found_a = true;
+    ASSERT_EQ(e.overloads.len(), 1u);
+    EXPECT_EQ(e.overloads[0u].return_type.type.name, "int");
+  }
+  EXPECT_TRUE(found_a);
+
+  // The same documentation is collected as when every body is parsed.
+  auto parsed = run_code_with_options(subdoc::RunOptions()
+                                          .set_show_progress(false)
+                                          .set_skip_function_bodies(false),
+                                      "test.cc", std::string(kCode));
+  ASSERT_TRUE(parsed.is_ok());
+  EXPECT_EQ(subdoc::save_database(db),
+            subdoc::save_database(sus::move(parsed).unwrap()));
+}
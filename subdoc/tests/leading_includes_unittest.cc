@@ -0,0 +1,89 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/leading_includes.h"
+
+#include "googletest/include/gtest/gtest.h"
+
+namespace {
+
+TEST(LeadingIncludes, StopsAtCode) {
+  EXPECT_EQ(subdoc::leading_includes("#include \"a.h\"\n"
+                                     "#include <b.h>\n"
+                                     "\n"
+                                     "int x;\n"
+                                     "#include <c.h>\n"),
+            Vec<std::string>("#include \"a.h\"", "#include <b.h>"));
+}
+
+TEST(LeadingIncludes, StopsAtOtherDirectives) {
+  EXPECT_EQ(subdoc::leading_includes("#include <a.h>\n"
+                                     "#define X\n"
+                                     "#include <b.h>\n"),
+            Vec<std::string>("#include <a.h>"));
+  EXPECT_EQ(subdoc::leading_includes("#pragma warning(push)\n"
+                                     "#include <a.h>\n"),
+            Vec<std::string>());
+}
+
+TEST(LeadingIncludes, SkipsLineComments) {
+  EXPECT_EQ(subdoc::leading_includes("// Copyright\n"
+                                     "  // Indented.\n"
+                                     "#include <a.h>\n"
+                                     "#include <b.h>  // For b.\n"),
+            Vec<std::string>("#include <a.h>", "#include <b.h>  // For b."));
+}
+
+TEST(LeadingIncludes, SkipsBlockComments) {
+  EXPECT_EQ(subdoc::leading_includes("/*\n"
+                                     " * Copyright\n"
+                                     " */\n"
+                                     "#include <a.h>\n"
+                                     "/* One line. */\n"
+                                     "/* Before */ #include <b.h>\n"
+                                     "/* Ends */ /* Twice */\n"
+                                     "#include <c.h>\n"),
+            Vec<std::string>("#include <a.h>", "#include <b.h>",
+                             "#include <c.h>"));
+  // Code after a block comment ends the includes.
+  EXPECT_EQ(subdoc::leading_includes("#include <a.h>\n"
+                                     "/*\n"
+                                     " */ int x;\n"
+                                     "#include <b.h>\n"),
+            Vec<std::string>("#include <a.h>"));
+  // The includes inside a block comment are not used.
+  EXPECT_EQ(subdoc::leading_includes("/* #include <a.h>\n"
+                                     "#include <b.h> */\n"
+                                     "#include <c.h>\n"),
+            Vec<std::string>("#include <c.h>"));
+}
+
+TEST(LeadingIncludes, SkipsPragmaOnce) {
+  EXPECT_EQ(subdoc::leading_includes("// A header.\n"
+                                     "\n"
+                                     "#pragma once\n"
+                                     "\n"
+                                     "#include <a.h>\n"),
+            Vec<std::string>("#include <a.h>"));
+}
+
+TEST(LeadingIncludes, WindowsLineEndings) {
+  EXPECT_EQ(subdoc::leading_includes("// Comment\r\n"
+                                     "#include <a.h>\r\n"
+                                     "#pragma once\r\n"
+                                     "#include <b.h>\r\n"),
+            Vec<std::string>("#include <a.h>", "#include <b.h>"));
+}
+
+}  // namespace
@@ -0,0 +1,210 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/serialize.h"
+#include "subdoc/tests/subdoc_test.h"
+#include "sus/assertions/unreachable.h"
+
+namespace {
+
+/// Returns the element that `find_name()` found, or null if it found nothing,
+/// so that two lookups can be compared.
+const void* found_element(const Option<subdoc::FoundName>& found) noexcept {
+  if (found.is_none()) return nullptr;
+  const subdoc::FoundName& f = found.as_value();
+  switch (f) {
+    case subdoc::FoundName::Tag::Namespace:
+      return &f.as<subdoc::FoundName::Tag::Namespace>();
+    case subdoc::FoundName::Tag::Function:
+      return &f.as<subdoc::FoundName::Tag::Function>();
+    case subdoc::FoundName::Tag::Type:
+      return &f.as<subdoc::FoundName::Tag::Type>();
+    case subdoc::FoundName::Tag::Concept:
+      return &f.as<subdoc::FoundName::Tag::Concept>();
+    case subdoc::FoundName::Tag::Field:
+      return &f.as<subdoc::FoundName::Tag::Field>();
+    case subdoc::FoundName::Tag::Macro:
+      return &f.as<subdoc::FoundName::Tag::Macro>();
+  }
+  sus_unreachable();
+}
+
+bool found_tag(const subdoc::Database& db, std::string_view name,
+               subdoc::FoundName::Tag tag) noexcept {
+  Option<subdoc::FoundName> found = db.find_name(name);
+  return found.is_some() && found.as_value() == tag;
+}
+
+}  // namespace
+
+TEST_F(SubDocTest, NameIndexFindName) {
+  auto result = run_code(R"(
+    namespace n {
+    /// Record a
+    struct a {
+      /// Record N
+      struct N {};
+      /// Method m
+      void m() {}
+      /// Method m two
+      /// #[doc.overloads=two]
+      void m(int) {}
+      /// Field field
+      int field;
+    };
+    /// Function a
+    void a(int) {}
+    /// Function f one
+    /// #[doc.overloads=one]
+    void f() {}
+    /// Function f two
+    /// #[doc.overloads=two]
+    void f(int) {}
+    /// Concept C
+    template <class T>
+    concept C = true;
+    }
+    /// Function g
+    void g() {}
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+
+  // A loaded `Database` has no index, so `find_name()` walks the elements.
+  subdoc::Database loaded =
+      subdoc::load_database(subdoc::save_database(db)).unwrap();
+
+  const std::string_view names[] = {
+      "",               //
+      "n",              //
+      "::n",            //
+      "n::a",           //
+      "::n::a",         //
+      "n::a::N",        //
+      "::n::a::N",      //
+      "n::a::m",        //
+      "n::a::m!two",    //
+      "::n::a::m!two",  //
+      "n::a::m!one",    //
+      "n::a::field",    //
+      "n::f",           //
+      "n::f!one",       //
+      "::n::f!two",     //
+      "n::f!three",     //
+      "n::f!",          //
+      "n::C",           //
+      "g",              //
+      "::g",            //
+      "g!",             //
+      "a",              //
+      "n::",            //
+      "n!one",          //
+      "n::x",           //
+      "n::a::x",        //
+      "n::a::N::x",     //
+  };
+  auto walked = Vec<const void*>();
+  for (std::string_view name : names)
+    walked.push(found_element(loaded.find_name(name)));
+
+  loaded.build_name_index();
+  for (usize i; i < walked.len(); i += 1u) {
+    std::string_view name = names[size_t{i}];
+    EXPECT_EQ(walked[i], found_element(loaded.find_name(name))) << name;
+  }
+
+  // The record is found before the function with the same name.
+  EXPECT_TRUE(found_tag(loaded, "n::a", subdoc::FoundName::Tag::Type));
+  EXPECT_TRUE(found_tag(loaded, "::n::a::N", subdoc::FoundName::Tag::Type));
+  EXPECT_TRUE(found_tag(loaded, "n::a::m", subdoc::FoundName::Tag::Function));
+  EXPECT_TRUE(
+      found_tag(loaded, "n::a::m!two", subdoc::FoundName::Tag::Function));
+  EXPECT_TRUE(found_tag(loaded, "n::a::field", subdoc::FoundName::Tag::Field));
+  EXPECT_TRUE(found_tag(loaded, "n::f!one", subdoc::FoundName::Tag::Function));
+  EXPECT_TRUE(
+      found_tag(loaded, "::n::f!two", subdoc::FoundName::Tag::Function));
+  EXPECT_TRUE(found_tag(loaded, "n::C", subdoc::FoundName::Tag::Concept));
+  EXPECT_TRUE(found_tag(loaded, "::g", subdoc::FoundName::Tag::Function));
+  // A function with an overload set is only found by naming the set.
+  EXPECT_TRUE(loaded.find_name("n::f").is_none());
+  EXPECT_TRUE(loaded.find_name("n::f!three").is_none());
+  EXPECT_TRUE(loaded.find_name("n::a::m!one").is_none());
+}
+
+TEST_F(SubDocTest, NameIndexInheritRecord) {
+  auto result = run_code(R"(
+    namespace n {
+    struct S {
+      /// Nested headline
+      struct R {};
+    };
+    /// #[doc.inherit=[n]n::[r]S::[r]R]
+    struct T {};
+    }
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(has_record_comment(db, "4:7", "<p>Nested headline</p>"));
+  EXPECT_TRUE(has_record_comment(db, "7:5", "<p>Nested headline</p>"));
+}
+
+TEST_F(SubDocTest, NameIndexInheritMethod) {
+  auto result = run_code(R"(
+    namespace n {
+    struct S {
+      /// Method headline
+      void m() {}
+    };
+    /// #[doc.inherit=[n]n::[r]S::[f]m]
+    void f() {}
+    }
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(has_method_comment(db, "4:7", "<p>Method headline</p>"));
+  EXPECT_TRUE(has_function_comment(db, "7:5", "<p>Method headline</p>"));
+}
+
+TEST_F(SubDocTest, NameIndexInheritOverloadSet) {
+  auto result = run_code(R"(
+    namespace n {
+    /// Overload headline
+    /// #[doc.overloads=one]
+    void f() {}
+    /// Overload headline
+    /// #[doc.overloads=two]
+    void f(int) {}
+    /// #[doc.inherit=[n]n::[f]f]
+    void g() {}
+    }
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(has_function_comment(db, "9:5", "<p>Overload headline</p>"));
+}
+
+TEST_F(SubDocTest, NameIndexInheritChain) {
+  auto result = run_code(R"(
+    /// #[doc.inherit=[f]b]
+    void a() {}
+    /// #[doc.inherit=[r]S]
+    void b() {}
+    /// Record headline
+    struct S {};
+  )");
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  EXPECT_TRUE(has_function_comment(db, "2:5", "<p>Record headline</p>"));
+  EXPECT_TRUE(has_function_comment(db, "4:5", "<p>Record headline</p>"));
+}
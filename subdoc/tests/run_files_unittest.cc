@@ -0,0 +1,137 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/serialize.h"
+#include "subdoc/tests/subdoc_test.h"
+
+namespace {
+
+/// Source files that share a header, with declarations that are split between
+/// them and must be merged.
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> make_merged_files() noexcept {
+  auto fs = llvm::IntrusiveRefCntPtr(new llvm::vfs::InMemoryFileSystem());
+  fs->addFile("shared.h", 0, llvm::MemoryBuffer::getMemBuffer(R"(#pragma once
+
+/// Comment headline S
+struct S {
+  /// Comment headline m
+  void m();
+  void m(int);
+};
+
+/// Comment headline f
+void f(int);
+
+void k();
+
+namespace n {
+/// Comment headline g
+void g(S);
+}  // namespace n
+)"));
+  fs->addFile("a.cc", 0, llvm::MemoryBuffer::getMemBuffer(R"(
+#include "shared.h"
+
+void f(char) {}
+void k() {}
+void S::m(int) {}
+
+namespace n {
+/// Comment headline A
+struct A {};
+}  // namespace n
+)"));
+  fs->addFile("b.cc", 0, llvm::MemoryBuffer::getMemBuffer(R"(
+#include "shared.h"
+
+void f(double) {}
+
+/// Comment headline k
+void k();
+
+/// Comment headline f two
+/// #[doc.overloads=two]
+void f(int, int) {}
+
+namespace n {
+void g(S) {}
+}  // namespace n
+)"));
+  fs->addFile("c.cc", 0, llvm::MemoryBuffer::getMemBuffer(R"(
+#include "shared.h"
+
+/// Comment headline T
+struct T {
+  S s;
+};
+
+namespace n {
+/// Comment headline h
+void h(T) {}
+}  // namespace n
+)"));
+  return fs;
+}
+
+}  // namespace
+
+TEST_F(SubDocTest, RunFilesParallel) {
+  auto paths = Vec<std::string>("a.cc", "b.cc", "c.cc");
+  auto serial = run_files_with_options(
+      subdoc::RunOptions().set_show_progress(false).set_jobs(1u),
+      sus::clone(paths), make_merged_files());
+  ASSERT_TRUE(serial.is_ok());
+  auto parallel = run_files_with_options(
+      subdoc::RunOptions().set_show_progress(false).set_jobs(4u),
+      sus::clone(paths), make_merged_files());
+  ASSERT_TRUE(parallel.is_ok());
+
+  subdoc::Database db = sus::move(parallel).unwrap();
+  // The comment on `k()` is only in the second file.
+  EXPECT_TRUE(
+      has_function_comment(db, "b.cc:6:1", "<p>Comment headline k</p>"));
+  EXPECT_TRUE(has_function_comment(db, "b.cc:9:1",
+                                   "<p>Comment headline f two</p>"));
+  EXPECT_TRUE(has_record_comment(db, "c.cc:4:1", "<p>Comment headline T</p>"));
+
+  // Parsing the files on many threads and merging them collects exactly what
+  // parsing them all on one thread does.
+  EXPECT_EQ(subdoc::save_database(sus::move(serial).unwrap()),
+            subdoc::save_database(db));
+}
+
+TEST_F(SubDocTest, RunFilesParallelConflictingComments) {
+  auto make_files = []() {
+    auto fs = llvm::IntrusiveRefCntPtr(new llvm::vfs::InMemoryFileSystem());
+    fs->addFile("a.cc", 0, llvm::MemoryBuffer::getMemBuffer(R"(
+/// Comment headline one
+void x();
+)"));
+    fs->addFile("b.cc", 0, llvm::MemoryBuffer::getMemBuffer(R"(
+/// Comment headline two
+void x();
+)"));
+    return llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(sus::move(fs));
+  };
+  auto paths = Vec<std::string>("a.cc", "b.cc");
+  // A function can only have one comment, so both runs fail.
+  EXPECT_TRUE(run_files_with_options(
+                  subdoc::RunOptions().set_show_progress(false).set_jobs(1u),
+                  sus::clone(paths), make_files())
+                  .is_err());
+  EXPECT_TRUE(run_files_with_options(
+                  subdoc::RunOptions().set_show_progress(false).set_jobs(4u),
+                  sus::clone(paths), make_files())
+                  .is_err());
+}
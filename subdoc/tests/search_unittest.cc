@@ -0,0 +1,196 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/gen/search.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "subdoc/lib/gen/output_file.h"
+#include "sus/prelude.h"
+
+namespace {
+
+using subdoc::gen::OutputFiles;
+using subdoc::gen::SearchDocument;
+using subdoc::gen::SearchIndex;
+
+class SearchIndexTest : public testing::Test {
+ public:
+  void SetUp() override {
+    root_ = std::filesystem::temp_directory_path() / "subdoc_search_unittest" /
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+    std::filesystem::remove_all(root_);
+  }
+  void TearDown() override { std::filesystem::remove_all(root_); }
+
+  /// Writes `index` and returns how many files were written.
+  usize write(const SearchIndex& index) noexcept {
+    auto files = OutputFiles();
+    index.write(root_, files);
+    return files.written();
+  }
+
+  /// Returns the contents of the file at `name` in the search directory, or an
+  /// empty string if it was not written.
+  std::string read(std::string_view name) const noexcept {
+    auto in = std::ifstream(root_ / "search" / name, std::ios::binary);
+    auto s = std::ostringstream();
+    s << in.rdbuf();
+    return sus::move(s).str();
+  }
+
+  std::filesystem::path root_;
+};
+
+SearchDocument make_doc(std::string type, std::string name,
+                        std::string full_name,
+                        std::string summary = std::string()) noexcept {
+  return SearchDocument{
+      .type = sus::move(type),
+      .url = name + ".html",
+      .name = sus::move(name),
+      .full_name = sus::move(full_name),
+      .summary = sus::move(summary),
+  };
+}
+
+TEST_F(SearchIndexTest, Files) {
+  auto index = SearchIndex();
+  index.add(make_doc("project", "PROJECT", "PROJECT"));
+  index.add(make_doc("class", "Vec", "sus::collections::Vec", "A vector."));
+  index.add(make_doc("method", "push", "sus::collections::Vec::push"));
+  EXPECT_EQ(index.len(), 3u);
+  EXPECT_EQ(write(index), 7u);
+
+  EXPECT_EQ(read("index.js"),
+            "g_search_index={\"shard_size\":500,\"num_docs\":3,"
+            "\"types\":[\"project\",\"class\",\"method\"],"
+            "\"terms\":[\"636f\",\"7072\",\"7075\",\"7375\",\"7665\"]};\n");
+  EXPECT_EQ(read("docs.0.js"),
+            "g_search_docs[0]=[\n"
+            "[0,\"PROJECT.html\",\"PROJECT\",\"PROJECT\",\"PROJECT\",\"\"],\n"
+            "[1,\"Vec.html\",\"Vec\",\"sus::collections::Vec\","
+            "\"sus collections Vec\",\"A vector.\"],\n"
+            "[2,\"push.html\",\"push\",\"sus::collections::Vec::push\","
+            "\"sus collections Vec push\",\"\"]\n"
+            "];\n");
+  // Terms are lowercased, and sharded by their first two bytes in hex.
+  EXPECT_EQ(read("terms.636f.js"),
+            "g_search_terms[\"636f\"]={\n"
+            "\"collections\":[1,2]\n"
+            "};\n");
+  EXPECT_EQ(read("terms.7072.js"),
+            "g_search_terms[\"7072\"]={\n"
+            "\"project\":[0]\n"
+            "};\n");
+  EXPECT_EQ(read("terms.7075.js"),
+            "g_search_terms[\"7075\"]={\n"
+            "\"push\":[2]\n"
+            "};\n");
+  // The full name is one token, as lunr.js does not split at `::`.
+  EXPECT_EQ(read("terms.7375.js"),
+            "g_search_terms[\"7375\"]={\n"
+            "\"sus\":[1,2],\n"
+            "\"sus::collections::vec\":[1],\n"
+            "\"sus::collections::vec::push\":[2]\n"
+            "};\n");
+  EXPECT_EQ(read("terms.7665.js"),
+            "g_search_terms[\"7665\"]={\n"
+            "\"vec\":[1,2]\n"
+            "};\n");
+}
+
+TEST_F(SearchIndexTest, Escaping) {
+  auto index = SearchIndex();
+  index.add(make_doc("function", "operator==", "ns::operator==",
+                     "Has \"quotes\", a \\ and\na\tcontrol \x01 char."));
+  write(index);
+  EXPECT_EQ(read("docs.0.js"),
+            "g_search_docs[0]=[\n"
+            "[0,\"operator==.html\",\"operator==\",\"ns::operator==\","
+            "\"ns operator==\","
+            "\"Has \\\"quotes\\\", a \\\\ and\\na\\tcontrol \\u0001 char.\"]\n"
+            "];\n");
+}
+
+TEST_F(SearchIndexTest, ShortAndHyphenatedTerms) {
+  auto index = SearchIndex();
+  // lunr.js splits at `-`, and a one byte term has a one byte shard.
+  index.add(make_doc("function", "v", "a-b"));
+  write(index);
+  EXPECT_EQ(read("terms.61.js"),
+            "g_search_terms[\"61\"]={\n"
+            "\"a\":[0]\n"
+            "};\n");
+  EXPECT_EQ(read("terms.62.js"),
+            "g_search_terms[\"62\"]={\n"
+            "\"b\":[0]\n"
+            "};\n");
+  EXPECT_EQ(read("terms.76.js"),
+            "g_search_terms[\"76\"]={\n"
+            "\"v\":[0]\n"
+            "};\n");
+}
+
+TEST_F(SearchIndexTest, LowercasesOnlyAscii) {
+  auto index = SearchIndex();
+  // "Über" in UTF-8. The search script looks up only query terms that are all
+  // ASCII, so the other characters are left as they are.
+  index.add(make_doc("class", "\xc3\x9c" "ber", "\xc3\x9c" "ber"));
+  write(index);
+  EXPECT_EQ(read("terms.c39c.js"),
+            "g_search_terms[\"c39c\"]={\n"
+            "\"\xc3\x9c" "ber\":[0]\n"
+            "};\n");
+}
+
+TEST_F(SearchIndexTest, Shards) {
+  auto index = SearchIndex();
+  for (usize i; i < 1001u; i += 1u)
+    index.add(make_doc("function", "f", "f"));
+  write(index);
+
+  EXPECT_EQ(read("index.js"),
+            "g_search_index={\"shard_size\":500,\"num_docs\":1001,"
+            "\"types\":[\"function\"],\"terms\":[\"66\"]};\n");
+  // The documents are split into shards of 500 by their id.
+  std::string docs_1 = read("docs.1.js");
+  EXPECT_TRUE(docs_1.starts_with("g_search_docs[1]=[\n[0,\"f.html\""));
+  EXPECT_EQ(std::count(docs_1.begin(), docs_1.end(), '\n'), 502);
+  EXPECT_EQ(read("docs.2.js"),
+            "g_search_docs[2]=[\n"
+            "[0,\"f.html\",\"f\",\"f\",\"f\",\"\"]\n"
+            "];\n");
+  EXPECT_EQ(read("docs.3.js"), "");
+  // A document is listed once for a term, though it has the term in more than
+  // one field.
+  std::string terms = read("terms.66.js");
+  EXPECT_TRUE(terms.starts_with("g_search_terms[\"66\"]={\n\"f\":[0,1,2,"));
+  EXPECT_TRUE(terms.ends_with(",999,1000]\n};\n"));
+}
+
+TEST_F(SearchIndexTest, Unchanged) {
+  auto index = SearchIndex();
+  index.add(make_doc("class", "Vec", "Vec"));
+  EXPECT_EQ(write(index), 3u);
+  // Writing the same index again leaves the files alone.
+  EXPECT_EQ(write(index), 0u);
+}
+
+}  // namespace
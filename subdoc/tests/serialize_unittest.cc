@@ -0,0 +1,93 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subdoc/lib/serialize.h"
+
+#include "subdoc/lib/merge.h"
+#include "subdoc/tests/subdoc_test.h"
+
+namespace {
+
+constexpr std::string_view kCode = R"(
+    namespace n {
+    /// Record comment
+    template <class T>
+    struct S {
+      /// Method comment
+      const T& get(int i = 2) const&;
+      /// Field comment
+      T* field;
+    };
+    /// Concept comment
+    template <class T> concept C = requires(T t) { t.get(); };
+    /// Function comment
+    template <C T> void f(S<T>& s);
+    /// Alias comment
+    using A = S<int>;
+    }
+    /// Macro comment
+    #define MACRO(x) x
+  )";
+
+TEST_F(SubDocTest, SerializeRoundTrip) {
+  auto result = run_code_with_options(
+      subdoc::RunOptions().set_show_progress(false).set_macro_prefixes(
+          Vec<std::string>("MACRO")),
+      "test.cc", std::string(kCode));
+  ASSERT_TRUE(result.is_ok());
+  subdoc::Database db = sus::move(result).unwrap();
+  subdoc::sort_database(db);
+  std::string bytes = subdoc::save_database(db);
+
+  auto loaded_result = subdoc::load_database(bytes);
+  ASSERT_TRUE(loaded_result.is_ok());
+  subdoc::Database loaded = sus::move(loaded_result).unwrap();
+  // The maps are filled in a different order when loading, so they are sorted
+  // again to compare the bytes.
+  subdoc::sort_database(loaded);
+  subdoc::relink_database(loaded);
+  EXPECT_EQ(subdoc::save_database(loaded), bytes);
+
+  EXPECT_TRUE(has_record_comment(loaded, "3:5", "<p>Record comment</p>"));
+  EXPECT_TRUE(has_method_comment(loaded, "6:7", "<p>Method comment</p>"));
+  EXPECT_TRUE(has_field_comment(loaded, "8:7", "<p>Field comment</p>"));
+  EXPECT_TRUE(has_concept_comment(loaded, "11:5", "<p>Concept comment</p>"));
+  EXPECT_TRUE(has_function_comment(loaded, "13:5", "<p>Function comment</p>"));
+  EXPECT_TRUE(has_alias_comment(loaded, "15:5", "<p>Alias comment</p>"));
+}
+
+TEST_F(SubDocTest, SerializeTruncated) {
+  auto result = run_code(std::string(kCode));
+  ASSERT_TRUE(result.is_ok());
+  std::string bytes = subdoc::save_database(sus::move(result).unwrap());
+
+  std::string_view truncated = std::string_view(bytes).substr(
+      0u, bytes.size() / 2u);
+  EXPECT_TRUE(subdoc::load_database(truncated).is_err());
+  EXPECT_TRUE(subdoc::load_database(bytes + "x").is_err());
+}
+
+TEST_F(SubDocTest, SerializeWrongVersion) {
+  auto result = run_code(std::string(kCode));
+  ASSERT_TRUE(result.is_ok());
+  std::string bytes = subdoc::save_database(sus::move(result).unwrap());
+  ASSERT_TRUE(subdoc::load_database(bytes).is_ok());
+
+  // The version follows the 8 byte magic.
+  bytes[8u] += 1;
+  EXPECT_TRUE(subdoc::load_database(bytes).is_err());
+  EXPECT_TRUE(subdoc::load_database("not a database").is_err());
+}
+
+}  // namespace
@@ -39,37 +39,12 @@ class SubDocGenTest : public testing::Test {
   bool run_gen_test(std::string directory) noexcept {
     std::string content =
         read_file(path_to_input(directory, sus::some("test.cc"))).unwrap();
+    Option<subdoc::Database> db = run_code(sus::move(content));
+    if (db.is_none()) return false;
 
-    auto args = Vec<std::string>();
-    args.push(std::string(subdoc::tests::cpp_version_flag(cpp_version_)));
-
-    auto run_options =
-        subdoc::RunOptions().set_show_progress(false).set_macro_prefixes(
-            Vec<std::string>("sus_"));
-
-    auto result = subdoc::run_test("test.cc", sus::move(content),
-                                   args.as_slice(), sus::move(run_options));
-    if (!result.is_ok()) return false;
-
-    using subdoc::gen::FavIcon;
-    using namespace std::string_literals;
-    auto options = subdoc::gen::Options{
-        .version_text = sus::some("VERSION_STRING"s),
-        .output_root =
-            [&]() {
-              std::filesystem::path test_root = output_root;
-              test_root.append(directory);
-              return test_root;
-            }(),
-        .stylesheets = Vec("../subdoc-test-style.css"s),
-        .favicons =
-            Vec(FavIcon::from_string("../icon.svg;image/svg+xml").unwrap(),
-                     FavIcon::from_string("../icon.png;image/png").unwrap()),
-        .copy_files = sus::empty,
-        .ignore_bad_code_links = false,
-    };
-    sus::result::Result<void, sus::Box<sus::error::DynError>> r =
-        subdoc::gen::generate(sus::move(result).unwrap(), options);
+    subdoc::gen::Options options = gen_options(directory);
+    sus::result::Result<subdoc::gen::GenerateStats, sus::error::SmallError> r =
+        subdoc::gen::generate(db.as_value(), options);
     if (r.is_err()) {
       std::string fail = fmt::to_string(r.as_err());
       for (Option<const sus::error::DynError&> source =
@@ -110,6 +85,40 @@ class SubDocGenTest : public testing::Test {
                          std::filesystem::path());
   }
 
+  /// Collects the docs from `content`, as the source file of a test.
+  Option<subdoc::Database> run_code(std::string content) const noexcept {
+    auto args = Vec<std::string>();
+    args.push(std::string(subdoc::tests::cpp_version_flag(cpp_version_)));
+
+    auto run_options =
+        subdoc::RunOptions().set_show_progress(false).set_macro_prefixes(
+            Vec<std::string>("sus_"));
+
+    auto result = subdoc::run_test("test.cc", sus::move(content),
+                                   args.as_slice(), sus::move(run_options));
+    if (!result.is_ok()) return sus::none();
+    return sus::some(sus::move(result).unwrap());
+  }
+
+  /// The options to generate the output of the test in `directory`.
+  static subdoc::gen::Options gen_options(std::string_view directory) noexcept {
+    using subdoc::gen::FavIcon;
+    using namespace std::string_literals;
+    return subdoc::gen::Options{
+        .version_text = sus::some("VERSION_STRING"s),
+        .output_root = path_to_output(directory, sus::none()),
+        .stylesheets = Vec("../subdoc-test-style.css"s),
+        .favicons =
+            Vec(FavIcon::from_string("../icon.svg;image/svg+xml").unwrap(),
+                     FavIcon::from_string("../icon.png;image/png").unwrap()),
+        .copy_files = sus::empty,
+        .ignore_bad_code_links = false,
+        // Write pages on more than one thread, which must give the same output
+        // as writing them in order.
+        .jobs = 4u,
+    };
+  }
+
  private:
   /// Gives the path to a test input file.
   static std::filesystem::path path_to_input(
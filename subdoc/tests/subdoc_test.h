@@ -47,6 +47,28 @@ class SubDocTest : public testing::Test {
                                  "test.cc", sus::move(content));
   }
 
+  /// Runs over each of `paths` in `fs`, compiled with the same arguments as
+  /// `run_code()` followed by `extra_args`.
+  sus::Result<subdoc::Database, subdoc::DiagnosticResults>
+  run_files_with_options(
+      const subdoc::RunOptions& options, Vec<std::string> paths,
+      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+      sus::Slice<std::string> extra_args = sus::empty) noexcept {
+    auto join_args = std::string(subdoc::tests::cpp_version_flag(cpp_version_));
+    join_args += "\n";
+    for (const std::string& a : extra_args) join_args += a + "\n";
+
+    auto err = std::string();
+    auto comp_db = clang::tooling::FixedCompilationDatabase::loadFromBuffer(
+        ".", join_args, err);
+    if (!err.empty()) {
+      ADD_FAILURE() << "error making comp_db for tests: " << err;
+      return sus::err(subdoc::DiagnosticResults());
+    }
+    return subdoc::run_files(*comp_db, sus::move(paths), sus::move(fs),
+                             options);
+  }
+
   /// Returns whether a record was found whose comment location ends with
   /// `comment_loc` and whose comment begins with `comment_start`.
   bool has_namespace_comment(const subdoc::Database& db,
@@ -0,0 +1,116 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <string_view>
+
+#include "subdoc/tests/subdoc_test.h"
+
+class SubDocTuCacheTest : public SubDocTest {
+ public:
+  void SetUp() override {
+    llvm::SmallString<128> dir;
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("subdoc-tu-cache", dir));
+    cache_dir_ = std::string(dir);
+  }
+  void TearDown() override {
+    if (!cache_dir_.empty()) llvm::sys::fs::remove_directories(cache_dir_);
+  }
+
+  struct CachedRun {
+    Option<subdoc::Database> db;
+    /// Whether `test.cc` was loaded from the cache instead of being parsed.
+    bool loaded;
+  };
+
+  /// Runs over `test.cc`, which includes a header whose comment ends with
+  /// `version`, using the cache.
+  CachedRun run_cached(std::string_view version,
+                       sus::Slice<std::string> extra_args = sus::empty,
+                       std::string options_key = "") noexcept {
+    auto fs = llvm::IntrusiveRefCntPtr(new llvm::vfs::InMemoryFileSystem());
+    fs->addFile("test.cc", 0,
+                llvm::MemoryBuffer::getMemBuffer("#include \"shared.h\"\n"));
+    fs->addFile("shared.h", 0,
+                llvm::MemoryBuffer::getMemBufferCopy(
+                    "\n/// Comment headline " + std::string(version) +
+                    "\nstruct S {};\n"));
+
+    // How many files were loaded from the cache is only reported as progress.
+    testing::internal::CaptureStderr();
+    auto result = run_files_with_options(
+        subdoc::RunOptions()
+            .set_show_progress(true)
+            .set_cache_dir(sus::some(cache_dir_))
+            .set_cache_options_key(sus::move(options_key)),
+        Vec<std::string>("test.cc"), sus::move(fs), extra_args);
+    std::string progress = testing::internal::GetCapturedStderr();
+    EXPECT_NE(progress.find("files from the cache"), std::string::npos);
+
+    auto run = CachedRun{
+        .db = Option<subdoc::Database>(),
+        .loaded = progress.find("Loaded 1 of 1 files from the cache") !=
+                  std::string::npos,
+    };
+    if (result.is_ok()) run.db.insert(sus::move(result).unwrap());
+    return run;
+  }
+
+ private:
+  std::string cache_dir_;
+};
+
+TEST_F(SubDocTuCacheTest, HeaderChanged) {
+  CachedRun first = run_cached("v1");
+  ASSERT_TRUE(first.db.is_some());
+  EXPECT_FALSE(first.loaded);
+  EXPECT_TRUE(has_record_comment(first.db.as_value(), "shared.h:2:1",
+                                 "<p>Comment headline v1</p>"));
+
+  CachedRun second = run_cached("v1");
+  ASSERT_TRUE(second.db.is_some());
+  EXPECT_TRUE(second.loaded);
+  EXPECT_TRUE(has_record_comment(second.db.as_value(), "shared.h:2:1",
+                                 "<p>Comment headline v1</p>"));
+
+  // The header changed, so the source file is parsed again.
+  CachedRun edited = run_cached("v2");
+  ASSERT_TRUE(edited.db.is_some());
+  EXPECT_FALSE(edited.loaded);
+  EXPECT_TRUE(has_record_comment(edited.db.as_value(), "shared.h:2:1",
+                                 "<p>Comment headline v2</p>"));
+
+  CachedRun after_edit = run_cached("v2");
+  ASSERT_TRUE(after_edit.db.is_some());
+  EXPECT_TRUE(after_edit.loaded);
+  EXPECT_TRUE(has_record_comment(after_edit.db.as_value(), "shared.h:2:1",
+                                 "<p>Comment headline v2</p>"));
+}
+
+TEST_F(SubDocTuCacheTest, CommandChanged) {
+  EXPECT_FALSE(run_cached("v1").loaded);
+  EXPECT_TRUE(run_cached("v1").loaded);
+
+  auto args = Vec<std::string>("-DEXTRA");
+  EXPECT_FALSE(run_cached("v1", args.as_slice()).loaded);
+  EXPECT_TRUE(run_cached("v1", args.as_slice()).loaded);
+}
+
+TEST_F(SubDocTuCacheTest, OptionsChanged) {
+  EXPECT_FALSE(run_cached("v1").loaded);
+  EXPECT_TRUE(run_cached("v1").loaded);
+
+  EXPECT_FALSE(run_cached("v1", sus::empty, "other").loaded);
+  EXPECT_TRUE(run_cached("v1", sus::empty, "other").loaded);
+}
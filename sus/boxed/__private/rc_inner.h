@@ -0,0 +1,259 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/collections/slice.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/forward.h"
+#include "sus/num/unsigned_integer.h"
+
+namespace sus::boxed::__private {
+
+/// The reference counts of an `Rc`, which are only used from a single thread.
+///
+/// The weak count includes one implicit weak reference that is shared by all
+/// strong references, so the allocation is freed only once the value has been
+/// destroyed and every weak reference is gone. A strong count of 0 means the
+/// value has been destroyed.
+struct RcCounts {
+  void inc_strong() noexcept {
+    sus_check(strong_ < SIZE_MAX / 2u);
+    strong_ += 1u;
+  }
+  /// Returns true if the last strong reference was released, in which case
+  /// the value must be destroyed.
+  bool dec_strong() noexcept {
+    strong_ -= 1u;
+    return strong_ == 0u;
+  }
+  /// Increments the strong count unless the value has already been destroyed.
+  bool try_inc_strong() noexcept {
+    if (strong_ == 0u) return false;
+    inc_strong();
+    return true;
+  }
+  void inc_weak() noexcept {
+    sus_check(weak_ < SIZE_MAX / 2u);
+    weak_ += 1u;
+  }
+  /// Returns true if the last weak reference was released, in which case the
+  /// allocation must be freed.
+  bool dec_weak() noexcept {
+    weak_ -= 1u;
+    return weak_ == 0u;
+  }
+  /// Moves the strong count from 1 to 0, which prevents any weak reference
+  /// from being upgraded. Returns false if there are other strong references.
+  bool try_lock_strong() noexcept {
+    if (strong_ != 1u) return false;
+    strong_ = 0u;
+    return true;
+  }
+  void unlock_strong() noexcept { strong_ = 1u; }
+  /// Whether the caller's strong reference is the only reference of any kind.
+  bool is_unique() noexcept { return strong_ == 1u && weak_ == 1u; }
+  /// Whether any weak references exist, when called from the only strong
+  /// reference.
+  bool has_weak() const noexcept { return weak_ != 1u; }
+
+  usize strong_count() const noexcept { return strong_; }
+  /// The number of weak references, not including the implicit one held by
+  /// the strong references. Only meaningful while the strong count is above 0.
+  usize weak_count() const noexcept { return weak_ - 1u; }
+
+ private:
+  size_t strong_ = 1u;
+  size_t weak_ = 1u;
+};
+
+/// The reference counts of an `Arc`, which may be used from many threads at
+/// once. The counting scheme is the same as `RcCounts`.
+///
+/// Increments are relaxed, since a new reference can only be made from an
+/// existing one. Decrements release, and the decrement that reaches 0 acquires
+/// so that all uses of the value happen before it is destroyed.
+struct ArcCounts {
+  void inc_strong() noexcept {
+    const size_t old = strong_.fetch_add(1u, std::memory_order_relaxed);
+    sus_check(old < SIZE_MAX / 2u);
+  }
+  bool dec_strong() noexcept {
+    if (strong_.fetch_sub(1u, std::memory_order_release) != 1u) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
+  bool try_inc_strong() noexcept {
+    size_t cur = strong_.load(std::memory_order_relaxed);
+    while (true) {
+      if (cur == 0u) return false;
+      sus_check(cur < SIZE_MAX / 2u);
+      if (strong_.compare_exchange_weak(cur, cur + 1u,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed))
+        return true;
+    }
+  }
+  void inc_weak() noexcept {
+    // `is_unique()` locks the weak count while it reads the strong count, so
+    // that a strong reference can not be downgraded and then released in
+    // between. Wait for it to finish.
+    size_t cur = weak_.load(std::memory_order_relaxed);
+    while (true) {
+      if (cur == kLocked) {
+        cur = weak_.load(std::memory_order_relaxed);
+        continue;
+      }
+      sus_check(cur < SIZE_MAX / 2u);
+      if (weak_.compare_exchange_weak(cur, cur + 1u, std::memory_order_acquire,
+                                      std::memory_order_relaxed))
+        return;
+    }
+  }
+  bool dec_weak() noexcept {
+    if (weak_.fetch_sub(1u, std::memory_order_release) != 1u) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
+  bool try_lock_strong() noexcept {
+    size_t one = 1u;
+    return strong_.compare_exchange_strong(one, 0u, std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+  }
+  void unlock_strong() noexcept { strong_.store(1u, std::memory_order_release); }
+  bool is_unique() noexcept {
+    size_t one = 1u;
+    if (!weak_.compare_exchange_strong(one, kLocked, std::memory_order_acquire,
+                                       std::memory_order_relaxed))
+      return false;
+    const bool unique = strong_.load(std::memory_order_acquire) == 1u;
+    weak_.store(1u, std::memory_order_release);
+    return unique;
+  }
+  bool has_weak() const noexcept {
+    return weak_.load(std::memory_order_acquire) != 1u;
+  }
+
+  usize strong_count() const noexcept {
+    return strong_.load(std::memory_order_acquire);
+  }
+  usize weak_count() const noexcept {
+    const size_t weak = weak_.load(std::memory_order_acquire);
+    // While locked, the weak count is known to be 1.
+    if (weak == kLocked) return 0u;
+    return weak - 1u;
+  }
+
+ private:
+  static constexpr size_t kLocked = SIZE_MAX;
+
+  std::atomic<size_t> strong_ = 1u;
+  std::atomic<size_t> weak_ = 1u;
+};
+
+/// The heap allocation behind an `Rc<T>` or `Arc<T>`, which holds the
+/// reference counts and the value together.
+///
+/// The value is in a union so that it can be destroyed when the last strong
+/// reference goes away, while the allocation lives on for weak references.
+template <class Counts, class T>
+struct RcAllocation {
+  template <class... Args>
+  static RcAllocation* with_args(Args&&... args) noexcept {
+    return new RcAllocation(::sus::forward<Args>(args)...);
+  }
+
+  void destroy_value() noexcept { std::destroy_at(&value); }
+  void deallocate() noexcept { delete this; }
+
+  Counts counts;
+  union {
+    T value;
+  };
+
+ private:
+  template <class... Args>
+  explicit RcAllocation(Args&&... args) noexcept
+      : value(::sus::forward<Args>(args)...) {}
+  // The value is destroyed by `destroy_value()`.
+  ~RcAllocation() noexcept {}
+};
+
+/// The heap allocation behind an `Rc<Slice<T>>` or `Arc<Slice<T>>`. The
+/// elements are stored after the header in the same allocation, and the
+/// `value` is a `Slice` over them.
+template <class Counts, class T>
+struct RcAllocation<Counts, ::sus::collections::Slice<T>> {
+  /// Allocates space for `len` elements, which must be constructed at
+  /// `data()` by the caller.
+  static RcAllocation* with_len(usize len) noexcept {
+    void* mem = ::operator new(alloc_size(len), std::align_val_t{kAlign});
+    auto* a = new (mem) RcAllocation();
+    a->value = ::sus::collections::Slice<T>::from_raw_parts(
+        ::sus::marker::unsafe_fn, a->data(), len);
+    return a;
+  }
+
+  T* data() noexcept {
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + kDataOffset);
+  }
+
+  void destroy_value() noexcept {
+    std::destroy_n(data(), size_t{value.len()});
+  }
+  void deallocate() noexcept {
+    const size_t size = alloc_size(value.len());
+    this->~RcAllocation();
+    ::operator delete(static_cast<void*>(this), size,
+                      std::align_val_t{kAlign});
+  }
+
+  Counts counts;
+  ::sus::collections::Slice<T> value;
+
+ private:
+  static constexpr size_t kAlign = alignof(T) > alignof(Counts)
+                                       ? alignof(T)
+                                       : alignof(Counts);
+  static constexpr size_t kHeaderSize =
+      sizeof(Counts) + sizeof(::sus::collections::Slice<T>);
+  static constexpr size_t kDataOffset =
+      (kHeaderSize + alignof(T) - 1u) / alignof(T) * alignof(T);
+
+  static size_t alloc_size(usize len) noexcept {
+    sus_check(len <= (SIZE_MAX - kDataOffset) / sizeof(T));
+    return kDataOffset + size_t{len} * sizeof(T);
+  }
+
+  RcAllocation() noexcept = default;
+  ~RcAllocation() noexcept = default;
+};
+
+template <class T>
+struct IsRcSlice : std::false_type {};
+template <class T>
+struct IsRcSlice<::sus::collections::Slice<T>> : std::true_type {};
+
+}  // namespace sus::boxed::__private
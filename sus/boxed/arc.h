@@ -0,0 +1,161 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/boxed/__private/rc_inner.h"
+#include "sus/boxed/boxed.h"  // namespace docs.
+#include "sus/cmp/eq.h"
+#include "sus/cmp/ord.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/construct/default.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/option/option.h"
+#include "sus/ptr/copy.h"
+#include "sus/result/result.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::boxed {
+
+template <class T>
+class Arc;
+template <class T>
+class ArcWeak;
+
+/// A thread-safe reference-counted pointer. "Arc" stands for "Atomically
+/// Reference Counted".
+///
+/// An `Arc<T>` provides shared ownership of a value of type `T`, allocated on
+/// the heap, and can be cloned and destroyed from many threads at once. It
+/// has the same API as [`Rc`]($sus::boxed::Rc), but updates its reference
+/// counts with atomic operations, which are more expensive than the plain
+/// increments done by `Rc`. Prefer `Rc` for values that stay on one thread.
+///
+/// The `Arc` only makes the reference counts thread-safe. The value itself is
+/// shared as a `const T&` from every thread, so it must be safe to read
+/// concurrently, and mutation through [`get_mut`]($sus::boxed::Arc::get_mut)
+/// or [`make_mut`]($sus::boxed::Arc::make_mut) is only given to a thread
+/// that holds the only reference.
+///
+/// As with `Rc`, the reference counts and the value are in a single heap
+/// allocation, the `Arc` is a single pointer which is
+/// [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable), and an
+/// `Arc<Slice<T>>` stores its elements in the same allocation as the reference
+/// counts.
+///
+/// Weak references, which do not keep the value alive, are made with
+/// [`downgrade`]($sus::boxed::Arc::downgrade) and held in an
+/// [`ArcWeak`]($sus::boxed::ArcWeak).
+///
+/// # Examples
+/// ```
+/// auto a = sus::boxed::Arc<std::string>::from("hello");
+/// auto t = std::thread([b = a.clone()] { sus_check(*b == "hello"); });
+/// t.join();
+/// sus_check(a.strong_count() == 1u);
+/// ```
+template <class T>
+class [[_sus_trivial_abi]] Arc final {
+  static_assert(!std::is_reference_v<T>, "Arc of a reference is not allowed.");
+  static_assert(!std::is_array_v<T>,
+                "Arc<T[N]> is not allowed, use Arc<Array<T, N>> or Arc<Slice<T>>");
+  static_assert(!std::is_const_v<T>,
+                "Arc inner type should not be const, it provides const access "
+                "to the value regardless.");
+
+ public:
+#define _self Arc
+#define _self_str "Arc"
+#define _weak ArcWeak
+#define _counts ArcCounts
+#include "__private/rc_methods.inc"
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(inner_));
+  // The moved-from state is `nullptr`, so the never-values start at the first
+  // aligned address after it.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, Arc, inner_,
+                                      alignof(Alloc), nullptr);
+  explicit Arc(::sus::mem::NeverValueConstructor) noexcept
+      : inner_(_sus_NeverValuePointer(0u)) {}
+};
+
+/// A weak reference to a value owned by [`Arc`]($sus::boxed::Arc).
+///
+/// An `ArcWeak` is the thread-safe counterpart of
+/// [`RcWeak`]($sus::boxed::RcWeak). It is made with
+/// [`Arc::downgrade`]($sus::boxed::Arc::downgrade), and
+/// [`upgrade`]($sus::boxed::ArcWeak::upgrade) returns an `Arc` to the value if
+/// it has not been destroyed yet, even while other threads are releasing their
+/// references to it.
+///
+/// A default-constructed or moved-from `ArcWeak` is not attached to any
+/// allocation, and is never able to be upgraded.
+template <class T>
+class [[_sus_trivial_abi]] ArcWeak final {
+ public:
+#define _self ArcWeak
+#define _strong Arc
+#define _counts ArcCounts
+#include "__private/rc_weak_methods.inc"
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(inner_));
+  // A `nullptr` is the unattached state, so the never-values start at the
+  // first aligned address after it.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, ArcWeak, inner_,
+                                      alignof(Alloc), nullptr);
+  explicit ArcWeak(::sus::mem::NeverValueConstructor) noexcept
+      : inner_(_sus_NeverValuePointer(0u)) {}
+};
+
+}  // namespace sus::boxed
+
+// fmt support.
+template <class T, class Char>
+struct fmt::formatter<::sus::boxed::Arc<T>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::boxed::Arc<T>& t,
+                        FormatContext& ctx) const {
+    return underlying_.format(*t, ctx);
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Stream support.
+_sus_format_to_stream(sus::boxed, Arc, T);
+
+// Promote `Arc` into the `sus` namespace.
+namespace sus {
+using ::sus::boxed::Arc;
+}
@@ -0,0 +1,143 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/boxed/arc.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/mem/size_of.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+
+namespace {
+using sus::boxed::Arc;
+using sus::boxed::ArcWeak;
+
+static_assert(sus::mem::Clone<Arc<i32>>);
+static_assert(sus::mem::Move<Arc<i32>>);
+static_assert(sus::mem::Clone<ArcWeak<i32>>);
+static_assert(sus::construct::Default<ArcWeak<i32>>);
+
+static_assert(sus::mem::size_of<Arc<i32>>() == sizeof(void*));
+// For any T.
+static_assert(sus::mem::TriviallyRelocatable<Arc<i32>>);
+static_assert(sus::mem::TriviallyRelocatable<ArcWeak<i32>>);
+static_assert(sus::mem::size_of<sus::Option<Arc<i32>>>() == sizeof(void*));
+
+constexpr usize kThreads = 4u;
+constexpr usize kIters = 10'000u;
+
+struct CountDrops {
+  ~CountDrops() { drops->fetch_add(1); }
+  std::atomic<int32_t>* drops;
+};
+
+TEST(Arc, Basics) {
+  auto a = Arc<std::string>::from("hello");
+  auto b = a.clone();
+  EXPECT_TRUE(a.ptr_eq(b));
+  EXPECT_EQ(*b, "hello");
+  EXPECT_EQ(a.strong_count(), 2u);
+  auto w = a.downgrade();
+  EXPECT_EQ(a.weak_count(), 1u);
+  EXPECT_EQ(*w.upgrade().unwrap(), "hello");
+
+  EXPECT_EQ(a.get_mut(), sus::None);
+  b = Arc<std::string>::from("other");
+  w = ArcWeak<std::string>();
+  a.get_mut().unwrap() += "!";
+  EXPECT_EQ(*a, "hello!");
+}
+
+TEST(Arc, MakeMut) {
+  auto data = Arc<i32>::from(5);
+  data.make_mut() += 1;
+  auto other = data.clone();
+  data.make_mut() += 1;
+  data.make_mut() += 1;
+  other.make_mut() *= 2;
+  EXPECT_EQ(*data, 8);
+  EXPECT_EQ(*other, 12);
+
+  auto w = data.downgrade();
+  data.make_mut() += 1;
+  EXPECT_EQ(w.upgrade(), sus::None);
+  EXPECT_EQ(*data, 9);
+}
+
+TEST(Arc, IntoInner) {
+  auto a = Arc<std::string>::from("hi");
+  auto b = a.clone();
+  EXPECT_TRUE(sus::move(a).try_unwrap().is_err());
+  EXPECT_EQ(sus::move(b).into_inner(), sus::some("hi"));
+}
+
+TEST(Arc, Slice) {
+  auto s = Arc<sus::Slice<i32>>::from(sus::Vec<i32>(1, 2, 3));
+  EXPECT_EQ(s->len(), 3u);
+  EXPECT_EQ(s->sum(), 6);
+}
+
+TEST(Arc, CloneAcrossThreads) {
+  std::atomic<int32_t> drops = 0;
+  auto a = Arc<CountDrops>::from(CountDrops(&drops));
+  drops.store(0);  // Ignore the moved-from temporary.
+  {
+    auto threads = sus::Vec<std::thread>();
+    for (usize t; t < kThreads; t += 1u) {
+      threads.push(std::thread([shared = a.clone()] {
+        for (usize i; i < kIters; i += 1u) {
+          auto c = shared.clone();
+          auto w = c.downgrade();
+          EXPECT_TRUE(w.upgrade().is_some());
+        }
+      }));
+    }
+    for (std::thread& t : threads.iter_mut()) t.join();
+  }
+  EXPECT_EQ(a.strong_count(), 1u);
+  EXPECT_EQ(a.weak_count(), 0u);
+  EXPECT_EQ(drops.load(), 0);
+  a = Arc<CountDrops>::with_args(&drops);
+  EXPECT_EQ(drops.load(), 1);
+}
+
+TEST(Arc, LastReleaseAcrossThreads) {
+  std::atomic<int32_t> drops = 0;
+  auto w = ArcWeak<CountDrops>();
+  {
+    auto threads = sus::Vec<std::thread>();
+    auto a = Arc<CountDrops>::with_args(&drops);
+    w = a.downgrade();
+    for (usize t; t < kThreads; t += 1u) {
+      threads.push(std::thread([mine = a.clone(), weak = w.clone()] {
+        for (usize i; i < kIters; i += 1u) {
+          [[maybe_unused]] auto up = weak.upgrade();
+        }
+      }));
+    }
+    // Drop the last local reference while the threads may still hold theirs.
+    a = Arc<CountDrops>::with_args(&drops);
+    for (std::thread& t : threads.iter_mut()) t.join();
+    EXPECT_EQ(drops.load(), 1);
+  }
+  EXPECT_EQ(drops.load(), 2);
+  EXPECT_EQ(w.upgrade(), sus::None);
+}
+
+}  // namespace
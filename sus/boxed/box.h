@@ -662,15 +662,13 @@ class [[_sus_trivial_abi]] Box final : public __private::BoxBase<Box<T>, T> {
 
   T* t_;
 
-  static constexpr T* never_value() {
-    return static_cast<T*>(nullptr) + alignof(T);
-  }
-
   sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(t_));
-  sus_class_never_value_field(::sus::marker::unsafe_fn, Box, t_, never_value(),
-                              nullptr);
+  // The moved-from state is `nullptr`, so the never-values start at the first
+  // aligned address after it.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, Box, t_,
+                                      alignof(T), nullptr);
   constexpr explicit Box(::sus::mem::NeverValueConstructor) noexcept
-      : t_(never_value()) {}
+      : t_(_sus_NeverValuePointer(0u)) {}
 };
 
 }  // namespace sus::boxed
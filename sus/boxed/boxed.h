@@ -18,8 +18,10 @@
 
 namespace sus {
 
-/// The [`Box<T>`]($sus::boxed::Box) type for heap allocation and other
-/// tools for [type-erasure of concepts]($sus::boxed::DynConcept).
+/// The [`Box<T>`]($sus::boxed::Box) type for heap allocation, the
+/// [`Rc<T>`]($sus::boxed::Rc) and [`Arc<T>`]($sus::boxed::Arc) types for shared
+/// ownership, and other tools for
+/// [type-erasure of concepts]($sus::boxed::DynConcept).
 namespace boxed {}
 
 }  // namespace sus
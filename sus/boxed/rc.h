@@ -0,0 +1,175 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/boxed/__private/rc_inner.h"
+#include "sus/boxed/boxed.h"  // namespace docs.
+#include "sus/cmp/eq.h"
+#include "sus/cmp/ord.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/construct/default.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/option/option.h"
+#include "sus/ptr/copy.h"
+#include "sus/result/result.h"
+#include "sus/string/__private/any_formatter.h"
+#include "sus/string/__private/format_to_stream.h"
+
+namespace sus::boxed {
+
+template <class T>
+class Rc;
+template <class T>
+class RcWeak;
+
+/// A single-threaded reference-counted pointer. "Rc" stands for "Reference
+/// Counted".
+///
+/// An `Rc<T>` provides shared ownership of a value of type `T`, allocated on
+/// the heap. Calling [`clone`]($sus::boxed::Rc::clone) makes a new `Rc`
+/// pointing to the same allocation. When the last `Rc` pointing to the
+/// allocation is destroyed, the value stored in it is also destroyed.
+///
+/// `Rc` is similar to [`std::shared_ptr`](
+/// https://en.cppreference.com/w/cpp/memory/shared_ptr) with some differences:
+/// * The reference counts are not atomic, so `Rc` is cheaper to clone and
+///   destroy but can not be shared between threads. Use
+///   [`Arc`]($sus::boxed::Arc) for that.
+/// * The reference counts and the value are always in a single heap
+///   allocation, as with [`std::make_shared`](
+///   https://en.cppreference.com/w/cpp/memory/shared_ptr/make_shared), and
+///   the `Rc` is a single pointer.
+/// * Shared values are immutable. A `const T&` is given to the value, and
+///   mutation is done through [`get_mut`]($sus::boxed::Rc::get_mut) when
+///   the `Rc` is not shared, or through [`make_mut`]($sus::boxed::Rc::make_mut)
+///   which clones the value when it is shared.
+/// * Never null. As with [`Box`]($sus::boxed::Box), using a moved-from `Rc`
+///   will [`panic`]($sus_panic).
+/// * `Rc` is [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable), so a
+///   [`Vec`]($sus::collections::Vec)`<Rc<T>>` grows by copying bytes instead
+///   of touching each reference count.
+///
+/// Weak references, which do not keep the value alive, are made with
+/// [`downgrade`]($sus::boxed::Rc::downgrade) and held in an
+/// [`RcWeak`]($sus::boxed::RcWeak).
+///
+/// An `Rc<Slice<T>>` holds a sequence of elements whose length is chosen at
+/// runtime, stored in the same allocation as the reference counts. It is
+/// constructed from a [`Slice`]($sus::collections::Slice), whose elements are
+/// cloned, or from a [`Vec`]($sus::collections::Vec), whose elements are
+/// moved, and dereferences to a `Slice<T>`.
+///
+/// # Examples
+/// ```
+/// auto a = sus::boxed::Rc<std::string>::from("hello");
+/// auto b = a.clone();
+/// sus_check(a.ptr_eq(b));
+/// sus_check(a.strong_count() == 2u);
+///
+/// auto w = a.downgrade();
+/// sus_check(*w.upgrade().unwrap() == "hello");
+/// ```
+template <class T>
+class [[_sus_trivial_abi]] Rc final {
+  static_assert(!std::is_reference_v<T>, "Rc of a reference is not allowed.");
+  static_assert(!std::is_array_v<T>,
+                "Rc<T[N]> is not allowed, use Rc<Array<T, N>> or Rc<Slice<T>>");
+  static_assert(!std::is_const_v<T>,
+                "Rc inner type should not be const, it provides const access "
+                "to the value regardless.");
+
+ public:
+#define _self Rc
+#define _self_str "Rc"
+#define _weak RcWeak
+#define _counts RcCounts
+#include "__private/rc_methods.inc"
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(inner_));
+  // The moved-from state is `nullptr`, so the never-values start at the first
+  // aligned address after it.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, Rc, inner_,
+                                      alignof(Alloc), nullptr);
+  explicit Rc(::sus::mem::NeverValueConstructor) noexcept
+      : inner_(_sus_NeverValuePointer(0u)) {}
+};
+
+/// A weak reference to a value owned by [`Rc`]($sus::boxed::Rc).
+///
+/// An `RcWeak` does not keep the value alive, only the heap allocation that
+/// holds it. It is made with [`Rc::downgrade`]($sus::boxed::Rc::downgrade), and
+/// [`upgrade`]($sus::boxed::RcWeak::upgrade) returns an `Rc` to the value if it
+/// has not been destroyed yet. This is useful to break reference cycles, such
+/// as pointers from a child node to its parent.
+///
+/// A default-constructed or moved-from `RcWeak` is not attached to any
+/// allocation, and is never able to be upgraded.
+template <class T>
+class [[_sus_trivial_abi]] RcWeak final {
+ public:
+#define _self RcWeak
+#define _strong Rc
+#define _counts RcCounts
+#include "__private/rc_weak_methods.inc"
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(inner_));
+  // A `nullptr` is the unattached state, so the never-values start at the
+  // first aligned address after it.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, RcWeak, inner_,
+                                      alignof(Alloc), nullptr);
+  explicit RcWeak(::sus::mem::NeverValueConstructor) noexcept
+      : inner_(_sus_NeverValuePointer(0u)) {}
+};
+
+}  // namespace sus::boxed
+
+// fmt support.
+template <class T, class Char>
+struct fmt::formatter<::sus::boxed::Rc<T>, Char> {
+  template <class ParseContext>
+  constexpr auto parse(ParseContext& ctx) {
+    return underlying_.parse(ctx);
+  }
+
+  template <class FormatContext>
+  constexpr auto format(const ::sus::boxed::Rc<T>& t,
+                        FormatContext& ctx) const {
+    return underlying_.format(*t, ctx);
+  }
+
+ private:
+  ::sus::string::__private::AnyFormatter<T, Char> underlying_;
+};
+
+// Stream support.
+_sus_format_to_stream(sus::boxed, Rc, T);
+
+// Promote `Rc` into the `sus` namespace.
+namespace sus {
+using ::sus::boxed::Rc;
+}
@@ -0,0 +1,299 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/boxed/rc.h"
+
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/mem/size_of.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+
+namespace {
+using sus::boxed::Rc;
+using sus::boxed::RcWeak;
+
+static_assert(sus::mem::Clone<Rc<i32>>);
+static_assert(!sus::mem::Copy<Rc<i32>>);
+static_assert(sus::mem::Move<Rc<i32>>);
+static_assert(sus::mem::Clone<RcWeak<i32>>);
+static_assert(sus::construct::Default<RcWeak<i32>>);
+static_assert(!sus::construct::Default<Rc<i32>>);
+
+static_assert(sus::mem::size_of<Rc<i32>>() == sizeof(void*));
+static_assert(sus::mem::size_of<Rc<sus::Slice<i32>>>() == sizeof(void*));
+// For any T.
+static_assert(sus::mem::TriviallyRelocatable<Rc<i32>>);
+static_assert(sus::mem::TriviallyRelocatable<RcWeak<i32>>);
+static_assert(sus::mem::NeverValueField<Rc<i32>>);
+static_assert(sus::mem::NeverValueField<RcWeak<i32>>);
+static_assert(sus::mem::size_of<sus::Option<Rc<i32>>>() == sizeof(void*));
+
+static_assert(sus::cmp::Eq<Rc<i32>>);
+static_assert(sus::cmp::StrongOrd<Rc<i32>>);
+static_assert(sus::cmp::PartialOrd<Rc<f32>>);
+
+/// Counts how many times it is destroyed.
+struct Tracked {
+  explicit Tracked(i32 v, i32& drops) : v(v), drops(&drops) {}
+  Tracked(Tracked&& o) : v(o.v), drops(o.drops) { o.drops = nullptr; }
+  Tracked& operator=(Tracked&& o) {
+    v = o.v;
+    drops = sus::mem::replace(o.drops, nullptr);
+    return *this;
+  }
+  ~Tracked() {
+    if (drops) *drops += 1;
+  }
+  Tracked clone() const { return Tracked(v, *drops); }
+
+  i32 v;
+  i32* drops;
+};
+
+TEST(Rc, FromAndDeref) {
+  auto r = Rc<i32>::from(3);
+  EXPECT_EQ(*r, 3);
+  EXPECT_EQ(r.as_ref(), 3);
+  EXPECT_EQ(r.as_ptr(), &*r);
+
+  auto s = Rc<std::string>::from("hello");
+  EXPECT_EQ(s->size(), 5u);
+
+  auto i = Rc<i32>(sus::into(4));
+  EXPECT_EQ(*i, 4);
+}
+
+TEST(Rc, WithArgs) {
+  struct NoMove {
+    NoMove(i32 a, i32 b) : sum(a + b) {}
+    NoMove(NoMove&&) = delete;
+    i32 sum;
+  };
+  auto r = Rc<NoMove>::with_args(1, 2);
+  EXPECT_EQ(r->sum, 3);
+
+  auto d = Rc<i32>::with_default();
+  EXPECT_EQ(*d, 0);
+}
+
+TEST(Rc, Clone) {
+  i32 drops = 0;
+  {
+    auto a = Rc<Tracked>::with_args(1, drops);
+    EXPECT_EQ(a.strong_count(), 1u);
+    {
+      auto b = a.clone();
+      EXPECT_TRUE(a.ptr_eq(b));
+      EXPECT_EQ(a.strong_count(), 2u);
+      EXPECT_EQ(b.strong_count(), 2u);
+    }
+    EXPECT_EQ(drops, 0);
+    EXPECT_EQ(a.strong_count(), 1u);
+  }
+  EXPECT_EQ(drops, 1);
+}
+
+TEST(Rc, Move) {
+  auto a = Rc<i32>::from(2);
+  auto b = sus::move(a);
+  EXPECT_EQ(*b, 2);
+  EXPECT_EQ(b.strong_count(), 1u);
+
+  auto c = Rc<i32>::from(3);
+  c = sus::move(b);
+  EXPECT_EQ(*c, 2);
+}
+
+TEST(RcDeathTest, UseAfterMove) {
+  auto a = Rc<i32>::from(2);
+  auto b = sus::move(a);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH([[maybe_unused]] auto x = *a, "");
+  EXPECT_DEATH([[maybe_unused]] auto x = a.clone(), "");
+#endif
+}
+
+TEST(Rc, Weak) {
+  i32 drops = 0;
+  auto w = RcWeak<Tracked>();
+  EXPECT_EQ(w.upgrade(), sus::None);
+  EXPECT_EQ(w.strong_count(), 0u);
+  EXPECT_EQ(w.weak_count(), 0u);
+  {
+    auto a = Rc<Tracked>::with_args(4, drops);
+    w = a.downgrade();
+    EXPECT_EQ(a.weak_count(), 1u);
+    EXPECT_EQ(w.strong_count(), 1u);
+    EXPECT_EQ(w.weak_count(), 1u);
+
+    auto w2 = w.clone();
+    EXPECT_TRUE(w.ptr_eq(w2));
+    EXPECT_EQ(a.weak_count(), 2u);
+
+    auto up = w.upgrade();
+    EXPECT_TRUE(up.as_value().ptr_eq(a));
+    EXPECT_EQ(up.as_value()->v, 4);
+    EXPECT_EQ(a.strong_count(), 2u);
+  }
+  // The value is destroyed while a weak reference remains.
+  EXPECT_EQ(drops, 1);
+  EXPECT_EQ(w.upgrade(), sus::None);
+  EXPECT_EQ(w.strong_count(), 0u);
+  EXPECT_EQ(w.weak_count(), 0u);
+}
+
+TEST(Rc, WeakParent) {
+  struct Node {
+    Node(i32& drops, RcWeak<Node> parent)
+        : drops(drops), parent(sus::move(parent)) {}
+    ~Node() { drops += 1; }
+    i32& drops;
+    RcWeak<Node> parent;
+  };
+  i32 drops = 0;
+  auto root = Rc<Node>::with_args(drops, RcWeak<Node>());
+  auto child = Rc<Node>::with_args(drops, root.downgrade());
+  EXPECT_TRUE(child->parent.upgrade().unwrap().ptr_eq(root));
+  // The child's weak reference does not keep the parent alive.
+  root = Rc<Node>::with_args(drops, RcWeak<Node>());
+  EXPECT_EQ(drops, 1);
+  EXPECT_EQ(child->parent.upgrade(), sus::None);
+}
+
+TEST(Rc, GetMut) {
+  auto a = Rc<i32>::from(1);
+  EXPECT_EQ(a.get_mut().unwrap(), 1);
+  a.get_mut().unwrap() = 5;
+  EXPECT_EQ(*a, 5);
+
+  auto b = a.clone();
+  EXPECT_EQ(a.get_mut(), sus::None);
+  {
+    auto d = sus::move(b);
+  }
+  auto w = a.downgrade();
+  EXPECT_EQ(a.get_mut(), sus::None);
+  w = RcWeak<i32>();
+  EXPECT_EQ(a.get_mut().unwrap(), 5);
+}
+
+TEST(Rc, MakeMut) {
+  auto data = Rc<i32>::from(5);
+  const i32* first = data.as_ptr();
+  data.make_mut() += 1;
+  EXPECT_EQ(data.as_ptr(), first);
+  auto other = data.clone();
+  data.make_mut() += 1;
+  EXPECT_NE(data.as_ptr(), first);
+  EXPECT_EQ(other.as_ptr(), first);
+  data.make_mut() += 1;
+  other.make_mut() *= 2;
+  EXPECT_EQ(other.as_ptr(), first);
+  EXPECT_EQ(*data, 8);
+  EXPECT_EQ(*other, 12);
+}
+
+TEST(Rc, MakeMutDetachesWeak) {
+  i32 drops = 0;
+  auto a = Rc<Tracked>::with_args(2, drops);
+  auto w = a.downgrade();
+  a.make_mut().v = 3;
+  EXPECT_EQ(w.upgrade(), sus::None);
+  EXPECT_EQ(a->v, 3);
+  EXPECT_EQ(a.weak_count(), 0u);
+  // The moved-from value was destroyed, the moved-to value is alive.
+  EXPECT_EQ(drops, 0);
+}
+
+TEST(Rc, IntoInner) {
+  auto a = Rc<std::string>::from("hi");
+  auto b = a.clone();
+  EXPECT_EQ(sus::move(a).into_inner(), sus::None);
+  EXPECT_EQ(sus::move(b).into_inner(), sus::some("hi"));
+}
+
+TEST(Rc, TryUnwrap) {
+  auto a = Rc<std::string>::from("hi");
+  auto b = a.clone();
+  auto err = sus::move(a).try_unwrap();
+  EXPECT_TRUE(err.is_err());
+  a = sus::move(err).unwrap_err();
+  EXPECT_EQ(a.strong_count(), 2u);
+  b = Rc<std::string>::from("other");
+
+  auto w = a.downgrade();
+  EXPECT_EQ(sus::move(a).try_unwrap().unwrap(), "hi");
+  EXPECT_EQ(w.upgrade(), sus::None);
+}
+
+TEST(Rc, Slice) {
+  i32 arr[] = {1, 2, 3};
+  auto s = Rc<sus::Slice<i32>>::from(sus::Slice<i32>::from(arr));
+  EXPECT_EQ(s->len(), 3u);
+  EXPECT_EQ((*s)[2u], 3);
+  EXPECT_NE(s->as_ptr(), arr);
+  auto s2 = s.clone();
+  EXPECT_EQ(s2->as_ptr(), s->as_ptr());
+  EXPECT_EQ(*s2, sus::Slice<i32>::from(arr));
+
+  auto empty = Rc<sus::Slice<i32>>::from(sus::Slice<i32>());
+  EXPECT_EQ(empty->len(), 0u);
+}
+
+TEST(Rc, SliceFromVec) {
+  auto v = sus::Vec<std::string>("a", "b");
+  auto s = Rc<sus::Slice<std::string>>::from(sus::move(v));
+  EXPECT_EQ(s->len(), 2u);
+  EXPECT_EQ((*s)[1u], "b");
+
+  i32 drops = 0;
+  {
+    auto tv = sus::Vec<Tracked>();
+    tv.push(Tracked(1, drops));
+    tv.push(Tracked(2, drops));
+    auto ts = Rc<sus::Slice<Tracked>>::from(sus::move(tv));
+    auto w = ts.downgrade();
+    EXPECT_EQ((*ts)[0u].v + (*ts)[1u].v, 3);
+  }
+  EXPECT_EQ(drops, 2);
+
+  auto aligned = sus::Vec<u64>(1_u64, 2_u64);
+  auto as = Rc<sus::Slice<u64>>::from(sus::move(aligned));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(as->as_ptr()) % alignof(u64), 0u);
+  EXPECT_EQ(as->sum(), 3_u64);
+}
+
+TEST(Rc, VecOfRc) {
+  auto v = sus::Vec<Rc<i32>>();
+  auto first = Rc<i32>::from(7);
+  for (usize i; i < 100u; i += 1u) v.push(first.clone());
+  EXPECT_EQ(first.strong_count(), 101u);
+  v.clear();
+  EXPECT_EQ(first.strong_count(), 1u);
+}
+
+TEST(Rc, Eq) {
+  EXPECT_EQ(Rc<i32>::from(1), Rc<i32>::from(1));
+  EXPECT_NE(Rc<i32>::from(1), Rc<i32>::from(2));
+  EXPECT_LT(Rc<i32>::from(1), Rc<i32>::from(2));
+}
+
+TEST(Rc, fmt) {
+  EXPECT_EQ(fmt::format("{}", Rc<i32>::from(12345)), "12345");
+}
+
+}  // namespace
@@ -0,0 +1,266 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <concepts>
+#include <new>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/boxed/boxed.h"  // namespace docs.
+#include "sus/boxed/dyn.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/fn/fn_dyn.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+
+namespace sus::boxed {
+
+/// An owned type-erased concept object, which is stored inside the `SmallBox`
+/// when it is small enough and on the heap otherwise.
+///
+/// A `SmallBox<DynC>` can be used in place of a
+/// [`Box`]($sus::boxed::Box)`<DynC>` to hold an object satisfying a concept
+/// `C` through the [`DynConcept`]($sus::boxed::DynConcept) type-erasure class
+/// `DynC`, such as [`DynFn`]($sus::fn::DynFn) or
+/// [`DynError`]($sus::error::DynError). It is constructed in the same ways,
+/// with [`from`]($sus::boxed::SmallBox::from) or through
+/// [`sus::into()`]($sus::construct::into).
+///
+/// The type-erased object is constructed in the `Bytes` of storage inside the
+/// `SmallBox` without a heap allocation when:
+/// * It fits in `Bytes` and its alignment is no larger than a pointer's.
+/// * The concrete type is [`TriviallyRelocatable`](
+///   $sus::mem::TriviallyRelocatable), as the `SmallBox` moves the object
+///   between its storage and another's by copying its bytes.
+///
+/// Otherwise the object is allocated on the heap as with
+/// [`Box`]($sus::boxed::Box). In both cases it is accessed through the same
+/// pointer to `DynC`, so calls through the `SmallBox` are a single virtual
+/// dispatch with no branch on where the object is stored.
+///
+/// The default `Bytes` holds the type-erased object's virtual table pointer
+/// and two pointers of data, such as a lambda that captures two references.
+///
+/// Like [`Box`]($sus::boxed::Box), a moved-from `SmallBox` may not be used
+/// except to be assigned to or destroyed. It will [`panic`]($sus_panic)
+/// otherwise.
+///
+/// # Examples
+///
+/// ```
+/// auto f = sus::boxed::SmallBox<sus::fn::DynFn<i32(i32)>>::from(
+///     [](i32 i) { return i * 2; });
+/// sus_check(f.is_inline());
+/// sus_check(f(3) == 6);
+/// ```
+template <class DynC, size_t Bytes = 3u * sizeof(void*)>
+class SmallBox final {
+  static_assert(std::same_as<DynC, std::remove_cvref_t<DynC>>,
+                "SmallBox<DynC> requires a non-qualified, non-reference DynC.");
+  static_assert(Bytes >= sizeof(void*),
+                "SmallBox needs room for at least a virtual table pointer.");
+
+ public:
+  /// Whether a concrete type `U` will be stored inside the `SmallBox` rather
+  /// than on the heap when type-erased into `DynC`.
+  template <class U>
+  static constexpr bool stores_inline =
+      sizeof(typename DynC::template DynTyped<U, U>) <= Bytes &&
+      alignof(typename DynC::template DynTyped<U, U>) <= alignof(void*) &&
+      ::sus::mem::TriviallyRelocatable<U>;
+
+  /// Type-erases `u` into `DynC`, constructing it inside the `SmallBox` if
+  /// it fits, or on the heap otherwise.
+  ///
+  /// Satisfies the [`From<U>`]($sus::construct::From) concept for
+  /// `SmallBox<DynC>` from any type satisfying the concept that `DynC`
+  /// type-erases.
+  template <::sus::mem::Move U>
+  static SmallBox from(U u) noexcept
+    requires(std::same_as<U, std::remove_cvref_t<U>> &&  //
+             DynConcept<DynC, U> &&                      //
+             DynC::template SatisfiesConcept<U>)
+  {
+    using DynTyped = DynC::template DynTyped<U, U>;
+    auto b = SmallBox(FROM_POINTER, nullptr);
+    if constexpr (stores_inline<U>) {
+      // This implicitly upcasts to the `DynConcept` type `DynC`.
+      b.ptr_ = new (b.storage_) DynTyped(::sus::move(u));
+    } else {
+      b.ptr_ = new DynTyped(::sus::move(u));
+    }
+    return b;
+  }
+
+  /// Destroys the type-erased object, and frees its heap memory if it was not
+  /// stored inline.
+  ///
+  /// Does nothing if the `SmallBox` was moved-from.
+  ~SmallBox() noexcept { destroy(); }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `SmallBox`.
+  ///
+  /// An object stored inline is relocated into this `SmallBox`, while an
+  /// object on the heap stays where it is.
+  SmallBox(SmallBox&& o) noexcept : ptr_(nullptr) {
+    sus_check_with_message(o.ptr_, "SmallBox used after move");
+    take_from(o);
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `SmallBox`.
+  SmallBox& operator=(SmallBox&& o) noexcept {
+    sus_check_with_message(o.ptr_, "SmallBox used after move");
+    if (this != &o) {
+      destroy();
+      take_from(o);
+    }
+    return *this;
+  }
+
+  SmallBox(const SmallBox&) = delete;
+  SmallBox& operator=(const SmallBox&) = delete;
+
+  /// Returns whether the type-erased object is stored inside the `SmallBox`,
+  /// rather than on the heap.
+  _sus_pure bool is_inline() const noexcept {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return points_inline();
+  }
+
+  _sus_pure const DynC& operator*() const noexcept {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return *ptr_;
+  }
+  _sus_pure DynC& operator*() noexcept {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return *ptr_;
+  }
+  _sus_pure const DynC* operator->() const noexcept {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return ptr_;
+  }
+  _sus_pure DynC* operator->() noexcept {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return ptr_;
+  }
+
+  /// Returns a const reference to the type-erased object.
+  const DynC& as_ref() const& noexcept { return **this; }
+  const DynC& as_ref() && noexcept = delete;
+  /// Returns a mutable reference to the type-erased object.
+  DynC& as_mut() & noexcept { return **this; }
+
+  /// A `SmallBox` holding a type-erased function type will satisfy the fn
+  /// concepts and can be used as a function type, in the same way as
+  /// [`Box`]($sus::boxed::Box).
+  ///
+  /// A `SmallBox<`[`DynFnOnce`]($sus::fn::DynFnOnce)`>` must be moved from
+  /// when called, and will destroy the underlying function object after the
+  /// call completes.
+  template <class... Args>
+  sus::fn::Return<DynC, Args...> operator()(Args&&... args) const&
+    requires(DynC::IsDynFn &&
+             ::sus::fn::Fn<DynC, sus::fn::Return<DynC, Args...>(Args...)>)
+  {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return ::sus::fn::call(*ptr_, ::sus::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  sus::fn::ReturnMut<DynC, Args...> operator()(Args&&... args) &
+    requires(DynC::IsDynFn &&  //
+             ::sus::fn::FnMut<DynC,
+                              sus::fn::ReturnMut<DynC, Args...>(Args...)>)
+  {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    return ::sus::fn::call_mut(*ptr_, ::sus::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  sus::fn::ReturnOnce<DynC, Args...> operator()(Args&&... args) &&
+    requires(DynC::IsDynFn &&  //
+             ::sus::fn::FnOnce<DynC,
+                               sus::fn::ReturnOnce<DynC, Args...>(Args...)>)
+  {
+    sus_check_with_message(ptr_, "SmallBox used after move");
+    struct Cleanup {
+      ~Cleanup() noexcept { b.destroy(); }
+      SmallBox& b;
+    };
+    auto cleanup = Cleanup(*this);
+    return ::sus::fn::call_once(::sus::move(*ptr_),
+                                ::sus::forward<Args>(args)...);
+  }
+
+ private:
+  enum FromPointer { FROM_POINTER };
+  explicit SmallBox(FromPointer, DynC* ptr) noexcept : ptr_(ptr) {}
+
+  bool points_inline() const noexcept {
+    const auto p = reinterpret_cast<uintptr_t>(ptr_);
+    const auto s = reinterpret_cast<uintptr_t>(storage_);
+    return p - s < uintptr_t{Bytes};
+  }
+
+  void destroy() noexcept {
+    if (ptr_ == nullptr) return;
+    // The destructor of `DynC` is virtual, and destroys the concrete type.
+    if (points_inline())
+      ptr_->~DynC();
+    else
+      delete ptr_;
+    ptr_ = nullptr;
+  }
+
+  /// Takes ownership of the object in `o`, which must not be moved-from.
+  void take_from(SmallBox& o) noexcept {
+    if (o.points_inline()) {
+      // SAFETY: Only objects of a `TriviallyRelocatable` concrete type are
+      // stored inline, and the rest of the type-erased object is its virtual
+      // table pointer, so the object is relocated by copying its bytes. The
+      // `DynC` may not be at the start of the object, so its offset is kept.
+      const auto offset = reinterpret_cast<const char*>(o.ptr_) - o.storage_;
+      memcpy(storage_, o.storage_, Bytes);
+      ptr_ = reinterpret_cast<DynC*>(storage_ + offset);
+      o.ptr_ = nullptr;
+    } else {
+      ptr_ = ::sus::mem::replace(o.ptr_, nullptr);
+    }
+  }
+
+  // Points into `storage_` or to a heap allocation, or is null when moved-from.
+  DynC* ptr_;
+  alignas(alignof(void*)) char storage_[Bytes];
+
+  // The pointer is never null until it is moved-from.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, SmallBox, ptr_,
+                                      alignof(DynC), nullptr);
+  explicit SmallBox(::sus::mem::NeverValueConstructor) noexcept
+      : ptr_(_sus_NeverValuePointer(0u)) {}
+};
+
+}  // namespace sus::boxed
+
+// Promote `SmallBox` into the `sus` namespace.
+namespace sus {
+using ::sus::boxed::SmallBox;
+}
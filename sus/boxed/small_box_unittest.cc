@@ -0,0 +1,183 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/boxed/small_box.h"
+
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/boxed/box.h"
+#include "sus/fn/fn.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+
+namespace {
+using sus::boxed::SmallBox;
+using sus::fn::DynFn;
+using sus::fn::DynFnMut;
+using sus::fn::DynFnOnce;
+
+/// Some concept which requires a function.
+template <class T>
+concept C = requires(const T& c) {
+  { c.concept_fn() } -> std::same_as<i32>;
+};
+
+template <C T, class Store>
+class DynCTyped;
+
+class DynC {
+  sus_dyn_concept(C, DynC, DynCTyped);
+
+ public:
+  virtual i32 concept_fn() const = 0;
+};
+
+template <C T, class Store>
+class DynCTyped final : public DynC {
+  sus_dyn_concept_typed(C, DynC, DynCTyped, c_);
+
+ public:
+  i32 concept_fn() const override { return c_.concept_fn(); }
+};
+
+struct Small {
+  i32 concept_fn() const { return i; }
+  i32 i;
+};
+struct Large {
+  i32 concept_fn() const { return i; }
+  i32 i;
+  char padding[64];
+};
+struct Adder {
+  void operator()(i32 i) { *sum += i; }
+  i32* sum;
+};
+struct Counted {
+  Counted(i32& drops) : drops(&drops) {}
+  Counted(Counted&& o) : drops(sus::mem::replace(o.drops, nullptr)) {}
+  Counted& operator=(Counted&& o) {
+    drops = sus::mem::replace(o.drops, nullptr);
+    return *this;
+  }
+  ~Counted() {
+    if (drops) *drops += 1;
+  }
+  i32 concept_fn() const { return 7; }
+  i32* drops;
+};
+
+static_assert(sus::mem::Move<SmallBox<DynC>>);
+static_assert(!sus::mem::Copy<SmallBox<DynC>>);
+static_assert(sus::construct::From<SmallBox<DynC>, Small>);
+static_assert(sus::construct::Into<Small, SmallBox<DynC>>);
+static_assert(sus::mem::NeverValueField<SmallBox<DynC>>);
+static_assert(sizeof(sus::Option<SmallBox<DynC>>) == sizeof(SmallBox<DynC>));
+
+static_assert(SmallBox<DynC>::stores_inline<Small>);
+static_assert(!SmallBox<DynC>::stores_inline<Large>);
+static_assert(SmallBox<DynC, 128u>::stores_inline<Large>);
+// Types which can not be relocated by copying their bytes are on the heap.
+static_assert(!SmallBox<DynC>::stores_inline<Counted>);
+
+TEST(SmallBox, Inline) {
+  auto b = SmallBox<DynC>::from(Small(3));
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(b->concept_fn(), 3);
+  EXPECT_EQ((*b).concept_fn(), 3);
+  EXPECT_EQ(b.as_ref().concept_fn(), 3);
+
+  SmallBox<DynC> i = sus::into(Small(4));
+  EXPECT_TRUE(i.is_inline());
+  EXPECT_EQ(i->concept_fn(), 4);
+}
+
+TEST(SmallBox, Heap) {
+  auto b = SmallBox<DynC>::from(Large(5, {}));
+  EXPECT_FALSE(b.is_inline());
+  EXPECT_EQ(b->concept_fn(), 5);
+
+  auto big = SmallBox<DynC, 128u>::from(Large(6, {}));
+  EXPECT_TRUE(big.is_inline());
+  EXPECT_EQ(big->concept_fn(), 6);
+}
+
+TEST(SmallBox, Move) {
+  auto a = SmallBox<DynC>::from(Small(3));
+  auto b = sus::move(a);
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(b->concept_fn(), 3);
+
+  auto h = SmallBox<DynC>::from(Large(5, {}));
+  const DynC* heap = h.operator->();
+  b = sus::move(h);
+  EXPECT_FALSE(b.is_inline());
+  // The heap object is not moved.
+  EXPECT_EQ(b.operator->(), heap);
+  EXPECT_EQ(b->concept_fn(), 5);
+
+  b = SmallBox<DynC>::from(Small(9));
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(b->concept_fn(), 9);
+}
+
+TEST(SmallBox, Destroy) {
+  i32 drops;
+  {
+    auto b = SmallBox<DynC>::from(Counted(drops));
+    EXPECT_EQ(drops, 0);
+    auto c = sus::move(b);
+    EXPECT_EQ(c->concept_fn(), 7);
+  }
+  EXPECT_EQ(drops, 1);
+  {
+    auto b = SmallBox<DynC>::from(Counted(drops));
+    b = SmallBox<DynC>::from(Small(1));
+    EXPECT_EQ(drops, 2);
+  }
+  EXPECT_EQ(drops, 2);
+}
+
+TEST(SmallBox, Fn) {
+  i32 sum;
+  auto f = SmallBox<DynFnMut<void(i32)>>::from(Adder(&sum));
+  EXPECT_TRUE(f.is_inline());
+  f(2);
+  f(3);
+  EXPECT_EQ(sum, 5);
+  static_assert(sus::fn::FnMut<SmallBox<DynFnMut<void(i32)>>, void(i32)>);
+
+  const auto g = SmallBox<DynFn<i32(i32)>>::from([](i32 i) { return i * 2; });
+  EXPECT_EQ(g(4), 8);
+  static_assert(sus::fn::Fn<SmallBox<DynFn<i32(i32)>>, i32(i32)>);
+
+  auto h = SmallBox<DynFnOnce<std::string()>>::from(
+      []() { return std::string("hello"); });
+  EXPECT_EQ(sus::move(h)(), "hello");
+  static_assert(
+      sus::fn::FnOnce<SmallBox<DynFnOnce<std::string()>>, std::string()>);
+}
+
+TEST(SmallBoxDeathTest, UseAfterMove) {
+  auto b = SmallBox<DynC>::from(Small(3));
+  auto c = sus::move(b);
+
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH({ [[maybe_unused]] auto x = sus::move(b); }, "used after move");
+  EXPECT_DEATH(b->concept_fn(), "used after move");
+#endif
+}
+
+}  // namespace
@@ -0,0 +1,236 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <compare>
+#include <memory>
+#include <type_traits>
+
+#include "sus/choice/__private/nothing.h"
+#include "sus/choice/__private/storage.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/forward.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/relocate.h"
+#include "sus/tuple/tuple.h"
+
+namespace sus::choice_type::__private {
+
+/// Storage for a `Choice` with two tags, where one tag has no value and the
+/// other has a single value of type `T` with a never-value field.
+///
+/// The tag is not stored separately. The tag at `DataIndex` is active when the
+/// `T` is constructed, and the other tag is active when the `T` is in its
+/// never-value state, so the `Choice` is the same size as `T`.
+///
+/// The storage provides the same operations as the `Storage` union which the
+/// `Choice` uses otherwise, but ignores indices that refer to the tag with no
+/// value. Unlike the `Storage` union, it always holds a `T`, in one of its two
+/// states, and destroys it from its own destructor.
+template <size_t DataIndex, class T>
+struct NicheStorage {
+  static_assert(DataIndex <= 1u);
+
+  constexpr NicheStorage() noexcept : access_() {}
+  constexpr NicheStorage(::sus::mem::NeverValueIndex i) noexcept
+      : access_(::sus::mem::NeverValueIndex{i.index + 1u}) {}
+  ~NicheStorage()
+    requires(std::is_trivially_destructible_v<T>)
+  = default;
+  constexpr ~NicheStorage()
+    requires(!std::is_trivially_destructible_v<T>)
+  {
+    if (!access_.is_constructed())
+      access_.set_destroy_value(::sus::marker::unsafe_fn);
+    access_.~NeverValueAccess();
+  }
+
+  NicheStorage(const NicheStorage&)
+    requires(std::is_trivially_copy_constructible_v<T>)
+  = default;
+  NicheStorage& operator=(const NicheStorage&)
+    requires(std::is_trivially_copy_assignable_v<T>)
+  = default;
+  NicheStorage(NicheStorage&&)
+    requires(std::is_trivially_move_constructible_v<T>)
+  = default;
+  NicheStorage& operator=(NicheStorage&&)
+    requires(std::is_trivially_move_assignable_v<T>)
+  = default;
+
+  /// The index of the active tag.
+  _sus_pure constexpr size_t index() const noexcept {
+    return access_.is_constructed() ? DataIndex : 1u - DataIndex;
+  }
+
+  inline constexpr void activate_for_construct(size_t index) {
+    if (index == DataIndex) destroy_never_value();
+  }
+  template <class U>
+  inline constexpr void construct(U&& value) {
+    std::construct_at(&access_, ::sus::forward<U>(value));
+  }
+  inline constexpr void assign(T&& value) {
+    access_.as_inner_mut() = ::sus::move(value);
+  }
+  inline constexpr void move_construct(size_t index, NicheStorage&& from) {
+    if (index == DataIndex) {
+      destroy_never_value();
+      std::construct_at(&access_, ::sus::move(from.access_.as_inner_mut()));
+    }
+  }
+  inline constexpr void move_assign(size_t index, NicheStorage&& from) {
+    if (index == DataIndex)
+      access_.as_inner_mut() = ::sus::move(from.access_.as_inner_mut());
+  }
+  inline constexpr void copy_construct(size_t index, const NicheStorage& from) {
+    if (index == DataIndex) {
+      destroy_never_value();
+      std::construct_at(&access_, from.access_.as_inner());
+    }
+  }
+  inline constexpr void copy_assign(size_t index, const NicheStorage& from) {
+    if (index == DataIndex) access_.as_inner_mut() = from.access_.as_inner();
+  }
+  inline constexpr void clone_construct(size_t index,
+                                        const NicheStorage& from) {
+    if (index == DataIndex) {
+      auto x = ::sus::clone(from.access_.as_inner());
+      destroy_never_value();
+      std::construct_at(&access_, ::sus::move(x));
+    }
+  }
+  /// Destroys the value for the tag at `index`, which leaves the `T` in its
+  /// never-value state.
+  inline constexpr void destroy(size_t index) {
+    if (index == DataIndex) {
+      access_.~NeverValueAccess();
+      std::construct_at(&access_);
+    }
+  }
+  inline constexpr bool eq(size_t index, const NicheStorage& other) const& {
+    if (index == DataIndex) return as() == other.as();
+    return true;
+  }
+  inline constexpr auto strong_ord(size_t index,
+                                   const NicheStorage& other) const& {
+    if (index == DataIndex) return std::strong_order(as(), other.as());
+    return std::strong_ordering::equivalent;
+  }
+  inline constexpr auto weak_ord(size_t index,
+                                 const NicheStorage& other) const& {
+    if (index == DataIndex) return std::weak_order(as(), other.as());
+    return std::weak_ordering::equivalent;
+  }
+  inline constexpr auto partial_ord(size_t index,
+                                    const NicheStorage& other) const& {
+    if (index == DataIndex) return std::partial_order(as(), other.as());
+    return std::partial_ordering::equivalent;
+  }
+
+  inline constexpr const T& as() const& { return access_.as_inner(); }
+  inline constexpr T& as_mut() & { return access_.as_inner_mut(); }
+  inline constexpr T&& into_inner() && {
+    return ::sus::move(access_.as_inner_mut());
+  }
+
+  // The first never-value of `T` represents the tag with no value, and the rest
+  // of them are used as the never-values of the `Choice`.
+  static constexpr size_t kNeverValueCount =
+      ::sus::mem::never_value_count<T>() - 1u;
+
+  _sus_pure constexpr bool is_never_value() const noexcept {
+    return !access_.is_constructed() && access_.never_value_index() > 0u;
+  }
+  _sus_pure constexpr size_t never_value_index() const noexcept {
+    return access_.never_value_index() - 1u;
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn, i + 1u);
+  }
+  constexpr void set_never_value_destroy_value() noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn, 0u);
+  }
+
+ private:
+  using NeverValueAccess = ::sus::mem::__private::NeverValueAccess<T>;
+
+  /// Ends the lifetime of the `T` in its never-value state, so that a value can
+  /// be constructed in its place.
+  constexpr void destroy_never_value() noexcept {
+    access_.set_destroy_value(::sus::marker::unsafe_fn);
+    access_.~NeverValueAccess();
+  }
+
+  union {
+    NeverValueAccess access_;
+  };
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(access_));
+};
+
+/// Chooses the storage for a `Choice` with the storage types `Ts...`.
+///
+/// A `Choice` keeps its tag inside the never-value field of its value, in a
+/// `NicheStorage`, when it has exactly two tags, one of them with no value and
+/// the other with a single (non-reference) value that has a never-value field.
+/// Otherwise it uses the `Storage` union along with a separate index.
+template <class... Ts>
+struct ChoiceNiche {
+  static constexpr bool packed = false;
+  using Storage = ::sus::choice_type::__private::Storage<0u, Ts...>;
+};
+
+template <class T>
+  requires(!std::is_reference_v<T> && ::sus::mem::NeverValueField<T>)
+struct ChoiceNiche<::sus::Tuple<T>, Nothing> {
+  static constexpr bool packed = true;
+  using Storage = NicheStorage<0u, T>;
+};
+
+template <class T>
+  requires(!std::is_reference_v<T> && ::sus::mem::NeverValueField<T>)
+struct ChoiceNiche<Nothing, ::sus::Tuple<T>> {
+  static constexpr bool packed = true;
+  using Storage = NicheStorage<1u, T>;
+};
+
+/// Stands in for the index of a `Choice` when the tag is packed into the
+/// never-value field of its value.
+struct NicheIndex {};
+
+template <size_t I, size_t DataIndex, class T>
+static constexpr const auto& find_choice_storage(
+    const NicheStorage<DataIndex, T>& storage) {
+  static_assert(I == DataIndex);
+  return storage;
+}
+
+template <size_t I, size_t DataIndex, class T>
+static constexpr auto& find_choice_storage_mut(
+    NicheStorage<DataIndex, T>& storage) {
+  static_assert(I == DataIndex);
+  return storage;
+}
+
+}  // namespace sus::choice_type::__private
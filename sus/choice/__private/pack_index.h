@@ -16,6 +16,8 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <utility>  // TODO: Replace std::index_sequence to remove this header.
+
 namespace sus::choice_type::__private {
 
 template <class... Ts>
@@ -29,20 +31,40 @@ struct PackFirstHelper<T, Ts...> {
 template <class... Ts>
 using PackFirst = PackFirstHelper<Ts...>::type;
 
-template <size_t I, class... Ts>
-struct PackIthHelper;
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define _sus_has_type_pack_element 1
+#endif
+#endif
 
-template <size_t I, class T, class... Ts>
-struct PackIthHelper<I, T, Ts...> {
-  using type = PackIthHelper<I - 1, Ts...>::type;
-};
-
-template <class T, class... Ts>
-struct PackIthHelper<0, T, Ts...> {
+// Neither way of finding the `I`th type instantiates a helper for each type
+// before it, which would add up when every element of a large pack is looked
+// up.
+#if defined(_sus_has_type_pack_element)
+template <size_t I, class... Ts>
+using PackIth = __type_pack_element<I, Ts...>;
+#undef _sus_has_type_pack_element
+#else
+template <size_t I, class T>
+struct PackIthAt {
   using type = T;
 };
 
+template <class Is, class... Ts>
+struct PackIthIndex;
+
+template <size_t... Is, class... Ts>
+struct PackIthIndex<std::index_sequence<Is...>, Ts...>
+    : PackIthAt<Is, Ts>... {};
+
+// Finds the `I`th type by overload resolution to the base class with index `I`.
+template <size_t I, class T>
+PackIthAt<I, T> pack_ith_at(const PackIthAt<I, T>*);
+
 template <size_t I, class... Ts>
-using PackIth = PackIthHelper<I, Ts...>::type;
+using PackIth = decltype(pack_ith_at<I>(
+    static_cast<const PackIthIndex<std::make_index_sequence<sizeof...(Ts)>,
+                                   Ts...>*>(nullptr)))::type;
+#endif
 
 }  // namespace sus::choice_type::__private
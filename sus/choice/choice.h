@@ -24,6 +24,7 @@
 #include "sus/choice/__private/all_values_are_unique.h"
 #include "sus/choice/__private/index_of_value.h"
 #include "sus/choice/__private/index_type.h"
+#include "sus/choice/__private/niche_storage.h"
 #include "sus/choice/__private/ops_concepts.h"
 #include "sus/choice/__private/pack_index.h"
 #include "sus/choice/__private/storage.h"
@@ -34,6 +35,7 @@
 #include "sus/lib/__private/forward_decl.h"
 #include "sus/macros/lifetimebound.h"
 #include "sus/macros/no_unique_address.h"
+#include "sus/macros/pure.h"
 #include "sus/marker/unsafe.h"
 #include "sus/mem/clone.h"
 #include "sus/mem/copy.h"
@@ -126,6 +128,13 @@ struct CanConvertToStorage<I, ::sus::tuple_type::Tuple<Ts...>, U> {
 ///   reference to the values attached to the tag if its currently active, and
 ///   returns `None` if the tag is not active.
 ///
+/// A `Choice` with two tags, where one tag has no value and the other has a
+/// single value with a [never-value field]($sus::mem::NeverValueField), such
+/// as a [`Box`]($sus::boxed::Box) or a [`NonNull`]($sus::ptr::NonNull), keeps
+/// its tag in the never-value field of that value. It is then the same size as
+/// the value, but can not detect use after it is moved from, and has no
+/// never-value field of its own.
+///
 /// # Examples
 /// This `Choice` holds either a [`u64`]($sus::num::u64) with
 /// the `First` tag or a [`u32`]($sus::num::u32) with the `Second` tag.
@@ -193,7 +202,11 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
       "The number of types and values in the Choice don't match. Use "
       "`sus_choice_types()` to define the Choice's value-type pairings.");
 
-  using Storage = __private::Storage<0, Ts...>;
+  // When the tag can be stored in the never-value field of the `Choice`'s only
+  // value, there is no separate index.
+  static constexpr bool kNichePacked = __private::ChoiceNiche<Ts...>::packed;
+
+  using Storage = typename __private::ChoiceNiche<Ts...>::Storage;
   using TagsType = __private::PackFirst<decltype(Tags)...>;
 
   static_assert((... && std::same_as<TagsType, decltype(Tags)>),
@@ -355,8 +368,12 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires(!(std::is_trivially_destructible_v<TagsType> && ... &&
                std::is_trivially_destructible_v<Ts>))
   {
-    if (index_ != kUseAfterMove && index_ != kNeverValue)
-      storage_.destroy(index_);
+    // The `NicheStorage` destroys its value itself, as it is never left without
+    // one.
+    if constexpr (!kNichePacked) {
+      if (index_ != kUseAfterMove && index_ != kNeverValue)
+        storage_.destroy(index_);
+    }
   }
 
   /// Move constructor.
@@ -374,12 +391,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires((... && ::sus::mem::Move<Ts>) &&
              !(std::is_trivially_move_constructible_v<TagsType> && ... &&
                std::is_trivially_move_constructible_v<Ts>))
-      : index_(::sus::mem::replace(o.index_,
-                                   // Attempt to catch use-after-move by setting
-                                   // the tag to an unused value.
-                                   kUseAfterMove)) {
-    sus_check(index_ != kUseAfterMove);
-    storage_.move_construct(index_, ::sus::move(o.storage_));
+  {
+    const IndexType i = o.active_index();
+    sus_check(i != kUseAfterMove);
+    // Attempt to catch use-after-move by setting the tag to an unused value.
+    o.set_index(kUseAfterMove);
+    set_index(i);
+    storage_.move_construct(i, ::sus::move(o.storage_));
   }
   /// #[doc.overloads=move]
   Choice(Choice&& o)
@@ -402,15 +420,17 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
              !(std::is_trivially_move_assignable_v<TagsType> && ... &&
                std::is_trivially_move_assignable_v<Ts>))
   {
-    sus_check(o.index_ != kUseAfterMove);
-    if (index_ == o.index_) {
-      storage_.move_assign(index_, ::sus::move(o.storage_));
+    const IndexType i = active_index();
+    const IndexType o_i = o.active_index();
+    sus_check(o_i != kUseAfterMove);
+    if (i == o_i) {
+      storage_.move_assign(i, ::sus::move(o.storage_));
     } else {
-      if (index_ != kUseAfterMove) storage_.destroy(index_);
-      index_ = ::sus::move(o.index_);
-      storage_.move_construct(index_, ::sus::move(o.storage_));
+      if (i != kUseAfterMove) storage_.destroy(i);
+      set_index(o_i);
+      storage_.move_construct(o_i, ::sus::move(o.storage_));
     }
-    o.index_ = kUseAfterMove;
+    o.set_index(kUseAfterMove);
     return *this;
   }
   /// #[doc.overloads=move]
@@ -433,9 +453,11 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires((... && ::sus::mem::Copy<Ts>) &&
              !(std::is_trivially_copy_constructible_v<TagsType> && ... &&
                std::is_trivially_copy_constructible_v<Ts>))
-      : index_(o.index_) {
-    sus_check(o.index_ != kUseAfterMove);
-    storage_.copy_construct(index_, o.storage_);
+  {
+    const IndexType i = o.active_index();
+    sus_check(i != kUseAfterMove);
+    set_index(i);
+    storage_.copy_construct(i, o.storage_);
   }
   /// #[doc.overloads=copy]
   Choice(const Choice& o)
@@ -458,13 +480,15 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
              !(std::is_trivially_copy_assignable_v<TagsType> && ... &&
                std::is_trivially_copy_assignable_v<Ts>))
   {
-    sus_check(o.index_ != kUseAfterMove);
-    if (index_ == o.index_) {
-      storage_.copy_assign(index_, o.storage_);
+    const IndexType i = active_index();
+    const IndexType o_i = o.active_index();
+    sus_check(o_i != kUseAfterMove);
+    if (i == o_i) {
+      storage_.copy_assign(i, o.storage_);
     } else {
-      if (index_ != kUseAfterMove) storage_.destroy(index_);
-      index_ = o.index_;
-      storage_.copy_construct(index_, o.storage_);
+      if (i != kUseAfterMove) storage_.destroy(i);
+      set_index(o_i);
+      storage_.copy_construct(o_i, o.storage_);
     }
     return *this;
   }
@@ -479,9 +503,10 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   constexpr Choice clone() const& noexcept
     requires((... && ::sus::mem::Clone<Ts>) && !(... && ::sus::mem::Copy<Ts>))
   {
-    sus_check(index_ != kUseAfterMove);
-    auto u = Choice(::sus::clone(index_));
-    u.storage_.clone_construct(index_, storage_);
+    const IndexType i = active_index();
+    sus_check(i != kUseAfterMove);
+    auto u = Choice(i);
+    u.storage_.clone_construct(i, storage_);
     return u;
   }
 
@@ -541,9 +566,10 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   ///                             ████
   /// ```
   constexpr inline TagsType which() const& noexcept {
-    sus_check(index_ != kUseAfterMove);
+    const IndexType i = active_index();
+    sus_check(i != kUseAfterMove);
     constexpr TagsType tags[] = {Tags...};
-    return tags[size_t{index_}];
+    return tags[size_t{i}];
   }
 
   /// Returns a const reference to the value(s) inside the `Choice`.
@@ -563,7 +589,7 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> > 0u)
   constexpr inline decltype(auto) as() const& noexcept {
-    sus_check(index_ == index<V>);
+    sus_check(active_index() == index<V>);
     return __private::find_choice_storage<index<V>>(storage_).as();
   }
   // If the storage is a value type, it can't be accessed by reference in an
@@ -589,7 +615,7 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> > 0u)
   constexpr inline decltype(auto) as_mut() & noexcept {
-    sus_check(index_ == index<V>);
+    sus_check(active_index() == index<V>);
     return __private::find_choice_storage_mut<index<V>>(storage_).as_mut();
   }
 
@@ -610,7 +636,7 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> > 0u)
   constexpr inline decltype(auto) into_inner() && noexcept {
-    sus_check(index_ == index<V>);
+    sus_check(active_index() == index<V>);
     auto& s = __private::find_choice_storage_mut<index<V>>(storage_);
     return ::sus::move(s).into_inner();
   }
@@ -628,7 +654,7 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> > 0u)
   constexpr inline Option<AccessTypeOfTagConst<V>> get() const& noexcept {
-    if (index_ != index<V>) return ::sus::none();
+    if (active_index() != index<V>) return ::sus::none();
     return ::sus::some(__private::find_choice_storage<index<V>>(storage_).as());
   }
   // If the storage is a value type, it can't be accessed by reference in an
@@ -650,7 +676,7 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> > 0u)
   constexpr inline Option<AccessTypeOfTagMut<V>> get_mut() & noexcept {
-    if (index_ != index<V>) return ::sus::none();
+    if (active_index() != index<V>) return ::sus::none();
     return ::sus::some(
         __private::find_choice_storage_mut<index<V>>(storage_).as_mut());
   }
@@ -663,9 +689,10 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   template <TagsType V>
     requires(__private::StorageCount<StorageTypeOfTag<V>> == 0u)
   constexpr void set() & noexcept {
-    if (index_ != index<V>) {
-      if (index_ != kUseAfterMove) storage_.destroy(index_);
-      index_ = index<V>;
+    const IndexType i = active_index();
+    if (i != index<V>) {
+      if (i != kUseAfterMove) storage_.destroy(i);
+      set_index(index<V>);
     }
   }
   template <TagsType V, class U>
@@ -685,12 +712,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
         "holding `const i32&, u32` can not be constructed from "
         "`const i16&, u32` parameters but it can be constructed from "
         " `i32, u16`.");
-    if (index_ == index<V>) {
+    const IndexType i = active_index();
+    if (i == index<V>) {
       __private::find_choice_storage_mut<index<V>>(storage_).assign(
           ::sus::forward<U>(value));
     } else {
-      if (index_ != kUseAfterMove) storage_.destroy(index_);
-      index_ = index<V>;
+      if (i != kUseAfterMove) storage_.destroy(i);
+      set_index(index<V>);
       storage_.activate_for_construct(index<V>);
       __private::find_choice_storage_mut<index<V>>(storage_).construct(
           ::sus::forward<U>(value));
@@ -716,12 +744,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
         "holding `const i32&, u32` can not be constructed from "
         "`const i16&, u32` parameters but it can be constructed from "
         " `i32, u16`.");
-    if (index_ == index<V>) {
+    const IndexType i = active_index();
+    if (i == index<V>) {
       __private::find_choice_storage_mut<index<V>>(storage_).assign(
           StorageType(::sus::forward<Us>(values)...));
     } else {
-      if (index_ != kUseAfterMove) storage_.destroy(index_);
-      index_ = index<V>;
+      if (i != kUseAfterMove) storage_.destroy(i);
+      set_index(index<V>);
       storage_.activate_for_construct(index<V>);
       __private::find_choice_storage_mut<index<V>>(storage_).construct(
           StorageType(::sus::forward<Us>(values)...));
@@ -784,8 +813,10 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires(__private::ChoiceIsEq<TagsType, __private::TypeList<Ts...>,
                                    TagsType, __private::TypeList<Ts...>>)
   {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
-    return l.index_ == r.index_ && l.storage_.eq(l.index_, r.storage_);
+    const auto l_i = l.active_index();
+    const auto r_i = r.active_index();
+    sus_check(l_i != kUseAfterMove && r_i != kUseAfterMove);
+    return l_i == r_i && l.storage_.eq(l_i, r.storage_);
   }
 
   template <class... Us, auto V, auto... Vs>
@@ -794,8 +825,10 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   friend constexpr bool operator==(
       const Choice& l,
       const Choice<__private::TypeList<Us...>, V, Vs...>& r) noexcept {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
-    return l.index_ == r.index_ && l.storage_.eq(l.index_, r.storage_);
+    const auto l_i = l.active_index();
+    const auto r_i = r.active_index();
+    sus_check(l_i != kUseAfterMove && r_i != kUseAfterMove);
+    return l_i == r_i && l.storage_.eq(l_i, r.storage_);
   }
 
   template <class... Us, auto V, auto... Vs>
@@ -816,12 +849,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires(__private::ChoiceIsStrongOrd<TagsType, __private::TypeList<Ts...>,
                                           TagsType, __private::TypeList<Ts...>>)
   {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::strong_order(l.which(), r.which());
     if (value_order != std::strong_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.strong_ord(l.index_, r.storage_);
+      return l.storage_.strong_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -832,12 +866,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   friend constexpr std::strong_ordering operator<=>(
       const Choice& l,
       const Choice<__private::TypeList<Us...>, V, Vs...>& r) noexcept {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::strong_order(l.which(), r.which());
     if (value_order != std::strong_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.strong_ord(l.index_, r.storage_);
+      return l.storage_.strong_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -846,12 +881,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
     requires(__private::ChoiceIsOrd<TagsType, __private::TypeList<Ts...>,
                                     TagsType, __private::TypeList<Ts...>>)
   {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::weak_order(l.which(), r.which());
     if (value_order != std::weak_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.weak_ord(l.index_, r.storage_);
+      return l.storage_.weak_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -861,12 +897,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   friend constexpr std::weak_ordering operator<=>(
       const Choice& l,
       const Choice<__private::TypeList<Us...>, V, Vs...>& r) noexcept {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::weak_order(l.which(), r.which());
     if (value_order != std::weak_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.weak_ord(l.index_, r.storage_);
+      return l.storage_.weak_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -876,12 +913,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
         __private::ChoiceIsPartialOrd<TagsType, __private::TypeList<Ts...>,
                                       TagsType, __private::TypeList<Ts...>>)
   {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::partial_order(l.which(), r.which());
     if (value_order != std::partial_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.partial_ord(l.index_, r.storage_);
+      return l.storage_.partial_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -892,12 +930,13 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
   friend constexpr std::partial_ordering operator<=>(
       const Choice& l,
       const Choice<__private::TypeList<Us...>, V, Vs...>& r) noexcept {
-    sus_check(l.index_ != kUseAfterMove && r.index_ != kUseAfterMove);
+    sus_check(l.active_index() != kUseAfterMove &&
+              r.active_index() != kUseAfterMove);
     const auto value_order = std::partial_order(l.which(), r.which());
     if (value_order != std::partial_ordering::equivalent) {
       return value_order;
     } else {
-      return l.storage_.partial_ord(l.index_, r.storage_);
+      return l.storage_.partial_ord(l.active_index(), r.storage_);
     }
   }
 
@@ -911,25 +950,107 @@ class Choice<__private::TypeList<Ts...>, Tags...> final {
       delete;
 
  private:
-  constexpr explicit Choice(IndexType i) noexcept : index_(i) {}
+  constexpr explicit Choice(IndexType i) noexcept
+    requires(!kNichePacked)
+      : index_(i) {}
+  // A `NicheStorage` starts with the tag that has no value active, and
+  // constructing the value in it activates the other tag.
+  constexpr explicit Choice(IndexType) noexcept
+    requires(kNichePacked)
+  {}
+
+  _sus_pure constexpr IndexType active_index() const noexcept {
+    if constexpr (kNichePacked)
+      return static_cast<IndexType>(storage_.index());
+    else
+      return index_;
+  }
+  // The `NicheStorage` can not represent a moved-from state, so setting
+  // `kUseAfterMove` has no effect there, and its tag is otherwise changed by
+  // changing its value.
+  constexpr void set_index(IndexType i) noexcept {
+    if constexpr (!kNichePacked) index_ = i;
+  }
 
   // TODO: We don't use `[[_sus_no_unique_address]]` here as the compiler
   // overwrites the `index_` when we move-construct into the Storage union.
   // Clang: https://github.com/llvm/llvm-project/issues/60711
   // GCC: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=108775
   Storage storage_;
-  IndexType index_;
+  // The index is empty when it is stored in the `NicheStorage`, and is not
+  // placed in the storage's bytes, so the above issue does not apply.
+  [[_sus_no_unique_address]] std::conditional_t<
+      kNichePacked, __private::NicheIndex, IndexType> index_;
 
   // Declare that this type can always be trivially relocated for library
   // optimizations.
   sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn, IndexType,
                                            Ts...);
 
-  sus_class_never_value_field(::sus::marker::unsafe_fn, Choice, index_,
-                              kNeverValue, kNeverValue);
+  // The never-values of the `Choice` are the values of the index that do not
+  // refer to a tag and do not mark it as moved-from. When the tag is held in
+  // the never-value field of the value, they are instead the never-values of
+  // the value other than the one which represents the tag with no value.
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueAccess;
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueChecker;
+
+  static consteval size_t find_never_value_count() noexcept {
+    if constexpr (kNichePacked)
+      return Storage::kNeverValueCount;
+    else
+      return size_t{kUseAfterMove} - sizeof...(Tags) + 1u;
+  }
+  static constexpr size_t _sus_NeverValueCount = find_never_value_count();
+
+  _sus_pure constexpr bool _sus_Unsafe_NeverValueIsConstructed(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    if constexpr (kNichePacked)
+      return !storage_.is_never_value();
+    else
+      return index_ < sizeof...(Tags) || index_ == kUseAfterMove;
+  }
+  _sus_pure constexpr size_t _sus_Unsafe_NeverValueIndex(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    if constexpr (kNichePacked)
+      return storage_.never_value_index();
+    else if (index_ == kNeverValue)
+      return 0u;
+    else
+      return size_t{kUseAfterMove} - size_t{index_};
+  }
+  constexpr void _sus_Unsafe_NeverValueSetIndex(::sus::marker::UnsafeFnMarker,
+                                                size_t i) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    if constexpr (kNichePacked)
+      storage_.set_never_value_index(i);
+    else if (i == 0u)
+      index_ = kNeverValue;
+    else
+      index_ = static_cast<IndexType>(size_t{kUseAfterMove} - i);
+  }
+  constexpr void _sus_Unsafe_NeverValueSetDestroyValue(
+      ::sus::marker::UnsafeFnMarker) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    if constexpr (kNichePacked)
+      storage_.set_never_value_destroy_value();
+    else
+      index_ = kNeverValue;
+  }
   // For the NeverValueField.
   constexpr Choice(sus::mem::NeverValueConstructor) noexcept
+    requires(!kNichePacked)
       : index_(kNeverValue) {}
+  constexpr Choice(sus::mem::NeverValueConstructor) noexcept
+    requires(kNichePacked && _sus_NeverValueCount > 0u)
+      : storage_(::sus::mem::NeverValueIndex{0u}) {}
 };
 
 }  // namespace sus::choice_type
@@ -18,10 +18,12 @@
 
 #include "googletest/include/gtest/gtest.h"
 #include "sus/assertions/unreachable.h"
+#include "sus/boxed/box.h"
 #include "sus/mem/forward.h"
 #include "sus/num/types.h"
 #include "sus/option/option.h"
 #include "sus/prelude.h"
+#include "sus/ptr/nonnull.h"
 #include "sus/test/no_copy_move.h"
 #include "sus/tuple/tuple.h"
 
@@ -54,6 +56,7 @@ struct fmt::formatter<Order, Char> {
 
 namespace {
 
+using sus::Box;
 using sus::Choice;
 using sus::test::NoCopyMove;
 
@@ -91,6 +94,16 @@ TEST(Choice, NeverValue) {
   static_assert(std::is_standard_layout_v<One>);
   static_assert(sus::mem::NeverValueField<One>);
   static_assert(sizeof(sus::Option<One>) == sizeof(One));
+  // The index has unused values beyond the one used by the Option, so nesting
+  // does not add a flag.
+  static_assert(sus::mem::never_value_count<One>() > 1u);
+  static_assert(sizeof(sus::Option<sus::Option<One>>) == sizeof(One));
+  auto o = sus::Option<sus::Option<One>>();
+  EXPECT_TRUE(o.is_none());
+  o.insert(sus::Option<One>());
+  EXPECT_TRUE(o.is_some() && o->is_none());
+  o->insert(One::with<Order::Second>(2u));
+  EXPECT_EQ(o->as_value().as<Order::Second>(), 2u);
 
   // It used to be that Option<T> did not support the NeverValueField
   // optimization for non-Standard-Layout types, but it does now.
@@ -100,6 +113,129 @@ TEST(Choice, NeverValue) {
   static_assert(sizeof(sus::Option<Two>) == sizeof(Two));
 }
 
+// A Choice between a value with a never-value field and no value keeps its tag
+// in the never-value field.
+using NonNullI32 = sus::ptr::NonNull<i32>;
+using U64OrU32 =
+    Choice<sus_choice_types((Order::First, u64), (Order::Second, u32))>;
+static_assert(sizeof(Choice<sus_choice_types((Order::First, NonNullI32),
+                                             (Order::Second, void))>) ==
+              sizeof(i32*));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, void),
+                                             (Order::Second, Box<i32>))>) ==
+              sizeof(i32*));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, U64OrU32),
+                                             (Order::Second, void))>) ==
+              sizeof(U64OrU32));
+// The tag is stored separately when the value has no never-value field, when it
+// is a reference, when there are more values, or when there are more tags.
+static_assert(sizeof(Choice<sus_choice_types((Order::First, u64),
+                                             (Order::Second, void))>) ==
+              2 * sizeof(u64));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, const i32&),
+                                             (Order::Second, void))>) ==
+              2 * sizeof(i32*));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, NonNullI32, u64),
+                                             (Order::Second, void))>) ==
+              3 * sizeof(u64));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, NonNullI32),
+                                             (Order::Second, NonNullI32))>) ==
+              2 * sizeof(i32*));
+static_assert(sizeof(Choice<sus_choice_types((Order::First, NonNullI32),
+                                             (Order::Second, void),
+                                             (Order::Third, void))>) ==
+              2 * sizeof(i32*));
+
+TEST(Choice, NichePacked) {
+  using Ptr = Choice<sus_choice_types((Order::First, NonNullI32),
+                                      (Order::Second, void))>;
+  static_assert(std::is_trivially_copyable_v<Ptr>);
+  // The only never-value is used for the tag.
+  static_assert(!sus::mem::NeverValueField<Ptr>);
+  static_assert(sizeof(sus::Option<Ptr>) > sizeof(Ptr));
+
+  i32 i = 3, j = 4;
+  auto p = Ptr::with<Order::First>(NonNullI32::from(i));
+  EXPECT_EQ(p.which(), Order::First);
+  EXPECT_EQ(&p.as<Order::First>().as_ref(), &i);
+  auto q = Ptr::with<Order::Second>();
+  EXPECT_EQ(q.which(), Order::Second);
+  EXPECT_TRUE(q.get<Order::First>().is_none());
+  EXPECT_NE(p, q);
+  EXPECT_LT(p, q);
+
+  q = p;
+  EXPECT_EQ(q.which(), Order::First);
+  EXPECT_EQ(p, q);
+  q.set<Order::First>(NonNullI32::from(j));
+  EXPECT_EQ(&q.as<Order::First>().as_ref(), &j);
+  EXPECT_NE(p, q);
+  q.set<Order::Second>();
+  EXPECT_EQ(q.which(), Order::Second);
+  q.set<Order::First>(NonNullI32::from(j));
+  EXPECT_EQ(q.which(), Order::First);
+  EXPECT_EQ(&q.get<Order::First>().unwrap().as_ref(), &j);
+
+  auto o = sus::Option<Ptr>();
+  EXPECT_TRUE(o.is_none());
+  o.insert(Ptr::with<Order::Second>());
+  EXPECT_TRUE(o.is_some());
+  EXPECT_EQ(o->which(), Order::Second);
+  o.insert(Ptr::with<Order::First>(NonNullI32::from(i)));
+  EXPECT_EQ(&o->as<Order::First>().as_ref(), &i);
+  o = sus::none();
+  EXPECT_TRUE(o.is_none());
+}
+
+TEST(Choice, NichePackedNonTrivial) {
+  using Boxed = Choice<sus_choice_types((Order::First, void),
+                                        (Order::Second, sus::Box<i32>))>;
+  static_assert(!std::is_trivially_copyable_v<Boxed>);
+  static_assert(!sus::mem::Copy<Boxed>);
+  static_assert(sus::mem::Clone<Boxed>);
+  // The first never-value of the Box is used for the tag, and the rest are
+  // passed on to types holding the Choice.
+  static_assert(sus::mem::never_value_count<Boxed>() ==
+                sus::mem::never_value_count<sus::Box<i32>>() - 1u);
+  static_assert(sizeof(sus::Option<Boxed>) == sizeof(Boxed));
+
+  auto b = Boxed::with<Order::Second>(sus::Box<i32>(2));
+  EXPECT_EQ(b.which(), Order::Second);
+  EXPECT_EQ(*b.as<Order::Second>(), 2);
+  *b.as_mut<Order::Second>() = 5;
+
+  auto c = sus::clone(b);
+  EXPECT_EQ(c.which(), Order::Second);
+  EXPECT_EQ(*c.as<Order::Second>(), 5);
+  EXPECT_NE(&*c.as<Order::Second>(), &*b.as<Order::Second>());
+
+  auto n = Boxed::with<Order::First>();
+  EXPECT_EQ(n.which(), Order::First);
+  auto m = sus::move(n);
+  EXPECT_EQ(m.which(), Order::First);
+
+  // Moving between different tags.
+  m = sus::move(b);
+  EXPECT_EQ(m.which(), Order::Second);
+  EXPECT_EQ(*m.as<Order::Second>(), 5);
+  m = Boxed::with<Order::First>();
+  EXPECT_EQ(m.which(), Order::First);
+  m.set<Order::Second>(sus::Box<i32>(7));
+  EXPECT_EQ(*m.as<Order::Second>(), 7);
+  m.set<Order::Second>(sus::Box<i32>(8));
+  EXPECT_EQ(*m.as<Order::Second>(), 8);
+
+  sus::Box<i32> out = sus::move(m).into_inner<Order::Second>();
+  EXPECT_EQ(*out, 8);
+
+  auto d = Boxed(sus::move(c));
+  EXPECT_EQ(d.which(), Order::Second);
+  EXPECT_EQ(*d.as<Order::Second>(), 5);
+  d.set<Order::First>();
+  EXPECT_EQ(d.which(), Order::First);
+  EXPECT_EQ(d.get<Order::Second>(), sus::None);
+}
+
 TEST(Choice, ConstructorFunctionNoValue) {
   using U =
       Choice<sus_choice_types((Order::First, u32), (Order::Second, void))>;
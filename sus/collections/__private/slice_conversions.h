@@ -0,0 +1,125 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+
+#include <concepts>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "sus/construct/cast.h"
+#include "sus/num/float_concepts.h"
+#include "sus/num/integer_concepts.h"
+
+// Conversion kernels between contiguous numeric data, used by the
+// `cast_into()`, `saturating_cast_into()` and `try_cast_into()` methods of
+// `Slice`.
+//
+// The kernels read and write the primitive values inside the Subspace numeric
+// types directly, with no data-dependent branch per element, so that the
+// compiler can vectorize them. Conversions from floating point values select
+// between the converted value and the saturated one, which compilers only
+// vectorize when they need not preserve floating point exceptions (such as
+// with `-fno-trapping-math`).
+
+namespace sus::collections::__private {
+
+template <class T>
+using ConversionPrimitive =
+    std::remove_cvref_t<decltype(std::declval<const T&>().primitive_value)>;
+
+/// Slice element types that the numeric conversions operate on.
+template <class T>
+concept ConvertibleInteger = ::sus::num::IntegerNumeric<T>;
+template <class T>
+concept ConvertibleNumeric =
+    ::sus::num::IntegerNumeric<T> || ::sus::num::Float<T>;
+
+/// The number of elements that `try_cast_numbers()` checks together before
+/// converting them.
+inline constexpr size_t kConversionBlock = 64u;
+
+template <class U, class T>
+constexpr void cast_numbers(const T* src, U* dst, size_t len) noexcept {
+  using UP = ConversionPrimitive<U>;
+  for (size_t i = 0u; i < len; ++i)
+    dst[i].primitive_value = ::sus::cast<UP>(src[i].primitive_value);
+}
+
+/// Converts the primitive integer `v` to `UP`, clamping it to the range of
+/// `UP`. Only the bounds of `UP` that `TP` can exceed are compared against.
+template <class UP, class TP>
+constexpr UP saturate(TP v) noexcept {
+  constexpr UP lo = std::numeric_limits<UP>::min();
+  constexpr UP hi = std::numeric_limits<UP>::max();
+  constexpr bool check_lo =
+      std::cmp_less(std::numeric_limits<TP>::min(), lo);
+  constexpr bool check_hi =
+      std::cmp_greater(std::numeric_limits<TP>::max(), hi);
+  UP out = static_cast<UP>(v);
+  if constexpr (check_lo) out = v < static_cast<TP>(lo) ? lo : out;
+  if constexpr (check_hi) out = v > static_cast<TP>(hi) ? hi : out;
+  return out;
+}
+
+template <class U, class T>
+constexpr void saturating_cast_numbers(const T* src, U* dst,
+                                       size_t len) noexcept {
+  using UP = ConversionPrimitive<U>;
+  if constexpr (::sus::num::Float<T>) {
+    // Casting from a float already saturates.
+    cast_numbers(src, dst, len);
+  } else {
+    for (size_t i = 0u; i < len; ++i)
+      dst[i].primitive_value = saturate<UP>(src[i].primitive_value);
+  }
+}
+
+/// Converts the elements of `src` into `dst` until reaching one that is out of
+/// range for `U`, and returns its index. Returns `len` if all of the elements
+/// were converted.
+template <class U, class T>
+constexpr size_t try_cast_numbers(const T* src, U* dst, size_t len) noexcept {
+  using UP = ConversionPrimitive<U>;
+  size_t i = 0u;
+  while (i < len) {
+    const size_t block =
+        len - i < kConversionBlock ? len - i : kConversionBlock;
+    // Check the whole block for values out of range first, which the compiler
+    // can vectorize, then convert it in a second pass.
+    // The result is accumulated in an integer as a `bool` accumulator is not
+    // vectorized.
+    unsigned out_of_range = 0u;
+    for (size_t j = 0u; j < block; ++j)
+      out_of_range |= unsigned{!std::in_range<UP>(src[i + j].primitive_value)};
+    if (out_of_range != 0u) [[unlikely]] {
+      while (std::in_range<UP>(src[i].primitive_value)) {
+        dst[i].primitive_value = static_cast<UP>(src[i].primitive_value);
+        i += 1u;
+      }
+      return i;
+    }
+    for (size_t j = 0u; j < block; ++j)
+      dst[i + j].primitive_value = static_cast<UP>(src[i + j].primitive_value);
+    i += block;
+  }
+  return len;
+}
+
+}  // namespace sus::collections::__private
@@ -0,0 +1,366 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <concepts>
+#include <type_traits>
+
+#include "sus/num/__private/intrinsics.h"
+#include "sus/num/float_concepts.h"
+#include "sus/num/integer_concepts.h"
+
+// Reduction kernels over contiguous numeric data, used by the `sum()`,
+// `product()`, `min()`, `max()` and `dot()` methods of `Slice`.
+//
+// The kernels work on the primitive values inside the Subspace numeric types
+// and avoid a data-dependent branch per element, so that the compiler can keep
+// several independent accumulators in vector registers. Integer overflow is
+// detected once per block (or once at the end) instead of once per element.
+
+namespace sus::collections::__private {
+
+/// The number of independent accumulators used by kernels whose operation the
+/// compiler is not allowed to reassociate on its own (floating point math, or
+/// integer math that also tracks overflow).
+inline constexpr size_t kReductionLanes = 8u;
+
+template <class T>
+using ReductionPrimitive =
+    std::remove_cvref_t<decltype(std::declval<const T&>().primitive_value)>;
+
+/// Slice element types that the numeric reductions operate on.
+template <class T>
+concept ReducibleInteger = ::sus::num::IntegerNumeric<T>;
+template <class T>
+concept ReducibleFloat = ::sus::num::Float<T>;
+
+/// An exact sum of integers, as a 128-bit two's complement value.
+struct WideSum {
+  uint64_t lo;
+  int64_t hi;
+
+  constexpr void add_signed(int64_t v) noexcept {
+    const uint64_t u = static_cast<uint64_t>(v);
+    const uint64_t s = lo + u;
+    hi += static_cast<int64_t>(s < u) - static_cast<int64_t>(v < 0);
+    lo = s;
+  }
+  constexpr void add_unsigned(uint64_t v) noexcept {
+    const uint64_t s = lo + v;
+    hi += static_cast<int64_t>(s < v);
+    lo = s;
+  }
+  constexpr void add(WideSum o) noexcept {
+    const uint64_t s = lo + o.lo;
+    hi += o.hi + static_cast<int64_t>(s < o.lo);
+    lo = s;
+  }
+
+  /// Whether the exact sum can be represented by the primitive integer `P`.
+  template <class P>
+  constexpr bool fits() const noexcept {
+    if constexpr (std::is_signed_v<P>) {
+      const auto v = static_cast<int64_t>(lo);
+      return hi == (v < 0 ? -1 : 0) &&
+             v >= int64_t{::sus::num::__private::min_value<P>()} &&
+             v <= int64_t{::sus::num::__private::max_value<P>()};
+    } else {
+      return hi == 0 && lo <= uint64_t{::sus::num::__private::max_value<P>()};
+    }
+  }
+  /// The sum truncated to `P`, which is the wrapping sum.
+  template <class P>
+  constexpr P truncate() const noexcept {
+    return static_cast<P>(lo);
+  }
+};
+
+/// Computes the exact sum of `len` 64-bit integer values produced by `get(i)`.
+///
+/// A carry (and for signed values, a borrow) is counted per lane and folded in
+/// at the end, so there is no overflow check per element.
+template <class P, class Get>
+  requires(sizeof(P) == 8u && std::is_integral_v<P>)
+constexpr WideSum wide_sum_64(size_t len, Get get) noexcept {
+  uint64_t lo[kReductionLanes] = {};
+  int64_t hi[kReductionLanes] = {};
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l) {
+      const P x = get(i + l);
+      const uint64_t u = static_cast<uint64_t>(x);
+      const uint64_t s = lo[l] + u;
+      hi[l] += static_cast<int64_t>(s < u);
+      if constexpr (std::is_signed_v<P>) hi[l] -= static_cast<int64_t>(x < 0);
+      lo[l] = s;
+    }
+  }
+  auto out = WideSum{0u, 0};
+  for (size_t l = 0u; l < kReductionLanes; ++l)
+    out.add(WideSum{lo[l], hi[l]});
+  for (; i < len; ++i) {
+    if constexpr (std::is_signed_v<P>)
+      out.add_signed(get(i));
+    else
+      out.add_unsigned(get(i));
+  }
+  return out;
+}
+
+/// Computes the exact sum of the integers in `data`.
+///
+/// Integers narrower than 64 bits are summed into a wider accumulator over
+/// blocks that are short enough that the accumulator can not overflow, and each
+/// block's total is added to the exact sum. This leaves a plain widening
+/// addition in the inner loop, which the compiler vectorizes.
+template <ReducibleInteger T>
+constexpr WideSum integer_sum(const T* data, size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  if constexpr (sizeof(P) == 8u) {
+    return wide_sum_64<P>(len,
+                          [data](size_t i) { return data[i].primitive_value; });
+  } else {
+    using Acc = std::conditional_t<
+        sizeof(P) <= 2u,
+        std::conditional_t<std::is_signed_v<P>, int32_t, uint32_t>,
+        std::conditional_t<std::is_signed_v<P>, int64_t, uint64_t>>;
+    // The largest block whose sum can not overflow `Acc`.
+    constexpr size_t block_len =
+        sizeof(P) <= 2u ? size_t{1u} << 15u : size_t{1u} << 31u;
+    auto out = WideSum{0u, 0};
+    for (size_t start = 0u; start < len; start += block_len) {
+      const size_t end = len - start < block_len ? len : start + block_len;
+      Acc acc = 0;
+      for (size_t i = start; i < end; ++i)
+        acc += static_cast<Acc>(data[i].primitive_value);
+      if constexpr (std::is_signed_v<P>)
+        out.add_signed(acc);
+      else
+        out.add_unsigned(acc);
+    }
+    return out;
+  }
+}
+
+/// Computes the exact dot product of two arrays of integers that are at most 32
+/// bits wide, whose products therefore fit in 64 bits.
+template <ReducibleInteger T>
+  requires(sizeof(ReductionPrimitive<T>) <= 4u)
+constexpr WideSum integer_dot(const T* a, const T* b, size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  using Wide = std::conditional_t<std::is_signed_v<P>, int64_t, uint64_t>;
+  return wide_sum_64<Wide>(len, [a, b](size_t i) {
+    return static_cast<Wide>(a[i].primitive_value) *
+           static_cast<Wide>(b[i].primitive_value);
+  });
+}
+
+/// The product of integers, along with whether it overflowed.
+template <class P>
+struct IntegerProduct {
+  P value;
+  bool overflow;
+};
+
+/// Computes the wrapping product of the integers in `data`, and whether
+/// multiplying them overflowed.
+///
+/// The product is computed in independent lanes. If any element is zero, the
+/// product is zero and is never reported as an overflow. Otherwise every
+/// partial product of non-zero integers has a magnitude no larger than the
+/// final product, so an overflow in any lane means the product overflows.
+template <ReducibleInteger T>
+constexpr IntegerProduct<ReductionPrimitive<T>> integer_product(
+    const T* data, size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P lanes[kReductionLanes];
+  for (size_t l = 0u; l < kReductionLanes; ++l) lanes[l] = P{1};
+  bool overflow = false;
+  bool zero = false;
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l) {
+      const P x = data[i + l].primitive_value;
+      const auto out = ::sus::num::__private::mul_with_overflow(lanes[l], x);
+      overflow |= out.overflow;
+      zero |= x == P{0};
+      lanes[l] = out.value;
+    }
+  }
+  for (; i < len; ++i) {
+    const P x = data[i].primitive_value;
+    const auto out = ::sus::num::__private::mul_with_overflow(lanes[0u], x);
+    overflow |= out.overflow;
+    zero |= x == P{0};
+    lanes[0u] = out.value;
+  }
+  P p = lanes[0u];
+  for (size_t l = 1u; l < kReductionLanes; ++l) {
+    const auto out = ::sus::num::__private::mul_with_overflow(p, lanes[l]);
+    overflow |= out.overflow;
+    p = out.value;
+  }
+  if (zero) return IntegerProduct<P>{P{0}, false};
+  return IntegerProduct<P>{p, overflow};
+}
+
+/// Returns the smallest (or with `Max` the largest) integer in `data`, which
+/// must not be empty.
+template <bool Max, ReducibleInteger T>
+constexpr ReductionPrimitive<T> integer_min_max(const T* data,
+                                                size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P m = data[0u].primitive_value;
+  // Integer min and max are associative, so the compiler is free to split this
+  // into vector lanes.
+  for (size_t i = 1u; i < len; ++i) {
+    const P x = data[i].primitive_value;
+    if constexpr (Max)
+      m = x > m ? x : m;
+    else
+      m = x < m ? x : m;
+  }
+  return m;
+}
+
+/// Sums the floating point values in `data` in independent lanes. The result
+/// may differ from summing in order due to rounding.
+template <ReducibleFloat T>
+constexpr ReductionPrimitive<T> float_sum(const T* data, size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P lanes[kReductionLanes] = {};
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l)
+      lanes[l] += data[i + l].primitive_value;
+  }
+  for (; i < len; ++i) lanes[0u] += data[i].primitive_value;
+  // Combine the lanes pairwise.
+  for (size_t width = kReductionLanes / 2u; width > 0u; width /= 2u) {
+    for (size_t l = 0u; l < width; ++l) lanes[l] += lanes[l + width];
+  }
+  return lanes[0u];
+}
+
+/// Adds `x` to the running sum `s` with Neumaier's compensated summation, which
+/// accumulates the rounding error of each addition in `c`.
+template <class P>
+constexpr void compensated_add(P& s, P& c, P x) noexcept {
+  const P t = s + x;
+  const P abs_s = s < P{0} ? -s : s;
+  const P abs_x = x < P{0} ? -x : x;
+  c += abs_s >= abs_x ? (s - t) + x : (x - t) + s;
+  s = t;
+}
+
+/// Sums the floating point values in `data` with compensated (Kahan-Neumaier)
+/// summation in independent lanes. The error bound is independent of the
+/// number of elements, up to the final rounding.
+template <ReducibleFloat T>
+constexpr ReductionPrimitive<T> float_sum_compensated(const T* data,
+                                                      size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P sums[kReductionLanes] = {};
+  P errs[kReductionLanes] = {};
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l)
+      compensated_add(sums[l], errs[l], data[i + l].primitive_value);
+  }
+  for (; i < len; ++i)
+    compensated_add(sums[0u], errs[0u], data[i].primitive_value);
+  P s = P{0};
+  P c = P{0};
+  for (size_t l = 0u; l < kReductionLanes; ++l) {
+    compensated_add(s, c, sums[l]);
+    c += errs[l];
+  }
+  return s + c;
+}
+
+/// Multiplies the floating point values in `data` in independent lanes. The
+/// result may differ from multiplying in order due to rounding.
+template <ReducibleFloat T>
+constexpr ReductionPrimitive<T> float_product(const T* data,
+                                              size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P lanes[kReductionLanes];
+  for (size_t l = 0u; l < kReductionLanes; ++l) lanes[l] = P{1};
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l)
+      lanes[l] *= data[i + l].primitive_value;
+  }
+  for (; i < len; ++i) lanes[0u] *= data[i].primitive_value;
+  for (size_t width = kReductionLanes / 2u; width > 0u; width /= 2u) {
+    for (size_t l = 0u; l < width; ++l) lanes[l] *= lanes[l + width];
+  }
+  return lanes[0u];
+}
+
+/// Computes the dot product of two arrays of floating point values in
+/// independent lanes.
+template <ReducibleFloat T>
+constexpr ReductionPrimitive<T> float_dot(const T* a, const T* b,
+                                          size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P lanes[kReductionLanes] = {};
+  size_t i = 0u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l)
+      lanes[l] += a[i + l].primitive_value * b[i + l].primitive_value;
+  }
+  for (; i < len; ++i) lanes[0u] += a[i].primitive_value * b[i].primitive_value;
+  for (size_t width = kReductionLanes / 2u; width > 0u; width /= 2u) {
+    for (size_t l = 0u; l < width; ++l) lanes[l] += lanes[l + width];
+  }
+  return lanes[0u];
+}
+
+/// Returns the smallest (or with `Max` the largest) floating point value in
+/// `data`, ignoring NaN like [`f32::min`]($sus::num::f32::min) does. Returns
+/// NaN only if every value is NaN. The `data` must not be empty.
+template <bool Max, ReducibleFloat T>
+constexpr ReductionPrimitive<T> float_min_max(const T* data,
+                                              size_t len) noexcept {
+  using P = ReductionPrimitive<T>;
+  P lanes[kReductionLanes];
+  for (size_t l = 0u; l < kReductionLanes; ++l)
+    lanes[l] = data[0u].primitive_value;
+  // A lane takes `x` when it is better, or when the lane holds a NaN. A NaN
+  // `x` never compares better, so it is skipped.
+  const auto pick = [](P m, P x) {
+    if constexpr (Max)
+      return (x > m) | (m != m) ? x : m;
+    else
+      return (x < m) | (m != m) ? x : m;
+  };
+  size_t i = 1u;
+  for (; i + kReductionLanes <= len; i += kReductionLanes) {
+    for (size_t l = 0u; l < kReductionLanes; ++l)
+      lanes[l] = pick(lanes[l], data[i + l].primitive_value);
+  }
+  for (; i < len; ++i) lanes[0u] = pick(lanes[0u], data[i].primitive_value);
+  P m = lanes[0u];
+  for (size_t l = 1u; l < kReductionLanes; ++l) m = pick(m, lanes[l]);
+  return m;
+}
+
+}  // namespace sus::collections::__private
@@ -54,8 +54,12 @@ namespace sus {
 ///   caller that was expecting it to be received by reference.
 /// * Catch iterator invalidation. By default Subspace containers are built with
 ///   runtime protection against iterator invalidation. Iterators produced by
-///   collections are tracked and if the collection is mutated while an iterator
-///   still exists, the collection will panic and terminate the program.
+///   collections, and by view types like [`Slice`]($sus::collections::Slice)
+///   that refer to them, are tracked and if the collection is mutated while an
+///   iterator still exists, the collection will panic and terminate the
+///   program. Defining `SUS_ITERATOR_INVALIDATION_VIEWS` to 0 makes view types
+///   smaller by no longer tracking the iterators made from them, which leaves
+///   those iterators unprotected.
 ///
 /// Subspace's collections can be grouped into four major categories:
 /// * Sequences: [`Vec`]($sus::collections::Vec), [`Array`]($sus::collections::Array)
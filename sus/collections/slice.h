@@ -15,12 +15,16 @@
 #pragma once
 
 #include <algorithm>  // Replace std::sort.
+#include <bit>
+#include <numeric>
 
 #include "fmt/core.h"
 #include "sus/assertions/check.h"
 #include "sus/assertions/debug_check.h"
 #include "sus/cmp/eq.h"
 #include "sus/cmp/ord.h"
+#include "sus/collections/__private/slice_conversions.h"
+#include "sus/collections/__private/slice_reductions.h"
 #include "sus/collections/__private/sort.h"
 #include "sus/collections/concat.h"
 #include "sus/collections/iterators/chunks.h"
@@ -43,10 +47,12 @@
 #include "sus/mem/move.h"
 #include "sus/mem/swap.h"
 #include "sus/num/cast.h"
+#include "sus/num/overflow_integer.h"
 #include "sus/num/signed_integer.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/ops/range.h"
 #include "sus/option/option.h"
+#include "sus/ptr/align.h"
 #include "sus/ptr/copy.h"
 #include "sus/ptr/swap.h"
 #include "sus/result/result.h"
@@ -125,7 +131,10 @@ class [[_sus_trivial_abi]] Slice final {
 
   /// Constructs a slice from its raw parts with iterator invalidation tracking.
   /// Iterators produced from this slice will interact with the collection to
-  /// allow it to know when they are being invalidated by the collection.
+  /// allow it to know when they are being invalidated by the collection,
+  /// unless `SUS_ITERATOR_INVALIDATION_VIEWS` is defined to 0. Then the slice
+  /// is just a pointer and a length, and only iterators made directly from the
+  /// collection are tracked.
   ///
   /// For building a Slice from primitive pointer, use `from_raw_parts()`.
   ///
@@ -258,13 +267,13 @@ class [[_sus_trivial_abi]] Slice final {
  private:
   constexpr Slice(::sus::iter::IterRefCounter refs, T* data sus_lifetimebound,
                   usize len) noexcept
-      : iter_refs_(::sus::move(refs)), data_(data), len_(len) {}
+      : iter_refs_(refs), data_(data), len_(len) {}
 
   friend class SliceMut<T>;
   template <class VecT>
   friend class Vec;
 
-  [[_sus_no_unique_address]] ::sus::iter::IterRefCounter iter_refs_;
+  [[_sus_no_unique_address]] ::sus::iter::IterRefView iter_refs_;
   T* data_;
   usize len_;
 
@@ -348,7 +357,10 @@ class [[_sus_trivial_abi]] SliceMut final {
 
   /// Constructs a slice from its raw parts with iterator invalidation tracking.
   /// Iterators produced from this slice will interact with the collection to
-  /// allow it to know when they are being invalidated by the collection.
+  /// allow it to know when they are being invalidated by the collection,
+  /// unless `SUS_ITERATOR_INVALIDATION_VIEWS` is defined to 0. Then the slice
+  /// is just a pointer and a length, and only iterators made directly from the
+  /// collection are tracked.
   ///
   /// For building a SliceMut from primitive pointer, use
   /// `from_raw_parts_mut()`.
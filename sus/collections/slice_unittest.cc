@@ -21,6 +21,7 @@
 #include "sus/collections/vec.h"
 #include "sus/construct/into.h"
 #include "sus/iter/iterator.h"
+#include "sus/macros/compiler.h"
 #include "sus/mem/clone.h"
 #include "sus/mem/copy.h"
 #include "sus/mem/move.h"
@@ -42,6 +43,12 @@ static_assert(sus::mem::Copy<Slice<i32>>);
 static_assert(sus::mem::Clone<Slice<i32>>);
 static_assert(sus::mem::Move<Slice<i32>>);
 
+#if !SUS_ITERATOR_INVALIDATION_VIEWS
+// Views don't track iterators, so a Slice is just a pointer and a length.
+static_assert(sizeof(Slice<i32>) ==
+              2 * sizeof(void*) sus_clang_bug_49358(+sizeof(void*)));
+#endif
+
 TEST(Slice, FromRawParts) {
   i32 a[] = {1, 2, 3};
   auto sc = Slice<i32>::from_raw_parts(unsafe_fn, a, 3_usize);
@@ -874,6 +881,167 @@ TEST(SliceMut, AsMutPtrRange) {
   EXPECT_EQ(b, array.as_ptr() + 3u);
 }
 
+TEST(Slice, AlignTo) {
+  alignas(16) u8 bytes[35] = {};
+  for (usize i; i < 35u; i += 1u) bytes[size_t{i}] = sus::cast<u8>(i);
+
+  // Starting from an aligned pointer, there is no prefix.
+  {
+    auto s = Slice<u8>::from_raw_parts(unsafe_fn, bytes, 35u);
+    auto [prefix, middle, suffix] = s.align_to<u32>(unsafe_fn);
+    static_assert(std::same_as<decltype(middle), Slice<u32>>);
+    EXPECT_EQ(prefix.len(), 0u);
+    EXPECT_EQ(middle.len(), 8u);
+    EXPECT_EQ(reinterpret_cast<const u8*>(middle.as_ptr()), &bytes[0]);
+    EXPECT_EQ(suffix.len(), 3u);
+    EXPECT_EQ(suffix[0u], 32u);
+  }
+  // Starting from an unaligned pointer, the prefix covers up to the alignment.
+  {
+    auto s = Slice<u8>::from_raw_parts(unsafe_fn, bytes + 1u, 34u);
+    auto [prefix, middle, suffix] = s.align_to<u32>(unsafe_fn);
+    EXPECT_EQ(prefix.len(), 3u);
+    EXPECT_EQ(prefix[0u], 1u);
+    EXPECT_EQ(middle.len(), 7u);
+    EXPECT_EQ(reinterpret_cast<const u8*>(middle.as_ptr()), &bytes[4]);
+    EXPECT_EQ(suffix.len(), 3u);
+    EXPECT_EQ(suffix[0u], 32u);
+  }
+  // Too short to reach the alignment, everything is in the prefix.
+  {
+    auto s = Slice<u8>::from_raw_parts(unsafe_fn, bytes + 1u, 2u);
+    auto [prefix, middle, suffix] = s.align_to<u32>(unsafe_fn);
+    EXPECT_EQ(prefix.len(), 2u);
+    EXPECT_EQ(middle.len(), 0u);
+    EXPECT_EQ(suffix.len(), 0u);
+  }
+  // Element sizes that are not multiples of each other.
+  {
+    struct Three {
+      u8 a, b, c;
+    };
+    static_assert(sizeof(Three) == 3u);
+    auto s = Slice<u8>::from_raw_parts(unsafe_fn, bytes, 35u);
+    auto [prefix, middle, suffix] = s.align_to<Three>(unsafe_fn);
+    EXPECT_EQ(prefix.len(), 0u);
+    EXPECT_EQ(middle.len(), 11u);
+    EXPECT_EQ(suffix.len(), 2u);
+  }
+  // A wider type than the element, with sizes that are not multiples.
+  {
+    struct Four {
+      u16 a, b;
+    };
+    struct Six {
+      u16 a, b, c;
+    };
+    alignas(16) Six sixes[5] = {};
+    auto s = Slice<Six>::from_raw_parts(unsafe_fn, sixes, 5u);
+    auto [prefix, middle, suffix] = s.align_to<Four>(unsafe_fn);
+    EXPECT_EQ(prefix.len(), 0u);
+    // 2 Sixes make 3 Fours.
+    EXPECT_EQ(middle.len(), 6u);
+    EXPECT_EQ(suffix.len(), 1u);
+  }
+
+  // The Slice can be reached from Vec and SliceMut too.
+  auto v = sus::Vec<u32>(1u, 2u, 3u, 4u);
+  auto [vp, vm, vs] = v.align_to<u16>(unsafe_fn);
+  EXPECT_EQ(vp.len(), 0u);
+  EXPECT_EQ(vm.len(), 8u);
+  EXPECT_EQ(vs.len(), 0u);
+  auto [mp, mm, ms] = v.as_mut_slice().align_to<u16>(unsafe_fn);
+  EXPECT_EQ(mm.len(), 8u);
+}
+
+TEST(SliceMut, AlignToMut) {
+  alignas(16) u8 bytes[35] = {};
+  auto sm = SliceMut<u8>::from_raw_parts_mut(unsafe_fn, bytes + 1u, 34u);
+  auto [prefix, middle, suffix] = sm.align_to_mut<u32>(unsafe_fn);
+  static_assert(std::same_as<decltype(prefix), SliceMut<u8>>);
+  static_assert(std::same_as<decltype(middle), SliceMut<u32>>);
+  static_assert(std::same_as<decltype(suffix), SliceMut<u8>>);
+  EXPECT_EQ(prefix.len(), 3u);
+  EXPECT_EQ(middle.len(), 7u);
+  EXPECT_EQ(suffix.len(), 3u);
+
+  middle.fill(0xffffffff_u32);
+  prefix.fill(1_u8);
+  suffix.fill(2_u8);
+  EXPECT_EQ(bytes[0], 0u);
+  EXPECT_EQ(bytes[1], 1u);
+  EXPECT_EQ(bytes[3], 1u);
+  EXPECT_EQ(bytes[4], 0xffu);
+  EXPECT_EQ(bytes[31], 0xffu);
+  EXPECT_EQ(bytes[32], 2u);
+  EXPECT_EQ(bytes[34], 2u);
+}
+
+TEST(Slice, AsSimd) {
+  alignas(64) f32 floats[37] = {};
+  for (usize i; i < 37u; i += 1u) floats[size_t{i}] = sus::cast<f32>(i);
+
+  {
+    auto s = Slice<f32>::from_raw_parts(unsafe_fn, floats, 37u);
+    auto [prefix, middle, suffix] = s.as_simd<4>();
+    static_assert(std::same_as<decltype(middle), Slice<f32>>);
+    EXPECT_EQ(prefix.len(), 0u);
+    EXPECT_EQ(middle.len(), 36u);
+    EXPECT_EQ(suffix.len(), 1u);
+    EXPECT_EQ(suffix[0u], 36_f32);
+  }
+  {
+    auto s = Slice<f32>::from_raw_parts(unsafe_fn, floats + 1u, 36u);
+    auto [prefix, middle, suffix] = s.as_simd<8>();
+    EXPECT_EQ(prefix.len(), 7u);
+    EXPECT_EQ(middle.len(), 24u);
+    EXPECT_EQ(middle.as_ptr(), &floats[8]);
+    EXPECT_EQ(suffix.len(), 5u);
+    EXPECT_EQ(suffix[0u], 32_f32);
+    EXPECT_TRUE(sus::ptr::is_aligned_to(middle.as_ptr(), 32u));
+    for (auto block : middle.chunks_exact(8u)) {
+      EXPECT_TRUE(sus::ptr::is_aligned_to(block.as_ptr(), 32u));
+    }
+  }
+  // Too short to contain a whole block.
+  {
+    auto s = Slice<f32>::from_raw_parts(unsafe_fn, floats + 1u, 10u);
+    auto [prefix, middle, suffix] = s.as_simd<8>();
+    EXPECT_EQ(prefix.len(), 7u);
+    EXPECT_EQ(middle.len(), 0u);
+    EXPECT_EQ(suffix.len(), 3u);
+  }
+  {
+    auto s = Slice<f32>::from_raw_parts(unsafe_fn, floats + 1u, 3u);
+    auto [prefix, middle, suffix] = s.as_simd<8>();
+    EXPECT_EQ(prefix.len(), 3u);
+    EXPECT_EQ(middle.len(), 0u);
+    EXPECT_EQ(suffix.len(), 0u);
+  }
+  {
+    auto s = Slice<f32>();
+    auto [prefix, middle, suffix] = s.as_simd<8>();
+    EXPECT_EQ(prefix.len(), 0u);
+    EXPECT_EQ(middle.len(), 0u);
+    EXPECT_EQ(suffix.len(), 0u);
+  }
+}
+
+TEST(SliceMut, AsSimdMut) {
+  alignas(16) i32 ints[11] = {};
+  auto sm = SliceMut<i32>::from_raw_parts_mut(unsafe_fn, ints + 1u, 10u);
+  auto [prefix, middle, suffix] = sm.as_simd_mut<4>();
+  static_assert(std::same_as<decltype(middle), SliceMut<i32>>);
+  EXPECT_EQ(prefix.len(), 3u);
+  EXPECT_EQ(middle.len(), 4u);
+  EXPECT_EQ(suffix.len(), 3u);
+  for (auto block : middle.chunks_exact_mut(4u)) block.fill(1_i32);
+  EXPECT_EQ(ints[3], 0);
+  EXPECT_EQ(ints[4], 1);
+  EXPECT_EQ(ints[7], 1);
+  EXPECT_EQ(ints[8], 0);
+}
+
 TEST(Slice, BinarySearch) {
   auto v = sus::Vec<i32>(0, 1, 1, 1, 1, 2, 3, 5, 8, 13, 21, 34, 55);
   {
@@ -5836,6 +6004,337 @@ TEST(SliceMut, StripSuffixMut) {
   EXPECT_EQ(s.strip_suffix_mut(v[".."_r]).unwrap(), sus::empty);
 }
 
+TEST(Slice, Sum) {
+  EXPECT_EQ(Slice<i32>().sum(), 0_i32);
+  EXPECT_EQ(Slice<f32>().sum(), 0_f32);
+
+  // Longer than the lanes and blocks of the kernels, with a tail.
+  auto v8 = sus::Vec<u8>();
+  auto v16 = sus::Vec<i16>();
+  auto v32 = sus::Vec<i32>();
+  auto v64 = sus::Vec<u64>();
+  auto vsize = sus::Vec<isize>();
+  auto vf = sus::Vec<f64>();
+  auto e16 = 0_i16;
+  auto e32 = 0_i32;
+  auto e64 = 0_u64;
+  auto esize = 0_isize;
+  auto ef = 0_f64;
+  for (u32 i; i < 70'003u; i += 1u) {
+    v8.push(sus::cast<u8>(i % 7u));
+    v16.push(sus::cast<i16>(i % 7u) - 3_i16);
+    v32.push(sus::cast<i32>(i) - 35'000_i32);
+    v64.push(sus::cast<u64>(i));
+    vsize.push(sus::cast<isize>(i) - 35'001_isize);
+    vf.push(sus::cast<f64>(i % 4u));
+    e16 += v16.last().unwrap();
+    e32 += v32.last().unwrap();
+    e64 += v64.last().unwrap();
+    esize += vsize.last().unwrap();
+    ef += vf.last().unwrap();
+  }
+  // Summing u8 values beyond the range of u8 overflows, use OverflowInteger.
+  EXPECT_EQ(v8.sum<sus::num::OverflowInteger<u8>>().is_overflow(), true);
+  EXPECT_EQ(v16.sum(), e16);
+  EXPECT_EQ(v32.sum(), e32);
+  EXPECT_EQ(v64.sum(), e64);
+  EXPECT_EQ(vsize.sum(), esize);
+  EXPECT_EQ(vf.sum(), ef);
+  EXPECT_EQ(vf.as_slice().sum(), vf.as_mut_slice().sum());
+
+  // The sum is exact, so values that overflow part way through but come back
+  // into range do not overflow.
+  auto s = sus::Vec<i64>(i64::MAX, i64::MAX, i64::MIN, i64::MIN, 3_i64);
+  EXPECT_EQ(s.sum(), 1_i64);
+  auto t = sus::Vec<i8>(i8::MAX, 1_i8, -2_i8);
+  EXPECT_EQ(t.sum(), 126_i8);
+
+  // OverflowInteger.
+  {
+    auto o =
+        sus::Vec<u64>(u64::MAX, 1_u64).sum<sus::num::OverflowInteger<u64>>();
+    static_assert(std::same_as<decltype(o), sus::num::OverflowInteger<u64>>);
+    EXPECT_EQ(o.is_overflow(), true);
+    auto n = sus::Vec<i64>(i64::MIN, -1_i64)
+                 .sum<sus::num::OverflowInteger<i64>>();
+    EXPECT_EQ(n.is_overflow(), true);
+    auto p = sus::Vec<i32>(i32::MIN, i32::MAX)
+                 .sum<sus::num::OverflowInteger<i32>>();
+    EXPECT_EQ(sus::move(p).unwrap(), -1_i32);
+  }
+
+  // Constexpr.
+  static_assert([]() {
+    i32 a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    return SliceMut<i32>::from(a).sum();
+  }() == 55_i32);
+}
+
+TEST(SliceDeathTest, SumOverflow) {
+#if GTEST_HAS_DEATH_TEST
+  auto v = sus::Vec<i32>(i32::MAX, 1_i32);
+  EXPECT_DEATH(
+      {
+        auto x = v.sum();
+        ensure_use(&x);
+      },
+      "");
+  auto w = sus::Vec<u64>(u64::MAX, 1_u64);
+  EXPECT_DEATH(
+      {
+        auto x = w.sum();
+        ensure_use(&x);
+      },
+      "");
+#endif
+}
+
+TEST(Slice, SumKahan) {
+  EXPECT_EQ(Slice<f32>().sum_kahan(), 0_f32);
+
+  // Adding many small values to a large one loses all of them in a naive sum.
+  auto v = sus::Vec<f32>();
+  v.push(1.0_f32);
+  auto naive = 1_f32;
+  for (usize i; i < 10'000u; i += 1u) {
+    v.push(1e-8_f32);
+    naive += 1e-8_f32;
+  }
+  EXPECT_EQ(naive, 1_f32);
+  EXPECT_NEAR(float{v.sum_kahan()}, 1.0001f, 1e-7f);
+
+  auto w = sus::Vec<f64>(1_f64, 2_f64, 3.5_f64);
+  EXPECT_EQ(w.sum_kahan(), 6.5_f64);
+}
+
+TEST(Slice, Product) {
+  EXPECT_EQ(Slice<i32>().product(), 1_i32);
+  EXPECT_EQ(Slice<f64>().product(), 1_f64);
+
+  auto v = sus::Vec<i64>();
+  for (i64 i = 1; i <= 20; i += 1) v.push(i);
+  EXPECT_EQ(v.product(), 2'432'902'008'176'640'000_i64);
+  v.push(21_i64);
+  EXPECT_EQ(v.product<sus::num::OverflowInteger<i64>>().is_overflow(), true);
+  // A zero makes the product zero, even though multiplying in order would
+  // overflow before reaching it.
+  v.push(0_i64);
+  EXPECT_EQ(v.product(), 0_i64);
+  EXPECT_EQ(v.product<sus::num::OverflowInteger<i64>>().is_overflow(), false);
+
+  auto s = sus::Vec<i8>(-2_i8, 4_i8, -4_i8, 2_i8, 1_i8, 1_i8, 1_i8, 1_i8, -1_i8,
+                        1_i8);
+  EXPECT_EQ(s.product(), -64_i8);
+  EXPECT_EQ(sus::Vec<u8>(16_u8, 16_u8)
+                .product<sus::num::OverflowInteger<u8>>()
+                .is_overflow(),
+            true);
+
+  auto f = sus::Vec<f32>(2_f32, 0.5_f32, 3_f32);
+  EXPECT_EQ(f.product(), 3_f32);
+}
+
+TEST(SliceDeathTest, ProductOverflow) {
+#if GTEST_HAS_DEATH_TEST
+  auto v = sus::Vec<i32>(65536_i32, 65536_i32);
+  EXPECT_DEATH(
+      {
+        auto x = v.product();
+        ensure_use(&x);
+      },
+      "");
+#endif
+}
+
+TEST(Slice, MinMax) {
+  EXPECT_EQ(Slice<i32>().min(), sus::None);
+  EXPECT_EQ(Slice<i32>().max(), sus::None);
+  EXPECT_EQ(Slice<f32>().min(), sus::None);
+
+  auto v = sus::Vec<i32>();
+  for (i32 i = 0; i < 100; i += 1) v.push((i * 37) % 101 - 50);
+  // Every value in [-50, 50] except (100 * 37) % 101 - 50 == 13.
+  EXPECT_EQ(v.min().unwrap(), -50_i32);
+  EXPECT_EQ(v.max().unwrap(), 50_i32);
+  EXPECT_EQ(sus::Vec<u8>(3_u8).min().unwrap(), 3_u8);
+
+  auto f = sus::Vec<f32>(f32::NAN, 3_f32, -1_f32, 2_f32, 7_f32, f32::NAN,
+                         -4_f32, 1_f32, 0_f32, 5_f32, f32::NAN);
+  EXPECT_EQ(f.min().unwrap(), -4_f32);
+  EXPECT_EQ(f.max().unwrap(), 7_f32);
+  auto nans = sus::Vec<f64>(f64::NAN, f64::NAN);
+  EXPECT_TRUE(nans.min().unwrap().is_nan());
+  EXPECT_TRUE(nans.max().unwrap().is_nan());
+}
+
+TEST(Slice, Dot) {
+  EXPECT_EQ(Slice<i32>().dot(Slice<i32>()), 0_i32);
+
+  auto a = sus::Vec<f32>(1_f32, 2_f32, 3_f32);
+  auto b = sus::Vec<f32>(4_f32, 5_f32, 6_f32);
+  EXPECT_EQ(a.dot(b), 32_f32);
+
+  auto c = sus::Vec<i32>();
+  auto d = sus::Vec<i32>();
+  for (i32 i = 0; i < 21; i += 1) {
+    c.push(i - 10);
+    d.push(i * 2);
+  }
+  i32 expected = 0;
+  for (usize i; i < c.len(); i += 1u) expected += c[i] * d[i];
+  EXPECT_EQ(c.dot(d), expected);
+
+  // Products are computed without overflow.
+  auto e = sus::Vec<i32>(i32::MIN, i32::MAX);
+  auto f = sus::Vec<i32>(1_i32, 1_i32);
+  EXPECT_EQ(e.dot(f), -1_i32);
+}
+
+TEST(SliceDeathTest, DotChecks) {
+#if GTEST_HAS_DEATH_TEST
+  auto a = sus::Vec<i32>(1_i32, 2_i32);
+  auto b = sus::Vec<i32>(1_i32);
+  EXPECT_DEATH(
+      {
+        auto x = a.dot(b);
+        ensure_use(&x);
+      },
+      "");
+  auto c = sus::Vec<u16>(u16::MAX, u16::MAX);
+  auto d = sus::Vec<u16>(u16::MAX, u16::MAX);
+  EXPECT_DEATH(
+      {
+        auto x = c.dot(d);
+        ensure_use(&x);
+      },
+      "");
+#endif
+}
+
+TEST(Slice, CastInto) {
+  auto wide = sus::Vec<i64>(1_i64, -2_i64, 0x1'0000'0003_i64);
+  auto narrow = sus::Vec<i32>(0_i32, 0_i32, 0_i32);
+  wide.cast_into(narrow.as_mut_slice());
+  EXPECT_EQ(narrow, sus::Vec<i32>(1_i32, -2_i32, 3_i32));
+
+  auto bytes = sus::Vec<u8>(0_u8, 7_u8, u8::MAX);
+  auto words = sus::Vec<u32>(9_u32, 9_u32, 9_u32);
+  bytes.cast_into(words.as_mut_slice());
+  EXPECT_EQ(words, sus::Vec<u32>(0_u32, 7_u32, 255_u32));
+
+  auto signs = sus::Vec<i8>(-1_i8, 1_i8);
+  auto unsigns = sus::Vec<u8>(0_u8, 0_u8);
+  signs.cast_into(unsigns.as_mut_slice());
+  EXPECT_EQ(unsigns, sus::Vec<u8>(u8::MAX, 1_u8));
+
+  auto doubles = sus::Vec<f64>(1.5_f64, -0.25_f64, f64::INFINITY);
+  auto floats = sus::Vec<f32>(0_f32, 0_f32, 0_f32);
+  doubles.cast_into(floats.as_mut_slice());
+  EXPECT_EQ(floats, sus::Vec<f32>(1.5_f32, -0.25_f32, f32::INFINITY));
+
+  // Floats saturate when converting to integers, and NaN becomes 0.
+  auto fs = sus::Vec<f32>(2.75_f32, -1e10_f32, 1e10_f32, f32::NAN);
+  auto is = sus::Vec<i32>(9_i32, 9_i32, 9_i32, 9_i32);
+  fs.cast_into(is.as_mut_slice());
+  EXPECT_EQ(is, sus::Vec<i32>(2_i32, i32::MIN, i32::MAX, 0_i32));
+
+  // More than one block of elements.
+  auto many = sus::Vec<u16>();
+  for (u32 i; i < 300u; i += 1u) many.push(sus::cast<u16>(i * 1000u));
+  auto many_out = sus::Vec<u32>();
+  for (u32 i; i < 300u; i += 1u) many_out.push(0u);
+  many.cast_into(many_out.as_mut_slice());
+  for (usize i; i < many.len(); i += 1u)
+    EXPECT_EQ(many_out[i], sus::cast<u32>(many[i]));
+
+  Slice<i32>().cast_into(sus::collections::SliceMut<u8>());
+}
+
+TEST(Slice, SaturatingCastInto) {
+  auto wide =
+      sus::Vec<i64>(1_i64, -3'000'000'000_i64, 3'000'000'000_i64, -7_i64);
+  auto narrow = sus::Vec<i32>(0_i32, 0_i32, 0_i32, 0_i32);
+  wide.saturating_cast_into(narrow.as_mut_slice());
+  EXPECT_EQ(narrow, sus::Vec<i32>(1_i32, i32::MIN, i32::MAX, -7_i32));
+
+  auto signs = sus::Vec<i32>(-1_i32, 1_i32, 1000_i32);
+  auto bytes = sus::Vec<u8>(9_u8, 9_u8, 9_u8);
+  signs.saturating_cast_into(bytes.as_mut_slice());
+  EXPECT_EQ(bytes, sus::Vec<u8>(0_u8, 1_u8, u8::MAX));
+
+  auto big = sus::Vec<u64>(u64::MAX, 5_u64);
+  auto small = sus::Vec<i64>(0_i64, 0_i64);
+  big.saturating_cast_into(small.as_mut_slice());
+  EXPECT_EQ(small, sus::Vec<i64>(i64::MAX, 5_i64));
+
+  // Widening never saturates.
+  auto from = sus::Vec<i8>(i8::MIN, i8::MAX);
+  auto to = sus::Vec<i16>(0_i16, 0_i16);
+  from.saturating_cast_into(to.as_mut_slice());
+  EXPECT_EQ(to, sus::Vec<i16>(-128_i16, 127_i16));
+
+  auto fs = sus::Vec<f64>(-1.5_f64, 300.5_f64, f64::NAN);
+  auto us = sus::Vec<u8>(9_u8, 9_u8, 9_u8);
+  fs.saturating_cast_into(us.as_mut_slice());
+  EXPECT_EQ(us, sus::Vec<u8>(0_u8, u8::MAX, 0_u8));
+}
+
+TEST(Slice, TryCastInto) {
+  auto wide = sus::Vec<i32>(1_i32, 2_i32, 300_i32, 4_i32);
+  auto narrow = sus::Vec<u8>(0_u8, 0_u8, 0_u8, 0_u8);
+  auto r = wide.try_cast_into(narrow.as_mut_slice());
+  EXPECT_EQ(r.as_err(), 2u);
+  // Values after the failure are not written.
+  EXPECT_EQ(narrow, sus::Vec<u8>(1_u8, 2_u8, 0_u8, 0_u8));
+
+  auto ok = sus::Vec<i32>(1_i32, 2_i32, 255_i32);
+  auto ok_out = sus::Vec<u8>(0_u8, 0_u8, 0_u8);
+  EXPECT_TRUE(ok.try_cast_into(ok_out.as_mut_slice()).is_ok());
+  EXPECT_EQ(ok_out, sus::Vec<u8>(1_u8, 2_u8, 255_u8));
+
+  auto neg = sus::Vec<i64>(-1_i64);
+  auto neg_out = sus::Vec<u64>(9_u64);
+  EXPECT_EQ(neg.try_cast_into(neg_out.as_mut_slice()).unwrap_err(), 0u);
+  EXPECT_EQ(neg_out[0u], 9_u64);
+
+  // The first failure is found beyond the first block of elements, and when
+  // more than one value is out of range.
+  auto many = sus::Vec<u32>();
+  for (u32 i; i < 200u; i += 1u) many.push(i);
+  many[150u] = 70'000u;
+  many[170u] = 80'000u;
+  auto many_out = sus::Vec<u16>();
+  for (u32 i; i < 200u; i += 1u) many_out.push(0_u16);
+  EXPECT_EQ(many.try_cast_into(many_out.as_mut_slice()).unwrap_err(), 150u);
+  for (usize i; i < 150u; i += 1u)
+    EXPECT_EQ(many_out[i], sus::cast<u16>(many[i]));
+  for (usize i = 150u; i < 200u; i += 1u) EXPECT_EQ(many_out[i], 0_u16);
+
+  many[150u] = 150u;
+  many[170u] = 170u;
+  EXPECT_TRUE(many.try_cast_into(many_out.as_mut_slice()).is_ok());
+  for (usize i; i < 200u; i += 1u)
+    EXPECT_EQ(many_out[i], sus::cast<u16>(many[i]));
+
+  EXPECT_TRUE(
+      Slice<i32>().try_cast_into(sus::collections::SliceMut<u8>()).is_ok());
+}
+
+TEST(SliceDeathTest, CastIntoLength) {
+#if GTEST_HAS_DEATH_TEST
+  auto a = sus::Vec<i32>(1_i32, 2_i32);
+  auto b = sus::Vec<i64>(1_i64);
+  EXPECT_DEATH(a.cast_into(b.as_mut_slice()), "");
+  EXPECT_DEATH(a.saturating_cast_into(b.as_mut_slice()), "");
+  EXPECT_DEATH(
+      {
+        auto x = a.try_cast_into(b.as_mut_slice());
+        ensure_use(&x);
+      },
+      "");
+#endif
+}
+
 TEST(Slice, Windows) {
   auto v = sus::Vec<i32>(0, 1, 2, 3, 4, 5, 6, 7);
   sus::Slice<i32> s = v.as_slice();
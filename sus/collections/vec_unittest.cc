@@ -16,6 +16,7 @@
 
 #include <concepts>
 #include <sstream>
+#include <thread>
 
 #include "googletest/include/gtest/gtest.h"
 #include "sus/iter/extend.h"
@@ -1455,9 +1456,39 @@ TEST(VecDeathTest, IteratorInvalidation) {
         ensure_use(&v2);
       },
       "");
+  // An iterator made from a view of the Vec is counted in the Vec too.
+  auto v3 = sus::Vec<i32>(1, 2);
+  auto sit = v3.as_slice().iter();
+  sit.next();
+  EXPECT_DEATH(
+      {
+        v3.push(3);
+        ensure_use(&v3);
+      },
+      "");
 #endif
 }
 
+TEST(Vec, IterateOnManyThreads) {
+  auto v = sus::Vec<i32>(1, 2, 3, 4);
+  const auto& cv = v;
+  auto threads = sus::Vec<std::thread>();
+  for (usize t; t < 4u; t += 1u) {
+    threads.push(std::thread([&cv] {
+      for (usize i; i < 10'000u; i += 1u) {
+        i32 sum;
+        for (const i32& x : cv.as_slice()) sum += x;
+        EXPECT_EQ(sum, 10);
+      }
+    }));
+  }
+  for (std::thread& t : threads.iter_mut()) t.join();
+  // Every thread's iterators were counted and released, so the Vec can be
+  // mutated again.
+  v.push(5);
+  EXPECT_EQ(v.len(), 5u);
+}
+
 TEST(Vec, SliceInvalidation) {
   auto vec = sus::Vec<i32>(1, 2);
   const sus::Slice<i32>& s = vec;
@@ -240,6 +240,10 @@ concept HasErrorSource = requires(const T& t) {
 /// means the result can be constructed by `sus::err(sus::into(error))` for any
 /// `error` that satisfies [`Error`]($sus::error::Error).
 ///
+/// To avoid the heap allocation for small errors, return
+/// `Result<T, `[`SmallError`]($sus::error::SmallError)`>` instead, which is
+/// constructed in the same way and stores small errors inside itself.
+///
 /// This is similar to
 /// `Box<dyn Error>` when working with the Rust
 /// [`Error`](https://doc.rust-lang.org/stable/std/error/trait.Error.html)
@@ -0,0 +1,271 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <concepts>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/boxed/box.h"
+#include "sus/error/error.h"
+#include "sus/macros/lifetimebound.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/relocate.h"
+#include "sus/mem/replace.h"
+#include "sus/option/option.h"
+
+namespace sus::error {
+
+namespace __private {
+
+/// The single type-erased object shared by every `SmallError` holding the
+/// unit-like error type `E`. As `E` has no state, every `E` is the same.
+template <class E>
+inline constexpr DynErrorTyped<E, E> kStaticError{E()};
+
+}  // namespace __private
+
+/// A type-erased [`Error`]($sus::error::Error), which is stored without a heap
+/// allocation when it is small.
+///
+/// `SmallError` can be used in place of
+/// [`Box`]($sus::boxed::Box)`<`[`DynError`]($sus::error::DynError)`>` to hold
+/// any [`Error`]($sus::error::Error) type, such as in
+/// [`Result`]($sus::result::Result)`<T, SmallError>`. It is constructed in the
+/// same ways, with [`from`]($sus::error::SmallError::from) or through
+/// [`sus::into()`]($sus::construct::into), and it satisfies
+/// [`Error`]($sus::error::Error) itself.
+///
+/// The error is held in one of three ways:
+/// * A unit-like error type, which is empty and trivially constructible, is
+///   not stored at all. The `SmallError` points to a single static object for
+///   the type, and the pointer is tagged so that it is never destroyed.
+/// * A small error, such as an enum or an error code with a
+///   [`Box`]($sus::boxed::Box)`<DynError>` source, is stored inside the
+///   `SmallError`. It must fit in two pointers of data, alongside the
+///   type-erased object's virtual table pointer, and be
+///   [`TriviallyRelocatable`]($sus::mem::TriviallyRelocatable), as it is moved
+///   between `SmallError` objects by copying its bytes. A struct can be marked
+///   with [`sus_class_trivially_relocatable`](
+///   $sus_class_trivially_relocatable) to be stored inline.
+/// * Any other error is allocated on the heap, as with `Box<DynError>`.
+///
+/// Creating a `SmallError` does no formatting. The
+/// [`display`]($sus::error::error_display) string of the error, and of each
+/// [`source`]($sus::error::error_source) in its chain, is only produced when
+/// it is asked for, such as when the error is formatted or printed in a
+/// [`panic`]($sus_panic).
+///
+/// A moved-from `SmallError` may not be used except to be assigned to or
+/// destroyed. It will [`panic`]($sus_panic) otherwise.
+///
+/// # Examples
+/// ```
+/// struct NotFound {};
+/// template <>
+/// struct sus::error::ErrorImpl<NotFound> {
+///   static std::string display(const NotFound&) noexcept {
+///     return "not found";
+///   }
+/// };
+///
+/// auto f = []() -> sus::Result<i32, sus::error::SmallError> {
+///   return sus::err(sus::into(NotFound()));
+/// };
+/// auto r = f();
+/// sus_check(!r.as_err().is_allocated());
+/// sus_check(fmt::to_string(r.as_err()) == "not found");
+/// ```
+class SmallError final {
+ public:
+  /// The number of bytes in a `SmallError` that can hold an error, along with
+  /// its virtual table pointer.
+  static constexpr size_t kInlineBytes = 3u * sizeof(void*);
+
+  /// Whether the unit-like error type `E` will be represented by a pointer to
+  /// a static object.
+  template <class E>
+  static constexpr bool stores_static =
+      std::is_empty_v<E> && std::is_trivially_default_constructible_v<E> &&
+      std::is_trivially_destructible_v<E>;
+
+  /// Whether the error type `E` will be stored inside the `SmallError` rather
+  /// than on the heap.
+  template <class E>
+  static constexpr bool stores_inline =
+      !stores_static<E> && sizeof(DynErrorTyped<E, E>) <= kInlineBytes &&
+      alignof(DynErrorTyped<E, E>) <= alignof(void*) &&
+      ::sus::mem::TriviallyRelocatable<E>;
+
+  /// Type-erases the error `e` into the `SmallError`.
+  ///
+  /// Satisfies the [`From<E>`]($sus::construct::From) concept for
+  /// `SmallError` from any type satisfying [`Error`]($sus::error::Error).
+  /// #[doc.overloads=from.error]
+  template <::sus::mem::Move E>
+  static SmallError from(E e) noexcept
+    requires(std::same_as<E, std::remove_cvref_t<E>> &&       //
+             !std::same_as<E, ::sus::Box<DynError>> &&        //
+             !std::same_as<E, SmallError> && Error<E>)
+  {
+    using Typed = DynErrorTyped<E, E>;
+    if constexpr (stores_static<E>) {
+      return SmallError(FROM_POINTER,
+                        tag_static(&__private::kStaticError<E>));
+    } else if constexpr (stores_inline<E>) {
+      auto s = SmallError(FROM_POINTER, nullptr);
+      s.ptr_ = new (s.storage_) Typed(::sus::move(e));
+      return s;
+    } else {
+      return SmallError(FROM_POINTER, new Typed(::sus::move(e)));
+    }
+  }
+  /// Takes ownership of the heap-allocated error in `b`, without allocating.
+  ///
+  /// Satisfies the [`From`]($sus::construct::From)`<Box<DynError>>` concept
+  /// for `SmallError`.
+  /// #[doc.overloads=from.box]
+  static SmallError from(::sus::Box<DynError> b) noexcept {
+    return SmallError(FROM_POINTER, ::sus::move(b).into_raw());
+  }
+
+  /// Destroys the error, and frees its heap memory if it was allocated.
+  ///
+  /// Does nothing if the `SmallError` was moved-from.
+  ~SmallError() noexcept { destroy(); }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `SmallError`.
+  SmallError(SmallError&& o) noexcept : ptr_(nullptr) {
+    sus_check_with_message(o.ptr_, "SmallError used after move");
+    take_from(o);
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `SmallError`.
+  SmallError& operator=(SmallError&& o) noexcept {
+    sus_check_with_message(o.ptr_, "SmallError used after move");
+    if (this != &o) {
+      destroy();
+      take_from(o);
+    }
+    return *this;
+  }
+
+  SmallError(const SmallError&) = delete;
+  SmallError& operator=(const SmallError&) = delete;
+
+  /// Returns whether the error was allocated on the heap.
+  _sus_pure bool is_allocated() const noexcept {
+    sus_check_with_message(ptr_, "SmallError used after move");
+    return !is_static() && !points_inline();
+  }
+
+  /// Returns a reference to the type-erased error.
+  _sus_pure const DynError& as_ref() const& noexcept {
+    sus_check_with_message(ptr_, "SmallError used after move");
+    return *untagged();
+  }
+  const DynError& as_ref() && noexcept = delete;
+
+  _sus_pure const DynError& operator*() const& noexcept { return as_ref(); }
+  const DynError& operator*() && noexcept = delete;
+  _sus_pure const DynError* operator->() const noexcept { return &as_ref(); }
+
+ private:
+  enum FromPointer { FROM_POINTER };
+  explicit SmallError(FromPointer, DynError* ptr) noexcept : ptr_(ptr) {}
+
+  /// Marks a pointer to a static error object, which is never destroyed. The
+  /// virtual table pointer in the object ensures the low bit is free.
+  static DynError* tag_static(const DynError* p) noexcept {
+    return reinterpret_cast<DynError*>(reinterpret_cast<uintptr_t>(p) | 1u);
+  }
+  bool is_static() const noexcept {
+    return (reinterpret_cast<uintptr_t>(ptr_) & 1u) != 0u;
+  }
+  const DynError* untagged() const noexcept {
+    return reinterpret_cast<const DynError*>(
+        reinterpret_cast<uintptr_t>(ptr_) & ~uintptr_t{1u});
+  }
+
+  bool points_inline() const noexcept {
+    const auto p = reinterpret_cast<uintptr_t>(ptr_);
+    const auto s = reinterpret_cast<uintptr_t>(storage_);
+    return p - s < uintptr_t{kInlineBytes};
+  }
+
+  void destroy() noexcept {
+    if (ptr_ == nullptr || is_static()) {
+      ptr_ = nullptr;
+      return;
+    }
+    // The destructor of `DynError` is virtual, and destroys the concrete type.
+    if (points_inline())
+      ptr_->~DynError();
+    else
+      delete ptr_;
+    ptr_ = nullptr;
+  }
+
+  /// Takes ownership of the error in `o`, which must not be moved-from.
+  void take_from(SmallError& o) noexcept {
+    if (!o.is_static() && o.points_inline()) {
+      // SAFETY: Only errors of a `TriviallyRelocatable` type are stored inline,
+      // and the rest of the type-erased object is its virtual table pointer,
+      // so the object is relocated by copying its bytes.
+      const auto offset = reinterpret_cast<const char*>(o.ptr_) - o.storage_;
+      memcpy(storage_, o.storage_, kInlineBytes);
+      ptr_ = reinterpret_cast<DynError*>(storage_ + offset);
+      o.ptr_ = nullptr;
+    } else {
+      ptr_ = ::sus::mem::replace(o.ptr_, nullptr);
+    }
+  }
+
+  // Points into `storage_`, to a heap allocation, or to a static error with
+  // the low bit set. It is null when moved-from.
+  DynError* ptr_;
+  alignas(alignof(void*)) char storage_[kInlineBytes];
+
+  // The pointer is never null until it is moved-from.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, SmallError,
+                                      ptr_, alignof(DynError), nullptr);
+  explicit SmallError(::sus::mem::NeverValueConstructor) noexcept
+      : ptr_(_sus_NeverValuePointer(0u)) {}
+};
+
+}  // namespace sus::error
+
+// `SmallError` satisfies [`Error`]($sus::error::Error) by forwarding to the
+// error it holds.
+template <>
+struct sus::error::ErrorImpl<::sus::error::SmallError> {
+  static std::string display(const ::sus::error::SmallError& e) noexcept {
+    return e->display();
+  }
+  static sus::Option<const DynError&> source(
+      const ::sus::error::SmallError& e sus_lifetimebound) noexcept {
+    return e->source();
+  }
+};
+
+static_assert(sus::error::Error<sus::error::SmallError>);
@@ -0,0 +1,178 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/error/small_error.h"
+
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/boxed/box.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+
+namespace test::small_error {
+
+struct Unit {};
+
+enum class Reason { First, Second };
+
+struct Message {
+  std::string message;
+};
+
+struct WithSource {
+  i32 code;
+  sus::Box<sus::error::DynError> source;
+
+  sus_class_trivially_relocatable(unsafe_fn, decltype(code),
+                                  decltype(source));
+};
+
+}  // namespace test::small_error
+
+using namespace test::small_error;
+
+template <>
+struct sus::error::ErrorImpl<Unit> {
+  static std::string display(const Unit&) noexcept { return "unit"; }
+};
+template <>
+struct sus::error::ErrorImpl<Reason> {
+  static std::string display(const Reason& r) noexcept {
+    switch (r) {
+      case Reason::First: return "first";
+      case Reason::Second: return "second";
+    }
+    sus_unreachable();
+  }
+};
+template <>
+struct sus::error::ErrorImpl<Message> {
+  static std::string display(const Message& m) noexcept { return m.message; }
+};
+template <>
+struct sus::error::ErrorImpl<WithSource> {
+  static std::string display(const WithSource& e) noexcept {
+    return fmt::format("code {}", e.code);
+  }
+  static sus::Option<const DynError&> source(const WithSource& e) noexcept {
+    return sus::some(*e.source);
+  }
+};
+
+namespace {
+using sus::error::DynError;
+using sus::error::SmallError;
+
+static_assert(sus::mem::Move<SmallError>);
+static_assert(!sus::mem::Copy<SmallError>);
+static_assert(sus::construct::From<SmallError, Unit>);
+static_assert(sus::construct::From<SmallError, Reason>);
+static_assert(sus::construct::From<SmallError, Message>);
+static_assert(sus::construct::From<SmallError, sus::Box<DynError>>);
+static_assert(sus::construct::Into<Reason, SmallError>);
+static_assert(sus::mem::NeverValueField<SmallError>);
+static_assert(sizeof(sus::Option<SmallError>) == sizeof(SmallError));
+static_assert(sizeof(SmallError) == 4u * sizeof(void*));
+
+static_assert(SmallError::stores_static<Unit>);
+static_assert(!SmallError::stores_static<Reason>);
+static_assert(SmallError::stores_inline<Reason>);
+static_assert(SmallError::stores_inline<WithSource>);
+static_assert(!SmallError::stores_inline<Message>);
+
+TEST(SmallError, Static) {
+  auto e = SmallError::from(Unit());
+  EXPECT_FALSE(e.is_allocated());
+  EXPECT_EQ(e->display(), "unit");
+  // Every `Unit` error shares the same object.
+  auto f = SmallError::from(Unit());
+  EXPECT_EQ(&e.as_ref(), &f.as_ref());
+
+  auto g = sus::move(e);
+  EXPECT_EQ(&g.as_ref(), &f.as_ref());
+  EXPECT_EQ(fmt::to_string(g), "unit");
+}
+
+TEST(SmallError, Inline) {
+  SmallError e = sus::into(Reason::Second);
+  EXPECT_FALSE(e.is_allocated());
+  EXPECT_EQ(fmt::to_string(e), "second");
+  EXPECT_EQ(sus::error::error_source(e).is_some(), false);
+
+  auto f = sus::move(e);
+  EXPECT_FALSE(f.is_allocated());
+  EXPECT_EQ(fmt::to_string(f), "second");
+
+  f = SmallError::from(Reason::First);
+  EXPECT_EQ(fmt::to_string(f), "first");
+}
+
+TEST(SmallError, Heap) {
+  auto e = SmallError::from(Message("a long message which is on the heap"));
+  EXPECT_TRUE(e.is_allocated());
+  const DynError* p = &e.as_ref();
+  auto f = sus::move(e);
+  EXPECT_EQ(&f.as_ref(), p);
+  EXPECT_EQ(fmt::to_string(f), "a long message which is on the heap");
+
+  // A `Box<DynError>` is adopted without a new allocation.
+  auto b = sus::Box<DynError>::from(Message("boxed"));
+  const DynError* bp = &b.as_ref();
+  SmallError g = sus::into(sus::move(b));
+  EXPECT_TRUE(g.is_allocated());
+  EXPECT_EQ(&g.as_ref(), bp);
+  EXPECT_EQ(fmt::to_string(g), "boxed");
+}
+
+TEST(SmallError, Source) {
+  auto e = SmallError::from(WithSource(3, sus::into(Reason::First)));
+  EXPECT_FALSE(e.is_allocated());
+  EXPECT_EQ(fmt::to_string(e), "code 3");
+  auto f = sus::move(e);
+  auto source = sus::error::error_source(f);
+  EXPECT_EQ(source.is_some(), true);
+  EXPECT_EQ(fmt::to_string(*source), "first");
+  EXPECT_EQ(sus::error::error_source(*source).is_some(), false);
+}
+
+TEST(SmallError, Result) {
+  auto f = [](i32 i) -> sus::Result<i32, SmallError> {
+    if (i > 10) return sus::err(sus::into(Reason::First));
+    if (i < -10) return sus::err(sus::into(Unit()));
+    return sus::ok(i);
+  };
+  EXPECT_EQ(fmt::format("{}", f(20)), "Err(first)");
+  EXPECT_EQ(fmt::format("{}", f(-20)), "Err(unit)");
+  EXPECT_EQ(fmt::format("{}", f(0)), "Ok(0)");
+}
+
+TEST(SmallErrorDeathTest, UseAfterMove) {
+  auto e = SmallError::from(Reason::First);
+  auto f = sus::move(e);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH([[maybe_unused]] auto g = sus::move(e), "used after move");
+  EXPECT_DEATH(e->display(), "used after move");
+#endif
+}
+
+TEST(SmallErrorDeathTest, Unwrap) {
+  auto r = sus::Result<i32, SmallError>(sus::err(sus::into(Reason::Second)));
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(sus::move(r).unwrap(), "second");
+#endif
+}
+
+}  // namespace
@@ -17,6 +17,7 @@
 // IWYU pragma: begin_exports
 #include "sus/fn/fn_concepts.h"
 #include "sus/fn/fn_dyn.h"
+#include "sus/fn/inplace_fn.h"
 // IWYU pragma: end_exports
 
 namespace sus {
@@ -87,6 +88,11 @@ namespace sus {
 ///
 /// func(sus::dyn<DynFnMut<i32(i32)>>([](i32) { return 3; }));
 /// ```
+///
+/// To store a callable without a template or a heap allocation,
+/// [`InplaceFn`]($sus::fn::InplaceFn) and
+/// [`InplaceFnOnce`]($sus::fn::InplaceFnOnce) hold it in fixed storage inside
+/// themselves.
 namespace fn {}
 
 }  // namespace sus
@@ -0,0 +1,370 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/fn/fn.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <concepts>
+#include <new>
+#include <type_traits>
+
+#include "sus/assertions/check.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/marker/unsafe.h"
+#include "sus/mem/forward.h"
+#include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
+#include "sus/mem/replace.h"
+
+namespace sus::fn {
+
+template <class Sig, size_t Capacity = 3u * sizeof(void*)>
+class InplaceFn;
+template <class Sig, size_t Capacity = 3u * sizeof(void*)>
+class InplaceFnOnce;
+
+namespace __private {
+
+enum class InplaceOp { Copy, Move, Destroy };
+
+/// Copies, relocates or destroys the callable of type `F` in the storage of an
+/// `InplaceFn` or `InplaceFnOnce`.
+template <class F>
+void inplace_manage(InplaceOp op, char* dst, char* src) noexcept {
+  F& f = *std::launder(reinterpret_cast<F*>(src));
+  switch (op) {
+    case InplaceOp::Copy:
+      if constexpr (std::copy_constructible<F>) new (dst) F(f);
+      return;
+    case InplaceOp::Move:
+      new (dst) F(::sus::move(f));
+      [[fallthrough]];
+    case InplaceOp::Destroy:
+      f.~F();
+      return;
+  }
+}
+
+/// Callables that can be copied, relocated and destroyed as plain bytes do not
+/// need a manager function.
+template <class F>
+constexpr bool InplaceTrivial =
+    std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>;
+
+}  // namespace __private
+
+/// A callable object which satisfies the concept [`Fn<R(Args...)>`](
+/// $sus::fn::Fn) and stores any callable satisfying the same concept inside
+/// itself, without a heap allocation.
+///
+/// Unlike a [`Box`]($sus::boxed::Box)`<`[`DynFn`]($sus::fn::DynFn)`>`, an
+/// `InplaceFn` never allocates, and calling it is a single indirect call
+/// through a function pointer stored in the `InplaceFn`, rather than through a
+/// virtual table.
+///
+/// The callable must fit in `Capacity` bytes and have an alignment no larger
+/// than a pointer's. Constructing an `InplaceFn` from a larger callable fails
+/// to compile, and a larger `Capacity` can be given instead. The default
+/// `Capacity` holds three pointers, such as a lambda that captures three
+/// references.
+///
+/// An `InplaceFn` can be copied, which copies the callable it holds, so the
+/// callable must be copy-constructible. To hold a move-only callable, or one
+/// that is only called once, use [`InplaceFnOnce`]($sus::fn::InplaceFnOnce).
+///
+/// A moved-from `InplaceFn` may not be used except to be assigned to or
+/// destroyed. It will [`panic`]($sus_panic) otherwise.
+///
+/// # Examples
+///
+/// ```
+/// i32 base = 10;
+/// auto f = sus::fn::InplaceFn<i32(i32)>::from(
+///     [&base](i32 i) { return base + i; });
+/// sus_check(f(2) == 12);
+///
+/// // Receiving a callable through `sus::into()`.
+/// auto call_twice = [](sus::fn::InplaceFn<i32(i32)> f) { return f(f(1)); };
+/// sus_check(call_twice(sus::into([](i32 i) { return i * 3; })) == 9);
+/// ```
+template <class R, class... Args, size_t Capacity>
+class InplaceFn<R(Args...), Capacity> final {
+  static_assert(Capacity > 0u, "InplaceFn needs a non-zero Capacity.");
+
+ public:
+  /// Whether a callable of type `F` fits in the storage of the `InplaceFn`.
+  template <class F>
+  static constexpr bool fits =
+      sizeof(F) <= Capacity && alignof(F) <= alignof(void*);
+
+  /// Constructs an `InplaceFn` which holds the callable `f`.
+  ///
+  /// Satisfies the [`From<F>`]($sus::construct::From) concept for
+  /// `InplaceFn<R(Args...)>` from any copyable callable satisfying
+  /// [`Fn<R(Args...)>`]($sus::fn::Fn).
+  ///
+  /// The callable must fit in the `Capacity` of the `InplaceFn`, or this will
+  /// fail to compile.
+  template <class F>
+  static InplaceFn from(F f) noexcept
+    requires(std::same_as<F, std::remove_cvref_t<F>> &&  //
+             std::copy_constructible<F> &&                //
+             ::sus::fn::Fn<F, R(Args...)>)
+  {
+    static_assert(fits<F>,
+                  "The callable is too large for the storage of the InplaceFn, "
+                  "increase its Capacity to hold it.");
+    auto s = InplaceFn(FROM_CALLABLE);
+    new (s.storage_) F(::sus::move(f));
+    s.invoke_ = &invoke<F>;
+    if constexpr (!__private::InplaceTrivial<F>)
+      s.manage_ = &__private::inplace_manage<F>;
+    return s;
+  }
+
+  /// Destroys the callable held in the `InplaceFn`.
+  ~InplaceFn() noexcept { destroy(); }
+
+  /// Satisifes the [`Copy`]($sus::mem::Copy) concept for `InplaceFn`.
+  InplaceFn(const InplaceFn& o) noexcept : invoke_(nullptr) {
+    sus_check_with_message(o.invoke_, "InplaceFn used after move");
+    copy_from(o);
+  }
+  /// Satisifes the [`Copy`]($sus::mem::Copy) concept for `InplaceFn`.
+  InplaceFn& operator=(const InplaceFn& o) noexcept {
+    sus_check_with_message(o.invoke_, "InplaceFn used after move");
+    if (this != &o) {
+      destroy();
+      copy_from(o);
+    }
+    return *this;
+  }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `InplaceFn`.
+  InplaceFn(InplaceFn&& o) noexcept : invoke_(nullptr) {
+    sus_check_with_message(o.invoke_, "InplaceFn used after move");
+    take_from(o);
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `InplaceFn`.
+  InplaceFn& operator=(InplaceFn&& o) noexcept {
+    sus_check_with_message(o.invoke_, "InplaceFn used after move");
+    if (this != &o) {
+      destroy();
+      take_from(o);
+    }
+    return *this;
+  }
+
+  /// Calls the callable held in the `InplaceFn`.
+  ///
+  /// This satisfies the [`Fn`]($sus::fn::Fn) concept, and thus also
+  /// [`FnMut`]($sus::fn::FnMut) and [`FnOnce`]($sus::fn::FnOnce).
+  R operator()(Args&&... args) const {
+    sus_check_with_message(invoke_, "InplaceFn used after move");
+    return invoke_(storage_, ::sus::forward<Args>(args)...);
+  }
+
+ private:
+  enum FromCallable { FROM_CALLABLE };
+  explicit InplaceFn(FromCallable) noexcept
+      : invoke_(nullptr), manage_(nullptr) {}
+
+  template <class F>
+  static R invoke(const char* storage, Args&&... args) {
+    return ::sus::fn::call(*std::launder(reinterpret_cast<const F*>(storage)),
+                           ::sus::forward<Args>(args)...);
+  }
+
+  void destroy() noexcept {
+    if (invoke_ == nullptr) return;
+    if (manage_ != nullptr)
+      manage_(__private::InplaceOp::Destroy, nullptr, storage_);
+    invoke_ = nullptr;
+  }
+
+  /// Copies the callable in `o`, which must not be moved-from.
+  void copy_from(const InplaceFn& o) noexcept {
+    if (o.manage_ != nullptr)
+      o.manage_(__private::InplaceOp::Copy, storage_,
+                const_cast<char*>(o.storage_));
+    else
+      memcpy(storage_, o.storage_, Capacity);
+    invoke_ = o.invoke_;
+    manage_ = o.manage_;
+  }
+
+  /// Takes the callable from `o`, which must not be moved-from.
+  void take_from(InplaceFn& o) noexcept {
+    if (o.manage_ != nullptr)
+      o.manage_(__private::InplaceOp::Move, storage_, o.storage_);
+    else
+      memcpy(storage_, o.storage_, Capacity);
+    invoke_ = ::sus::mem::replace(o.invoke_, nullptr);
+    manage_ = o.manage_;
+  }
+
+  // Calls the callable in `storage_`, or is null when moved-from.
+  R (*invoke_)(const char*, Args&&...);
+  // Copies, relocates and destroys the callable, or is null when it is
+  // trivially copyable and destructible.
+  void (*manage_)(__private::InplaceOp, char*, char*) noexcept;
+  alignas(alignof(void*)) char storage_[Capacity];
+
+  // The function pointer is never null until it is moved-from.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, InplaceFn,
+                                      invoke_, 1u, nullptr);
+  explicit InplaceFn(::sus::mem::NeverValueConstructor) noexcept
+      : invoke_(_sus_NeverValuePointer(0u)) {}
+};
+
+/// A callable object which satisfies the concept [`FnOnce<R(Args...)>`](
+/// $sus::fn::FnOnce) and stores any callable satisfying the same concept
+/// inside itself, without a heap allocation.
+///
+/// This is the move-only counterpart to [`InplaceFn`]($sus::fn::InplaceFn).
+/// It can hold callables which can not be copied, such as a lambda that
+/// captures a [`Box`]($sus::boxed::Box), and must be moved from to be called.
+/// The callable it holds is destroyed after the call completes, and calling
+/// it again will [`panic`]($sus_panic).
+///
+/// The callable must fit in `Capacity` bytes and have an alignment no larger
+/// than a pointer's, or constructing the `InplaceFnOnce` fails to compile.
+///
+/// # Examples
+///
+/// ```
+/// auto f = sus::fn::InplaceFnOnce<i32(i32)>::from(
+///     [b = sus::Box<i32>(3)](i32 i) { return *b + i; });
+/// sus_check(sus::move(f)(4) == 7);
+/// ```
+template <class R, class... Args, size_t Capacity>
+class InplaceFnOnce<R(Args...), Capacity> final {
+  static_assert(Capacity > 0u, "InplaceFnOnce needs a non-zero Capacity.");
+
+ public:
+  /// Whether a callable of type `F` fits in the storage of the
+  /// `InplaceFnOnce`.
+  template <class F>
+  static constexpr bool fits =
+      sizeof(F) <= Capacity && alignof(F) <= alignof(void*);
+
+  /// Constructs an `InplaceFnOnce` which holds the callable `f`.
+  ///
+  /// Satisfies the [`From<F>`]($sus::construct::From) concept for
+  /// `InplaceFnOnce<R(Args...)>` from any callable satisfying
+  /// [`FnOnce<R(Args...)>`]($sus::fn::FnOnce).
+  ///
+  /// The callable must fit in the `Capacity` of the `InplaceFnOnce`, or this
+  /// will fail to compile.
+  template <class F>
+  static InplaceFnOnce from(F f) noexcept
+    requires(std::same_as<F, std::remove_cvref_t<F>> &&  //
+             std::move_constructible<F> &&                //
+             ::sus::fn::FnOnce<F, R(Args...)>)
+  {
+    static_assert(fits<F>,
+                  "The callable is too large for the storage of the "
+                  "InplaceFnOnce, increase its Capacity to hold it.");
+    auto s = InplaceFnOnce(FROM_CALLABLE);
+    new (s.storage_) F(::sus::move(f));
+    s.invoke_ = &invoke<F>;
+    if constexpr (!__private::InplaceTrivial<F>)
+      s.manage_ = &__private::inplace_manage<F>;
+    return s;
+  }
+
+  /// Destroys the callable held in the `InplaceFnOnce`, if it was not called.
+  ~InplaceFnOnce() noexcept { destroy(); }
+
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `InplaceFnOnce`.
+  InplaceFnOnce(InplaceFnOnce&& o) noexcept : invoke_(nullptr) {
+    sus_check_with_message(o.invoke_, "InplaceFnOnce used after move");
+    take_from(o);
+  }
+  /// Satisifes the [`Move`]($sus::mem::Move) concept for `InplaceFnOnce`.
+  InplaceFnOnce& operator=(InplaceFnOnce&& o) noexcept {
+    sus_check_with_message(o.invoke_, "InplaceFnOnce used after move");
+    if (this != &o) {
+      destroy();
+      take_from(o);
+    }
+    return *this;
+  }
+
+  InplaceFnOnce(const InplaceFnOnce&) = delete;
+  InplaceFnOnce& operator=(const InplaceFnOnce&) = delete;
+
+  /// Calls the callable held in the `InplaceFnOnce`, and destroys it after the
+  /// call completes.
+  ///
+  /// This satisfies the [`FnOnce`]($sus::fn::FnOnce) concept.
+  R operator()(Args&&... args) && {
+    sus_check_with_message(invoke_, "InplaceFnOnce used after move");
+    struct Cleanup {
+      ~Cleanup() noexcept { f.destroy(); }
+      InplaceFnOnce& f;
+    };
+    auto cleanup = Cleanup(*this);
+    return invoke_(storage_, ::sus::forward<Args>(args)...);
+  }
+
+ private:
+  enum FromCallable { FROM_CALLABLE };
+  explicit InplaceFnOnce(FromCallable) noexcept
+      : invoke_(nullptr), manage_(nullptr) {}
+
+  template <class F>
+  static R invoke(char* storage, Args&&... args) {
+    return ::sus::fn::call_once(
+        ::sus::move(*std::launder(reinterpret_cast<F*>(storage))),
+        ::sus::forward<Args>(args)...);
+  }
+
+  void destroy() noexcept {
+    if (invoke_ == nullptr) return;
+    if (manage_ != nullptr)
+      manage_(__private::InplaceOp::Destroy, nullptr, storage_);
+    invoke_ = nullptr;
+  }
+
+  /// Takes the callable from `o`, which must not be moved-from.
+  void take_from(InplaceFnOnce& o) noexcept {
+    if (o.manage_ != nullptr)
+      o.manage_(__private::InplaceOp::Move, storage_, o.storage_);
+    else
+      memcpy(storage_, o.storage_, Capacity);
+    invoke_ = ::sus::mem::replace(o.invoke_, nullptr);
+    manage_ = o.manage_;
+  }
+
+  // Calls the callable in `storage_`, or is null when moved-from or called.
+  R (*invoke_)(char*, Args&&...);
+  // Relocates and destroys the callable, or is null when it is trivially
+  // copyable and destructible.
+  void (*manage_)(__private::InplaceOp, char*, char*) noexcept;
+  alignas(alignof(void*)) char storage_[Capacity];
+
+  // The function pointer is never null until it is moved-from.
+  sus_class_never_value_pointer_field(::sus::marker::unsafe_fn, InplaceFnOnce,
+                                      invoke_, 1u, nullptr);
+  explicit InplaceFnOnce(::sus::mem::NeverValueConstructor) noexcept
+      : invoke_(_sus_NeverValuePointer(0u)) {}
+};
+
+}  // namespace sus::fn
@@ -0,0 +1,169 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/fn/inplace_fn.h"
+
+#include <string>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/boxed/box.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+
+namespace {
+using sus::fn::InplaceFn;
+using sus::fn::InplaceFnOnce;
+
+// Counts how many copies of itself are alive.
+struct Counted {
+  Counted(i32& alive) : alive(&alive) { *this->alive += 1; }
+  Counted(const Counted& o) : alive(o.alive) { *alive += 1; }
+  Counted& operator=(const Counted&) = delete;
+  ~Counted() { *alive -= 1; }
+  i32 operator()(i32 i) const { return i + 1; }
+  i32* alive;
+};
+
+static_assert(sus::fn::Fn<InplaceFn<i32(i32)>, i32(i32)>);
+static_assert(sus::fn::FnMut<InplaceFn<i32(i32)>, i32(i32)>);
+static_assert(sus::fn::FnOnce<InplaceFn<i32(i32)>, i32(i32)>);
+static_assert(!sus::fn::Fn<InplaceFnOnce<i32(i32)>, i32(i32)>);
+static_assert(!sus::fn::FnMut<InplaceFnOnce<i32(i32)>, i32(i32)>);
+static_assert(sus::fn::FnOnce<InplaceFnOnce<i32(i32)>, i32(i32)>);
+
+static_assert(sus::mem::Copy<InplaceFn<i32(i32)>>);
+static_assert(sus::mem::Move<InplaceFn<i32(i32)>>);
+static_assert(!sus::mem::Copy<InplaceFnOnce<i32(i32)>>);
+static_assert(sus::mem::Move<InplaceFnOnce<i32(i32)>>);
+
+// A non-const callable is not a `Fn`.
+static_assert(!sus::construct::From<InplaceFn<i32(i32)>,
+                                    decltype([j = 0_i32](i32 i) mutable {
+                                      return j += i;
+                                    })>);
+// A move-only callable can only be held by an `InplaceFnOnce`.
+using MoveOnly = decltype([b = sus::Box<i32>(1)](i32) { return *b; });
+static_assert(!sus::construct::From<InplaceFn<i32(i32)>, MoveOnly>);
+static_assert(sus::construct::From<InplaceFnOnce<i32(i32)>, MoveOnly>);
+
+static_assert(InplaceFn<void()>::fits<decltype([a = 1, b = 2, c = 3]() {})>);
+static_assert(
+    !InplaceFn<void()>::fits<decltype([a = sus::Array<i32, 8u>()]() {})>);
+static_assert(
+    InplaceFn<void(), 64u>::fits<decltype([a = sus::Array<i32, 8u>()]() {})>);
+
+// The function pointer is never null, so an `Option` has no extra storage.
+static_assert(sizeof(sus::Option<InplaceFn<void()>>) ==
+              sizeof(InplaceFn<void()>));
+static_assert(sizeof(sus::Option<InplaceFnOnce<void()>>) ==
+              sizeof(InplaceFnOnce<void()>));
+
+TEST(InplaceFn, Call) {
+  i32 base = 10;
+  auto f = InplaceFn<i32(i32)>::from([&base](i32 i) { return base + i; });
+  EXPECT_EQ(f(2), 12);
+  base = 20;
+  EXPECT_EQ(sus::fn::call(f, 2), 22);
+  EXPECT_EQ(sus::fn::call_mut(f, 2), 22);
+  EXPECT_EQ(sus::fn::call_once(sus::move(f), 2), 22);
+
+  auto g = InplaceFn<i32(i32, i32)>::from(
+      [a = 1_i32, b = 2_i32](i32 x, i32 y) { return a * x + b * y; });
+  EXPECT_EQ(g(3, 4), 11);
+
+  i32 (*ptr)(i32) = [](i32 i) { return i * 2; };
+  auto h = InplaceFn<i32(i32)>::from(ptr);
+  EXPECT_EQ(h(4), 8);
+}
+
+TEST(InplaceFn, Into) {
+  auto call_twice = [](InplaceFn<i32(i32)> f) { return f(f(1)); };
+  EXPECT_EQ(call_twice(sus::into([](i32 i) { return i * 3; })), 9);
+
+  InplaceFn<std::string(const std::string&)> f =
+      sus::into([](const std::string& s) { return s + s; });
+  EXPECT_EQ(f("ab"), "abab");
+}
+
+TEST(InplaceFn, CopyAndMove) {
+  i32 alive;
+  {
+    auto f = InplaceFn<i32(i32)>::from(Counted(alive));
+    EXPECT_EQ(alive, 1);
+    auto g = f;
+    EXPECT_EQ(alive, 2);
+    EXPECT_EQ(g(1), 2);
+    auto h = sus::move(f);
+    EXPECT_EQ(alive, 2);
+    EXPECT_EQ(h(2), 3);
+    f = h;
+    EXPECT_EQ(alive, 3);
+    EXPECT_EQ(f(3), 4);
+    g = InplaceFn<i32(i32)>::from([](i32 i) { return i - 1; });
+    EXPECT_EQ(alive, 2);
+    EXPECT_EQ(g(3), 2);
+    // Trivial callables are copied as bytes.
+    auto k = g;
+    EXPECT_EQ(k(5), 4);
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(InplaceFnOnce, Call) {
+  auto s = std::string("hello");
+  auto f = InplaceFnOnce<std::string(), sizeof(std::string)>::from(
+      [s = sus::move(s)]() mutable { return sus::move(s); });
+  auto g = sus::move(f);
+  EXPECT_EQ(sus::move(g)(), "hello");
+
+  auto b = InplaceFnOnce<i32(i32)>::from(
+      [b = sus::Box<i32>(3)](i32 i) { return *b + i; });
+  EXPECT_EQ(sus::fn::call_once(sus::move(b), 4), 7);
+
+  // A `Fn` can be called once too.
+  InplaceFnOnce<i32(i32)> c = sus::into([](i32 i) { return i; });
+  EXPECT_EQ(sus::move(c)(5), 5);
+}
+
+TEST(InplaceFnOnce, Destroy) {
+  i32 alive;
+  {
+    auto f = InplaceFnOnce<i32(i32)>::from(Counted(alive));
+    EXPECT_EQ(alive, 1);
+    auto g = sus::move(f);
+    EXPECT_EQ(alive, 1);
+  }
+  EXPECT_EQ(alive, 0);
+  {
+    auto f = InplaceFnOnce<i32(i32)>::from(Counted(alive));
+    EXPECT_EQ(sus::move(f)(1), 2);
+    // The callable is destroyed after being called.
+    EXPECT_EQ(alive, 0);
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(InplaceFnDeathTest, UseAfterMove) {
+  auto f = InplaceFn<i32(i32)>::from([](i32 i) { return i; });
+  auto g = sus::move(f);
+  auto o = InplaceFnOnce<i32(i32)>::from([](i32 i) { return i; });
+  EXPECT_EQ(sus::move(o)(1), 1);
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(f(1), "used after move");
+  EXPECT_DEATH([[maybe_unused]] auto h = f, "used after move");
+  EXPECT_DEATH(sus::move(o)(1), "used after move");
+#endif
+}
+
+}  // namespace
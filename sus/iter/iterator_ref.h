@@ -14,6 +14,12 @@
 
 #pragma once
 
+#include <stddef.h>
+
+#include <atomic>
+#include <type_traits>
+#include <version>
+
 #include "sus/marker/unsafe.h"
 #include "sus/mem/relocate.h"
 #include "sus/mem/replace.h"
@@ -23,8 +29,76 @@
 static_assert(SUS_ITERATOR_INVALIDATION == 0 || SUS_ITERATOR_INVALIDATION == 1);
 #endif
 
+// SUS_ITERATOR_INVALIDATION_ATOMIC can be defined to 0 to count iterators with
+// plain increments instead of relaxed atomic ones. This is cheaper, but then a
+// collection must not be iterated on more than one thread at a time.
+#if !defined(SUS_ITERATOR_INVALIDATION_ATOMIC)
+#define SUS_ITERATOR_INVALIDATION_ATOMIC 1
+#endif
+static_assert(SUS_ITERATOR_INVALIDATION_ATOMIC == 0 ||
+              SUS_ITERATOR_INVALIDATION_ATOMIC == 1);
+
+// SUS_ITERATOR_INVALIDATION_VIEWS can be defined to 0 to stop tracking
+// iterators made from view types like `Slice`. Then views are just a pointer
+// and a length, and iterators made from them do not count themselves in the
+// owning collection, which is cheaper in loops that make many short-lived
+// slices, such as over `windows()` or `chunks()`. But mutating a collection
+// while an iterator made from one of its views is alive is then not caught,
+// and is Undefined Behaviour. Iterators made directly from an owning
+// collection, such as `Vec::iter()` or `Vec::windows()`, are counted either
+// way.
+#if !defined(SUS_ITERATOR_INVALIDATION_VIEWS)
+#define SUS_ITERATOR_INVALIDATION_VIEWS 1
+#endif
+static_assert(SUS_ITERATOR_INVALIDATION_VIEWS == 0 ||
+              SUS_ITERATOR_INVALIDATION_VIEWS == 1);
+
 namespace sus::iter {
 
+namespace __private {
+
+/// Adds `n` to an iterator count, which may be shared by iterators on other
+/// threads. The count only has to be exact when the owning collection reads it
+/// to check for iterators before mutating, so relaxed ordering is enough.
+template <class P>
+constexpr inline void iter_count_add(P& count, P n) noexcept {
+  if (std::is_constant_evaluated() || !SUS_ITERATOR_INVALIDATION_ATOMIC) {
+    count += n;
+  } else {
+#if defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<P>(count).fetch_add(n, std::memory_order_relaxed);
+#else
+    __atomic_fetch_add(&count, n, __ATOMIC_RELAXED);
+#endif
+  }
+}
+template <class P>
+constexpr inline void iter_count_sub(P& count, P n) noexcept {
+  if (std::is_constant_evaluated() || !SUS_ITERATOR_INVALIDATION_ATOMIC) {
+    count -= n;
+  } else {
+#if defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<P>(count).fetch_sub(n, std::memory_order_relaxed);
+#else
+    __atomic_fetch_sub(&count, n, __ATOMIC_RELAXED);
+#endif
+  }
+}
+template <class P>
+constexpr inline P iter_count_load(P& count) noexcept {
+  if (std::is_constant_evaluated() || !SUS_ITERATOR_INVALIDATION_ATOMIC) {
+    return count;
+  } else {
+#if defined(__cpp_lib_atomic_ref)
+    return std::atomic_ref<P>(count).load(std::memory_order_relaxed);
+#else
+    return __atomic_load_n(&count, __ATOMIC_RELAXED);
+#endif
+  }
+}
+
+}  // namespace __private
+
 struct IterRefCounter;
 
 #if !defined(SUS_ITERATOR_INVALIDATION) || SUS_ITERATOR_INVALIDATION
@@ -60,10 +134,14 @@ struct [[_sus_trivial_abi]] IterRef final {
   constexpr void inc() {
     // TODO: Remove this condition? Some slices have no collection so the
     // iterator doesn't either.
-    if (count_ptr_) *count_ptr_ += 1u;
+    if (count_ptr_)
+      __private::iter_count_add(count_ptr_->primitive_value,
+                                decltype(usize::primitive_value){1u});
   }
   constexpr void dec() {
-    if (count_ptr_) *count_ptr_ -= 1u;
+    if (count_ptr_)
+      __private::iter_count_sub(count_ptr_->primitive_value,
+                                decltype(usize::primitive_value){1u});
   }
 
   sus_class_trivially_relocatable(::sus::marker::unsafe_fn,
@@ -104,7 +182,9 @@ struct [[_sus_trivial_abi]] IterRefCounter final {
   }
 
   /// Only valid to be called on owning collections such as Vec.
-  constexpr usize count_from_owner() const noexcept { return count; }
+  constexpr usize count_from_owner() const noexcept {
+    return __private::iter_count_load(count.primitive_value);
+  }
 
   /// Resets self to no ref counts, returning a new IterRefCounter containing
   /// the old ref counts.
@@ -129,9 +209,9 @@ struct [[_sus_trivial_abi]] IterRefCounter final {
   constexpr IterRefCounter(ForView, usize* ptr) noexcept : count_ptr(ptr) {}
 
   union {
-    /// The `count` member is active in owning collections like `Vec`.
-    // TODO: This needs to be atomic: a container can be iterated on multiple
-    // threads.
+    /// The `count` member is active in owning collections like `Vec`. It is
+    /// updated atomically, unless `SUS_ITERATOR_INVALIDATION_ATOMIC` is 0, so
+    /// that a collection can be iterated on multiple threads at once.
     mutable usize count;
     /// The `count_ptr` member is active in view collections like `Slice`. It
     /// points to he owning collection. The presence of a `count_ptr` must also
@@ -198,8 +278,54 @@ constexpr IterRefCounter IterRef::to_view() const noexcept {
 
 #endif
 
+#if SUS_ITERATOR_INVALIDATION_VIEWS
+
+/// The `IterRefCounter` held in a view type such as `Slice`, which points to
+/// the count in the owning collection so that iterators made from the view
+/// are counted there.
+struct [[_sus_trivial_abi]] IterRefView final {
+  constexpr IterRefView(IterRefCounter refs) noexcept : refs_(refs) {}
+
+  constexpr IterRef to_iter_from_view() const noexcept {
+    return refs_.to_iter_from_view();
+  }
+  constexpr IterRefCounter to_view_from_view() const noexcept {
+    return refs_.to_view_from_view();
+  }
+
+ private:
+  [[_sus_no_unique_address]] IterRefCounter refs_;
+
+  sus_class_trivially_relocatable(::sus::marker::unsafe_fn, decltype(refs_));
+};
+
+#else
+
+/// The `IterRefCounter` held in a view type such as `Slice`. Views are not
+/// tracked when `SUS_ITERATOR_INVALIDATION_VIEWS` is 0, so this is empty and
+/// the `refs` it is constructed from are dropped. Iterators made from the view
+/// are not counted in the owning collection, and do not prevent it from being
+/// mutated.
+struct [[_sus_trivial_abi]] IterRefView final {
+  constexpr IterRefView(IterRefCounter) noexcept {}
+
+  constexpr IterRef to_iter_from_view() const noexcept {
+    return IterRefCounter::empty_for_view().to_iter_from_view();
+  }
+  constexpr IterRefCounter to_view_from_view() const noexcept {
+    return IterRefCounter::empty_for_view();
+  }
+
+ private:
+  sus_class_trivially_relocatable_unchecked(::sus::marker::unsafe_fn);
+};
+
+#endif
+
 static_assert(sus::mem::Copy<IterRefCounter>);
 static_assert(sus::mem::Move<IterRefCounter>);
 static_assert(sus::mem::TriviallyRelocatable<IterRefCounter>);
+static_assert(sus::mem::Copy<IterRefView>);
+static_assert(sus::mem::TriviallyRelocatable<IterRefView>);
 
 }  // namespace sus::iter
@@ -0,0 +1,135 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The `sus` module, built when `SUBSPACE_BUILD_MODULE` is enabled. Importing it
+// with `import sus;` avoids re-parsing the library headers in every
+// translation unit.
+//
+// The headers are included in the global module fragment, and the names that
+// are promoted into the `sus` namespace, along with the prelude and numeric
+// literals, are exported. Other names remain reachable through the types that
+// use them. Macros such as `sus_check()` can not be exported from a module,
+// so their headers must still be included where they are used.
+
+module;
+
+#include "sus/boxed/arc.h"
+#include "sus/boxed/box.h"
+#include "sus/boxed/dyn.h"
+#include "sus/boxed/rc.h"
+#include "sus/boxed/small_box.h"
+#include "sus/choice/choice.h"
+#include "sus/collections/array.h"
+#include "sus/collections/slice.h"
+#include "sus/collections/vec.h"
+#include "sus/construct/cast.h"
+#include "sus/construct/into.h"
+#include "sus/marker/empty.h"
+#include "sus/mem/clone.h"
+#include "sus/mem/forward.h"
+#include "sus/mem/move.h"
+#include "sus/mem/size_of.h"
+#include "sus/num/types.h"
+#include "sus/ops/range_literals.h"
+#include "sus/option/option.h"
+#include "sus/prelude.h"
+#include "sus/result/result.h"
+#include "sus/tuple/tuple.h"
+
+export module sus;
+
+export namespace sus {
+using ::sus::Arc;
+using ::sus::Array;
+using ::sus::Box;
+using ::sus::Choice;
+using ::sus::Err;
+using ::sus::None;
+using ::sus::Ok;
+using ::sus::Option;
+using ::sus::Rc;
+using ::sus::Result;
+using ::sus::Slice;
+using ::sus::SliceMut;
+using ::sus::SmallBox;
+using ::sus::Some;
+using ::sus::Tuple;
+using ::sus::Vec;
+using ::sus::cast;
+using ::sus::clone;
+using ::sus::clone_into;
+using ::sus::data_size_of;
+using ::sus::dyn;
+using ::sus::empty;
+using ::sus::err;
+using ::sus::forward;
+using ::sus::into;
+using ::sus::move;
+using ::sus::move_into;
+using ::sus::none;
+using ::sus::ok;
+using ::sus::size_of;
+using ::sus::some;
+using ::sus::try_into;
+using ::sus::tuple;
+
+using ::sus::f32;
+using ::sus::f64;
+using ::sus::i16;
+using ::sus::i32;
+using ::sus::i64;
+using ::sus::i8;
+using ::sus::isize;
+using ::sus::u16;
+using ::sus::u32;
+using ::sus::u64;
+using ::sus::u8;
+using ::sus::uptr;
+using ::sus::usize;
+
+namespace prelude {
+using ::sus::prelude::f32;
+using ::sus::prelude::f64;
+using ::sus::prelude::i16;
+using ::sus::prelude::i32;
+using ::sus::prelude::i64;
+using ::sus::prelude::i8;
+using ::sus::prelude::isize;
+using ::sus::prelude::Option;
+using ::sus::prelude::u16;
+using ::sus::prelude::u32;
+using ::sus::prelude::u64;
+using ::sus::prelude::u8;
+using ::sus::prelude::unsafe_fn;
+using ::sus::prelude::uptr;
+using ::sus::prelude::usize;
+using ::sus::prelude::Vec;
+}  // namespace prelude
+}  // namespace sus
+
+// Numeric and range literals are declared in the global namespace.
+export using ::operator""_f32;
+export using ::operator""_f64;
+export using ::operator""_i16;
+export using ::operator""_i32;
+export using ::operator""_i64;
+export using ::operator""_i8;
+export using ::operator""_isize;
+export using ::operator""_r;
+export using ::operator""_rs;
+export using ::operator""_u16;
+export using ::operator""_u32;
+export using ::operator""_u64;
+export using ::operator""_u8;
+export using ::operator""_usize;
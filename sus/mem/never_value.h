@@ -15,6 +15,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <concepts>
 #include <type_traits>
@@ -30,6 +31,12 @@ namespace sus::mem {
 
 struct NeverValueConstructor {};
 
+/// Selects one of the never-values of a type with more than one, where index
+/// 0 is the never-value set by the `NeverValueConstructor` constructor.
+struct NeverValueIndex {
+  size_t index;
+};
+
 namespace __private {
 
 /// A helper class that constructs and holds a NeverValueField type T.
@@ -72,13 +79,24 @@ struct NeverValueAccess<T&> {
   static constexpr bool has_field = false;
 };
 
-/// Whether the type `T` has a never-value field.
+/// Whether the type `T` has a never-value field, and how many never-values
+/// it can hold.
 template <class T>
 struct NeverValueChecker {
   static constexpr bool has_field = requires {
     std::declval<T&>()._sus_Unsafe_NeverValueIsConstructed(
         ::sus::marker::unsafe_fn);
   };
+
+  static consteval size_t find_count() noexcept {
+    if constexpr (!has_field)
+      return 0u;
+    else if constexpr (requires { T::_sus_NeverValueCount; })
+      return T::_sus_NeverValueCount;
+    else
+      return 1u;
+  }
+  static constexpr size_t count = find_count();
 };
 
 template <class T>
@@ -89,6 +107,14 @@ struct NeverValueAccess {
     requires(sizeof...(U) > 0u)
   constexpr NeverValueAccess(U&&... v) : t_(::sus::forward<U>(v)...) {}
 
+  /// Constructs the T with its never-value field set to the never-value at
+  /// `i.index`.
+  constexpr NeverValueAccess(NeverValueIndex i) noexcept
+    requires(NeverValueChecker<T>::has_field)
+  {
+    if (i.index > 0u) set_never_value_index(::sus::marker::unsafe_fn, i.index);
+  }
+
   /// Checks if the never-value field is set to the never-value, returning false
   /// if it is.
   _sus_pure constexpr _sus_always_inline bool is_constructed() const noexcept
@@ -105,6 +131,29 @@ struct NeverValueAccess {
     t_._sus_Unsafe_NeverValueSetDestroyValue(::sus::marker::unsafe_fn);
   }
 
+  /// Returns which never-value the never-value field is set to. The field must
+  /// be set to a never-value.
+  _sus_pure constexpr _sus_always_inline size_t never_value_index()
+      const noexcept
+    requires(NeverValueChecker<T>::has_field)
+  {
+    if constexpr (NeverValueChecker<T>::count > 1u)
+      return t_._sus_Unsafe_NeverValueIndex(::sus::marker::unsafe_fn);
+    else
+      return 0u;
+  }
+
+  /// Sets the never-value field to the never-value at index `i`, which must be
+  /// less than the type's number of never-values. The field must already be
+  /// set to a never-value.
+  constexpr _sus_always_inline void set_never_value_index(
+      ::sus::marker::UnsafeFnMarker, size_t i) noexcept
+    requires(NeverValueChecker<T>::has_field)
+  {
+    if constexpr (NeverValueChecker<T>::count > 1u)
+      t_._sus_Unsafe_NeverValueSetIndex(::sus::marker::unsafe_fn, i);
+  }
+
   _sus_pure constexpr _sus_always_inline const T& as_inner() const {
     return t_;
   }
@@ -133,6 +182,33 @@ struct NeverValueAccess {
 template <class T>
 concept NeverValueField = __private::NeverValueChecker<T>::has_field;
 
+/// The number of distinct never-values that a
+/// [`NeverValueField`]($sus::mem::NeverValueField) type can hold, or 0 if the
+/// type is not a `NeverValueField`.
+///
+/// A type that wraps a `NeverValueField` type, such as
+/// [`Option`]($sus::option::Option), uses one of its never-values to represent
+/// its own state, and can pass the remaining ones on as never-values of its
+/// own. This allows nesting such types, such as in `Option<Option<T>>`,
+/// without adding a flag for each layer.
+///
+/// A type can hold more than one never-value by declaring
+/// `static constexpr size_t _sus_NeverValueCount` along with the methods
+/// `_sus_Unsafe_NeverValueIndex(UnsafeFnMarker)` and
+/// `_sus_Unsafe_NeverValueSetIndex(UnsafeFnMarker, size_t)`, which read and
+/// write the index of the never-value that is set. Index 0 is the never-value
+/// that is set by constructing from `NeverValueConstructor`, and the methods
+/// are only called on an object whose field is already set to a never-value.
+template <class T>
+constexpr inline size_t never_value_count() noexcept {
+  return __private::NeverValueChecker<T>::count;
+}
+
+/// The number of never-values of a pointer field declared with
+/// `sus_class_never_value_pointer_field()`, which are the addresses starting
+/// at a base address that can never point to an object.
+inline constexpr size_t kNeverValuePointerCount = 16u;
+
 }  // namespace sus::mem
 
 /// Mark a class field as never being a specific value, often a zero, after a
@@ -173,3 +249,72 @@ concept NeverValueField = __private::NeverValueChecker<T>::has_field;
     field_name = destroy_value;                                                \
   }                                                                            \
   static_assert(true)
+
+/// Mark a pointer field as never holding any of the addresses from `base` to
+/// `base + sus::mem::kNeverValuePointerCount - 1` after a constructor has run
+/// and before the destructor has completed. This is like
+/// `sus_class_never_value_field()` with `base` as the never-value, but gives
+/// the class more than one never-value so that types holding it can be nested
+/// without adding space to each of them.
+///
+/// The `base` is an integer address which is used as the never-value set by
+/// the `NeverValueConstructor`. Only use this for a pointer that the class
+/// owns, such as a heap allocation or a function, which can never be at one of
+/// these small addresses. A pointer that comes from outside the class, as in
+/// [`NonNull`]($sus::ptr::NonNull), may hold any non-null address and must use
+/// `sus_class_never_value_field()` with a single never-value instead.
+///
+/// The never-values other than `nullptr` are made with a `reinterpret_cast`,
+/// so they can not be set in a constant evaluation. When `base` is 0, the
+/// first never-value is `nullptr` and can be used in a constant evaluation,
+/// but for any other `base` none of them can be.
+///
+/// The macro includes `private:` which changes the class definition visibility
+/// to private.
+#define sus_class_never_value_pointer_field(unsafe_fn, T, field_name, base,    \
+                                            destroy_value)                     \
+ private:                                                                      \
+  static_assert(                                                               \
+      std::same_as<decltype(unsafe_fn), const ::sus::marker::UnsafeFnMarker>); \
+  static_assert(std::is_pointer_v<decltype(field_name)>,                       \
+                "The named field must be a pointer.");                         \
+                                                                               \
+  template <class>                                                             \
+  friend struct ::sus::mem::__private::NeverValueAccess;                       \
+  template <class>                                                             \
+  friend struct ::sus::mem::__private::NeverValueChecker;                      \
+                                                                               \
+  static constexpr size_t _sus_NeverValueCount =                               \
+      ::sus::mem::kNeverValuePointerCount;                                     \
+                                                                               \
+  static constexpr decltype(field_name) _sus_NeverValuePointer(                \
+      size_t i) noexcept {                                                     \
+    if (uintptr_t{base} + i == 0u) return nullptr;                             \
+    return reinterpret_cast<decltype(field_name)>(uintptr_t{base} + i);        \
+  }                                                                            \
+  _sus_pure constexpr bool _sus_Unsafe_NeverValueIsConstructed(                \
+      ::sus::marker::UnsafeFnMarker) const noexcept {                          \
+    /* Only `nullptr` can be set in a constant evaluation. */                 \
+    if (std::is_constant_evaluated()) {                                        \
+      if constexpr (uintptr_t{base} == 0u)                                     \
+        return !(field_name == nullptr);                                       \
+      else                                                                     \
+        return true;                                                           \
+    }                                                                          \
+    return reinterpret_cast<uintptr_t>(field_name) - uintptr_t{base} >=        \
+           uintptr_t{_sus_NeverValueCount};                                    \
+  }                                                                            \
+  _sus_pure constexpr size_t _sus_Unsafe_NeverValueIndex(                      \
+      ::sus::marker::UnsafeFnMarker) const noexcept {                          \
+    if (std::is_constant_evaluated()) return 0u;                               \
+    return reinterpret_cast<uintptr_t>(field_name) - uintptr_t{base};          \
+  }                                                                            \
+  constexpr void _sus_Unsafe_NeverValueSetIndex(::sus::marker::UnsafeFnMarker, \
+                                                size_t i) noexcept {           \
+    field_name = _sus_NeverValuePointer(i);                                    \
+  }                                                                            \
+  constexpr void _sus_Unsafe_NeverValueSetDestroyValue(                        \
+      ::sus::marker::UnsafeFnMarker) noexcept {                                \
+    field_name = destroy_value;                                                \
+  }                                                                            \
+  static_assert(true)
@@ -0,0 +1,271 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <bit>
+#include <limits>
+
+#include "sus/macros/inline.h"
+
+namespace sus::num::__private::batch {
+
+// The kernels below are written as straight-line scalar code over primitive
+// doubles, with every branch expressed as a `select()`. That lets the compiler
+// vectorize a loop that calls them, which the libm functions (that may set
+// errno and branch on special cases) prevent. The f32 kernels evaluate in
+// f64 and round once at the end.
+//
+// The constant `0x1.8p52` is used to round to an integer without a
+// conversion instruction: adding it to a double of magnitude less than 2^51
+// leaves the rounded integer in the low bits of the mantissa.
+
+inline constexpr double kRoundMagic = 0x1.8p52;
+
+inline double bits_to_double(uint64_t u) noexcept {
+  return std::bit_cast<double>(u);
+}
+inline uint64_t double_to_bits(double d) noexcept {
+  return std::bit_cast<uint64_t>(d);
+}
+
+/// Returns `a` if `c` is true, and `b` otherwise. The selection is done on the
+/// bits of the values, as compilers will not turn a floating point conditional
+/// into a vector blend when they have to preserve floating point exceptions
+/// (the default, `-ftrapping-math`).
+inline double select(bool c, double a, double b) noexcept {
+  const uint64_t mask = uint64_t{0} - uint64_t{c};
+  return bits_to_double((double_to_bits(a) & mask) |
+                        (double_to_bits(b) & ~mask));
+}
+
+/// Returns 2^n where the low bits of `magic_bits` hold `n` as produced by
+/// adding `kRoundMagic`, for `n` in [-1022, 1023].
+inline double pow2_from_magic(uint64_t magic_bits) noexcept {
+  return bits_to_double((magic_bits + 1023u) << 52u);
+}
+
+/// e^r - 1 for |r| <= ln(2)/2, as a Taylor polynomial of degree 13. The
+/// truncation error is below 2^-57 relative to the result.
+inline double expm1_reduced(double r) noexcept {
+  double p = 1.0 / 6227020800.0;  // 1/13!
+  p = p * r + 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  return r + (r * r) * p;
+}
+
+inline constexpr double kLog2E = 0x1.71547652b82fep0;
+// ln(2) split so that n * kLn2Hi is exact for |n| < 2^20.
+inline constexpr double kLn2Hi = 0x1.62e42fee00000p-1;
+inline constexpr double kLn2Lo = 0x1.a39ef35793c76p-33;
+
+/// Splits `x` into `n * ln(2) + r` with |r| <= ln(2)/2 and returns `r`, storing
+/// the rounding bits for 2^n in `magic_bits`. `x` must be clamped to a range
+/// where `n` fits in [-1100, 1100].
+inline double reduce_ln2(double x, uint64_t& magic_bits) noexcept {
+  const double t = x * kLog2E + kRoundMagic;
+  magic_bits = double_to_bits(t);
+  const double n = t - kRoundMagic;
+  return (x - n * kLn2Hi) - n * kLn2Lo;
+}
+
+inline constexpr double kExpMax = 0x1.62e42fefa39efp9;    // ln(DBL_MAX)
+inline constexpr double kExpMin = -0x1.74910d52d3051p9;   // ln(2^-1075)
+
+_sus_always_inline double exp(double x) noexcept {
+  const double lo = select(x < -746.0, -746.0, x);
+  const double c = select(lo > 710.0, 710.0, lo);
+  uint64_t magic_bits;
+  const double r = reduce_ln2(c, magic_bits);
+  const double p = 1.0 + expm1_reduced(r);
+  // Scale by 2^n in two steps so that subnormal results and 2^1024 do not
+  // need an exponent outside of the normal range.
+  const int64_t n =
+      static_cast<int64_t>(magic_bits - double_to_bits(kRoundMagic));
+  const int64_t n1 = n >> 1;
+  const uint64_t u1 = static_cast<uint64_t>(n1);
+  const uint64_t u2 = static_cast<uint64_t>(n - n1);
+  const double e = p * pow2_from_magic(u1) * pow2_from_magic(u2);
+  const double inf = std::numeric_limits<double>::infinity();
+  const double big = select(x > kExpMax, inf, e);
+  const double small = select(x < kExpMin, 0.0, big);
+  return select(x != x, x, small);
+}
+
+inline constexpr double kSqrtHalf = 0x1.6a09e667f3bcdp-1;
+
+_sus_always_inline double log(double x) noexcept {
+  // Subnormal inputs are scaled into the normal range first.
+  const bool sub = x < 0x1p-1022;
+  const double scaled = x * 0x1p54;
+  const double xs = select(sub, scaled, x);
+  const uint64_t bits = double_to_bits(xs);
+  // Rebias so that the mantissa `m` lands in [sqrt(1/2), sqrt(2)).
+  const uint64_t rebiased = bits - double_to_bits(kSqrtHalf);
+  const int64_t k = static_cast<int64_t>(rebiased) >> 52;
+  const uint64_t mbits =
+      (rebiased & 0x000fffffffffffffu) + double_to_bits(kSqrtHalf);
+  const double m = bits_to_double(mbits);
+  // Converts `k` to a double without a conversion instruction, which is not
+  // available for 64-bit integers in most vector instruction sets.
+  const double kd = bits_to_double(double_to_bits(kRoundMagic) +
+                                   static_cast<uint64_t>(k)) -
+                    kRoundMagic;
+  const double e = kd - select(sub, 54.0, 0.0);
+
+  // log(m) = log(1 + f) = 2 atanh(s) with s = f / (2 + f), |s| < 0.1716.
+  const double f = m - 1.0;
+  const double s = f / (2.0 + f);
+  const double z = s * s;
+  double p = 2.0 / 21.0;
+  p = p * z + 2.0 / 19.0;
+  p = p * z + 2.0 / 17.0;
+  p = p * z + 2.0 / 15.0;
+  p = p * z + 2.0 / 13.0;
+  p = p * z + 2.0 / 11.0;
+  p = p * z + 2.0 / 9.0;
+  p = p * z + 2.0 / 7.0;
+  p = p * z + 2.0 / 5.0;
+  p = p * z + 2.0 / 3.0;
+  // log(1 + f) = f - f^2/2 + s * (f^2/2 + R), which keeps the large terms
+  // exact.
+  const double hfsq = 0.5 * f * f;
+  const double r = s * (hfsq + z * p);
+  const double l = e * kLn2Hi + ((f - (hfsq - (r + e * kLn2Lo))));
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double l_inf = select(x == inf, inf, l);
+  const double l_zero = select(x == 0.0, -inf, l_inf);
+  const double l_neg = select(x < 0.0, nan, l_zero);
+  return select(x != x, x, l_neg);
+}
+
+inline constexpr double k2OverPi = 0x1.45f306dc9c883p-1;
+// pi/2 split into three 33-bit parts and a tail, so that `q * part` is exact
+// for |q| < 2^20.
+inline constexpr double kPiOver2_1 = 0x1.921fb54400000p0;
+inline constexpr double kPiOver2_2 = 0x1.0b4611a600000p-34;
+inline constexpr double kPiOver2_3 = 0x1.3198a2e000000p-69;
+inline constexpr double kPiOver2_3t = 0x1.b839a252049c1p-104;
+
+/// The largest magnitude that the vector sin/cos reduce. Larger inputs are
+/// handed to the scalar functions by the callers.
+inline constexpr double kTrigMax = 0x1p20;
+
+/// Reduces `x` by multiples of pi/2, returning `r` with |r| <= ~pi/4 and the
+/// quadrant in `q`.
+inline double reduce_pio2(double x, uint64_t& q) noexcept {
+  const double lo = select(x < -kTrigMax, -kTrigMax, x);
+  const double c = select(lo > kTrigMax, kTrigMax, lo);
+  const double t = c * k2OverPi + kRoundMagic;
+  q = double_to_bits(t);
+  const double n = t - kRoundMagic;
+  // Each step is exact or tracks its rounding error, so that the result is
+  // accurate even when `x` is close to a multiple of pi/2.
+  const double r1 = c - n * kPiOver2_1;
+  const double w2 = n * kPiOver2_2;
+  const double r2 = r1 - w2;
+  const double e2 = (r1 - r2) - w2;
+  const double w3 = n * kPiOver2_3;
+  const double r3 = r2 - w3;
+  const double e3 = (r2 - r3) - w3;
+  return r3 + ((e2 + e3) - n * kPiOver2_3t);
+}
+
+/// sin(r) for |r| <= pi/4, with the fdlibm minimax coefficients.
+inline double sin_reduced(double r) noexcept {
+  const double z = r * r;
+  double p = 1.58969099521155010221e-10;
+  p = p * z - 2.50507602534068634195e-08;
+  p = p * z + 2.75573137070700676789e-06;
+  p = p * z - 1.98412698298579493134e-04;
+  p = p * z + 8.33333333332248946124e-03;
+  p = p * z - 1.66666666666666324348e-01;
+  return r + r * z * p;
+}
+
+/// cos(r) for |r| <= pi/4, with the fdlibm minimax coefficients.
+inline double cos_reduced(double r) noexcept {
+  const double z = r * r;
+  double p = -1.13596475577881948265e-11;
+  p = p * z + 2.08757232129817482790e-09;
+  p = p * z - 2.75573143513906633035e-07;
+  p = p * z + 2.48015872894767294178e-05;
+  p = p * z - 1.38888888888741095749e-03;
+  p = p * z + 4.16666666666666019037e-02;
+  const double hz = 0.5 * z;
+  const double w = 1.0 - hz;
+  return w + (((1.0 - w) - hz) + z * z * p);
+}
+
+/// Combines sin and cos of the reduced argument for quadrant `q`.
+inline double trig_quadrant(double s, double c, uint64_t q) noexcept {
+  const double v = select((q & 1u) != 0u, c, s);
+  return select((q & 2u) != 0u, -v, v);
+}
+
+_sus_always_inline double sin(double x) noexcept {
+  uint64_t q;
+  const double r = reduce_pio2(x, q);
+  const double s = trig_quadrant(sin_reduced(r), cos_reduced(r), q);
+  // The reduction turns -0.0 into 0.0.
+  return select(x == 0.0, x, s);
+}
+
+_sus_always_inline double cos(double x) noexcept {
+  uint64_t q;
+  const double r = reduce_pio2(x, q);
+  // cos(x) = sin(x + pi/2).
+  return trig_quadrant(sin_reduced(r), cos_reduced(r), q + 1u);
+}
+
+_sus_always_inline double tanh(double x) noexcept {
+  const double a = select(x < 0.0, -x, x);
+  // tanh(a) rounds to 1 past 19.1 for f64.
+  const double c = select(a > 20.0, 20.0, a);
+  // tanh(a) = expm1(2a) / (expm1(2a) + 2), with expm1(2a) computed as
+  // 2^n * expm1(r) + (2^n - 1), where both terms are exact when n > 0.
+  uint64_t magic_bits;
+  const double r = reduce_ln2(2.0 * c, magic_bits);
+  const double scale = pow2_from_magic(magic_bits);
+  const double em = scale * expm1_reduced(r) + (scale - 1.0);
+  const double t = em / (em + 2.0);
+  const double t_big = select(a > 20.0, 1.0, t);
+  const double signed_t = select(x < 0.0, -t_big, t_big);
+  // NaN and -0.0 are returned as is.
+  const double t_zero = select(x == 0.0, x, signed_t);
+  return select(x != x, x, t_zero);
+}
+
+// The square root instruction is correctly rounded, but compilers only
+// vectorize it when they do not need to set `errno` for negative inputs (such
+// as with `-fno-math-errno`).
+_sus_always_inline double sqrt(double x) noexcept { return ::sqrt(x); }
+
+_sus_always_inline double rsqrt(double x) noexcept { return 1.0 / sqrt(x); }
+
+}  // namespace sus::num::__private::batch
@@ -0,0 +1,82 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+#include "sus/macros/pure.h"
+#include "sus/num/__private/int_log10.h"
+
+// Formatting of integers into decimal characters, as done by the `to_chars()`
+// methods of the integer types.
+namespace sus::num::__private {
+
+/// The decimal characters of each number from 0 to 99, so that digits can be
+/// written two at a time.
+inline constexpr char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/// Writes the decimal representation of `x` into `out`, which has space for
+/// `cap` characters. Returns the number of characters written, or 0 if they
+/// would not fit in `out`, in which case nothing is written.
+template <class P>
+  requires(std::is_integral_v<P> && sizeof(P) <= 8u)
+constexpr size_t integer_to_chars(P x, char* out, size_t cap) noexcept {
+  using U = std::make_unsigned_t<P>;
+  const bool negative = x < P{0};
+  const U u = negative ? static_cast<U>(U{0u} - static_cast<U>(x))
+                       : static_cast<U>(x);
+  uint64_t v = u;
+  const size_t digits = v == 0u ? 1u : int_log10::u64(v) + 1u;
+  const size_t len = digits + size_t{negative};
+  if (len > cap) return 0u;
+
+  if (negative) out[0u] = '-';
+  // Digits are written from the end, two at a time.
+  char* end = out + len;
+  while (v >= 100u) {
+    const size_t pair = static_cast<size_t>(v % 100u) * 2u;
+    v /= 100u;
+    end -= 2;
+    end[0] = kDigitPairs[pair];
+    end[1] = kDigitPairs[pair + 1u];
+  }
+  if (v >= 10u) {
+    const size_t pair = static_cast<size_t>(v) * 2u;
+    end -= 2;
+    end[0] = kDigitPairs[pair];
+    end[1] = kDigitPairs[pair + 1u];
+  } else {
+    end -= 1;
+    end[0] = static_cast<char>('0' + v);
+  }
+  return len;
+}
+
+}  // namespace sus::num::__private
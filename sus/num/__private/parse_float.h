@@ -0,0 +1,388 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <bit>
+#include <charconv>
+#include <string>
+#include <system_error>
+
+#include "sus/macros/inline.h"
+#include "sus/macros/pure.h"
+#include "sus/num/__private/parse_integer.h"
+#include "sus/num/__private/powers_of_five.h"
+#include "sus/num/parse_float_error.h"
+#include "sus/result/result.h"
+
+// Parsing of floating point numbers from strings of characters, as done by the
+// `from_str()` methods of the floating point types.
+//
+// Decimal digits are read 8 at a time as with integers, and the binary value
+// is computed with the Eisel-Lemire algorithm, following
+// https://github.com/fastfloat/fast_float. See "Number Parsing at a Gigabyte
+// per Second" (https://arxiv.org/abs/2101.11408) by Daniel Lemire.
+namespace sus::num::__private {
+
+template <class F>
+struct BinaryFormat;
+
+template <>
+struct BinaryFormat<double> {
+  using Bits = uint64_t;
+  static constexpr int32_t kMantissaBits = 52;
+  static constexpr int32_t kMinimumExponent = -1023;
+  static constexpr int32_t kInfinitePower = 0x7FF;
+  static constexpr int64_t kSmallestPowerOfTen = -342;
+  static constexpr int64_t kLargestPowerOfTen = 308;
+  static constexpr int64_t kMinExponentRoundToEven = -4;
+  static constexpr int64_t kMaxExponentRoundToEven = 23;
+  static constexpr int64_t kMinExponentFastPath = -22;
+  static constexpr int64_t kMaxExponentFastPath = 22;
+  static constexpr uint64_t kMaxMantissaFastPath = uint64_t{2} << 52;
+  static constexpr double kExactPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template <>
+struct BinaryFormat<float> {
+  using Bits = uint32_t;
+  static constexpr int32_t kMantissaBits = 23;
+  static constexpr int32_t kMinimumExponent = -127;
+  static constexpr int32_t kInfinitePower = 0xFF;
+  static constexpr int64_t kSmallestPowerOfTen = -65;
+  static constexpr int64_t kLargestPowerOfTen = 38;
+  static constexpr int64_t kMinExponentRoundToEven = -17;
+  static constexpr int64_t kMaxExponentRoundToEven = 10;
+  static constexpr int64_t kMinExponentFastPath = -10;
+  static constexpr int64_t kMaxExponentFastPath = 10;
+  static constexpr uint64_t kMaxMantissaFastPath = uint64_t{2} << 23;
+  static constexpr float kExactPowersOfTen[] = {
+      1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+struct Value128 {
+  uint64_t low;
+  uint64_t high;
+};
+
+__sus_pure_const _sus_always_inline constexpr Value128 full_multiplication(
+    uint64_t a, uint64_t b) noexcept {
+#if _MSC_VER
+  const uint64_t a_lo = a & 0xFFFFFFFFu;
+  const uint64_t a_hi = a >> 32u;
+  const uint64_t b_lo = b & 0xFFFFFFFFu;
+  const uint64_t b_hi = b >> 32u;
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t hi_hi = a_hi * b_hi;
+  const uint64_t cross = (lo_lo >> 32u) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+  return Value128{.low = (cross << 32u) | (lo_lo & 0xFFFFFFFFu),
+                  .high = (hi_lo >> 32u) + (cross >> 32u) + hi_hi};
+#else
+  const auto r = __uint128_t{a} * __uint128_t{b};
+  return Value128{.low = static_cast<uint64_t>(r),
+                  .high = static_cast<uint64_t>(r >> 64u)};
+#endif
+}
+
+/// Computes the high 128 bits of `w * 5^q`, with at least `BITS` of them
+/// correct. `w` must be normalized so its highest bit is set.
+template <int32_t BITS>
+_sus_pure constexpr Value128 compute_product_approximation(
+    int64_t q, uint64_t w) noexcept {
+  const size_t index = static_cast<size_t>(q - kSmallestPowerOfFive);
+  Value128 first = full_multiplication(w, kPowersOfFive128[index][0u]);
+  constexpr uint64_t kPrecisionMask = ~uint64_t{0u} >> BITS;
+  if ((first.high & kPrecisionMask) == kPrecisionMask) {
+    // The low bits may be affected by the truncated bits of the power of
+    // five, so the next 64 bits of it are included.
+    const Value128 second = full_multiplication(w, kPowersOfFive128[index][1u]);
+    first.low += second.high;
+    if (second.high > first.low) first.high += 1u;
+  }
+  return first;
+}
+
+/// A binary significand and biased exponent, before they are packed into a
+/// floating point value. A negative `power2` means the value could not be
+/// computed exactly.
+struct AdjustedMantissa {
+  uint64_t mantissa;
+  int32_t power2;
+
+  constexpr bool operator==(const AdjustedMantissa&) const noexcept = default;
+};
+
+/// Computes `floor(log2(10^q)) + 63`, for `q` in [-342, 308].
+__sus_pure_const _sus_always_inline constexpr int32_t power_of_ten_to_two(
+    int32_t q) noexcept {
+  return (((152170 + 65536) * q) >> 16) + 63;
+}
+
+/// The Eisel-Lemire algorithm, which computes the nearest floating point value
+/// to `w * 10^q`.
+template <class F>
+_sus_pure constexpr AdjustedMantissa compute_float(int64_t q,
+                                                    uint64_t w) noexcept {
+  using B = BinaryFormat<F>;
+  if (w == 0u || q < B::kSmallestPowerOfTen)
+    return AdjustedMantissa{.mantissa = 0u, .power2 = 0};
+  if (q > B::kLargestPowerOfTen)
+    return AdjustedMantissa{.mantissa = 0u, .power2 = B::kInfinitePower};
+
+  const int32_t lz = std::countl_zero(w);
+  w <<= lz;
+  // The product is always precise enough to round correctly, as proven in
+  // "Fast Number Parsing Without Fallback" by Noble Mushtak and Daniel
+  // Lemire.
+  const Value128 product =
+      compute_product_approximation<B::kMantissaBits + 3>(q, w);
+  const int32_t upperbit = static_cast<int32_t>(product.high >> 63u);
+  const int32_t shift = upperbit + 64 - B::kMantissaBits - 3;
+  AdjustedMantissa am{
+      .mantissa = product.high >> shift,
+      .power2 = power_of_ten_to_two(static_cast<int32_t>(q)) + upperbit - lz -
+                B::kMinimumExponent};
+
+  if (am.power2 <= 0) {
+    // A subnormal value.
+    if (-am.power2 + 1 >= 64) return AdjustedMantissa{.mantissa = 0u,
+                                                      .power2 = 0};
+    am.mantissa >>= -am.power2 + 1;
+    am.mantissa += am.mantissa & 1u;
+    am.mantissa >>= 1u;
+    // Rounding up may have produced the smallest normal value.
+    am.power2 =
+        am.mantissa < (uint64_t{1u} << B::kMantissaBits) ? 0 : 1;
+    return am;
+  }
+
+  // The value is rounded up, except exactly halfway between two values where
+  // it rounds to even, which can only happen for a narrow range of `q`.
+  if (product.low <= 1u && q >= B::kMinExponentRoundToEven &&
+      q <= B::kMaxExponentRoundToEven && (am.mantissa & 3u) == 1u) {
+    if ((am.mantissa << shift) == product.high) am.mantissa &= ~uint64_t{1u};
+  }
+  am.mantissa += am.mantissa & 1u;
+  am.mantissa >>= 1u;
+  if (am.mantissa >= (uint64_t{2u} << B::kMantissaBits)) {
+    am.mantissa = uint64_t{1u} << B::kMantissaBits;
+    am.power2 += 1;
+  }
+  am.mantissa &= ~(uint64_t{1u} << B::kMantissaBits);
+  if (am.power2 >= B::kInfinitePower)
+    return AdjustedMantissa{.mantissa = 0u, .power2 = B::kInfinitePower};
+  return am;
+}
+
+template <class F>
+__sus_pure_const _sus_always_inline constexpr F to_float(
+    bool negative, AdjustedMantissa am) noexcept {
+  using B = BinaryFormat<F>;
+  using Bits = typename B::Bits;
+  Bits bits = static_cast<Bits>(am.mantissa);
+  bits |= static_cast<Bits>(am.power2) << B::kMantissaBits;
+  bits |= static_cast<Bits>(negative) << (sizeof(Bits) * 8u - 1u);
+  return std::bit_cast<F>(bits);
+}
+
+/// Returns if `s` is equal to the lower-case ASCII string `lower`, ignoring
+/// case.
+_sus_pure constexpr bool equals_ignore_case(const char* s, size_t len,
+                                             const char* lower) noexcept {
+  size_t i = 0u;
+  for (; i < len; ++i) {
+    if (lower[i] == '\0' || (s[i] | 0x20) != lower[i]) return false;
+  }
+  return lower[i] == '\0';
+}
+
+/// Parses values that are too precise for `compute_float()` to determine
+/// the rounding of from their first 19 digits, with the standard library.
+///
+/// This is rare, as it needs more than 19 significant digits that land near
+/// the middle of two floating point values.
+template <class F>
+F parse_float_slow(const char* s, size_t len) noexcept {
+  // `from_chars()` and `strtod()` do not accept a leading `+`.
+  if (s[0u] == '+') {
+    s += 1u;
+    len -= 1u;
+  }
+#if defined(__cpp_lib_to_chars)
+  F value;
+  std::from_chars(s, s + len, value);
+  return value;
+#else
+  // This relies on the "C" locale for the decimal point.
+  const std::string terminated(s, len);
+  if constexpr (std::same_as<F, float>)
+    return ::strtof(terminated.c_str(), nullptr);
+  else
+    return ::strtod(terminated.c_str(), nullptr);
+#endif
+}
+
+/// Parses the primitive floating point type `F` from the characters in `s`.
+///
+/// The string may have a sign, followed by decimal digits with an optional
+/// decimal point and an optional exponent, such as `-12.5e-3`. At least one
+/// digit is required before or after the decimal point. The strings `inf`,
+/// `infinity` and `nan` are also accepted, ignoring case, with an optional
+/// sign. No other characters, including whitespace, are accepted.
+template <class F>
+::sus::result::Result<F, ::sus::num::ParseFloatError> parse_float(
+    const char* s, size_t len) noexcept {
+  using R = ::sus::result::Result<F, ::sus::num::ParseFloatError>;
+  using E = ::sus::num::ParseFloatError;
+  using B = BinaryFormat<F>;
+
+  if (len == 0u) return R::with_err(E::with_empty());
+  const char* p = s;
+  const char* const end = s + len;
+  const bool negative = *p == '-';
+  if (*p == '-' || *p == '+') p += 1;
+  const auto is_digit = [](char c) {
+    return static_cast<unsigned char>(c - '0') < 10u;
+  };
+
+  if (p != end && !is_digit(*p) && *p != '.') {
+    const size_t rest = static_cast<size_t>(end - p);
+    if (equals_ignore_case(p, rest, "inf") ||
+        equals_ignore_case(p, rest, "infinity")) {
+      return R(negative ? -std::numeric_limits<F>::infinity()
+                        : std::numeric_limits<F>::infinity());
+    }
+    if (equals_ignore_case(p, rest, "nan")) {
+      return R(negative ? -std::numeric_limits<F>::quiet_NaN()
+                        : std::numeric_limits<F>::quiet_NaN());
+    }
+    return R::with_err(E::with_invalid());
+  }
+
+  // The digits before the decimal point. The value may overflow here if there
+  // are more than 19 digits, which is handled below.
+  uint64_t w = 0u;
+  const char* const integer = p;
+  while (end - p >= 8 && is_eight_digits(load_eight_chars(p))) {
+    w = w * 100'000'000u + parse_eight_digits(load_eight_chars(p));
+    p += 8;
+  }
+  while (p != end && is_digit(*p)) {
+    w = w * 10u + static_cast<unsigned char>(*p - '0');
+    p += 1;
+  }
+  const char* const integer_end = p;
+  int64_t digits = integer_end - integer;
+
+  // The digits after the decimal point.
+  const char* fraction = p;
+  const char* fraction_end = p;
+  if (p != end && *p == '.') {
+    p += 1;
+    fraction = p;
+    while (end - p >= 8 && is_eight_digits(load_eight_chars(p))) {
+      w = w * 100'000'000u + parse_eight_digits(load_eight_chars(p));
+      p += 8;
+    }
+    while (p != end && is_digit(*p)) {
+      w = w * 10u + static_cast<unsigned char>(*p - '0');
+      p += 1;
+    }
+    fraction_end = p;
+    digits += fraction_end - fraction;
+  }
+  if (digits == 0) return R::with_err(E::with_invalid());
+  int64_t q = fraction - fraction_end;
+
+  int64_t explicit_exponent = 0;
+  if (p != end && (*p | 0x20) == 'e') {
+    p += 1;
+    const bool negative_exponent = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+')) p += 1;
+    if (p == end || !is_digit(*p)) return R::with_err(E::with_invalid());
+    while (p != end && is_digit(*p)) {
+      // Larger exponents than this are all infinity or zero.
+      if (explicit_exponent < 0x10000000)
+        explicit_exponent =
+            explicit_exponent * 10 + static_cast<unsigned char>(*p - '0');
+      p += 1;
+    }
+    if (negative_exponent) explicit_exponent = -explicit_exponent;
+    q += explicit_exponent;
+  }
+  if (p != end) return R::with_err(E::with_invalid());
+
+  // With more than 19 significant digits, the value is approximated by its
+  // first 19 digits.
+  bool truncated = false;
+  if (digits > 19) {
+    for (const char* z = integer; z != end && (*z == '0' || *z == '.'); ++z) {
+      if (*z == '0') digits -= 1;
+    }
+    if (digits > 19) {
+      truncated = true;
+      constexpr uint64_t kMinNineteenDigits = 1'000'000'000'000'000'000u;
+      w = 0u;
+      const char* d = integer;
+      while (w < kMinNineteenDigits && d != integer_end) {
+        w = w * 10u + static_cast<unsigned char>(*d - '0');
+        d += 1;
+      }
+      if (w >= kMinNineteenDigits) {
+        q = (integer_end - d) + explicit_exponent;
+      } else {
+        d = fraction;
+        while (w < kMinNineteenDigits && d != fraction_end) {
+          w = w * 10u + static_cast<unsigned char>(*d - '0');
+          d += 1;
+        }
+        q = (fraction - d) + explicit_exponent;
+      }
+    }
+  }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  // Clinger's fast path: both the mantissa and the power of ten are exactly
+  // representable, so a single rounding operation gives the correct result.
+  if (!truncated && q >= B::kMinExponentFastPath &&
+      q <= B::kMaxExponentFastPath && w <= B::kMaxMantissaFastPath) {
+    F value = static_cast<F>(w);
+    if (q < 0)
+      value = value / B::kExactPowersOfTen[-q];
+    else
+      value = value * B::kExactPowersOfTen[q];
+    return R(negative ? -value : value);
+  }
+#endif
+
+  AdjustedMantissa am = compute_float<F>(q, w);
+  if (truncated && am != compute_float<F>(q, w + 1u)) {
+    // The digits that were dropped change the result.
+    return R(parse_float_slow<F>(s, len));
+  }
+  return R(to_float<F>(negative, am));
+}
+
+}  // namespace sus::num::__private
@@ -0,0 +1,179 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <type_traits>
+
+#include "sus/macros/inline.h"
+#include "sus/macros/pure.h"
+#include "sus/num/parse_int_error.h"
+#include "sus/result/result.h"
+
+// Parsing of integers from strings of characters, as done by the
+// `from_str_radix()` methods of the integer types.
+//
+// Decimal digits are validated and combined 8 at a time in a 64-bit register
+// (SWAR, "SIMD within a register"), based on the approach in
+// https://github.com/fastfloat/fast_float.
+namespace sus::num::__private {
+
+/// Loads 8 characters into a 64-bit integer, with the first character in the
+/// lowest byte regardless of the platform's endianness. Compilers turn this
+/// into a single load on little endian platforms.
+__sus_pure_const _sus_always_inline constexpr uint64_t load_eight_chars(
+    const char* s) noexcept {
+  uint64_t v = 0u;
+  for (size_t i = 0u; i < 8u; ++i)
+    v |= uint64_t{static_cast<unsigned char>(s[i])} << (8u * i);
+  return v;
+}
+
+/// Returns if all 8 characters loaded by `load_eight_chars()` are decimal
+/// digits.
+__sus_pure_const _sus_always_inline constexpr bool is_eight_digits(
+    uint64_t v) noexcept {
+  return (((v + 0x4646464646464646u) | (v - 0x3030303030303030u)) &
+          0x8080808080808080u) == 0u;
+}
+
+/// Combines 8 decimal digits loaded by `load_eight_chars()` into their value,
+/// with the first character being the most significant digit.
+__sus_pure_const _sus_always_inline constexpr uint32_t parse_eight_digits(
+    uint64_t v) noexcept {
+  constexpr uint64_t kMask = 0x000000FF000000FFu;
+  constexpr uint64_t kMul1 = 0x000F424000000064u;  // 100 + (1000000 << 32)
+  constexpr uint64_t kMul2 = 0x0000271000000001u;  // 1 + (10000 << 32)
+  v -= 0x3030303030303030u;
+  // Each byte pair now holds the value of 2 digits in its low byte.
+  v = (v * 10u) + (v >> 8u);
+  // Combine the 4 pairs of digits.
+  v = (((v & kMask) * kMul1) + (((v >> 16u) & kMask) * kMul2)) >> 32u;
+  return static_cast<uint32_t>(v);
+}
+
+/// Returns the number of characters from the start of `s` that are decimal
+/// digits.
+_sus_pure constexpr size_t count_decimal_digits(const char* s,
+                                                 size_t len) noexcept {
+  size_t i = 0u;
+  while (len - i >= 8u && is_eight_digits(load_eight_chars(s + i))) i += 8u;
+  while (i < len && static_cast<unsigned char>(s[i] - '0') < 10u) i += 1u;
+  return i;
+}
+
+/// Returns the value of the decimal digits in `s`, which must all be decimal
+/// digits. There can be at most 19 digits so that the value can not overflow.
+_sus_pure constexpr uint64_t decimal_digits_value(const char* s,
+                                                   size_t len) noexcept {
+  uint64_t v = 0u;
+  size_t i = 0u;
+  for (; len - i >= 8u; i += 8u)
+    v = v * 100'000'000u + parse_eight_digits(load_eight_chars(s + i));
+  for (; i < len; i += 1u) v = v * 10u + static_cast<unsigned char>(s[i] - '0');
+  return v;
+}
+
+/// Returns the value of the digit `c` in any radix up to 36, or 36 if `c` is
+/// not a digit.
+__sus_pure_const _sus_always_inline constexpr uint32_t digit_value(
+    char c) noexcept {
+  const uint32_t u = static_cast<unsigned char>(c);
+  if (u - uint32_t{'0'} < 10u) return u - uint32_t{'0'};
+  // Lower-case ASCII letters.
+  const uint32_t l = u | 0x20u;
+  if (l - uint32_t{'a'} < 26u) return l - uint32_t{'a'} + 10u;
+  return 36u;
+}
+
+/// Parses the primitive integer `P` from the characters in `s` in the given
+/// `radix`.
+///
+/// The string may begin with a `+` sign, or a `-` sign if `P` is signed,
+/// followed by one or more digits and nothing else. As with Rust, the error
+/// reports whichever of an invalid character or an overflow is found first
+/// when reading the digits in order.
+template <class P>
+  requires(std::is_integral_v<P> && sizeof(P) <= 8u)
+_sus_pure constexpr ::sus::result::Result<P, ::sus::num::ParseIntError>
+parse_integer(const char* s, size_t len, uint32_t radix) noexcept {
+  using R = ::sus::result::Result<P, ::sus::num::ParseIntError>;
+  using E = ::sus::num::ParseIntError;
+  using U = std::make_unsigned_t<P>;
+
+  if (len == 0u) return R::with_err(E::with_empty());
+  bool negative = false;
+  size_t i = 0u;
+  if (s[0u] == '+') {
+    i = 1u;
+  } else if (std::is_signed_v<P> && s[0u] == '-') {
+    negative = true;
+    i = 1u;
+  }
+  if (i == len) return R::with_err(E::with_invalid_digit());
+
+  // The largest magnitude that can be parsed, which is one more for negative
+  // values of signed types.
+  const uint64_t limit =
+      static_cast<uint64_t>(std::numeric_limits<P>::max()) +
+      uint64_t{negative};
+  const auto overflow = [&]() {
+    return R::with_err(negative ? E::with_neg_overflow()
+                                : E::with_pos_overflow());
+  };
+
+  uint64_t v = 0u;
+  if (radix == 10u) {
+    // Leading zeros can't overflow, and are skipped so that the number of
+    // remaining digits bounds the value.
+    while (i < len && s[i] == '0') i += 1u;
+    const size_t digits = count_decimal_digits(s + i, len - i);
+    if (digits > 20u) return overflow();
+    if (digits == 20u) {
+      // Only a u64 may hold 20 digits.
+      v = decimal_digits_value(s + i, 19u);
+      const uint64_t last = static_cast<unsigned char>(s[i + 19u] - '0');
+      if (v > (std::numeric_limits<uint64_t>::max() - last) / 10u)
+        return overflow();
+      v = v * 10u + last;
+    } else {
+      v = decimal_digits_value(s + i, digits);
+    }
+    if (v > limit) return overflow();
+    i += digits;
+  } else {
+    const uint64_t cutoff = limit / radix;
+    const uint64_t cutlim = limit % radix;
+    for (; i < len; i += 1u) {
+      const uint32_t d = digit_value(s[i]);
+      if (d >= radix) break;
+      if (v > cutoff || (v == cutoff && d > cutlim)) return overflow();
+      v = v * radix + d;
+    }
+  }
+  // Every character must be a digit, and at least one of them must be
+  // present, which was checked above.
+  if (i != len) return R::with_err(E::with_invalid_digit());
+
+  const U u = static_cast<U>(v);
+  return R(static_cast<P>(negative ? static_cast<U>(U{0u} - u) : u));
+}
+
+}  // namespace sus::num::__private
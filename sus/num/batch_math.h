@@ -0,0 +1,269 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include "sus/assertions/check.h"
+#include "sus/collections/slice.h"
+#include "sus/construct/default.h"
+#include "sus/fn/fn_concepts.h"
+#include "sus/num/__private/batch_math_kernels.h"
+#include "sus/num/float.h"
+
+namespace sus::num {
+
+/// Math functions applied to whole slices of floating point numbers at once.
+///
+/// Each function reads every element of an input slice and writes the result
+/// to the same position in an output slice, which may be the same slice to
+/// operate in place. The functions use polynomial approximations that are
+/// written without branches, so the compiler can vectorize them, rather than
+/// calling the scalar methods such as [`f32::sin`]($sus::num::f32::sin) per
+/// element.
+///
+/// The results are not always correctly rounded, and may differ from the
+/// scalar methods in the last bits. The maximum error of each function is
+/// documented in units in the last place (ULP) of the result. All `f32`
+/// functions are evaluated in `f64` precision and are accurate to within 1
+/// ULP. Special values (NaN, infinities, signed zeros) give the same results
+/// as the scalar methods.
+namespace batch {}
+
+}  // namespace sus::num
+
+namespace sus::num::batch {
+
+/// The number of elements that [`map_simd`]($sus::num::batch::map_simd)
+/// processes together by default.
+inline constexpr size_t kMapSimdLanes = 16u;
+
+namespace __private {
+
+template <size_t LANES, class T, class U, class Kernel, class Fixup>
+constexpr void map_blocks(const T* src, U* dst, size_t len, Kernel& kernel,
+                          Fixup& fixup) noexcept {
+  // Results are produced into a local block before they are stored, so that
+  // `src` and `dst` may point to the same elements and the compiler does not
+  // need to check for aliasing in the inner loop.
+  U block[LANES];
+  size_t i = 0u;
+  for (; len - i >= LANES; i += LANES) {
+    for (size_t j = 0u; j < LANES; ++j) block[j] = kernel(src[i + j]);
+    for (size_t j = 0u; j < LANES; ++j) fixup(src[i + j], block[j]);
+    for (size_t j = 0u; j < LANES; ++j) dst[i + j] = block[j];
+  }
+  const size_t rem = len - i;
+  for (size_t j = 0u; j < rem; ++j) block[j] = kernel(src[i + j]);
+  for (size_t j = 0u; j < rem; ++j) fixup(src[i + j], block[j]);
+  for (size_t j = 0u; j < rem; ++j) dst[i + j] = block[j];
+}
+
+// Maps a kernel over primitive doubles for either float type.
+template <double (*K)(double), class T, class Fixup>
+inline void map_float(const Slice<T>& in, SliceMut<T> out,
+                      Fixup fixup) noexcept {
+  sus_check(in.len() == out.len());
+  auto kernel = [](const T& x) {
+    using P = decltype(x.primitive_value);
+    return T(static_cast<P>(K(static_cast<double>(x.primitive_value))));
+  };
+  map_blocks<kMapSimdLanes>(in.as_ptr(), out.as_mut_ptr(),
+                            in.len().primitive_value, kernel, fixup);
+}
+
+constexpr inline auto no_fixup = [](const auto&, auto&) {};
+
+// The vectorized sin and cos reduce arguments up to
+// `__private::batch::kTrigMax`. Larger (and non-finite) inputs are rare, and
+// are computed with the scalar method instead.
+constexpr inline auto trig_fixup(auto scalar) noexcept {
+  return [scalar](const auto& x, auto& y) {
+    const double a = static_cast<double>(x.primitive_value);
+    if (!(a <= ::sus::num::__private::batch::kTrigMax &&
+          a >= -::sus::num::__private::batch::kTrigMax)) [[unlikely]]
+      y = scalar(x);
+  };
+}
+
+}  // namespace __private
+
+/// Applies `kernel` to each element of `in` and writes the results to the
+/// same positions in `out`.
+///
+/// The elements are processed in fixed-size blocks of `LANES` elements, with
+/// the results stored through a local block. When `kernel` is a
+/// branch-free function of its input, this shape lets the compiler vectorize
+/// the whole block, so `map_simd` is the building block for the other
+/// functions in this namespace.
+///
+/// `in` and `out` may refer to the same elements, to map a slice in place.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// # Examples
+/// ```
+/// auto v = sus::Vec<f32>(1_f32, 2_f32, 3_f32);
+/// sus::num::batch::map_simd(v.as_slice(), v.as_mut_slice(),
+///                           [](const f32& x) { return x * x + 1_f32; });
+/// sus_check(v == sus::Vec<f32>(2_f32, 5_f32, 10_f32));
+/// ```
+template <size_t LANES = kMapSimdLanes, class T, class U>
+  requires(LANES > 0u && ::sus::construct::Default<U>)
+constexpr void map_simd(const Slice<T>& in, SliceMut<U> out,
+                        ::sus::fn::FnMut<U(const T&)> auto kernel) noexcept {
+  sus_check(in.len() == out.len());
+  auto fixup = __private::no_fixup;
+  __private::map_blocks<LANES>(in.as_ptr(), out.as_mut_ptr(),
+                               in.len().primitive_value, kernel, fixup);
+}
+
+/// Computes the sine (in radians) of each element of `in` into `out`.
+///
+/// The `f64` result is within 2 ULP for inputs of magnitude up to 2^20,
+/// and larger inputs are computed by [`f64::sin`]($sus::num::f64::sin).
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.sin]
+inline void sin(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::sin>(
+      in, out, __private::trig_fixup([](const f32& x) { return x.sin(); }));
+}
+/// #[doc.overloads=batch.sin]
+inline void sin(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::sin>(
+      in, out, __private::trig_fixup([](const f64& x) { return x.sin(); }));
+}
+
+/// Computes the cosine (in radians) of each element of `in` into `out`.
+///
+/// The `f64` result is within 2 ULP for inputs of magnitude up to 2^20,
+/// and larger inputs are computed by [`f64::cos`]($sus::num::f64::cos).
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.cos]
+inline void cos(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::cos>(
+      in, out, __private::trig_fixup([](const f32& x) { return x.cos(); }));
+}
+/// #[doc.overloads=batch.cos]
+inline void cos(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::cos>(
+      in, out, __private::trig_fixup([](const f64& x) { return x.cos(); }));
+}
+
+/// Computes `e^x` for each element `x` of `in` into `out`.
+///
+/// The `f64` result is within 1 ULP.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.exp]
+inline void exp(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::exp>(
+      in, out, __private::no_fixup);
+}
+/// #[doc.overloads=batch.exp]
+inline void exp(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::exp>(
+      in, out, __private::no_fixup);
+}
+
+/// Computes the natural logarithm of each element of `in` into `out`.
+///
+/// The `f64` result is within 1 ULP.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.ln]
+inline void ln(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::log>(
+      in, out, __private::no_fixup);
+}
+/// #[doc.overloads=batch.ln]
+inline void ln(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::log>(
+      in, out, __private::no_fixup);
+}
+
+/// Computes the hyperbolic tangent of each element of `in` into `out`.
+///
+/// The `f64` result is within 3 ULP.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.tanh]
+inline void tanh(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::tanh>(
+      in, out, __private::no_fixup);
+}
+/// #[doc.overloads=batch.tanh]
+inline void tanh(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::tanh>(
+      in, out, __private::no_fixup);
+}
+
+/// Computes the square root of each element of `in` into `out`.
+///
+/// The result is correctly rounded. Like [`f32::sqrt`]($sus::num::f32::sqrt),
+/// the result is NaN for negative numbers other than `-0.0`.
+///
+/// Compilers only vectorize the square root when they do not need to set
+/// `errno` for negative inputs, such as when building with `-fno-math-errno`.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.sqrt]
+inline void sqrt(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::sqrt>(
+      in, out, __private::no_fixup);
+}
+/// #[doc.overloads=batch.sqrt]
+inline void sqrt(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::sqrt>(
+      in, out, __private::no_fixup);
+}
+
+/// Computes the reciprocal of the square root, `1 / sqrt(x)`, of each element
+/// `x` of `in` into `out`.
+///
+/// The `f64` result is within 2 ULP. As with
+/// [`sqrt`]($sus::num::batch::sqrt), this is only vectorized when the compiler
+/// does not need to set `errno`.
+///
+/// # Panics
+/// Panics if `in` and `out` have different lengths.
+///
+/// #[doc.overloads=batch.rsqrt]
+inline void rsqrt(const Slice<f32>& in, SliceMut<f32> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::rsqrt>(
+      in, out, __private::no_fixup);
+}
+/// #[doc.overloads=batch.rsqrt]
+inline void rsqrt(const Slice<f64>& in, SliceMut<f64> out) noexcept {
+  __private::map_float<::sus::num::__private::batch::rsqrt>(
+      in, out, __private::no_fixup);
+}
+
+}  // namespace sus::num::batch
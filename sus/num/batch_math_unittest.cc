@@ -0,0 +1,256 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/num/batch_math.h"
+
+#include <bit>
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/collections/vec.h"
+#include "sus/prelude.h"
+#include "sus/test/ensure_use.h"
+
+using sus::collections::Slice;
+using sus::collections::SliceMut;
+using sus::test::ensure_use;
+
+namespace {
+
+// The distance in ULP between two floats of the same sign, measured against
+// the scalar methods which are themselves accurate to about half an ULP.
+u64 ulp_distance(f64 a, f64 b) {
+  if (a.is_nan() && b.is_nan()) return 0u;
+  const auto ia = std::bit_cast<int64_t>(a.primitive_value);
+  const auto ib = std::bit_cast<int64_t>(b.primitive_value);
+  return ia > ib ? u64(uint64_t(ia - ib)) : u64(uint64_t(ib - ia));
+}
+u64 ulp_distance(f32 a, f32 b) {
+  if (a.is_nan() && b.is_nan()) return 0u;
+  const auto ia = std::bit_cast<int32_t>(a.primitive_value);
+  const auto ib = std::bit_cast<int32_t>(b.primitive_value);
+  return ia > ib ? u64(uint64_t(ia - ib)) : u64(uint64_t(ib - ia));
+}
+
+// Fills a Vec with `n` values spread over [lo, hi], with a tail that does not
+// fill a whole block.
+template <class F>
+sus::Vec<F> spread(F lo, F hi, usize n) {
+  auto v = sus::Vec<F>::with_capacity(n);
+  for (usize i; i < n; i += 1u) {
+    v.push(lo + (hi - lo) * sus::cast<F>(i) / sus::cast<F>(n - 1u));
+  }
+  return v;
+}
+
+// Checks that `batch` is within `max_ulp` of (the correctly rounded result
+// approximated by) `scalar` for every input.
+template <class F>
+void check_ulp(const sus::Vec<F>& in, void (*batch)(const Slice<F>&,
+                                                     SliceMut<F>),
+               F (*scalar)(const F&), u64 max_ulp) {
+  auto out = sus::Vec<F>::with_capacity(in.len());
+  for (usize i; i < in.len(); i += 1u) out.push(F());
+  batch(in, out);
+  for (usize i; i < in.len(); i += 1u) {
+    EXPECT_LE(ulp_distance(out[i], scalar(in[i])), max_ulp)
+        << "input " << in[i].primitive_value << " gave "
+        << out[i].primitive_value << " expected "
+        << scalar(in[i]).primitive_value;
+  }
+}
+
+// The f32 kernels are compared against the f64 scalar methods rounded to f32,
+// as the f32 scalar methods are not always correctly rounded.
+f32 f32_ref(f32 x, f64 (f64::*method)() const&) {
+  return sus::cast<f32>((sus::cast<f64>(x).*method)());
+}
+
+template <class F>
+sus::Vec<F> run(void (*batch)(const Slice<F>&, SliceMut<F>),
+                sus::Vec<F> in) {
+  auto out = sus::Vec<F>::with_capacity(in.len());
+  for (usize i; i < in.len(); i += 1u) out.push(F());
+  batch(in, out);
+  return out;
+}
+
+TEST(BatchMath, MapSimd) {
+  // Full blocks and a tail.
+  auto v = sus::Vec<i32>();
+  for (i32 i; i < 37; i += 1) v.push(i);
+  auto out = sus::Vec<i64>();
+  for (usize i; i < v.len(); i += 1u) out.push(0);
+  sus::num::batch::map_simd(v.as_slice(), out.as_mut_slice(), [](const i32& x) {
+    return sus::cast<i64>(x) * 3_i64;
+  });
+  for (usize i; i < v.len(); i += 1u) EXPECT_EQ(out[i], i64::from(v[i]) * 3);
+
+  // In place, with a custom block size.
+  sus::num::batch::map_simd<4u>(v.as_slice(), v.as_mut_slice(),
+                                [](const i32& x) { return x + 1_i32; });
+  for (usize i; i < v.len(); i += 1u)
+    EXPECT_EQ(v[i], sus::cast<i32>(i) + 1_i32);
+
+  // Empty.
+  sus::num::batch::map_simd(Slice<f32>(), SliceMut<f32>(),
+                            [](const f32& x) { return x; });
+
+  // Constexpr.
+  static_assert([]() {
+    i32 a[] = {1, 2, 3, 4, 5};
+    auto s = SliceMut<i32>::from(a);
+    sus::num::batch::map_simd<2u>(s.as_slice(), s,
+                                  [](const i32& x) { return x * x; });
+    return a[0u] + a[4u];
+  }() == 26_i32);
+}
+
+TEST(BatchMathDeathTest, MapSimdLengthMismatch) {
+#if GTEST_HAS_DEATH_TEST
+  auto a = sus::Vec<f32>(1_f32, 2_f32);
+  auto b = sus::Vec<f32>(1_f32);
+  EXPECT_DEATH(sus::num::batch::map_simd(a.as_slice(), b.as_mut_slice(),
+                                         [](const f32& x) { return x; }),
+               "");
+  EXPECT_DEATH(sus::num::batch::sin(a, b), "");
+#endif
+}
+
+TEST(BatchMath, Sin) {
+  check_ulp<f64>(spread(-10_f64, 10_f64, 10'003u), sus::num::batch::sin,
+                 [](const f64& x) { return x.sin(); }, 2u);
+  check_ulp<f64>(spread(-1e6_f64, 1e6_f64, 10'003u), sus::num::batch::sin,
+                 [](const f64& x) { return x.sin(); }, 2u);
+  check_ulp<f32>(spread(-100_f32, 100_f32, 10'003u), sus::num::batch::sin,
+                 [](const f32& x) { return f32_ref(x, &f64::sin); }, 1u);
+  // Large and non-finite inputs use the scalar method.
+  auto out = run<f64>(sus::num::batch::sin,
+                      sus::Vec<f64>(1e22_f64, f64::INFINITY, f64::NAN, -0_f64));
+  EXPECT_EQ(out[0u], (1e22_f64).sin());
+  EXPECT_TRUE(out[1u].is_nan());
+  EXPECT_TRUE(out[2u].is_nan());
+  EXPECT_EQ(out[3u], 0_f64);
+  EXPECT_TRUE(out[3u].is_sign_negative());
+}
+
+TEST(BatchMath, Cos) {
+  check_ulp<f64>(spread(-10_f64, 10_f64, 10'003u), sus::num::batch::cos,
+                 [](const f64& x) { return x.cos(); }, 2u);
+  check_ulp<f64>(spread(-1e6_f64, 1e6_f64, 10'003u), sus::num::batch::cos,
+                 [](const f64& x) { return x.cos(); }, 2u);
+  check_ulp<f32>(spread(-100_f32, 100_f32, 10'003u), sus::num::batch::cos,
+                 [](const f32& x) { return f32_ref(x, &f64::cos); }, 1u);
+  auto out = run<f32>(sus::num::batch::cos,
+                      sus::Vec<f32>(1e30_f32, f32::NEG_INFINITY, 0_f32));
+  EXPECT_EQ(out[0u], (1e30_f32).cos());
+  EXPECT_TRUE(out[1u].is_nan());
+  EXPECT_EQ(out[2u], 1_f32);
+}
+
+TEST(BatchMath, Exp) {
+  check_ulp<f64>(spread(-745_f64, 709.7_f64, 10'003u), sus::num::batch::exp,
+                 [](const f64& x) { return x.exp(); }, 1u);
+  check_ulp<f64>(spread(-1_f64, 1_f64, 10'003u), sus::num::batch::exp,
+                 [](const f64& x) { return x.exp(); }, 1u);
+  check_ulp<f32>(spread(-103_f32, 88_f32, 10'003u), sus::num::batch::exp,
+                 [](const f32& x) { return f32_ref(x, &f64::exp); }, 1u);
+  auto out = run<f64>(sus::num::batch::exp,
+                      sus::Vec<f64>(f64::INFINITY, f64::NEG_INFINITY, f64::NAN,
+                                    710_f64, -746_f64, 0_f64));
+  EXPECT_EQ(out[0u], f64::INFINITY);
+  EXPECT_EQ(out[1u], 0_f64);
+  EXPECT_TRUE(out[2u].is_nan());
+  EXPECT_EQ(out[3u], f64::INFINITY);
+  EXPECT_EQ(out[4u], 0_f64);
+  EXPECT_EQ(out[5u], 1_f64);
+  auto out32 = run<f32>(sus::num::batch::exp, sus::Vec<f32>(89_f32, -104_f32));
+  EXPECT_EQ(out32[0u], f32::INFINITY);
+  EXPECT_EQ(out32[1u], 0_f32);
+}
+
+TEST(BatchMath, Ln) {
+  check_ulp<f64>(spread(0.5_f64, 2_f64, 10'003u), sus::num::batch::ln,
+                 [](const f64& x) { return x.ln(); }, 1u);
+  check_ulp<f64>(spread(1e-300_f64, 1e300_f64, 10'003u), sus::num::batch::ln,
+                 [](const f64& x) { return x.ln(); }, 1u);
+  check_ulp<f32>(spread(1e-3_f32, 1e3_f32, 10'003u), sus::num::batch::ln,
+                 [](const f32& x) { return f32_ref(x, &f64::ln); }, 1u);
+  auto out = run<f64>(
+      sus::num::batch::ln,
+      sus::Vec<f64>(0_f64, -1_f64, f64::INFINITY, f64::NAN, 1_f64,
+                    f64::MIN_POSITIVE / 1024_f64));
+  EXPECT_EQ(out[0u], f64::NEG_INFINITY);
+  EXPECT_TRUE(out[1u].is_nan());
+  EXPECT_EQ(out[2u], f64::INFINITY);
+  EXPECT_TRUE(out[3u].is_nan());
+  EXPECT_EQ(out[4u], 0_f64);
+  // Subnormal.
+  EXPECT_LE(ulp_distance(out[5u], (f64::MIN_POSITIVE / 1024_f64).ln()), 1u);
+}
+
+TEST(BatchMath, Tanh) {
+  check_ulp<f64>(spread(-25_f64, 25_f64, 10'003u), sus::num::batch::tanh,
+                 [](const f64& x) { return x.tanh(); }, 3u);
+  check_ulp<f64>(spread(-0.5_f64, 0.5_f64, 10'003u), sus::num::batch::tanh,
+                 [](const f64& x) { return x.tanh(); }, 3u);
+  check_ulp<f32>(spread(-10_f32, 10_f32, 10'003u), sus::num::batch::tanh,
+                 [](const f32& x) { return f32_ref(x, &f64::tanh); }, 1u);
+  auto out = run<f64>(sus::num::batch::tanh,
+                      sus::Vec<f64>(f64::INFINITY, f64::NEG_INFINITY, f64::NAN,
+                                    -0_f64, 1e-300_f64));
+  EXPECT_EQ(out[0u], 1_f64);
+  EXPECT_EQ(out[1u], -1_f64);
+  EXPECT_TRUE(out[2u].is_nan());
+  EXPECT_TRUE(out[3u].is_sign_negative());
+  EXPECT_EQ(out[4u], 1e-300_f64);
+}
+
+TEST(BatchMath, Sqrt) {
+  check_ulp<f64>(spread(0_f64, 1e6_f64, 10'003u), sus::num::batch::sqrt,
+                 [](const f64& x) { return x.sqrt(); }, 0u);
+  check_ulp<f32>(spread(0_f32, 1e6_f32, 10'003u), sus::num::batch::sqrt,
+                 [](const f32& x) { return f32_ref(x, &f64::sqrt); }, 0u);
+  auto out = run<f32>(sus::num::batch::sqrt,
+                      sus::Vec<f32>(-1_f32, -0_f32, f32::INFINITY, f32::NAN));
+  EXPECT_TRUE(out[0u].is_nan());
+  EXPECT_TRUE(out[1u].is_sign_negative());
+  EXPECT_EQ(out[2u], f32::INFINITY);
+  EXPECT_TRUE(out[3u].is_nan());
+}
+
+TEST(BatchMath, Rsqrt) {
+  check_ulp<f64>(spread(1e-6_f64, 1e6_f64, 10'003u), sus::num::batch::rsqrt,
+                 [](const f64& x) { return 1_f64 / x.sqrt(); }, 2u);
+  check_ulp<f32>(spread(1e-6_f32, 1e6_f32, 10'003u), sus::num::batch::rsqrt,
+                 [](const f32& x) {
+                   return sus::cast<f32>(1_f64 / sus::cast<f64>(x).sqrt());
+                 },
+                 1u);
+  auto out = run<f64>(sus::num::batch::rsqrt,
+                      sus::Vec<f64>(0_f64, f64::INFINITY, -1_f64));
+  EXPECT_EQ(out[0u], f64::INFINITY);
+  EXPECT_EQ(out[1u], 0_f64);
+  EXPECT_TRUE(out[2u].is_nan());
+}
+
+TEST(BatchMath, InPlace) {
+  auto v = spread(-3_f64, 3_f64, 101u);
+  auto expected = v.clone();
+  for (f64& x : expected.iter_mut()) x = x.exp();
+  sus::num::batch::exp(v, v);
+  for (usize i; i < v.len(); i += 1u)
+    EXPECT_LE(ulp_distance(v[i], expected[i]), 1u);
+}
+
+}  // namespace
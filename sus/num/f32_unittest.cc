@@ -1220,6 +1220,44 @@ TEST(f32, FromNeBytes) {
   }
 }
 
+TEST(f32, FromStr) {
+  using Kind = sus::num::ParseFloatError::Kind;
+  EXPECT_EQ(f32::from_str("1.5").unwrap(), 1.5_f32);
+  EXPECT_EQ(f32::from_str("-0.1").unwrap(), -0.1_f32);
+  EXPECT_EQ(f32::from_str("3.4028235e38").unwrap(), f32::MAX);
+  EXPECT_EQ(f32::from_str("3.5e38").unwrap(), f32::INFINITY);
+  EXPECT_EQ(f32::from_str("1e-46").unwrap(), 0_f32);
+  EXPECT_EQ(f32::from_str("1.4e-45").unwrap(), f32::from_bits(1_u32));
+  EXPECT_EQ(f32::from_str("16777217").unwrap(), 16777216_f32);
+  EXPECT_EQ(f32::from_str("1e").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f32::from_str("").unwrap_err().kind(), Kind::Empty);
+
+  char buf[64u];
+  uint32_t state = 0x12345678u;
+  for (int i = 0; i < 20000; ++i) {
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+    const f32 f = f32::from_bits(u32(state));
+    if (!f.is_finite()) continue;
+    const int n = snprintf(buf, sizeof(buf), "%.9g",
+                           static_cast<double>(f.primitive_value));
+    const std::string_view s(buf, static_cast<size_t>(n));
+    EXPECT_EQ(f32::from_str(s).unwrap().to_bits(),
+              f32(strtof(buf, nullptr)).to_bits())
+        << s;
+  }
+}
+
+TEST(f32, ToChars) {
+  char buf[15u];
+  auto s = sus::SliceMut<char>::from(buf);
+  EXPECT_EQ((0.1_f32).to_chars(s), sus::some(3u));
+  EXPECT_EQ(std::string_view(buf, 3u), "0.1");
+  EXPECT_EQ((-1.1754944e-38_f32).to_chars(s), sus::some(14u));
+  EXPECT_EQ(std::string_view(buf, 14u), "-1.1754944e-38");
+}
+
 TEST(f32, fmt) {
   static_assert(fmt::is_formattable<f32, char>::value);
   EXPECT_EQ(fmt::format("{}", -123.456_f32), "-123.456");
@@ -1210,6 +1210,108 @@ TEST(f64, FromNeBytes) {
   }
 }
 
+TEST(f64, FromStr) {
+  using Kind = sus::num::ParseFloatError::Kind;
+  EXPECT_EQ(f64::from_str("0").unwrap(), 0_f64);
+  EXPECT_TRUE(f64::from_str("-0").unwrap().is_sign_negative());
+  EXPECT_EQ(f64::from_str("1").unwrap(), 1_f64);
+  EXPECT_EQ(f64::from_str("+1.5").unwrap(), 1.5_f64);
+  EXPECT_EQ(f64::from_str("-12.5e-1").unwrap(), -1.25_f64);
+  EXPECT_EQ(f64::from_str(".5").unwrap(), 0.5_f64);
+  EXPECT_EQ(f64::from_str("5.").unwrap(), 5_f64);
+  EXPECT_EQ(f64::from_str("1E3").unwrap(), 1000_f64);
+  EXPECT_EQ(f64::from_str("1e+3").unwrap(), 1000_f64);
+  EXPECT_EQ(f64::from_str("0.1").unwrap(), 0.1_f64);
+  EXPECT_EQ(f64::from_str("3.141592653589793").unwrap(),
+            3.141592653589793_f64);
+  EXPECT_EQ(f64::from_str("1.7976931348623157e308").unwrap(), f64::MAX);
+  EXPECT_EQ(f64::from_str("2.2250738585072014e-308").unwrap(),
+            f64::MIN_POSITIVE);
+  EXPECT_EQ(f64::from_str("5e-324").unwrap(),
+            f64::from_bits(1_u64));
+  EXPECT_EQ(f64::from_str("2e-324").unwrap(), 0_f64);
+  EXPECT_EQ(f64::from_str("1e309").unwrap(), f64::INFINITY);
+  EXPECT_EQ(f64::from_str("-1e999999999999").unwrap(), f64::NEG_INFINITY);
+  EXPECT_EQ(f64::from_str("0e999999999999").unwrap(), 0_f64);
+  EXPECT_EQ(f64::from_str("inf").unwrap(), f64::INFINITY);
+  EXPECT_EQ(f64::from_str("-Infinity").unwrap(), f64::NEG_INFINITY);
+  EXPECT_TRUE(f64::from_str("NaN").unwrap().is_nan());
+  // Many digits, which are truncated to their first 19 significant digits.
+  EXPECT_EQ(f64::from_str("0.1000000000000000000000000000001").unwrap(),
+            0.1_f64);
+  EXPECT_EQ(f64::from_str("123456789012345678901234567890").unwrap(),
+            1.2345678901234568e29_f64);
+  // Exactly halfway between 2^53 and 2^53 + 2, which needs more than 19
+  // digits to round.
+  EXPECT_EQ(f64::from_str("9007199254740993.0000000000000000001").unwrap(),
+            9007199254740994_f64);
+  EXPECT_EQ(f64::from_str("9007199254740993.0000000000000000000").unwrap(),
+            9007199254740992_f64);
+
+  EXPECT_EQ(f64::from_str("").unwrap_err().kind(), Kind::Empty);
+  EXPECT_EQ(f64::from_str("-").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str(".").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("e5").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("1e").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("1e+").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("1.5x").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str(" 1").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("1..0").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("infinit").unwrap_err().kind(), Kind::Invalid);
+  EXPECT_EQ(f64::from_str("0x10").unwrap_err().kind(), Kind::Invalid);
+
+  char chars[] = {'2', '.', '5'};
+  EXPECT_EQ(f64::from_str(sus::Slice<char>::from(chars)).unwrap(), 2.5_f64);
+}
+
+TEST(f64, FromStrMatchesStrtod) {
+  // Random bit patterns and decimal strings give the same results as the
+  // standard library.
+  uint64_t state = 0x853c49e6748fea9bu;
+  const auto next = [&state]() {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return state;
+  };
+  char buf[64u];
+  for (int i = 0; i < 20000; ++i) {
+    const f64 f = f64::from_bits(u64(next()));
+    if (!f.is_finite()) continue;
+    for (int precision : {17, 12, 25}) {
+      const int n = snprintf(buf, sizeof(buf), "%.*g", precision,
+                             f.primitive_value);
+      const std::string_view s(buf, static_cast<size_t>(n));
+      EXPECT_EQ(f64::from_str(s).unwrap().to_bits(),
+                f64(strtod(buf, nullptr)).to_bits())
+          << s;
+    }
+  }
+}
+
+TEST(f64, ToChars) {
+  char buf[24u];
+  auto s = sus::SliceMut<char>::from(buf);
+  EXPECT_EQ((0.1_f64).to_chars(s), sus::some(3u));
+  EXPECT_EQ(std::string_view(buf, 3u), "0.1");
+  EXPECT_EQ((-2.5_f64).to_chars(s), sus::some(4u));
+  EXPECT_EQ(std::string_view(buf, 4u), "-2.5");
+  EXPECT_EQ(f64::INFINITY.to_chars(s), sus::some(3u));
+  EXPECT_EQ(std::string_view(buf, 3u), "inf");
+  EXPECT_EQ((-2.2250738585072014e-308_f64).to_chars(s), sus::some(24u));
+  EXPECT_EQ(std::string_view(buf, 24u), "-2.2250738585072014e-308");
+
+  char small[2u] = {'x', 'x'};
+  EXPECT_EQ((0.1_f64).to_chars(sus::SliceMut<char>::from(small)), sus::None);
+  EXPECT_EQ(std::string_view(small, 2u), "xx");
+
+  // The output parses back to the same value.
+  for (f64 f : {1_f64 / 3_f64, f64::MAX, f64::MIN_POSITIVE, -1e-300_f64}) {
+    const usize n = f.to_chars(s).unwrap();
+    EXPECT_EQ(f64::from_str(std::string_view(buf, n)).unwrap(), f);
+  }
+}
+
 TEST(f64, fmt) {
   static_assert(fmt::is_formattable<f64, char>::value);
   EXPECT_EQ(fmt::format("{}", -123789.456_f64), "-123789.456");
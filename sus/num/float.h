@@ -18,6 +18,7 @@
 
 #include <concepts>
 #include <functional>  // TODO: remove this but we need to hash things > size_t.
+#include <string_view>
 
 #include "fmt/format.h"
 #include "sus/iter/iterator_concept.h"
@@ -34,6 +35,7 @@
 #include "sus/num/cmath_macros.h"
 #include "sus/num/float_concepts.h"
 #include "sus/num/fp_category.h"
+#include "sus/num/parse_float_error.h"
 #include "sus/num/signed_integer.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/string/__private/format_to_stream.h"
@@ -17,7 +17,10 @@
 #pragma once
 
 #include "sus/collections/array.h"
+#include "sus/num/__private/parse_float.h"
 #include "sus/num/float.h"
+#include "sus/num/parse_float_error_impl.h"
+#include "sus/ptr/copy.h"
 
 #define _self f32
 #define _primitive float
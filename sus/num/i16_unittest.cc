@@ -713,6 +713,9 @@ TEST(i16, InvokeEverything) {
   (void)i.from_be_bytes(a);
   (void)i.from_le_bytes(a);
   (void)i.from_ne_bytes(a);
+  (void)i.from_str_radix("1", 10u);
+  char chars[24u];
+  (void)i.to_chars(sus::SliceMut<char>::from(chars));
 
   i = -j;
   i = ~j;
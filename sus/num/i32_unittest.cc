@@ -2948,6 +2948,60 @@ TEST(i32DeathTest, WrappingRemEuclidOverflow) {
 #endif
 }
 
+TEST(i32, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(i32::from_str_radix("0", 10u).unwrap(), 0);
+  EXPECT_EQ(i32::from_str_radix("-0", 10u).unwrap(), 0);
+  EXPECT_EQ(i32::from_str_radix("+12", 10u).unwrap(), 12);
+  EXPECT_EQ(i32::from_str_radix("-12", 10u).unwrap(), -12);
+  EXPECT_EQ(i32::from_str_radix("2147483647", 10u).unwrap(), i32::MAX);
+  EXPECT_EQ(i32::from_str_radix("-2147483648", 10u).unwrap(), i32::MIN);
+  EXPECT_EQ(i32::from_str_radix("-80000000", 16u).unwrap(), i32::MIN);
+  EXPECT_EQ(i32::from_str_radix("-zz", 36u).unwrap(), -(36 * 36 - 1));
+
+  EXPECT_EQ(i32::from_str_radix("", 10u).unwrap_err().kind(), Kind::Empty);
+  EXPECT_EQ(i32::from_str_radix("-", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(i32::from_str_radix("--1", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(i32::from_str_radix("1-", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(i32::from_str_radix("2147483648", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(i32::from_str_radix("-2147483649", 10u).unwrap_err().kind(),
+            Kind::NegOverflow);
+  EXPECT_EQ(i32::from_str_radix("80000000", 16u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(i32::from_str_radix("-80000001", 16u).unwrap_err().kind(),
+            Kind::NegOverflow);
+  EXPECT_EQ(
+      i32::from_str_radix("-999999999999999999999", 10u).unwrap_err().kind(),
+      Kind::NegOverflow);
+
+  constexpr auto c = i32::from_str_radix("-42", 10u);
+  static_assert(c.as_value() == -42);
+}
+
+TEST(i32, ToChars) {
+  char buf[11u];
+  auto s = sus::SliceMut<char>::from(buf);
+  EXPECT_EQ((0_i32).to_chars(s), sus::some(1u));
+  EXPECT_EQ(std::string_view(buf, 1u), "0");
+  EXPECT_EQ((-7_i32).to_chars(s), sus::some(2u));
+  EXPECT_EQ(std::string_view(buf, 2u), "-7");
+  EXPECT_EQ((-120_i32).to_chars(s), sus::some(4u));
+  EXPECT_EQ(std::string_view(buf, 4u), "-120");
+  EXPECT_EQ(i32::MAX.to_chars(s), sus::some(10u));
+  EXPECT_EQ(std::string_view(buf, 10u), "2147483647");
+  EXPECT_EQ(i32::MIN.to_chars(s), sus::some(11u));
+  EXPECT_EQ(std::string_view(buf, 11u), "-2147483648");
+
+  char small[2u];
+  EXPECT_EQ((-10_i32).to_chars(sus::SliceMut<char>::from(small)), sus::None);
+  EXPECT_EQ((-1_i32).to_chars(sus::SliceMut<char>::from(small)),
+            sus::some(2u));
+}
+
 TEST(i32, fmt) {
   static_assert(fmt::is_formattable<i32, char>::value);
   EXPECT_EQ(fmt::format("{}", -654321_i32), "-654321");
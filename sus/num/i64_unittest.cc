@@ -726,6 +726,9 @@ TEST(i64, InvokeEverything) {
   (void)i.from_be_bytes(a);
   (void)i.from_le_bytes(a);
   (void)i.from_ne_bytes(a);
+  (void)i.from_str_radix("1", 10u);
+  char chars[24u];
+  (void)i.to_chars(sus::SliceMut<char>::from(chars));
 
   i = -j;
   i = ~j;
@@ -756,6 +759,29 @@ TEST(i64, InvokeEverything) {
   [[maybe_unused]] auto z = i >= j;
 }
 
+TEST(i64, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(i64::from_str_radix("9223372036854775807", 10u).unwrap(),
+            i64::MAX);
+  EXPECT_EQ(i64::from_str_radix("-9223372036854775808", 10u).unwrap(),
+            i64::MIN);
+  EXPECT_EQ(i64::from_str_radix("9223372036854775808", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(
+      i64::from_str_radix("-9223372036854775809", 10u).unwrap_err().kind(),
+      Kind::NegOverflow);
+  EXPECT_EQ(
+      i64::from_str_radix("-18446744073709551616", 10u).unwrap_err().kind(),
+      Kind::NegOverflow);
+}
+
+TEST(i64, ToChars) {
+  char buf[20u];
+  EXPECT_EQ(i64::MIN.to_chars(sus::SliceMut<char>::from(buf)),
+            sus::some(20u));
+  EXPECT_EQ(std::string_view(buf, 20u), "-9223372036854775808");
+}
+
 TEST(i64, fmt) {
   static_assert(fmt::is_formattable<i64, char>::value);
   EXPECT_EQ(fmt::format("{}", -87654321_i64), "-87654321");
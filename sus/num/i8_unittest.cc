@@ -705,6 +705,9 @@ TEST(i8, InvokeEverything) {
   (void)i.from_be_bytes(a);
   (void)i.from_le_bytes(a);
   (void)i.from_ne_bytes(a);
+  (void)i.from_str_radix("1", 10u);
+  char chars[24u];
+  (void)i.to_chars(sus::SliceMut<char>::from(chars));
 
   i = -j;
   i = ~j;
@@ -735,6 +738,16 @@ TEST(i8, InvokeEverything) {
   [[maybe_unused]] auto z = i >= j;
 }
 
+TEST(i8, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(i8::from_str_radix("-128", 10u).unwrap(), i8::MIN);
+  EXPECT_EQ(i8::from_str_radix("127", 10u).unwrap(), i8::MAX);
+  EXPECT_EQ(i8::from_str_radix("128", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(i8::from_str_radix("-129", 10u).unwrap_err().kind(),
+            Kind::NegOverflow);
+}
+
 TEST(i8, fmt) {
   static_assert(fmt::is_formattable<i8, char>::value);
   EXPECT_EQ(fmt::format("{}", -21_i8), "-21");
@@ -126,6 +126,46 @@ class OverflowInteger {
     return p;
   }
 
+  /// Constructs an `OverflowInteger` from an `Iterator` by computing the
+  /// sum of all elements in the iterator.
+  ///
+  /// This method should rarely be called directly, as it is used to satisfy the
+  /// `sus::iter::Sum` concept.
+  ///
+  /// This method satisfies `sus::iter::Sum<OverflowInteger<T>, T>` as well
+  /// as `sus::iter::Sum<OverflowInteger<T>, OverflowInteger<T>>`, for a
+  /// subspace integer type `T`.
+  ///
+  /// If an iterator yields a subspace integer type, `iter.sum()` would
+  /// panic on overflow. So instead `iter.sum<OverflowInteger<T>>()` can be
+  /// used (for integer type `T`) which will perform the sum computation and
+  /// return an `OverflowInteger` without ever panicking.
+  static constexpr OverflowInteger from_sum(
+      ::sus::iter::Iterator<I> auto&& it) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(it)>)
+  {
+    // SAFETY: This is not lossy, as all integers can hold 0.
+    auto p = OverflowInteger(::sus::cast<I>(0));
+    for (I i : ::sus::move(it)) p += i;
+    return p;
+  }
+
+  static constexpr OverflowInteger from_sum(
+      ::sus::iter::Iterator<OverflowInteger> auto&& it) noexcept
+    requires(::sus::mem::IsMoveRef<decltype(it)>)
+  {
+    // SAFETY: This is not lossy, as all integers can hold 0.
+    auto p = OverflowInteger(::sus::cast<I>(0));
+    for (OverflowInteger i : ::sus::move(it)) p += i;
+    return p;
+  }
+
+  /// Constructs an `OverflowInteger` from an `Option`, where `None` represents
+  /// the overflow state. This is the inverse of `to_option()`.
+  _sus_pure static constexpr OverflowInteger from_option(Option<I> o) noexcept {
+    return OverflowInteger(FROM_OPTION, ::sus::move(o));
+  }
+
   _sus_pure bool is_valid() const noexcept { return v_.is_some(); }
   _sus_pure bool is_overflow() const noexcept { return v_.is_none(); }
 
@@ -109,6 +109,42 @@ TEST(OverflowInteger, Example_Iterator) {
   sus_check(maybe_answer.is_overflow());  // Overflow happened.
 }
 
+TEST(OverflowInteger, FromSum) {
+  static_assert(::sus::iter::Sum<OverflowInteger<i32>, i32>);
+  static_assert(::sus::iter::Sum<OverflowInteger<i32>>);
+
+  // To OverflowInteger with overflow.
+  {
+    auto a = sus::Array<i32, 2>(1, i32::MAX);
+    decltype(auto) o =
+        sus::move(a).into_iter().sum<sus::num::OverflowInteger<i32>>();
+    static_assert(std::same_as<decltype(o), sus::num::OverflowInteger<i32>>);
+    EXPECT_EQ(o.to_option(), sus::None);
+  }
+  // To OverflowInteger without overflow.
+  {
+    auto a = sus::Array<i32, 2>(2, 4);
+    decltype(auto) o =
+        sus::move(a).into_iter().sum<sus::num::OverflowInteger<i32>>();
+    static_assert(std::same_as<decltype(o), sus::num::OverflowInteger<i32>>);
+    EXPECT_EQ(o.to_option().unwrap(), 2 + 4);
+  }
+  // Iterating OverflowInteger types with overflow.
+  {
+    auto a = sus::Array<OverflowInteger<i32>, 2>(
+        OverflowInteger<i32>(1), OverflowInteger<i32>(i32::MAX));
+    decltype(auto) o = sus::move(a).into_iter().sum();
+    static_assert(std::same_as<decltype(o), sus::num::OverflowInteger<i32>>);
+    EXPECT_EQ(o.to_option(), sus::None);
+  }
+}
+
+TEST(OverflowInteger, FromOption) {
+  EXPECT_EQ(OverflowInteger<i32>::from_option(sus::some(3_i32)).to_option(),
+            sus::some(3_i32));
+  EXPECT_EQ(OverflowInteger<i32>::from_option(sus::Option<i32>()).is_overflow(), true);
+}
+
 TEST(OverflowInteger, FromProduct) {
   static_assert(::sus::iter::Product<OverflowInteger<i32>, i32>);
   static_assert(::sus::iter::Product<OverflowInteger<i32>>);
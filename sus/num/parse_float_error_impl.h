@@ -0,0 +1,67 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/num/types.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <string>
+
+#include "sus/assertions/unreachable.h"
+#include "sus/error/error.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/num/parse_float_error.h"
+
+namespace sus::num {
+
+constexpr ParseFloatError ParseFloatError::with_empty() noexcept {
+  return ParseFloatError(CONSTRUCT, Kind::Empty);
+}
+
+constexpr ParseFloatError ParseFloatError::with_invalid() noexcept {
+  return ParseFloatError(CONSTRUCT, Kind::Invalid);
+}
+
+_sus_pure constexpr ParseFloatError::Kind ParseFloatError::kind()
+    const noexcept {
+  return kind_;
+}
+
+_sus_pure constexpr bool ParseFloatError::operator==(
+    ParseFloatError rhs) const noexcept {
+  return kind_ == rhs.kind_;
+}
+
+constexpr ParseFloatError::ParseFloatError(Construct, Kind k) noexcept
+    : kind_(k) {}
+
+}  // namespace sus::num
+
+// sus::error::Error implementation.
+template <>
+struct sus::error::ErrorImpl<sus::num::ParseFloatError> {
+  constexpr static std::string display(
+      const sus::num::ParseFloatError& e) noexcept {
+    switch (e.kind()) {
+      case sus::num::ParseFloatError::Kind::Empty:
+        return "cannot parse float from empty string";
+      case sus::num::ParseFloatError::Kind::Invalid:
+        return "invalid float literal";
+    }
+    sus_unreachable_unchecked(::sus::marker::unsafe_fn);
+  }
+};
+
+static_assert(sus::error::Error<sus::num::ParseFloatError>);
@@ -0,0 +1,78 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// IWYU pragma: private, include "sus/num/types.h"
+// IWYU pragma: friend "sus/.*"
+#pragma once
+
+#include <string>
+
+#include "sus/assertions/unreachable.h"
+#include "sus/error/error.h"
+#include "sus/macros/pure.h"
+#include "sus/marker/unsafe.h"
+#include "sus/num/parse_int_error.h"
+
+namespace sus::num {
+
+constexpr ParseIntError ParseIntError::with_empty() noexcept {
+  return ParseIntError(CONSTRUCT, Kind::Empty);
+}
+
+constexpr ParseIntError ParseIntError::with_invalid_digit() noexcept {
+  return ParseIntError(CONSTRUCT, Kind::InvalidDigit);
+}
+
+constexpr ParseIntError ParseIntError::with_pos_overflow() noexcept {
+  return ParseIntError(CONSTRUCT, Kind::PosOverflow);
+}
+
+constexpr ParseIntError ParseIntError::with_neg_overflow() noexcept {
+  return ParseIntError(CONSTRUCT, Kind::NegOverflow);
+}
+
+_sus_pure constexpr ParseIntError::Kind ParseIntError::kind() const noexcept {
+  return kind_;
+}
+
+_sus_pure constexpr bool ParseIntError::operator==(
+    ParseIntError rhs) const noexcept {
+  return kind_ == rhs.kind_;
+}
+
+constexpr ParseIntError::ParseIntError(Construct, Kind k) noexcept
+    : kind_(k) {}
+
+}  // namespace sus::num
+
+// sus::error::Error implementation.
+template <>
+struct sus::error::ErrorImpl<sus::num::ParseIntError> {
+  constexpr static std::string display(
+      const sus::num::ParseIntError& e) noexcept {
+    switch (e.kind()) {
+      case sus::num::ParseIntError::Kind::Empty:
+        return "cannot parse integer from empty string";
+      case sus::num::ParseIntError::Kind::InvalidDigit:
+        return "invalid digit found in string";
+      case sus::num::ParseIntError::Kind::PosOverflow:
+        return "number too large to fit in target type";
+      case sus::num::ParseIntError::Kind::NegOverflow:
+        return "number too small to fit in target type";
+    }
+    sus_unreachable_unchecked(::sus::marker::unsafe_fn);
+  }
+};
+
+static_assert(sus::error::Error<sus::num::ParseIntError>);
@@ -21,6 +21,7 @@
 
 #include <compare>
 #include <functional>  // TODO: remove this but we need to hash things > size_t.
+#include <string_view>
 
 #include "fmt/format.h"
 #include "sus/assertions/check.h"
@@ -36,6 +37,7 @@
 #include "sus/num/__private/literals.h"
 #include "sus/num/__private/primitive_type.h"
 #include "sus/num/integer_concepts.h"
+#include "sus/num/parse_int_error.h"
 #include "sus/num/try_from_int_error.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/option/option.h"
@@ -17,6 +17,9 @@
 #pragma once
 
 #include "sus/collections/array.h"
+#include "sus/num/__private/integer_to_chars.h"
+#include "sus/num/__private/parse_integer.h"
+#include "sus/num/parse_int_error_impl.h"
 #include "sus/num/signed_integer.h"
 #include "sus/ptr/copy.h"
 
@@ -110,6 +110,8 @@ namespace num {}
 #include "sus/num/cast.h"
 #include "sus/num/float.h"
 #include "sus/num/float_impl.h"
+#include "sus/num/parse_float_error_impl.h"
+#include "sus/num/parse_int_error_impl.h"
 #include "sus/num/signed_integer.h"
 #include "sus/num/signed_integer_impl.h"
 #include "sus/num/try_from_int_error_impl.h"
@@ -2141,6 +2141,103 @@ TEST(u32DeathTest, WrappingRemEuclidOverflow) {
 #endif
 }
 
+TEST(u32, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(u32::from_str_radix("0", 10u).unwrap(), 0u);
+  EXPECT_EQ(u32::from_str_radix("+7", 10u).unwrap(), 7u);
+  EXPECT_EQ(u32::from_str_radix("123456789", 10u).unwrap(), 123456789u);
+  EXPECT_EQ(u32::from_str_radix("4294967295", 10u).unwrap(), u32::MAX);
+  EXPECT_EQ(u32::from_str_radix("00000000000000000000042", 10u).unwrap(),
+            42u);
+  EXPECT_EQ(u32::from_str_radix("ffffffff", 16u).unwrap(), u32::MAX);
+  EXPECT_EQ(u32::from_str_radix("DeadBeef", 16u).unwrap(), 0xdeadbeef_u32);
+  EXPECT_EQ(u32::from_str_radix("1010", 2u).unwrap(), 10u);
+  EXPECT_EQ(u32::from_str_radix("zz", 36u).unwrap(), 36u * 36u - 1u);
+
+  EXPECT_EQ(u32::from_str_radix("", 10u).unwrap_err().kind(), Kind::Empty);
+  EXPECT_EQ(u32::from_str_radix("+", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix("-1", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix(" 1", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix("12345678a", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix("2", 2u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix("4294967296", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u32::from_str_radix("100000000", 16u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u32::from_str_radix("99999999999999999999999", 10u)
+                .unwrap_err()
+                .kind(),
+            Kind::PosOverflow);
+  // The first error in the string is reported.
+  EXPECT_EQ(u32::from_str_radix("99999999999x", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u32::from_str_radix("9x999999999", 10u).unwrap_err().kind(),
+            Kind::InvalidDigit);
+  EXPECT_EQ(u32::from_str_radix("fffffffffx", 16u).unwrap_err().kind(),
+            Kind::PosOverflow);
+
+  char chars[] = {'1', '2', '3'};
+  EXPECT_EQ(u32::from_str_radix(sus::Slice<char>::from(chars), 10u).unwrap(),
+            123u);
+  EXPECT_EQ(u32::from_str_radix(sus::Slice<char>(), 10u).unwrap_err().kind(),
+            Kind::Empty);
+
+  constexpr auto c = u32::from_str_radix("42", 10u);
+  static_assert(c.as_value() == 42u);
+}
+
+TEST(u32DeathTest, FromStrRadixInvalidRadix) {
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto r = u32::from_str_radix("1", 1u);
+        ensure_use(&r);
+      },
+      "");
+  EXPECT_DEATH(
+      {
+        auto r = u32::from_str_radix("1", 37u);
+        ensure_use(&r);
+      },
+      "");
+#endif
+}
+
+TEST(u32, ToChars) {
+  char buf[10u];
+  auto s = sus::SliceMut<char>::from(buf);
+  EXPECT_EQ((0_u32).to_chars(s), sus::some(1u));
+  EXPECT_EQ(std::string_view(buf, 1u), "0");
+  EXPECT_EQ((7_u32).to_chars(s), sus::some(1u));
+  EXPECT_EQ(std::string_view(buf, 1u), "7");
+  EXPECT_EQ((10_u32).to_chars(s), sus::some(2u));
+  EXPECT_EQ(std::string_view(buf, 2u), "10");
+  EXPECT_EQ((12345_u32).to_chars(s), sus::some(5u));
+  EXPECT_EQ(std::string_view(buf, 5u), "12345");
+  EXPECT_EQ(u32::MAX.to_chars(s), sus::some(10u));
+  EXPECT_EQ(std::string_view(buf, 10u), "4294967295");
+
+  // Nothing is written if the output doesn't fit.
+  char small[3u] = {'x', 'x', 'x'};
+  EXPECT_EQ((1234_u32).to_chars(sus::SliceMut<char>::from(small)),
+            sus::None);
+  EXPECT_EQ(std::string_view(small, 3u), "xxx");
+  EXPECT_EQ((123_u32).to_chars(sus::SliceMut<char>::from(small)),
+            sus::some(3u));
+  EXPECT_EQ(std::string_view(small, 3u), "123");
+
+  // Round trip through parsing.
+  for (u32 i = 1u; i < u32::MAX / 7u; i *= 7u) {
+    const usize n = i.to_chars(s).unwrap();
+    EXPECT_EQ(u32::from_str_radix(std::string_view(buf, n), 10u).unwrap(), i);
+  }
+}
+
 TEST(u32, fmt) {
   static_assert(fmt::is_formattable<u32, char>::value);
   EXPECT_EQ(fmt::format("{}", 1234567_u32), "1234567");
@@ -726,6 +726,9 @@ TEST(u64, InvokeEverything) {
   (void)i.from_be_bytes(a);
   (void)i.from_le_bytes(a);
   (void)i.from_ne_bytes(a);
+  (void)i.from_str_radix("1", 10u);
+  char chars[24u];
+  (void)i.to_chars(sus::SliceMut<char>::from(chars));
 
   i = ~j;
 
@@ -755,6 +758,28 @@ TEST(u64, InvokeEverything) {
   [[maybe_unused]] auto z = i >= j;
 }
 
+TEST(u64, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(u64::from_str_radix("18446744073709551615", 10u).unwrap(),
+            u64::MAX);
+  EXPECT_EQ(u64::from_str_radix("9999999999999999999", 10u).unwrap(),
+            9999999999999999999_u64);
+  EXPECT_EQ(u64::from_str_radix("18446744073709551616", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u64::from_str_radix("99999999999999999999", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u64::from_str_radix("ffffffffffffffff", 16u).unwrap(), u64::MAX);
+  EXPECT_EQ(u64::from_str_radix("10000000000000000", 16u).unwrap_err().kind(),
+            Kind::PosOverflow);
+}
+
+TEST(u64, ToChars) {
+  char buf[20u];
+  EXPECT_EQ(u64::MAX.to_chars(sus::SliceMut<char>::from(buf)),
+            sus::some(20u));
+  EXPECT_EQ(std::string_view(buf, 20u), "18446744073709551615");
+}
+
 TEST(u64, fmt) {
   static_assert(fmt::is_formattable<u64, char>::value);
   EXPECT_EQ(fmt::format("{}", 123456789_u64), "123456789");
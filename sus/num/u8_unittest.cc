@@ -704,6 +704,9 @@ TEST(u8, InvokeEverything) {
   (void)i.from_be_bytes(a);
   (void)i.from_le_bytes(a);
   (void)i.from_ne_bytes(a);
+  (void)i.from_str_radix("1", 10u);
+  char chars[24u];
+  (void)i.to_chars(sus::SliceMut<char>::from(chars));
 
   i = ~j;
 
@@ -733,6 +736,16 @@ TEST(u8, InvokeEverything) {
   [[maybe_unused]] auto z = i >= j;
 }
 
+TEST(u8, FromStrRadix) {
+  using Kind = sus::num::ParseIntError::Kind;
+  EXPECT_EQ(u8::from_str_radix("255", 10u).unwrap(), 255u);
+  EXPECT_EQ(u8::from_str_radix("256", 10u).unwrap_err().kind(),
+            Kind::PosOverflow);
+  EXPECT_EQ(u8::from_str_radix("11111111", 2u).unwrap(), 255u);
+  EXPECT_EQ(u8::from_str_radix("100000000", 2u).unwrap_err().kind(),
+            Kind::PosOverflow);
+}
+
 TEST(u8, fmt) {
   static_assert(fmt::is_formattable<u8, char>::value);
   EXPECT_EQ(fmt::format("{}", 123_u8), "123");
@@ -22,6 +22,7 @@
 #include <bit>
 #include <compare>
 #include <functional>  // TODO: remove this but we need to hash things > size_t.
+#include <string_view>
 
 #include "fmt/format.h"
 #include "sus/assertions/check.h"
@@ -39,6 +40,7 @@
 #include "sus/num/__private/primitive_type.h"
 #include "sus/num/float_concepts.h"
 #include "sus/num/integer_concepts.h"
+#include "sus/num/parse_int_error.h"
 #include "sus/num/try_from_int_error.h"
 #include "sus/string/__private/format_to_stream.h"
 
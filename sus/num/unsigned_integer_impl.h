@@ -20,6 +20,9 @@
 #include <stdint.h>
 
 #include "sus/collections/array.h"
+#include "sus/num/__private/integer_to_chars.h"
+#include "sus/num/__private/parse_integer.h"
+#include "sus/num/parse_int_error_impl.h"
 #include "sus/num/unsigned_integer.h"
 #include "sus/option/option.h"
 #include "sus/ptr/copy.h"
@@ -16,6 +16,9 @@
 // IWYU pragma: friend "sus/.*"
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
 
 #include "sus/macros/inline.h"
@@ -62,8 +65,8 @@ struct Storage<T, false> final {
 
   constexpr Storage(const Storage& o) noexcept
     requires(!std::is_trivially_copy_constructible_v<T>)
-      : state_(o.state()) {
-    if (state_ == Some) std::construct_at(&val_, o.val());
+      : state_(o.state_) {
+    if (state_ == kSome) std::construct_at(&val_, o.val());
   }
   constexpr void operator=(const Storage& o) noexcept
     requires(!std::is_trivially_copy_assignable_v<T>)
@@ -75,8 +78,8 @@ struct Storage<T, false> final {
   }
   constexpr Storage(Storage&& o) noexcept
     requires(!std::is_trivially_move_constructible_v<T>)
-      : state_(o.state()) {
-    if (state_ == Some) std::construct_at(&val_, o.take_and_set_none());
+      : state_(o.state_) {
+    if (state_ == kSome) std::construct_at(&val_, o.take_and_set_none());
   }
   constexpr void operator=(Storage&& o) noexcept
     requires(!std::is_trivially_move_assignable_v<T>)
@@ -89,54 +92,60 @@ struct Storage<T, false> final {
 
   constexpr Storage() noexcept {}
   constexpr Storage(const std::remove_cvref_t<T>& t) noexcept
-      : val_(t), state_(Some) {}
+      : val_(t), state_(kSome) {}
   constexpr Storage(std::remove_cvref_t<T>& t) noexcept
-      : val_(t), state_(Some) {}
+      : val_(t), state_(kSome) {}
   constexpr Storage(std::remove_cvref_t<T>&& t) noexcept
-      : val_(::sus::move(t)), state_(Some) {}
+      : val_(::sus::move(t)), state_(kSome) {}
+  constexpr Storage(::sus::mem::NeverValueIndex i) noexcept
+      : state_(static_cast<uint8_t>(kFirstNeverValue + i.index)) {}
 
   template <class U>
     requires(std::convertible_to<U, T>)
-  constexpr Storage(const Storage<U>& o) noexcept : state_(o.state()) {
-    if (state_ == Some) std::construct_at(&val_, o.val());
+  constexpr Storage(const Storage<U>& o) noexcept
+      : state_(o.state() == Some ? kSome : kNone) {
+    if (state_ == kSome) std::construct_at(&val_, o.val());
   }
   template <class U>
     requires(std::convertible_to<U &&, T>)
-  constexpr Storage(Storage<U>&& o) noexcept : state_(o.state()) {
-    if (state_ == Some) std::construct_at(&val_, o.take_and_set_none());
+  constexpr Storage(Storage<U>&& o) noexcept
+      : state_(o.state() == Some ? kSome : kNone) {
+    if (state_ == kSome) std::construct_at(&val_, o.take_and_set_none());
   }
 
   _sus_pure constexpr const T& val() const noexcept { return val_; }
   _sus_pure constexpr T& val_mut() noexcept { return val_; }
 
-  _sus_pure constexpr inline State state() const noexcept { return state_; }
+  _sus_pure constexpr inline State state() const noexcept {
+    return state_ == kSome ? Some : None;
+  }
 
   constexpr inline void construct_from_none(const T& t) noexcept
     requires(::sus::mem::Copy<T>)
   {
     std::construct_at(&val_, t);
-    state_ = Some;
+    state_ = kSome;
   }
   constexpr inline void construct_from_none(T&& t) noexcept {
     std::construct_at(&val_, ::sus::move(t));
-    state_ = Some;
+    state_ = kSome;
   }
 
   constexpr inline void set_some(const T& t) noexcept
     requires(::sus::mem::Copy<T>)
   {
-    if (state_ == None)
+    if (state_ == kNone)
       construct_from_none(t);
     else
       val_ = t;
-    state_ = Some;
+    state_ = kSome;
   }
   constexpr inline void set_some(T&& t) noexcept {
-    if (state_ == None)
+    if (state_ == kNone)
       construct_from_none(::sus::move(t));
     else
       val_ = ::sus::move(t);
-    state_ = Some;
+    state_ = kSome;
   }
 
   [[nodiscard]] constexpr inline T replace_some(T&& t) noexcept {
@@ -144,7 +153,7 @@ struct Storage<T, false> final {
   }
 
   [[nodiscard]] constexpr inline T take_and_set_none() noexcept {
-    state_ = None;
+    state_ = kNone;
     if constexpr (::sus::mem::Move<T>) {
       return ::sus::mem::take_and_destruct(::sus::marker::unsafe_fn, val_);
     } else {
@@ -153,13 +162,32 @@ struct Storage<T, false> final {
   }
 
   constexpr inline void set_none() noexcept {
-    state_ = None;
+    state_ = kNone;
     val_.~T();
   }
 
   constexpr inline void destroy() noexcept { val_.~T(); }
 
+  // The state byte has space for many more values than `None` and `Some`, and
+  // they are used as the never-values of the `Option`.
+  static constexpr size_t kNeverValueCount = 256u - 2u;
+
+  _sus_pure constexpr bool is_never_value() const noexcept {
+    return state_ >= kFirstNeverValue;
+  }
+  _sus_pure constexpr size_t never_value_index() const noexcept {
+    return size_t{state_} - kFirstNeverValue;
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    state_ = static_cast<uint8_t>(kFirstNeverValue + i);
+  }
+  constexpr void set_never_value_destroy_value() noexcept { state_ = kNone; }
+
  private:
+  static constexpr uint8_t kNone = 0u;
+  static constexpr uint8_t kSome = 1u;
+  static constexpr uint8_t kFirstNeverValue = 2u;
+
   union {
     // TODO: We can make this T [[no_unique_address]], however then
     // we can not construct_at on it. Instead, we would need to only
@@ -168,7 +196,7 @@ struct Storage<T, false> final {
     // See also https://github.com/llvm/llvm-project/issues/70494
     T val_;
   };
-  State state_ = None;
+  uint8_t state_ = kNone;
 
   sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
                                            decltype(val_));
@@ -232,6 +260,8 @@ struct Storage<T, true> final {
   constexpr Storage() noexcept : access_() {}
   constexpr Storage(const T& t) noexcept : access_(t) {}
   constexpr Storage(T&& t) noexcept : access_(::sus::move(t)) {}
+  constexpr Storage(::sus::mem::NeverValueIndex i) noexcept
+      : access_(::sus::mem::NeverValueIndex{i.index + 1u}) {}
 
   template <class U>
     requires(std::convertible_to<U, T>)
@@ -309,6 +339,24 @@ struct Storage<T, true> final {
     access_.~NeverValueAccess();
   }
 
+  // The first never-value of `T` represents `None`, and the rest of them are
+  // used as the never-values of the `Option`.
+  static constexpr size_t kNeverValueCount =
+      ::sus::mem::never_value_count<T>() - 1u;
+
+  _sus_pure constexpr bool is_never_value() const noexcept {
+    return !access_.is_constructed() && access_.never_value_index() > 0u;
+  }
+  _sus_pure constexpr size_t never_value_index() const noexcept {
+    return access_.never_value_index() - 1u;
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn, i + 1u);
+  }
+  constexpr void set_never_value_destroy_value() noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn, 0u);
+  }
+
  private:
   using NeverValueAccess = ::sus::mem::__private::NeverValueAccess<T>;
 
@@ -41,6 +41,7 @@
 #include "sus/mem/copy.h"
 #include "sus/mem/forward.h"
 #include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
 #include "sus/mem/relocate.h"
 #include "sus/mem/replace.h"
 #include "sus/mem/take.h"
@@ -180,11 +181,28 @@ namespace sus {
 /// * [`ptr::NonNull<U>`]($sus::ptr::NonNull)
 /// * [`Box<T>`]($sus::boxed::Box)
 /// * [`Choice`]($sus::choice_type::Choice)
+/// * [`Result`]($sus::result::Result)
+/// * [`Option<U>`]($sus::option::Option), for any `U`
 ///
 /// This is called the "NeverValueField optimization", but is also called the
 /// ["null pointer optimization" or NPO in Rust](
 /// https://doc.rust-lang.org/stable/std/option/index.html#representation).
 ///
+/// A type can have more than one never-value, as reported by
+/// [`never_value_count`]($sus::mem::never_value_count). The
+/// [`Option`]($sus::option::Option) uses one of them to represent `None`, and
+/// its own never-values are the rest of them. When `T` has no never-values,
+/// the flag that [`Option`]($sus::option::Option) adds has spare values which
+/// become its never-values. So nesting them, such as in `Option<Option<i32>>`
+/// or `Option<Option<Box<T>>>`, does not grow the size beyond that of the
+/// innermost [`Option`]($sus::option::Option) that has a flag, or of `T` when
+/// none do.
+///
+/// Owning pointers such as [`Box`]($sus::boxed::Box) have a handful of
+/// never-values. [`NonNull`]($sus::ptr::NonNull) and references have only
+/// one, as they may point to any non-null address, so
+/// `Option<Option<NonNull<T>>>` adds a flag to the pointer.
+///
 /// # Reference parameters
 ///
 /// As mentioned above [`Option`]($sus::option::Option) type can hold a
@@ -1981,6 +1999,47 @@ class Option final {
 
   sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
                                            StorageType<T>);
+
+  // The `Option` has a never-value field when its storage has spare values
+  // that are not used to represent `Some` or `None`. Those are either values of
+  // the state flag, or the never-values of `T` beyond the one used for `None`.
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueAccess;
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueChecker;
+
+  static constexpr size_t _sus_NeverValueCount =
+      StorageType<T>::kNeverValueCount;
+
+  _sus_pure constexpr bool _sus_Unsafe_NeverValueIsConstructed(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    return !t_.is_never_value();
+  }
+  _sus_pure constexpr size_t _sus_Unsafe_NeverValueIndex(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    return t_.never_value_index();
+  }
+  constexpr void _sus_Unsafe_NeverValueSetIndex(::sus::marker::UnsafeFnMarker,
+                                                size_t i) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    t_.set_never_value_index(i);
+  }
+  // The destroy value is `None`, which the destructor does nothing for.
+  constexpr void _sus_Unsafe_NeverValueSetDestroyValue(
+      ::sus::marker::UnsafeFnMarker) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    t_.set_never_value_destroy_value();
+  }
+  // For the NeverValueField.
+  constexpr explicit Option(::sus::mem::NeverValueConstructor) noexcept
+    requires(_sus_NeverValueCount > 0u)
+      : t_(::sus::mem::NeverValueIndex{0u}) {}
 };
 
 template <class T>
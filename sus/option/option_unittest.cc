@@ -19,6 +19,7 @@
 
 #include "fmt/std.h"
 #include "googletest/include/gtest/gtest.h"
+#include "sus/boxed/box.h"
 #include "sus/collections/array.h"
 #include "sus/iter/from_iterator.h"
 #include "sus/iter/iterator.h"
@@ -2838,6 +2839,48 @@ TEST(Option, NonZeroField) {
   EXPECT_EQ(o->as_ptr(), &j);
 }
 
+TEST(Option, NestedNeverValues) {
+  // The state flag of an Option has spare values, which nested Options use
+  // instead of adding a flag of their own.
+  static_assert(sizeof(Option<Option<i32>>) == sizeof(Option<i32>));
+  static_assert(sizeof(Option<Option<Option<u32>>>) == sizeof(Option<u32>));
+  // A Box has more than one never-value, so nested Options of it are the size
+  // of a pointer.
+  using T = sus::Box<i32>;
+  static_assert(sizeof(Option<Option<T>>) == sizeof(T));
+  static_assert(sizeof(Option<Option<Option<T>>>) == sizeof(T));
+  // A NonNull or a reference has a single never-value, which is used by the
+  // innermost Option. The next Option adds a flag, whose spare values are used
+  // by any further Options.
+  using P = sus::ptr::NonNull<i32>;
+  static_assert(sizeof(Option<P>) == sizeof(P));
+  static_assert(sizeof(Option<Option<P>>) > sizeof(Option<P>));
+  static_assert(sizeof(Option<Option<Option<P>>>) == sizeof(Option<Option<P>>));
+  static_assert(sizeof(Option<Option<i32&>>) > sizeof(Option<i32&>));
+
+  auto o = Option<Option<Option<T>>>();
+  EXPECT_EQ(o, None);
+  o.insert(Option<Option<T>>());
+  EXPECT_EQ(o, Some);
+  EXPECT_EQ(*o, None);
+  o->insert(Option<T>());
+  EXPECT_EQ(*o, Some);
+  EXPECT_EQ(**o, None);
+  o->as_value_mut().insert(T(3));
+  EXPECT_EQ(**o, Some);
+  EXPECT_EQ(*o.as_value().as_value().as_value(), 3);
+  EXPECT_EQ(*sus::move(o).flatten().flatten().unwrap(), 3);
+
+  auto n = Option<Option<i32>>(Option<i32>());
+  EXPECT_EQ(n, Some);
+  EXPECT_EQ(*n, None);
+  auto m = n;
+  m = sus::some(sus::some(4_i32));
+  EXPECT_EQ(m.take().flatten().unwrap(), 4_i32);
+  EXPECT_EQ(m, None);
+  EXPECT_EQ(n, Some);
+}
+
 TEST(Option, From) {
   static_assert(sus::construct::From<Option<i64>, i64>);
   // If the Option can be constructed from it, then From works too.
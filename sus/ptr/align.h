@@ -0,0 +1,95 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "sus/assertions/check.h"
+#include "sus/macros/pure.h"
+#include "sus/mem/size_of.h"
+#include "sus/num/unsigned_integer.h"
+
+namespace sus::ptr {
+
+/// Computes the offset, in number of `T` elements, that needs to be applied to
+/// the pointer `p` in order to make it aligned to `align` bytes.
+///
+/// If it is not possible to align the pointer by stepping in units of `T`,
+/// the implementation returns [`usize::MAX`]($sus::num::usize::MAX). For
+/// example, a pointer to a `u16` at an odd address can never be moved to an
+/// address that is a multiple of 4 by adding whole `u16` elements.
+///
+/// The offset is not bounds checked, so it is up to the caller to ensure that
+/// `p + offset` stays within the same allocation before using the resulting
+/// pointer.
+///
+/// # Panics
+/// The function panics if `align` is not a power of two.
+template <class T>
+_sus_pure inline ::sus::num::usize align_offset(const T* p,
+                                                ::sus::num::usize align) noexcept {
+  sus_check(align.is_power_of_two());
+  const uintptr_t a = align.primitive_value;
+  const uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t mask = a - 1u;
+  const uintptr_t misaligned = addr & mask;
+  if (misaligned == 0u) return 0u;
+
+  const uintptr_t stride = ::sus::mem::size_of<T>();
+  // The common case of a power-of-two element size that divides the requested
+  // alignment evenly.
+  if ((stride & (stride - 1u)) == 0u && stride <= a) {
+    const uintptr_t byte_offset = a - misaligned;
+    if (byte_offset % stride != 0u) return ::sus::num::usize::MAX;
+    return byte_offset / stride;
+  }
+
+  // Otherwise we need to solve `offset * stride == -addr (mod align)`. Let
+  // `gcd` be the largest power of two dividing both `stride` and `align`. There
+  // is only a solution if `gcd` also divides `addr`, and then dividing
+  // everything by `gcd` leaves an odd `stride` which has a multiplicative
+  // inverse modulo the (power of two) `align`.
+  const uintptr_t stride_low_bit = stride & (~stride + 1u);
+  const uintptr_t gcd = stride_low_bit < a ? stride_low_bit : a;
+  if ((addr & (gcd - 1u)) != 0u) return ::sus::num::usize::MAX;
+  const uintptr_t reduced_mask = (a / gcd) - 1u;
+  const uintptr_t reduced_stride = stride / gcd;
+  // Newton's iteration for the inverse of an odd number modulo a power of two.
+  // Every step doubles the number of correct low bits, starting from 3, so
+  // five steps are enough for 64 bits.
+  uintptr_t inverse = reduced_stride;
+  for (int i = 0; i < 5; ++i) inverse *= uintptr_t{2} - reduced_stride * inverse;
+  const uintptr_t reduced_target = ((~addr + 1u) / gcd) & reduced_mask;
+  return (reduced_target * inverse) & reduced_mask;
+}
+
+/// Returns whether the pointer `p` is aligned to `align` bytes.
+///
+/// # Panics
+/// The function panics if `align` is not a power of two.
+template <class T>
+_sus_pure inline bool is_aligned_to(const T* p,
+                                    ::sus::num::usize align) noexcept {
+  sus_check(align.is_power_of_two());
+  return (reinterpret_cast<uintptr_t>(p) & (align.primitive_value - 1u)) == 0u;
+}
+
+/// Returns whether the pointer `p` is properly aligned for `T`.
+template <class T>
+_sus_pure inline bool is_aligned(const T* p) noexcept {
+  return (reinterpret_cast<uintptr_t>(p) & (alignof(T) - 1u)) == 0u;
+}
+
+}  // namespace sus::ptr
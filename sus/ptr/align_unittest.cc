@@ -0,0 +1,87 @@
+// Copyright 2023 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sus/ptr/align.h"
+
+#include "googletest/include/gtest/gtest.h"
+#include "sus/prelude.h"
+
+namespace {
+
+TEST(PtrAlign, AlignOffset) {
+  alignas(64) u8 bytes[128] = {};
+
+  EXPECT_EQ(sus::ptr::align_offset(&bytes[0], 16u), 0u);
+  EXPECT_EQ(sus::ptr::align_offset(&bytes[1], 16u), 15u);
+  EXPECT_EQ(sus::ptr::align_offset(&bytes[15], 16u), 1u);
+  EXPECT_EQ(sus::ptr::align_offset(&bytes[16], 16u), 0u);
+  EXPECT_EQ(sus::ptr::align_offset(&bytes[1], 1u), 0u);
+
+  // Stepping by u16 from an even address.
+  auto* u16s = reinterpret_cast<u16*>(&bytes[2]);
+  EXPECT_EQ(sus::ptr::align_offset(u16s, 8u), 3u);
+  // Stepping by u16 from an odd address can't reach an even one.
+  auto* odd_u16s = reinterpret_cast<u16*>(&bytes[1]);
+  EXPECT_EQ(sus::ptr::align_offset(odd_u16s, 8u), usize::MAX);
+  // The element is larger than the alignment and the pointer is misaligned.
+  auto* u64s = reinterpret_cast<u64*>(&bytes[4]);
+  EXPECT_EQ(sus::ptr::align_offset(u64s, 8u), usize::MAX);
+
+  // An odd sized element can reach any alignment.
+  struct Three {
+    u8 a, b, c;
+  };
+  for (usize i; i < 16u; i += 1u) {
+    auto* p = reinterpret_cast<Three*>(&bytes[size_t{i}]);
+    usize off = sus::ptr::align_offset(p, 16u);
+    EXPECT_LT(off, 16u);
+    EXPECT_TRUE(sus::ptr::is_aligned_to(p + size_t{off}, 16u));
+  }
+  // An element with size 6 can reach an alignment of 8 from even addresses.
+  struct Six {
+    u16 a, b, c;
+  };
+  for (usize i; i < 16u; i += 2u) {
+    auto* p = reinterpret_cast<Six*>(&bytes[size_t{i}]);
+    usize off = sus::ptr::align_offset(p, 8u);
+    EXPECT_LT(off, 4u);
+    EXPECT_TRUE(sus::ptr::is_aligned_to(p + size_t{off}, 8u));
+  }
+}
+
+TEST(PtrAlignDeathTest, AlignOffsetNotPowerOfTwo) {
+  u8 b;
+#if GTEST_HAS_DEATH_TEST
+  EXPECT_DEATH(
+      {
+        auto o = sus::ptr::align_offset(&b, 3u);
+        EXPECT_EQ(o, 0u);
+      },
+      "");
+#endif
+}
+
+TEST(PtrAlign, IsAligned) {
+  alignas(16) u32 ints[4] = {};
+  EXPECT_TRUE(sus::ptr::is_aligned(&ints[0]));
+  EXPECT_TRUE(sus::ptr::is_aligned(&ints[1]));
+  EXPECT_FALSE(sus::ptr::is_aligned(
+      reinterpret_cast<const u32*>(reinterpret_cast<const char*>(ints) + 1)));
+
+  EXPECT_TRUE(sus::ptr::is_aligned_to(&ints[0], 16u));
+  EXPECT_FALSE(sus::ptr::is_aligned_to(&ints[1], 16u));
+  EXPECT_TRUE(sus::ptr::is_aligned_to(&ints[2], 8u));
+}
+
+}  // namespace
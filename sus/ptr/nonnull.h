@@ -158,7 +158,8 @@ class [[_sus_trivial_abi]] NonNull {
   // optimizations.
   sus_class_trivially_relocatable_unchecked(::sus::marker::unsafe_fn);
   // Declare that the `ptr_` field is never set to `nullptr` for library
-  // optimizations.
+  // optimizations. It is the only never-value, as any other address may be
+  // valid for a `T` with a small alignment.
   sus_class_never_value_field(::sus::marker::unsafe_fn, NonNull, ptr_, nullptr,
                               nullptr);
   // For the NeverValueField.
@@ -18,11 +18,14 @@
 
 #include <concepts>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
 
 #include "sus/cmp/ord.h"
 #include "sus/macros/no_unique_address.h"
 #include "sus/mem/copy.h"
 #include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
 #include "sus/mem/take.h"
 
 namespace sus::result::__private {
@@ -38,6 +41,8 @@ struct MaybeNoUniqueAddress {
   template <class... U>
   constexpr MaybeNoUniqueAddress(WithE, U&&... v) noexcept
       : v(WITH_E, ::sus::forward<U>(v)...) {}
+  constexpr MaybeNoUniqueAddress(::sus::mem::NeverValueIndex i) noexcept
+      : v(i) {}
 
   T v;
 };
@@ -49,13 +54,16 @@ struct MaybeNoUniqueAddress<T, true> {
   template <class... U>
   constexpr MaybeNoUniqueAddress(WithE, U&&... v) noexcept
       : v(WITH_E, ::sus::forward<U>(v)...) {}
+  constexpr MaybeNoUniqueAddress(::sus::mem::NeverValueIndex i) noexcept
+      : v(i) {}
 
   [[_sus_no_unique_address]] T v;
 };
 
 template <class E>
 struct StorageVoid {
-  enum State { Ok, Err, Moved };
+  // The values after `Moved` are the never-values of the `Result`.
+  enum State : uint32_t { Ok, Err, Moved };
 
   constexpr StorageVoid(WithT) noexcept : inner_(WITH_T) {}
   constexpr StorageVoid(WithE, const E& e) noexcept
@@ -64,6 +72,7 @@ struct StorageVoid {
   constexpr StorageVoid(WithE, E&& e) noexcept
     requires(std::is_move_constructible_v<E>)
       : inner_(WITH_E, ::sus::move(e)) {}
+  constexpr StorageVoid(::sus::mem::NeverValueIndex i) noexcept : inner_(i) {}
 
   ~StorageVoid() noexcept = default;
 
@@ -76,6 +85,21 @@ struct StorageVoid {
   constexpr bool is_ok() const noexcept { return inner_.v.state == Ok; }
   constexpr bool is_err() const noexcept { return inner_.v.state == Err; }
 
+  static constexpr size_t kNeverValueCount = size_t{UINT32_MAX - Moved};
+
+  constexpr bool is_never_value() const noexcept {
+    return inner_.v.state > Moved;
+  }
+  constexpr size_t never_value_index() const noexcept {
+    return size_t{inner_.v.state - (Moved + 1u)};
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    inner_.v.state = static_cast<State>(Moved + 1u + i);
+  }
+  constexpr void set_never_value_destroy_value() noexcept {
+    inner_.v.state = Moved;
+  }
+
   template <class As>
   constexpr void get_ok() const noexcept {}
   constexpr const E& get_err() const noexcept {
@@ -111,6 +135,8 @@ struct StorageVoid {
  private:
   struct Inner {
     constexpr explicit Inner(WithT) : u(WITH_T), state(Ok) {}
+    constexpr explicit Inner(::sus::mem::NeverValueIndex i)
+        : state(static_cast<State>(Moved + 1u + i.index)) {}
     template <class U>
     constexpr Inner(WithE, U&& err)
         : u(WITH_E, ::sus::forward<U>(err)), state(Err) {}
@@ -279,7 +305,8 @@ struct StorageVoid {
 
 template <class T, class E>
 struct StorageNonVoid {
-  enum State { Ok, Err, Moved };
+  // The values after `Moved` are the never-values of the `Result`.
+  enum State : uint32_t { Ok, Err, Moved };
 
   constexpr StorageNonVoid(WithT, const T& t) noexcept
     requires(std::is_copy_constructible_v<T>)
@@ -293,6 +320,8 @@ struct StorageNonVoid {
   constexpr StorageNonVoid(WithE, E&& e) noexcept
     requires(std::is_move_constructible_v<E>)
       : inner_(WITH_E, ::sus::move(e)) {}
+  constexpr StorageNonVoid(::sus::mem::NeverValueIndex i) noexcept
+      : inner_(i) {}
 
   ~StorageNonVoid() noexcept = default;
 
@@ -305,6 +334,21 @@ struct StorageNonVoid {
   constexpr bool is_ok() const noexcept { return inner_.v.state == Ok; }
   constexpr bool is_err() const noexcept { return inner_.v.state == Err; }
 
+  static constexpr size_t kNeverValueCount = size_t{UINT32_MAX - Moved};
+
+  constexpr bool is_never_value() const noexcept {
+    return inner_.v.state > Moved;
+  }
+  constexpr size_t never_value_index() const noexcept {
+    return size_t{inner_.v.state - (Moved + 1u)};
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    inner_.v.state = static_cast<State>(Moved + 1u + i);
+  }
+  constexpr void set_never_value_destroy_value() noexcept {
+    inner_.v.state = Moved;
+  }
+
   template <class As>
   constexpr const std::remove_reference_t<As>& get_ok() const noexcept {
     return inner_.v.u.ok;  //
@@ -352,6 +396,8 @@ struct StorageNonVoid {
     template <class U>
     constexpr Inner(WithT, U&& ok)
         : u(WITH_T, ::sus::forward<U>(ok)), state(Ok) {}
+    constexpr explicit Inner(::sus::mem::NeverValueIndex i)
+        : state(static_cast<State>(Moved + 1u + i.index)) {}
     template <class U>
     constexpr Inner(WithE, U&& err)
         : u(WITH_E, ::sus::forward<U>(err)), state(Err) {}
@@ -545,4 +591,215 @@ struct StorageNonVoid {
                                            decltype(inner_.v.state));
 };
 
+/// Whether a `Result<T, E>` can hold its state in the never-values of `T`,
+/// which needs an `E` that holds no data, and a `T` with a never-value for each
+/// of the `Err` and moved-from states.
+template <class T, class E>
+concept NicheStorable =
+    !std::is_void_v<T> && !std::is_reference_v<T> && std::is_empty_v<E> &&
+    std::is_trivially_copyable_v<E> &&
+    std::is_trivially_default_constructible_v<E> &&
+    ::sus::mem::never_value_count<T>() >= 2u;
+
+/// The storage for a `Result<T, E>` where `NicheStorable<T, E>`. It is the
+/// same size as `T`, as any value of `T` is `Ok`, and the first two
+/// never-values of `T` are `Err` and the moved-from state. The never-values of
+/// `T` after those are the never-values of the `Result`.
+template <class T, class E>
+struct StorageNiche {
+  // The indices of the never-values of `T` for each state.
+  static constexpr size_t kErr = 0u;
+  static constexpr size_t kMoved = 1u;
+  static constexpr size_t kFirstNeverValue = 2u;
+
+  constexpr StorageNiche(WithT, const T& t) noexcept
+    requires(std::is_copy_constructible_v<T>)
+      : access_(t) {}
+  constexpr StorageNiche(WithT, T&& t) noexcept
+    requires(std::is_move_constructible_v<T>)
+      : access_(::sus::move(t)) {}
+  constexpr StorageNiche(WithE, const E&) noexcept
+      : access_(::sus::mem::NeverValueIndex{kErr}) {}
+  constexpr StorageNiche(::sus::mem::NeverValueIndex i) noexcept
+      : access_(::sus::mem::NeverValueIndex{kFirstNeverValue + i.index}) {}
+
+  constexpr ~StorageNiche() noexcept
+    requires(std::is_trivially_destructible_v<T>)
+  = default;
+  constexpr ~StorageNiche() noexcept
+    requires(!std::is_trivially_destructible_v<T>)
+  {
+    if (!access_.is_constructed())
+      access_.set_destroy_value(::sus::marker::unsafe_fn);
+    access_.~NeverValueAccess();
+  }
+
+  StorageNiche(const StorageNiche&)
+    requires(std::is_trivially_copy_constructible_v<T>)
+  = default;
+  constexpr StorageNiche(const StorageNiche& o) noexcept
+    requires(!std::is_trivially_copy_constructible_v<T> &&
+             std::is_copy_constructible_v<T>)
+  {
+    if (o.is_ok()) {
+      std::construct_at(&access_, o.access_.as_inner());
+    } else {
+      sus_check_with_message(!o.is_moved(), "Result used after move");
+      std::construct_at(&access_, ::sus::mem::NeverValueIndex{o.index()});
+    }
+  }
+  StorageNiche& operator=(const StorageNiche&)
+    requires(std::is_trivially_copy_assignable_v<T>)
+  = default;
+  constexpr StorageNiche& operator=(const StorageNiche& o) noexcept
+    requires(!std::is_trivially_copy_assignable_v<T> &&
+             std::is_copy_assignable_v<T>)
+  {
+    sus_check_with_message(!o.is_moved(), "Result used after move");
+    if (is_ok() && o.is_ok()) {
+      access_.as_inner_mut() = o.access_.as_inner();
+    } else {
+      if (is_ok()) set_index(kMoved);
+      // If this trips, it means the destructor in this Result moved out of the
+      // Result that is being assigned from.
+      sus_check_with_message(!o.is_moved(), "Result used after move");
+      if (o.is_ok()) {
+        access_.set_destroy_value(::sus::marker::unsafe_fn);
+        access_.~NeverValueAccess();
+        std::construct_at(&access_, o.access_.as_inner());
+      } else {
+        set_index(o.index());
+      }
+    }
+    return *this;
+  }
+
+  StorageNiche(StorageNiche&&)
+    requires(std::is_trivially_move_constructible_v<T>)
+  = default;
+  constexpr StorageNiche(StorageNiche&& o) noexcept
+    requires(!std::is_trivially_move_constructible_v<T> &&
+             std::is_move_constructible_v<T>)
+  {
+    if (o.is_ok()) {
+      std::construct_at(&access_, ::sus::move(o.access_.as_inner_mut()));
+      o.set_index(kMoved);
+    } else {
+      sus_check_with_message(!o.is_moved(), "Result used after move");
+      std::construct_at(&access_, ::sus::mem::NeverValueIndex{o.index()});
+      o.access_.set_never_value_index(::sus::marker::unsafe_fn, kMoved);
+    }
+  }
+  StorageNiche& operator=(StorageNiche&&)
+    requires(std::is_trivially_move_assignable_v<T>)
+  = default;
+  constexpr StorageNiche& operator=(StorageNiche&& o) noexcept
+    requires(!std::is_trivially_move_assignable_v<T> &&
+             std::is_move_assignable_v<T>)
+  {
+    sus_check_with_message(!o.is_moved(), "Result used after move");
+    if (is_ok() && o.is_ok()) {
+      access_.as_inner_mut() = ::sus::move(o.access_.as_inner_mut());
+      o.set_index(kMoved);
+    } else {
+      if (is_ok()) set_index(kMoved);
+      // If this trips, it means the destructor in this Result moved out of the
+      // Result that is being assigned from.
+      sus_check_with_message(!o.is_moved(), "Result used after move");
+      if (o.is_ok()) {
+        access_.set_destroy_value(::sus::marker::unsafe_fn);
+        access_.~NeverValueAccess();
+        std::construct_at(&access_, ::sus::move(o.access_.as_inner_mut()));
+        o.set_index(kMoved);
+      } else {
+        set_index(o.index());
+        o.access_.set_never_value_index(::sus::marker::unsafe_fn, kMoved);
+      }
+    }
+    return *this;
+  }
+
+  constexpr bool is_moved() const noexcept {
+    return !access_.is_constructed() && index() == kMoved;
+  }
+  constexpr bool is_ok() const noexcept { return access_.is_constructed(); }
+  constexpr bool is_err() const noexcept {
+    return !access_.is_constructed() && index() == kErr;
+  }
+
+  static constexpr size_t kNeverValueCount =
+      ::sus::mem::never_value_count<T>() - kFirstNeverValue;
+
+  constexpr bool is_never_value() const noexcept {
+    return !access_.is_constructed() && index() >= kFirstNeverValue;
+  }
+  constexpr size_t never_value_index() const noexcept {
+    return index() - kFirstNeverValue;
+  }
+  constexpr void set_never_value_index(size_t i) noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn,
+                                  kFirstNeverValue + i);
+  }
+  constexpr void set_never_value_destroy_value() noexcept {
+    access_.set_never_value_index(::sus::marker::unsafe_fn, kMoved);
+  }
+
+  template <class As>
+  constexpr const std::remove_reference_t<As>& get_ok() const noexcept {
+    return access_.as_inner();
+  }
+  constexpr const E& get_err() const noexcept { return err_; }
+
+  template <class As>
+  constexpr As& get_ok_mut() & noexcept {
+    return access_.as_inner_mut();
+  }
+  constexpr E& get_err_mut() & noexcept { return err_; }
+
+  template <class As>
+  constexpr As take_ok() & noexcept
+    requires(::sus::mem::Move<T>)
+  {
+    auto t = T(::sus::move(access_.as_inner_mut()));
+    set_index(kMoved);
+    return t;
+  }
+  constexpr E take_err() & noexcept {
+    set_index(kMoved);
+    return err_;
+  }
+
+  constexpr void drop_ok() & noexcept { set_index(kMoved); }
+  constexpr void drop_err() & noexcept { set_index(kMoved); }
+
+ private:
+  using NeverValueAccess = ::sus::mem::__private::NeverValueAccess<T>;
+
+  /// The index of the never-value of `T` that is set, when the `Result` is not
+  /// `Ok`.
+  constexpr size_t index() const noexcept {
+    return access_.never_value_index();
+  }
+  /// Sets the never-value of `T` at index `i`, destroying the `T` first if the
+  /// `Result` is `Ok`.
+  constexpr void set_index(size_t i) noexcept {
+    if (access_.is_constructed()) {
+      access_.~NeverValueAccess();
+      std::construct_at(&access_, ::sus::mem::NeverValueIndex{i});
+    } else {
+      access_.set_never_value_index(::sus::marker::unsafe_fn, i);
+    }
+  }
+
+  union {
+    NeverValueAccess access_;
+  };
+  // The `E` holds no data, so each `Err` has the same value and it does not
+  // need to be stored with the state.
+  [[_sus_no_unique_address]] E err_ = E();
+
+  sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
+                                           decltype(access_));
+};
+
 }  // namespace sus::result::__private
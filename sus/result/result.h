@@ -35,6 +35,7 @@
 #include "sus/mem/clone.h"
 #include "sus/mem/copy.h"
 #include "sus/mem/move.h"
+#include "sus/mem/never_value.h"
 #include "sus/mem/relocate.h"
 #include "sus/mem/take.h"
 #include "sus/option/option.h"
@@ -927,11 +928,56 @@ class [[nodiscard]] Result final {
   using Storage = std::conditional_t<  //
       std::is_void_v<T>,               //
       __private::StorageVoid<E>,       //
-      __private::StorageNonVoid<OkStorageType, E>>;
+      std::conditional_t<__private::NicheStorable<T, E>,
+                         __private::StorageNiche<TUnlessVoid, E>,
+                         __private::StorageNonVoid<OkStorageType, E>>>;
   [[no_unique_address]] Storage storage_;
 
   sus_class_trivially_relocatable_if_types(::sus::marker::unsafe_fn,
                                            decltype(storage_));
+
+  // The state of the `Result` has space for many values beyond `Ok`, `Err` and
+  // the moved-from state, which are used as its never-values. This allows an
+  // `Option<Result<T, E>>` to be the same size as the `Result`. When `E` holds
+  // no data and the state is kept in the never-values of `T`, the `Result` has
+  // the never-values of `T` that are left over, which may be none.
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueAccess;
+  template <class>
+  friend struct ::sus::mem::__private::NeverValueChecker;
+
+  static constexpr size_t _sus_NeverValueCount = Storage::kNeverValueCount;
+
+  _sus_pure constexpr bool _sus_Unsafe_NeverValueIsConstructed(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    return !storage_.is_never_value();
+  }
+  _sus_pure constexpr size_t _sus_Unsafe_NeverValueIndex(
+      ::sus::marker::UnsafeFnMarker) const noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    return storage_.never_value_index();
+  }
+  constexpr void _sus_Unsafe_NeverValueSetIndex(::sus::marker::UnsafeFnMarker,
+                                                size_t i) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    storage_.set_never_value_index(i);
+  }
+  // The destroy value is the moved-from state, which the destructor does
+  // nothing for.
+  constexpr void _sus_Unsafe_NeverValueSetDestroyValue(
+      ::sus::marker::UnsafeFnMarker) noexcept
+    requires(_sus_NeverValueCount > 0u)
+  {
+    storage_.set_never_value_destroy_value();
+  }
+  // For the NeverValueField.
+  constexpr explicit Result(::sus::mem::NeverValueConstructor) noexcept
+    requires(_sus_NeverValueCount > 0u)
+      : storage_(::sus::mem::NeverValueIndex{0u}) {}
 };
 
 /// Implicit for-ranged loop iteration via [`Result::iter()`](
@@ -18,6 +18,7 @@
 
 #include "fmt/std.h"
 #include "googletest/include/gtest/gtest.h"
+#include "sus/boxed/box.h"
 #include "sus/collections/array.h"
 #include "sus/iter/iterator.h"
 #include "sus/iter/once.h"
@@ -25,6 +26,7 @@
 #include "sus/mem/move.h"
 #include "sus/num/types.h"
 #include "sus/prelude.h"
+#include "sus/ptr/nonnull.h"
 #include "sus/test/behaviour_types.h"
 #include "sus/test/no_copy_move.h"
 
@@ -2070,4 +2072,81 @@ TEST(Result, AsValue) {
   EXPECT_EQ(y.as_value_mut(), 2);
 }
 
+TEST(Result, NeverValue) {
+  enum class ECode { A, B };
+  // The Result's state has spare values which an Option uses instead of adding
+  // a flag.
+  static_assert(sus::mem::NeverValueField<Result<i32, ECode>>);
+  static_assert(sizeof(sus::Option<Result<sus::Box<i32>, ECode>>) ==
+                sizeof(Result<sus::Box<i32>, ECode>));
+  static_assert(sizeof(sus::Option<Result<void, ECode>>) ==
+                sizeof(Result<void, ECode>));
+  static_assert(sizeof(sus::Option<sus::Option<Result<i32&, ECode>>>) ==
+                sizeof(Result<i32&, ECode>));
+
+  auto o = sus::Option<Result<sus::Box<i32>, ECode>>();
+  EXPECT_TRUE(o.is_none());
+  o.insert(Result<sus::Box<i32>, ECode>(sus::Box<i32>(4)));
+  EXPECT_TRUE(o.is_some());
+  EXPECT_EQ(*o->as_value(), 4);
+  o.insert(Result<sus::Box<i32>, ECode>::with_err(ECode::B));
+  EXPECT_EQ(o.take().unwrap().unwrap_err(), ECode::B);
+  EXPECT_TRUE(o.is_none());
+
+  constexpr auto c = sus::Option<Result<i32, ECode>>(Result<i32, ECode>(2));
+  static_assert(c.as_value().as_value() == 2);
+  static_assert(sus::Option<Result<i32, ECode>>().is_none());
+}
+
+TEST(Result, NeverValueEmptyError) {
+  struct Unit {};
+  enum class ECode { A, B };
+  using B = sus::Box<i32>;
+  using R = Result<B, Unit>;
+  // When the error type holds no data, the state is held in the never-values
+  // of `T` when it has at least two, and the rest are passed on.
+  static_assert(sizeof(R) == sizeof(B));
+  static_assert(sus::mem::never_value_count<R>() ==
+                sus::mem::never_value_count<B>() - 2u);
+  static_assert(sizeof(sus::Option<R>) == sizeof(R));
+  static_assert(sizeof(Result<Option<i32>, Unit>) == sizeof(Option<i32>));
+  // An error type with data, or a `T` with a single never-value, needs a
+  // separate state.
+  static_assert(sizeof(Result<B, ECode>) > sizeof(B));
+  static_assert(sizeof(Result<sus::ptr::NonNull<i32>, Unit>) >
+                sizeof(sus::ptr::NonNull<i32>));
+
+  auto r = R(B(3));
+  EXPECT_TRUE(r.is_ok());
+  EXPECT_EQ(*r.as_value(), 3);
+  auto c = sus::clone(r);
+  EXPECT_EQ(*c.as_value(), 3);
+  auto e = R::with_err(Unit());
+  EXPECT_TRUE(e.is_err());
+  r = sus::move(e);
+  EXPECT_TRUE(r.is_err());
+  auto m = sus::move(r);
+  EXPECT_TRUE(m.is_err());
+  m = sus::move(c);
+  EXPECT_EQ(*sus::move(m).unwrap(), 3);
+
+  auto o = sus::Option<R>();
+  EXPECT_TRUE(o.is_none());
+  o.insert(R::with_err(Unit()));
+  EXPECT_TRUE(o.is_some());
+  EXPECT_TRUE(o->is_err());
+  o.insert(R(B(5)));
+  EXPECT_EQ(*o.take().unwrap().unwrap(), 5);
+  EXPECT_TRUE(o.is_none());
+
+  using C = Result<Option<i32>, Unit>;
+  static_assert(C(Option<i32>(2)).unwrap().unwrap() == 2);
+  static_assert(C::with_err(Unit()).is_err());
+  auto x = C::with_err(Unit());
+  auto y = x;
+  EXPECT_TRUE(y.is_err());
+  y = C(Option<i32>());
+  EXPECT_EQ(sus::move(y).unwrap(), sus::None);
+}
+
 }  // namespace
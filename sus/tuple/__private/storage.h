@@ -19,6 +19,7 @@
 #include <type_traits>
 #include <utility>  // TODO: Replace std::index_sequence to remove this header.
 
+#include "sus/choice/__private/pack_index.h"
 #include "sus/macros/no_unique_address.h"
 #include "sus/macros/nonnull.h"
 #include "sus/mem/addressof.h"
@@ -27,22 +28,17 @@
 
 namespace sus::tuple_type::__private {
 
-// TODO: Consider having TupleStorage inherit from each type (if it's final then
-// it has to compose it), or just inherit from N things that each hold a T, as
-// libc++ does for std::tuple, using `:public Holds<Index..., T...>`. Then to
-// get from the Storage to the base class you can static_cast the Storage
-// pointer to it.
-template <class... T>
-struct TupleStorage;
-
-template <class T>
-struct TupleStorage<T> {
-  TupleStorage()
+/// Holds the `I`th element of a Tuple. The `TupleStorage` inherits from one
+/// `TupleHolder` for each element, so the element at an index is found by
+/// converting the storage to the `TupleHolder` base with that index.
+template <size_t I, class T>
+struct TupleHolder {
+  TupleHolder()
     requires(std::is_trivially_default_constructible_v<T>)
   = default;
 
   template <class U>
-  constexpr inline explicit TupleStorage(U&& value)
+  constexpr inline explicit TupleHolder(U&& value)
       : value(::sus::forward<U>(value)) {}
 
   inline constexpr const T& at() const& noexcept { return value; }
@@ -53,9 +49,9 @@ struct TupleStorage<T> {
   [[_sus_no_unique_address]] T value;
 };
 
-template <class T>
-struct TupleStorage<T&> {
-  constexpr inline explicit TupleStorage(T& value)
+template <size_t I, class T>
+struct TupleHolder<I, T&> {
+  constexpr inline explicit TupleHolder(T& value)
       : value(::sus::mem::addressof(value)) {}
 
   inline constexpr const T& at() const& noexcept { return *value; }
@@ -66,78 +62,114 @@ struct TupleStorage<T&> {
   T* _sus_nonnull_var value;
 };
 
-template <class T, class... Ts>
-  requires(sizeof...(Ts) > 0)
-struct TupleStorage<T, Ts...> : TupleStorage<Ts...> {
-  using Super = TupleStorage<Ts...>;
-
-  TupleStorage()
-    requires(std::is_trivially_default_constructible_v<T>)
-  = default;
-
-  template <class U, class... Us>
-  constexpr inline TupleStorage(U&& value, Us&&... more) noexcept
-      : Super(::sus::forward<Us>(more)...), value(::sus::forward<U>(value)) {}
+/// The alignment of a Tuple element as it is stored, where references are
+/// stored as pointers.
+template <class T>
+constexpr size_t stored_align =
+    alignof(std::conditional_t<std::is_reference_v<T>,
+                               std::remove_reference_t<T>*, T>);
 
-  inline constexpr const T& at() const& noexcept { return value; }
-  inline constexpr T& at_mut() & noexcept { return value; }
-  inline constexpr T&& into_inner() && noexcept { return ::sus::move(value); }
+/// The order in which the elements of a Tuple are stored: by decreasing
+/// alignment, so that no padding is needed between them, and otherwise in
+/// reverse of the order they are specified.
+template <class... T>
+struct TupleOrder {
+  static constexpr size_t N = sizeof...(T);
+  struct Indices {
+    size_t at[N];
+  };
+  static constexpr Indices indices = []() {
+    constexpr size_t aligns[] = {stored_align<T>...};
+    Indices out;
+    for (size_t i = 0u; i < N; ++i) {
+      // Insert index `N - 1 - i` after all indices with at least its alignment.
+      const size_t index = N - 1u - i;
+      size_t pos = i;
+      while (pos > 0u && aligns[out.at[pos - 1u]] < aligns[index]) {
+        out.at[pos] = out.at[pos - 1u];
+        --pos;
+      }
+      out.at[pos] = index;
+    }
+    return out;
+  }();
+
+  template <size_t... Is>
+  static constexpr auto sequence(std::index_sequence<Is...>) noexcept {
+    return std::index_sequence<indices.at[Is]...>();
+  }
+  using type = decltype(sequence(std::make_index_sequence<N>()));
+};
 
- private:
-  [[_sus_no_unique_address]] T value;
+/// The values given to construct a `TupleStorage`, held by reference so they
+/// can be picked out by index in the storage order.
+template <size_t I, class U>
+struct TupleArg {
+  U&& value;
 };
 
-template <class T, class... Ts>
-  requires(sizeof...(Ts) > 0)
-struct TupleStorage<T&, Ts...> : TupleStorage<Ts...> {
-  using Super = TupleStorage<Ts...>;
+template <class Is, class... U>
+struct TupleArgs;
 
-  template <class... Us>
-  constexpr inline TupleStorage(T& value, Us&&... more) noexcept
-      : Super(::sus::forward<Us>(more)...),
-        value(::sus::mem::addressof(value)) {}
+template <size_t... Is, class... U>
+struct TupleArgs<std::index_sequence<Is...>, U...> : TupleArg<Is, U>... {};
 
-  inline constexpr const T& at() const& noexcept { return *value; }
-  inline constexpr T& at_mut() & noexcept { return *value; }
-  inline constexpr T& into_inner() && noexcept { return *value; }
+template <size_t I, class U>
+constexpr inline U&& tuple_arg(const TupleArg<I, U>& arg) noexcept {
+  return ::sus::forward<U>(arg.value);
+}
 
+template <class Order, class... T>
+struct TupleStorageImpl;
+
+/// Storage for the elements of a Tuple, as a flat set of `TupleHolder` base
+/// classes in the given storage `Order`. Since the base classes are not
+/// nested, looking up an element does not recurse through the other elements,
+/// and each element may be placed in the tail padding of the ones before it.
+template <size_t... Order, class... T>
+struct TupleStorageImpl<std::index_sequence<Order...>, T...>
+    : TupleHolder<Order,
+                  ::sus::choice_type::__private::PackIth<Order, T...>>... {
  private:
-  T* value;
-};
+  enum Construct { CONSTRUCT };
 
-template <size_t I, class S>
-static constexpr const auto& find_tuple_storage(const S& storage) {
-  return find_tuple_storage(storage, std::integral_constant<size_t, I>());
-}
+ public:
+  TupleStorageImpl()
+    requires((std::is_trivially_default_constructible_v<T> && ...))
+  = default;
 
-template <size_t I, class S>
-static constexpr const auto& find_tuple_storage(
-    const S& storage, std::integral_constant<size_t, I>) {
-  return find_tuple_storage(static_cast<const S::Super&>(storage),
-                            std::integral_constant<size_t, I - 1>());
-}
+  template <class... U>
+    requires(sizeof...(U) == sizeof...(T) &&
+             (!std::is_same_v<std::remove_cvref_t<U>, Construct> && ...))
+  constexpr inline explicit TupleStorageImpl(U&&... values) noexcept
+      : TupleStorageImpl(
+            CONSTRUCT, TupleArgs<std::make_index_sequence<sizeof...(T)>, U...>{
+                           {::sus::forward<U>(values)}...}) {}
 
-template <class S>
-static constexpr const S& find_tuple_storage(
-    const S& storage, std::integral_constant<size_t, 0>) {
-  return storage;
-}
+ private:
+  template <class... U>
+  constexpr inline TupleStorageImpl(
+      Construct,
+      const TupleArgs<std::make_index_sequence<sizeof...(T)>, U...>&
+          args) noexcept
+      : TupleHolder<Order, ::sus::choice_type::__private::PackIth<Order, T...>>(
+            tuple_arg<Order>(args))... {}
+};
 
-template <size_t I, class S>
-static constexpr auto& find_tuple_storage_mut(S& storage) {
-  return find_tuple_storage_mut(storage, std::integral_constant<size_t, I>());
-}
+template <class... T>
+using TupleStorage = TupleStorageImpl<typename TupleOrder<T...>::type, T...>;
 
-template <size_t I, class S>
-static constexpr auto& find_tuple_storage_mut(
-    S& storage, std::integral_constant<size_t, I>) {
-  return find_tuple_storage_mut(static_cast<S::Super&>(storage),
-                                std::integral_constant<size_t, I - 1>());
+/// Returns the `TupleHolder` for the `I`th element of a `TupleStorage`, which
+/// is deduced from the base class that has the index `I`.
+template <size_t I, class T>
+constexpr inline const TupleHolder<I, T>& find_tuple_storage(
+    const TupleHolder<I, T>& storage) noexcept {
+  return storage;
 }
 
-template <class S>
-static constexpr S& find_tuple_storage_mut(S& storage,
-                                           std::integral_constant<size_t, 0>) {
+template <size_t I, class T>
+constexpr inline TupleHolder<I, T>& find_tuple_storage_mut(
+    TupleHolder<I, T>& storage) noexcept {
   return storage;
 }
 
@@ -70,8 +70,8 @@ namespace sus::tuple_type {
 ///
 /// # Tail padding
 /// The Tuple's tail padding may be reused when the Tuple is marked as
-/// `[[no_unique_address]]`. The Tuple will have tail padding if the first
-/// type has a size that is not a multiple of the Tuple's alignment. For
+/// `[[no_unique_address]]`. The Tuple will have tail padding if the sizes of
+/// its types do not add up to a multiple of the Tuple's alignment. For
 /// example if it's smaller than the alignment, such as `Tuple<u8, u64>` which
 /// has `(alignof(u64) == sizeof(u64)) - sizeof(u8)` or 7 bytes of tail padding.
 ///
@@ -93,13 +93,13 @@ namespace sus::tuple_type {
 /// Additionally types within the tuple may be placed inside the tail padding of
 /// other types in the tuple, should such padding exist.
 ///
-/// Generally, but not always, use of tail padding in Tuple is optimized by
-/// ordering types (left-to-right in the template variables) from smallest-to-
-/// largest for simple types such as integers (which have no tail padding
-/// themselves), or in least-to-most tail-padding for more complex types.
-/// Elements in a Tuple are stored internally in reverse of the order they are
-/// specified, which is why the size of the *first* element matters for the
-/// Tuple's externally usable tail padding.
+/// Elements in a Tuple are stored internally from the largest alignment to the
+/// smallest, so that no padding is needed between them, regardless of the
+/// order they are specified in. Elements with the same alignment are stored in
+/// reverse of the order they are specified. For more complex types that have
+/// tail padding themselves, use of that padding is optimized by ordering types
+/// of the same alignment (left-to-right in the template variables) from
+/// least-to-most tail padding.
 template <class T, class... Ts>
 class Tuple final {
  public:
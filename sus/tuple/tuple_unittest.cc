@@ -111,6 +111,13 @@ TEST(Tuple, TailPadding) {
   static_assert(sizeof(WithTuple) == sizeof(std::declval<WithTuple&>().t) +
                                          sus_if_msvc_else(sizeof(i64), 0));
 
+  // Elements are stored from largest to smallest alignment, so there is no
+  // padding between them regardless of the order they are specified in.
+  using Unordered = Tuple<u8, u64, u16, u32>;
+  static_assert(sizeof(Unordered) == sizeof(u64) * 2u);
+  static_assert(sizeof(Tuple<u8, u64, u8, u32, u16, u64>) ==
+                sizeof(u64) * 3u);
+
   // The example from the Tuple docs.
   struct ExampleFromDocs {
     [[_sus_no_unique_address]] Tuple<u32, u64> tuple;  // 16 bytes.
@@ -0,0 +1,11 @@
+#!/bin/sh
+
+# Times a full run of subdoc over subspace, first parsing every function body
+# and then skipping them, which is the default. Extra arguments are passed to
+# both runs.
+
+echo "Parsing function bodies:"
+time tools/run_subdoc.sh --parse-function-bodies "$@"
+
+echo "Skipping function bodies:"
+time tools/run_subdoc.sh "$@"